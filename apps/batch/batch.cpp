@@ -0,0 +1,463 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include <modules/opengl/inviwoopengl.h>
+#include <modules/glfw/canvasglfw.h>
+
+#include <inviwo/core/common/defaulttohighperformancegpu.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/network/workspacemanager.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/networklock.h>
+#include <inviwo/core/processors/canvasprocessor.h>
+#include <inviwo/core/processors/processorwidget.h>
+#include <inviwo/core/util/utilities.h>
+#include <inviwo/core/util/commandlineparser.h>
+#include <inviwo/core/util/raiiutils.h>
+#include <inviwo/core/util/consolelogger.h>
+#include <inviwo/core/util/logerrorcounter.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/moduleregistration.h>
+
+#include "batchspec.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <iomanip>
+#include <numeric>
+#include <thread>
+
+using namespace inviwo;
+
+namespace {
+
+struct RunResult {
+    size_t index = 0;
+    bool ok = false;
+    double seconds = 0.0;
+    std::string message;
+};
+
+std::string runDirectory(const std::string& output, size_t index) {
+    std::ostringstream ss;
+    ss << output << "/run-" << std::setw(4) << std::setfill('0') << index;
+    return ss.str();
+}
+
+std::string csvField(std::string str) {
+    replaceInString(str, "\"", "\"\"");
+    return "\"" + str + "\"";
+}
+
+void writeSummary(const std::string& filename, const std::vector<RunResult>& results) {
+    auto os = filesystem::ofstream(filename);
+    os << "run,status,seconds,message\n";
+    for (const auto& r : results) {
+        os << r.index << "," << (r.ok ? "ok" : "failed") << "," << r.seconds << ","
+           << csvField(r.message) << "\n";
+    }
+}
+
+std::vector<RunResult> readSummary(const std::string& filename) {
+    std::vector<RunResult> results;
+    auto is = filesystem::ifstream(filename);
+    std::string line;
+    std::getline(is, line);  // header
+    while (std::getline(is, line)) {
+        const auto fields = batch::splitCsvLine(line);
+        if (fields.size() < 3) continue;
+        RunResult r;
+        r.index = stringTo<size_t>(fields[0]);
+        r.ok = fields[1] == "ok";
+        r.seconds = stringTo<double>(fields[2]);
+        if (fields.size() > 3) r.message = fields[3];
+        results.push_back(std::move(r));
+    }
+    return results;
+}
+
+void report(const std::vector<RunResult>& results, double wallSeconds) {
+    const auto failed = std::count_if(results.begin(), results.end(),
+                                      [](const RunResult& r) { return !r.ok; });
+    const auto total =
+        std::accumulate(results.begin(), results.end(), 0.0,
+                        [](double sum, const RunResult& r) { return sum + r.seconds; });
+    const auto minmax = std::minmax_element(
+        results.begin(), results.end(),
+        [](const RunResult& a, const RunResult& b) { return a.seconds < b.seconds; });
+
+    std::ostringstream ss;
+    ss << results.size() << " runs, " << (results.size() - failed) << " succeeded, " << failed
+       << " failed in " << msToString(wallSeconds * 1000.0);
+    if (!results.empty()) {
+        ss << " (per run min " << msToString(minmax.first->seconds * 1000.0) << ", mean "
+           << msToString(total * 1000.0 / results.size()) << ", max "
+           << msToString(minmax.second->seconds * 1000.0) << ")";
+    }
+    LogInfoCustom("Batch", ss.str());
+    for (const auto& r : results) {
+        if (!r.ok) LogWarnCustom("Batch", "Run " << r.index << " failed: " << r.message);
+    }
+}
+
+std::string quoteArg(const std::string& arg) {
+#ifdef WIN32
+    return "\"" + arg + "\"";
+#else
+    std::string quoted = arg;
+    replaceInString(quoted, "'", "'\\''");
+    return "'" + quoted + "'";
+#endif
+}
+
+/**
+ * Build the command line for a worker process, the original arguments without --jobs and with a
+ * --shard argument.
+ */
+std::string workerCommand(int argc, char** argv, size_t shard, size_t shards) {
+    std::vector<std::string> args{quoteArg(argv[0])};
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "-j" || arg == "--jobs") {
+            ++i;
+            continue;
+        }
+        // TCLAP also accepts the value directly after the short flag, i.e. "-j4"
+        if (arg.compare(0, 7, "--jobs=") == 0 || (arg.size() > 2 && arg.compare(0, 2, "-j") == 0)) {
+            continue;
+        }
+        args.push_back(quoteArg(arg));
+    }
+    args.push_back("--shard");
+    args.push_back(toString(shard) + "/" + toString(shards));
+    const auto command = joinString(args, " ");
+#ifdef WIN32
+    // cmd.exe strips the outer quotes of the whole command
+    return "\"" + command + "\"";
+#else
+    return command;
+#endif
+}
+
+/**
+ * Process events until all processors are valid or no more progress is made.
+ */
+bool evaluateNetwork(InviwoApplication& app) {
+    auto network = app.getProcessorNetwork();
+    for (int i = 0; i < 1000; ++i) {
+        app.processFront();
+        app.waitForPool();
+        app.processFront();
+        const auto processors = network->getProcessors();
+        if (std::all_of(processors.begin(), processors.end(),
+                        [](Processor* p) { return p->isValid() || !p->isReady(); })) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool loadWorkspace(InviwoApplication& app, const std::string& workspace) {
+    NetworkLock lock(app.getProcessorNetwork());
+    try {
+        app.getWorkspaceManager()->load(workspace, [&](ExceptionContext ec) {
+            try {
+                throw;
+            } catch (const IgnoreException& e) {
+                util::log(e.getContext(),
+                          "Incomplete network loading " + workspace + " due to " + e.getMessage(),
+                          LogLevel::Error);
+            }
+        });
+    } catch (const Exception& exception) {
+        util::log(exception.getContext(),
+                  "Unable to load network " + workspace + " due to " + exception.getMessage(),
+                  LogLevel::Error);
+        return false;
+    } catch (const ticpp::Exception& exception) {
+        LogErrorCustom("Batch", "Unable to load network " + workspace +
+                                    " due to deserialization error: " + exception.what());
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    using Clock = std::chrono::high_resolution_clock;
+    using Seconds = std::chrono::duration<double>;
+    const auto batchStart = Clock::now();
+
+    LogCentral::init();
+    inviwo::util::OnScopeExit deleteLogcentral([]() { inviwo::LogCentral::deleteInstance(); });
+    auto logger = std::make_shared<inviwo::ConsoleLogger>();
+    LogCentral::getPtr()->registerLogger(logger);
+    auto errorCounter = std::make_shared<LogErrorCounter>();
+    LogCentral::getPtr()->registerLogger(errorCounter);
+
+    TCLAP::ValueArg<std::string> specArg(
+        "", "spec", "Batch specification, a .json or .csv file with the property values to run",
+        true, "", "spec file");
+    TCLAP::ValueArg<size_t> jobsArg("j", "jobs", "Number of worker processes to run in parallel",
+                                    false, 1, "count");
+    TCLAP::ValueArg<std::string> shardArg(
+        "", "shard", "Only run every n:th run starting at i, used internally by --jobs", false, "",
+        "i/n");
+    TCLAP::ValueArg<std::string> extArg("", "image-extension", "File extension of saved canvases",
+                                        false, "png", "extension");
+    TCLAP::MultiArg<std::string> outportArg(
+        "", "outport", "Save the data of an outport for each run, as <processor>.<outport>:<ext>",
+        false, "outport");
+
+    // The batch arguments are parsed before the application is created. The dispatching process
+    // only starts the workers and collects their summaries, it needs neither the modules nor an
+    // OpenGL context. Other arguments are left for the application of the workers.
+    TCLAP::ValueArg<std::string> workspaceArg("w", "workspace", "Workspace to run", false, "",
+                                              "workspace file");
+    TCLAP::ValueArg<std::string> outputArg("o", "output", "Output directory", false, "",
+                                           "output path");
+    WildCardArg otherArgs;
+    TCLAP::CmdLine batchCmd("Inviwo batch runner", ' ', IVW_VERSION, false);
+    for (TCLAP::Arg* arg : std::initializer_list<TCLAP::Arg*>{
+             &specArg, &jobsArg, &shardArg, &extArg, &outportArg, &workspaceArg, &outputArg}) {
+        batchCmd.add(arg);
+    }
+    batchCmd.add(otherArgs);
+    batchCmd.setExceptionHandling(false);
+    try {
+        batchCmd.parse(argc, argv);
+    } catch (const TCLAP::ArgException& e) {
+        LogErrorCustom("Batch", e.error() << " for arg " << e.argId());
+        return 1;
+    }
+
+    batch::Spec spec;
+    try {
+        spec = batch::loadSpec(specArg.getValue());
+    } catch (const Exception& e) {
+        util::log(e.getContext(), e.getMessage(), LogLevel::Error);
+        return 1;
+    }
+    for (const auto& item : outportArg.getValue()) {
+        const auto pos = item.rfind(':');
+        if (pos == std::string::npos || pos == 0 || pos + 1 == item.size()) {
+            LogErrorCustom("Batch", "Invalid outport \"" << item
+                                                          << "\", expected <path>:<extension>");
+            return 1;
+        }
+        spec.outports.emplace_back(item.substr(0, pos), item.substr(pos + 1));
+    }
+
+    // Paths in the spec are relative to the spec file
+    auto specDir = filesystem::getFileDirectory(specArg.getValue());
+    if (specDir.empty()) specDir = filesystem::getWorkingDirectory();
+    const auto resolve = [&](const std::string& path) {
+        if (path.empty() || filesystem::isAbsolutePath(path)) return path;
+        return specDir + "/" + path;
+    };
+
+    const std::string workspace =
+        workspaceArg.isSet() ? workspaceArg.getValue() : resolve(spec.workspace);
+    std::string output = outputArg.getValue();
+    if (output.empty()) {
+        output = spec.output.empty() ? specDir + "/batch-output" : resolve(spec.output);
+    }
+    filesystem::createDirectoryRecursively(output);
+
+    size_t shard = 0;
+    size_t shards = 1;
+    if (!shardArg.getValue().empty()) {
+        const auto parts = splitString(shardArg.getValue(), '/');
+        if (parts.size() != 2) {
+            LogErrorCustom("Batch", "Invalid shard \"" << shardArg.getValue() << "\"");
+            return 1;
+        }
+        shard = stringTo<size_t>(parts[0]);
+        shards = std::max(size_t{1}, stringTo<size_t>(parts[1]));
+    }
+
+    // Distribute the runs over worker processes, each loads its own copy of the workspace
+    if (shardArg.getValue().empty() && jobsArg.getValue() > 1) {
+        const size_t jobs = std::min(jobsArg.getValue(), spec.runs.size());
+        LogInfoCustom("Batch", "Running " << spec.runs.size() << " runs in " << jobs
+                                          << " processes");
+        // Summaries left from an earlier batch in the same output would be taken as results
+        const auto summaryFile = [&](size_t i) {
+            return output + "/summary-" + toString(i) + ".csv";
+        };
+        for (size_t i = 0; i < jobs; ++i) {
+            const auto file = summaryFile(i);
+            if (filesystem::fileExists(file) && std::remove(file.c_str()) != 0) {
+                LogErrorCustom("Batch", "Unable to remove old summary " << file);
+                return 1;
+            }
+        }
+
+        std::vector<int> exitCodes(jobs, 0);
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < jobs; ++i) {
+            workers.emplace_back([&, i]() {
+                exitCodes[i] = std::system(workerCommand(argc, argv, i, jobs).c_str());
+            });
+        }
+        for (auto& worker : workers) worker.join();
+
+        std::vector<RunResult> results;
+        for (size_t i = 0; i < jobs; ++i) {
+            const auto file = summaryFile(i);
+            if (exitCodes[i] != 0 && !filesystem::fileExists(file)) {
+                LogErrorCustom("Batch", "Worker " << i << " failed with exit code "
+                                                  << exitCodes[i]);
+            }
+            auto shardResults = readSummary(file);
+            std::move(shardResults.begin(), shardResults.end(), std::back_inserter(results));
+        }
+        // Runs of crashed workers have no result, mark them as failed
+        for (const auto& run : spec.runs) {
+            if (std::none_of(results.begin(), results.end(),
+                             [&](const RunResult& r) { return r.index == run.index; })) {
+                results.push_back({run.index, false, 0.0, "worker process failed"});
+            }
+        }
+        std::sort(results.begin(), results.end(),
+                  [](const RunResult& a, const RunResult& b) { return a.index < b.index; });
+        writeSummary(output + "/summary.csv", results);
+        report(results, Seconds(Clock::now() - batchStart).count());
+        return std::all_of(results.begin(), results.end(), [](const RunResult& r) { return r.ok; })
+                   ? 0
+                   : 1;
+    }
+
+    if (workspace.empty()) {
+        LogErrorCustom("Batch", "No workspace given, use --workspace or the spec");
+        return 1;
+    }
+
+    InviwoApplication inviwoApp(argc, argv, "Inviwo-Batch");
+    inviwoApp.setPostEnqueueFront([]() { glfwPostEmptyEvent(); });
+
+    CanvasGLFW::setAlwaysOnTopByDefault(false);
+
+    // Initialize all modules
+    inviwoApp.registerModules(inviwo::getModuleList());
+
+    // Parse again with the arguments of the modules
+    auto& cmdparser = inviwoApp.getCommandLineParser();
+    for (TCLAP::Arg* arg :
+         std::initializer_list<TCLAP::Arg*>{&specArg, &jobsArg, &shardArg, &extArg, &outportArg}) {
+        cmdparser.add(arg);
+    }
+    cmdparser.parse(inviwo::CommandLineParser::Mode::Normal);
+
+    if (!loadWorkspace(inviwoApp, workspace)) return 1;
+
+    auto network = inviwoApp.getProcessorNetwork();
+    // Render off screen, canvases are evaluated even though their windows are hidden
+    for (auto canvas : network->getProcessorsByType<CanvasProcessor>()) {
+        canvas->setEvaluateWhenHidden(true);
+        if (auto widget = canvas->getProcessorWidget()) widget->hide();
+    }
+
+    cmdparser.processCallbacks();  // run any command line callbacks from modules.
+
+    std::vector<RunResult> results;
+    for (const auto& run : spec.runs) {
+        if (run.index % shards != shard) continue;
+
+        RunResult result;
+        result.index = run.index;
+        const auto start = Clock::now();
+        const auto errors = errorCounter->getErrorCount();
+        try {
+            {
+                NetworkLock lock(network);
+                for (const auto& item : run.values) {
+                    batch::setPropertyValue(*network, item.first, item.second);
+                }
+            }
+            if (!evaluateNetwork(inviwoApp)) {
+                throw Exception("Network evaluation did not finish",
+                                IVW_CONTEXT_CUSTOM("Batch"));
+            }
+
+            const auto dir = runDirectory(output, run.index);
+            filesystem::createDirectoryRecursively(dir);
+            util::saveAllCanvases(network, dir, "", extArg.getValue());
+            for (const auto& item : spec.outports) {
+                batch::writeOutportData(*network, *inviwoApp.getDataWriterFactory(), item.first,
+                                        item.second, dir + "/" + item.first);
+            }
+
+            auto os = filesystem::ofstream(dir + "/parameters.txt");
+            for (const auto& item : run.values) os << item.first << " = " << item.second << "\n";
+
+            result.ok = errorCounter->getErrorCount() == errors;
+            if (!result.ok) {
+                result.message = toString(errorCounter->getErrorCount() - errors) +
+                                 " errors logged, see the log for details";
+            }
+        } catch (const Exception& e) {
+            util::log(e.getContext(), "Run " + toString(run.index) + ": " + e.getMessage(),
+                      LogLevel::Error);
+            result.message = e.getMessage();
+        } catch (const std::exception& e) {
+            LogErrorCustom("Batch", "Run " << run.index << ": " << e.what());
+            result.message = e.what();
+        }
+        result.seconds = Seconds(Clock::now() - start).count();
+        LogInfoCustom("Batch", "Run " << run.index << (result.ok ? " done" : " failed") << " in "
+                                      << msToString(result.seconds * 1000.0));
+        results.push_back(std::move(result));
+    }
+
+    if (shardArg.getValue().empty()) {
+        writeSummary(output + "/summary.csv", results);
+        report(results, Seconds(Clock::now() - batchStart).count());
+    } else {
+        writeSummary(output + "/summary-" + toString(shard) + ".csv", results);
+    }
+
+    glfwTerminate();
+    return std::all_of(results.begin(), results.end(), [](const RunResult& r) { return r.ok; })
+               ? 0
+               : 1;
+}
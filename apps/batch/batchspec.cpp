@@ -0,0 +1,336 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#include "batchspec.h"
+
+#include <inviwo/core/datastructures/geometry/mesh.h>
+#include <inviwo/core/datastructures/image/image.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/io/datawriterfactory.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/ports/dataoutport.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/buttonproperty.h>
+#include <inviwo/core/properties/fileproperty.h>
+#include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/core/properties/stringproperty.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/foreacharg.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <nlohmann/json.hpp>
+#include <warn/pop>
+
+#include <sstream>
+
+namespace inviwo {
+
+namespace batch {
+
+namespace {
+
+using json = nlohmann::json;
+
+std::string toValueString(const json& value) {
+    if (value.is_string()) return value.get<std::string>();
+    if (value.is_boolean()) return value.get<bool>() ? "true" : "false";
+    if (value.is_array()) {
+        std::vector<std::string> elems;
+        for (const auto& elem : value) elems.push_back(toValueString(elem));
+        return joinString(elems, " ");
+    }
+    return value.dump();
+}
+
+std::vector<std::pair<std::string, std::string>> toValues(const json& object) {
+    std::vector<std::pair<std::string, std::string>> values;
+    for (auto it = object.begin(); it != object.end(); ++it) {
+        values.emplace_back(it.key(), toValueString(it.value()));
+    }
+    return values;
+}
+
+struct OrdinalSetter {
+    template <typename T>
+    void operator()(Property* property, const std::string& value, bool& done) {
+        if (done) return;
+        if (auto ordinal = dynamic_cast<OrdinalProperty<T>*>(property)) {
+            using V = typename util::value_type<T>::type;
+            std::istringstream is{value};
+            T result{};
+            for (size_t i = 0; i < util::extent<T>::value; ++i) {
+                V comp{};
+                if (!(is >> comp)) {
+                    throw Exception("Expected " + toString(util::extent<T>::value) +
+                                        " values for " + joinString(property->getPath(), ".") +
+                                        ", got \"" + value + "\"",
+                                    IVW_CONTEXT_CUSTOM("batch::setPropertyValue"));
+                }
+                util::glmcomp(result, i) = comp;
+            }
+            ordinal->set(result);
+            done = true;
+        }
+    }
+};
+
+struct OutportWriter {
+    template <typename T>
+    void operator()(Outport* port, DataWriterFactory& factory, const std::string& extension,
+                    const std::string& filename, bool& done) {
+        if (done) return;
+        if (auto dataPort = dynamic_cast<DataOutport<T>*>(port)) {
+            done = true;
+            const auto data = dataPort->getData();
+            if (!data) {
+                throw Exception("No data in outport " + port->getProcessor()->getIdentifier() +
+                                    "." + port->getIdentifier(),
+                                IVW_CONTEXT_CUSTOM("batch::writeOutportData"));
+            }
+            auto writer = factory.getWriterForTypeAndExtension<T>(extension);
+            if (!writer) {
+                throw Exception("No writer for " + DataTraits<T>::dataName() +
+                                    " with extension \"" + extension + "\"",
+                                IVW_CONTEXT_CUSTOM("batch::writeOutportData"));
+            }
+            writer->setOverwrite(true);
+            writer->writeData(data.get(), filename + "." + extension);
+        }
+    }
+};
+
+}  // namespace
+
+std::vector<std::string> splitCsvLine(const std::string& line) {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); ++i) {
+        const char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                fields.back() += '"';
+                ++i;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                fields.back() += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.emplace_back();
+        } else if (c != '\r') {
+            fields.back() += c;
+        }
+    }
+    for (auto& field : fields) field = trim(field);
+    return fields;
+}
+
+Spec parseJsonSpec(std::istream& is) {
+    json j;
+    try {
+        is >> j;
+    } catch (const json::exception& e) {
+        throw Exception(std::string("Invalid JSON spec: ") + e.what(),
+                        IVW_CONTEXT_CUSTOM("batch::parseJsonSpec"));
+    }
+
+    Spec spec;
+    spec.workspace = j.value("workspace", "");
+    spec.output = j.value("output", "");
+
+    const auto fixed = j.count("fixed") ? toValues(j["fixed"])
+                                        : std::vector<std::pair<std::string, std::string>>{};
+
+    if (j.count("sweep")) {
+        // Generate all combinations of the sweep values. The properties are ordered by path, and
+        // the last one varies fastest
+        std::vector<std::pair<std::string, std::vector<std::string>>> axes;
+        for (auto it = j["sweep"].begin(); it != j["sweep"].end(); ++it) {
+            std::vector<std::string> values;
+            if (it.value().is_array()) {
+                for (const auto& v : it.value()) values.push_back(toValueString(v));
+            } else {
+                values.push_back(toValueString(it.value()));
+            }
+            if (values.empty()) continue;
+            axes.emplace_back(it.key(), std::move(values));
+        }
+        if (!axes.empty()) {
+            std::vector<size_t> counter(axes.size(), 0);
+            for (;;) {
+                Run run;
+                run.values = fixed;
+                for (size_t a = 0; a < axes.size(); ++a) {
+                    run.values.emplace_back(axes[a].first, axes[a].second[counter[a]]);
+                }
+                spec.runs.push_back(std::move(run));
+
+                size_t a = axes.size();
+                while (a > 0 && ++counter[a - 1] == axes[a - 1].second.size()) {
+                    counter[a - 1] = 0;
+                    --a;
+                }
+                if (a == 0) break;
+            }
+        }
+    }
+
+    if (j.count("runs")) {
+        for (const auto& item : j["runs"]) {
+            Run run;
+            run.values = fixed;
+            auto values = toValues(item);
+            run.values.insert(run.values.end(), values.begin(), values.end());
+            spec.runs.push_back(std::move(run));
+        }
+    }
+
+    if (spec.runs.empty()) spec.runs.push_back(Run{0, fixed});
+
+    if (j.count("outports")) spec.outports = toValues(j["outports"]);
+
+    for (size_t i = 0; i < spec.runs.size(); ++i) spec.runs[i].index = i;
+    return spec;
+}
+
+Spec parseCsvSpec(std::istream& is) {
+    Spec spec;
+    std::vector<std::string> header;
+    std::string line;
+    while (std::getline(is, line)) {
+        if (trim(line).empty() || trim(line)[0] == '#') continue;
+        auto fields = splitCsvLine(line);
+        if (header.empty()) {
+            header = std::move(fields);
+            continue;
+        }
+        if (fields.size() > header.size()) {
+            throw Exception("Too many fields in CSV line: " + line,
+                            IVW_CONTEXT_CUSTOM("batch::parseCsvSpec"));
+        }
+        Run run;
+        run.index = spec.runs.size();
+        for (size_t i = 0; i < fields.size(); ++i) {
+            if (!fields[i].empty()) run.values.emplace_back(header[i], fields[i]);
+        }
+        spec.runs.push_back(std::move(run));
+    }
+    return spec;
+}
+
+Spec loadSpec(const std::string& filename) {
+    auto is = filesystem::ifstream(filename);
+    if (!is) {
+        throw FileException("Could not open spec file: " + filename,
+                            IVW_CONTEXT_CUSTOM("batch::loadSpec"));
+    }
+    const auto ext = toLower(filesystem::getFileExtension(filename));
+    if (ext == "json") return parseJsonSpec(is);
+    if (ext == "csv") return parseCsvSpec(is);
+    throw Exception("Unsupported spec file type \"" + ext + "\", expected json or csv",
+                    IVW_CONTEXT_CUSTOM("batch::loadSpec"));
+}
+
+void setPropertyValue(ProcessorNetwork& network, const std::string& path,
+                      const std::string& value) {
+    auto property = network.getProperty(splitString(path, '.'));
+    if (!property) {
+        throw Exception("Property not found: " + path,
+                        IVW_CONTEXT_CUSTOM("batch::setPropertyValue"));
+    }
+
+    if (auto boolProperty = dynamic_cast<BoolProperty*>(property)) {
+        const auto v = toLower(value);
+        if (v == "true" || v == "1") {
+            boolProperty->set(true);
+        } else if (v == "false" || v == "0") {
+            boolProperty->set(false);
+        } else {
+            throw Exception("Invalid bool value \"" + value + "\" for " + path,
+                            IVW_CONTEXT_CUSTOM("batch::setPropertyValue"));
+        }
+    } else if (auto fileProperty = dynamic_cast<FileProperty*>(property)) {
+        fileProperty->set(value);
+    } else if (auto stringProperty = dynamic_cast<StringProperty*>(property)) {
+        stringProperty->set(value);
+    } else if (auto button = dynamic_cast<ButtonProperty*>(property)) {
+        button->pressButton();
+    } else if (auto option = dynamic_cast<BaseOptionProperty*>(property)) {
+        if (!option->setSelectedIdentifier(value) && !option->setSelectedDisplayName(value)) {
+            std::istringstream is{value};
+            size_t index = 0;
+            if (!(is >> index) || !is.eof() || !option->setSelectedIndex(index)) {
+                throw Exception("Invalid option \"" + value + "\" for " + path,
+                                IVW_CONTEXT_CUSTOM("batch::setPropertyValue"));
+            }
+        }
+    } else {
+        using Types = std::tuple<float, double, int, glm::i64, size_t, vec2, dvec2, ivec2, size2_t,
+                                 vec3, dvec3, ivec3, size3_t, vec4, dvec4, ivec4, size4_t>;
+        bool done = false;
+        util::for_each_type<Types>{}(OrdinalSetter{}, property, value, done);
+        if (!done) {
+            throw Exception("Unsupported property type " + property->getClassIdentifier() +
+                                " for " + path,
+                            IVW_CONTEXT_CUSTOM("batch::setPropertyValue"));
+        }
+    }
+}
+
+void writeOutportData(ProcessorNetwork& network, DataWriterFactory& factory,
+                      const std::string& path, const std::string& extension,
+                      const std::string& filename) {
+    const auto parts = splitString(path, '.');
+    auto processor = parts.size() == 2 ? network.getProcessorByIdentifier(parts[0]) : nullptr;
+    auto port = processor ? processor->getOutport(parts[1]) : nullptr;
+    if (!port) {
+        throw Exception("Outport not found: " + path,
+                        IVW_CONTEXT_CUSTOM("batch::writeOutportData"));
+    }
+
+    using Types = std::tuple<Volume, Mesh, Image, Layer>;
+    bool done = false;
+    util::for_each_type<Types>{}(OutportWriter{}, port, factory, extension, filename, done);
+    if (!done) {
+        throw Exception("Unsupported outport type " + port->getClassIdentifier() + " for " + path,
+                        IVW_CONTEXT_CUSTOM("batch::writeOutportData"));
+    }
+}
+
+}  // namespace batch
+
+}  // namespace inviwo
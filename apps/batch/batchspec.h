@@ -0,0 +1,134 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#ifndef IVW_BATCHSPEC_H
+#define IVW_BATCHSPEC_H
+
+#include <inviwo/core/common/inviwo.h>
+
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+class ProcessorNetwork;
+class DataWriterFactory;
+
+namespace batch {
+
+/**
+ * \brief One configuration of a sweep, a list of property paths and values.
+ * Property paths are dot separated, starting with the processor identifier, i.e.
+ * "Raycaster.raycaster.samplingRate". Values are given as strings, see setPropertyValue.
+ */
+struct Run {
+    size_t index = 0;
+    std::vector<std::pair<std::string, std::string>> values;
+};
+
+/**
+ * \brief The workspace, output directory and runs of a batch.
+ *
+ * A JSON spec looks like
+ * \code{.json}
+ * {
+ *     "workspace": "boron.inv",
+ *     "output": "boron-sweep",
+ *     "fixed": {"Canvas.inputSize.dimensions": [512, 512]},
+ *     "sweep": {
+ *         "Raycaster.raycaster.samplingRate": [1.0, 2.0, 4.0],
+ *         "Raycaster.raycaster.renderingType": ["dvr", "iso"]
+ *     },
+ *     "runs": [
+ *         {"Raycaster.raycaster.samplingRate": 8.0}
+ *     ],
+ *     "outports": {"VolumeSubsample.outputVolume": "dat"}
+ * }
+ * \endcode
+ * All keys are optional. "sweep" generates a run for each combination of its values, "runs"
+ * lists additional runs explicitly, and "fixed" values are applied before each run. "outports"
+ * maps outport paths, "<processor>.<outport>", to the file extension used to find a DataWriter,
+ * their data is saved for each run in addition to the canvases.
+ *
+ * A CSV spec has a header line with property paths and one line per run. Empty fields leave the
+ * property unchanged, lines starting with # are ignored.
+ */
+struct Spec {
+    std::string workspace;
+    std::string output;
+    std::vector<Run> runs;
+    std::vector<std::pair<std::string, std::string>> outports;
+};
+
+/**
+ * Load a spec from a .json or .csv file.
+ * @throws Exception if the file could not be read or parsed
+ */
+Spec loadSpec(const std::string& filename);
+Spec parseJsonSpec(std::istream& is);
+Spec parseCsvSpec(std::istream& is);
+
+/**
+ * Split a line of comma separated values, fields may be quoted with double quotes and quotes
+ * within quoted fields are escaped by doubling them. Fields are trimmed.
+ */
+std::vector<std::string> splitCsvLine(const std::string& line);
+
+/**
+ * \brief Set a property of the network from a string.
+ *
+ * Supported are bool ("true", "false", "1", "0"), string and file properties, option properties
+ * (by identifier, display name or index), scalar and vector ordinal properties (components
+ * separated by spaces) and button properties (any value presses the button).
+ * @throws Exception if the property does not exist or the value could not be applied
+ */
+void setPropertyValue(ProcessorNetwork& network, const std::string& path,
+                      const std::string& value);
+
+/**
+ * \brief Write the data of an outport to a file using a registered DataWriter.
+ *
+ * Supported are outports of volumes, meshes, images and layers.
+ * @param path Outport path, "<processor>.<outport>"
+ * @param extension File extension used to find the writer, also appended to the filename
+ * @param filename File to write, without extension
+ * @throws Exception if the outport does not exist, has no data or no writer was found
+ */
+void writeOutportData(ProcessorNetwork& network, DataWriterFactory& factory,
+                      const std::string& path, const std::string& extension,
+                      const std::string& filename);
+
+}  // namespace batch
+
+}  // namespace inviwo
+
+#endif  // IVW_BATCHSPEC_H
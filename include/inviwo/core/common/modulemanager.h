@@ -41,6 +41,7 @@
 
 #include <warn/push>
 #include <warn/ignore/all>
+#include <chrono>
 #include <set>
 #include <warn/pop>
 
@@ -59,6 +60,18 @@ class IVW_CORE_API ModuleManager {
 public:
     using IdSet = std::set<std::string, CaseInsensitiveCompare>;
 
+    /**
+     * Time spent on a module during registration.
+     */
+    struct ModuleTiming {
+        std::string name;
+        std::chrono::nanoseconds load{0};          ///< Loading the library, zero if not a library
+        std::chrono::nanoseconds construction{0};  ///< Constructing the module
+        std::chrono::nanoseconds capabilities{0};  ///< Retrieving and printing its capabilities
+
+        std::chrono::nanoseconds total() const { return load + construction + capabilities; }
+    };
+
     ModuleManager(InviwoApplication* app);
     ModuleManager(const ModuleManager& rhs) = delete;
     ModuleManager& operator=(const ModuleManager& that) = delete;
@@ -133,7 +146,16 @@ public:
     static std::function<bool(const std::string&)> getEnabledFilter();
     void reloadModules();
 
+    /**
+     * \brief Time spent on each module while registering modules, in order of registration.
+     * A summary is logged after each registration, the details are also recorded in the Tracer.
+     */
+    const std::vector<ModuleTiming>& getModuleTimings() const;
+
 private:
+    ModuleTiming& getTiming(const std::string& module);
+    void logTimings(std::chrono::nanoseconds total) const;
+
     void registerModule(std::unique_ptr<InviwoModule> module);
     bool checkDependencies(const InviwoModuleFactoryObject& obj) const;
     std::vector<std::string> deregisterDependetModules(
@@ -155,6 +177,7 @@ private:
     std::vector<std::unique_ptr<InviwoModuleFactoryObject>> factoryObjects_;
     std::vector<std::unique_ptr<InviwoModule>> modules_;
     util::OnScopeExit clearModules_;
+    std::vector<ModuleTiming> timings_;
 };
 
 template <class T>
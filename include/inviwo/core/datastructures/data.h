@@ -34,7 +34,9 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/datastructures/representationconverterfactory.h>
+#include <inviwo/core/util/tracing.h>
 #include <typeindex>
+#include <atomic>
 
 namespace inviwo {
 /**
@@ -161,6 +163,14 @@ public:
      */
     void invalidateAllOther(const Repr* repr);
 
+    /**
+     * A counter that is incremented whenever the data might have been modified, i.e. when an
+     * editable representation is requested, other representations are invalidated, or
+     * representations are added or cleared. Caches of derived data, like acceleration
+     * structures, can store the count and compare it to detect changes.
+     */
+    size_t getModificationCount() const;
+
     /**
      * Set the format of the data.
      * @see DataFormatBase
@@ -186,6 +196,7 @@ protected:
     // A pointer to the the most recently updated representation. Makes updates and creation faster.
     mutable std::shared_ptr<Repr> lastValidRepresentation_;
     const DataFormatBase* dataFormatBase_;
+    std::atomic<size_t> modificationCount_{0};
 };
 
 template <typename Self, typename Repr>
@@ -238,6 +249,11 @@ const T* Data<Self, Repr>::getValidRepresentation() const {
     if (package) {
         for (auto converter : package->getConverters()) {
             auto dest = converter->getConverterID().second;
+            const auto traceName =
+                Tracer::isEnabled() ? parseTypeIdName(converter->getConverterID().first.name()) +
+                                          " to " + parseTypeIdName(dest.name())
+                                    : std::string{};
+            IVW_TRACE_SCOPE("conversion", traceName);
             auto it = representations_.find(dest);
             if (it != representations_.end()) {  // Next repr. already exist, just update it
                 converter->update(lastValidRepresentation_, it->second);
@@ -284,12 +300,19 @@ void Data<Self, Repr>::invalidateAllOther(const Repr* repr) {
         }
     }
     if (!found) throw Exception("Called with representation not in representations.", IvwContext);
+    ++modificationCount_;
+}
+
+template <typename Self, typename Repr>
+size_t Data<Self, Repr>::getModificationCount() const {
+    return modificationCount_;
 }
 
 template <typename Self, typename Repr>
 void Data<Self, Repr>::clearRepresentations() {
     std::unique_lock<std::mutex> lock(mutex_);
     representations_.clear();
+    ++modificationCount_;
 }
 
 template <typename Self, typename Repr>
@@ -315,6 +338,7 @@ template <typename Self, typename Repr>
 void Data<Self, Repr>::addRepresentation(std::shared_ptr<Repr> representation) {
     std::unique_lock<std::mutex> lock(mutex_);
     lastValidRepresentation_ = addRepresentationInternal(representation);
+    ++modificationCount_;
 }
 
 template <typename Self, typename Repr>
@@ -40,6 +40,9 @@
 #include <inviwo/core/metadata/metadataowner.h>
 #include <inviwo/core/util/document.h>
 #include <utility>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
 #include <inviwo/core/io/datareader.h>
 #include <inviwo/core/io/datawriter.h>
 
@@ -207,6 +210,16 @@ public:
         const Camera& camera) const;
     using SpatialEntity<3>::getCoordinateTransformer;
 
+    /**
+     * \brief Get data derived from the mesh, like an acceleration structure, stored under \p key.
+     *
+     * Derived data is not copied with the mesh and is released together with it. The users of an
+     * entry are responsible for detecting if it is outdated, see Data::getModificationCount.
+     * @return the data stored under \p key or nullptr
+     */
+    std::shared_ptr<void> getDerivedData(std::type_index key) const;
+    void setDerivedData(std::type_index key, std::shared_ptr<void> data) const;
+
     static uvec3 colorCode;
     static const std::string classIdentifier;
     static const std::string dataName;
@@ -215,6 +228,10 @@ protected:
     BufferVector buffers_;
     IndexVector indices_;
     MeshInfo meshInfo_;
+
+private:
+    mutable std::mutex derivedMutex_;
+    mutable std::unordered_map<std::type_index, std::shared_ptr<void>> derived_;
 };
 
 inline bool operator==(const Mesh::BufferInfo& a, const Mesh::BufferInfo& b) {
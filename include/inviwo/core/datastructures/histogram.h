@@ -34,6 +34,11 @@
 #include <inviwo/core/common/inviwo.h>
 
 namespace inviwo {
+
+namespace util {
+class QuantileSketch;
+}
+
 enum class HistogramMode { Off, All, P99, P95, P90, Log };
 
 /**
@@ -61,7 +66,18 @@ public:
     void resize(size_t);
 
     void performNormalization();
+    /**
+     * Approximate stats_.percentiles from the bins, the precision is limited by the bin width.
+     */
     void calculatePercentiles();
+    /**
+     * Set stats_.percentiles from a sketch of the underlying data
+     */
+    void calculatePercentiles(const util::QuantileSketch& sketch);
+    /**
+     * Compute histStats_ from the bin heights, used to scale the histogram in the different
+     * HistogramMode%s.
+     */
     void calculateHistStats();
     double getMaximumBinValue() const;
 
@@ -37,6 +37,8 @@
 #include <inviwo/core/util/formats.h>
 #include <inviwo/core/util/formatdispatching.h>
 
+#include <functional>
+
 namespace inviwo {
 
 /**
@@ -72,6 +74,15 @@ public:
     virtual const HistogramContainer* getHistograms(size_t bins = 2048u,
                                                     size3_t sampleRate = size3_t(1)) const = 0;
     virtual void calculateHistograms(size_t bins, size3_t sampleRate, const bool& stop) const = 0;
+    /**
+     * Calculate the histograms in several passes of increasing resolution, see
+     * util::calculateVolumeHistogramProgressive. \p callback is called with an estimate after
+     * each pass except the last one. The final result is stored and can be retrieved using
+     * getHistograms(), nothing is stored if the calculation is stopped.
+     */
+    virtual void calculateHistogramsProgressive(
+        size_t bins, const bool& stop,
+        std::function<void(const HistogramContainer&)> callback) const = 0;
 
     // uniform getters and setters
     virtual double getAsDouble(const size3_t& pos) const = 0;
@@ -32,43 +32,144 @@
 
 #include <inviwo/core/datastructures/histogram.h>
 #include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/quantilesketch.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
 namespace inviwo {
 
 namespace util {
 
-template <typename T>
-HistogramContainer calculateVolumeHistogram(const T* data, size3_t dimensions, dvec2 dataRange,
-                                            const bool& stop = false, size_t bins = 2048,
-                                            size3_t sampleRate = size3_t(1)) {
-    // a double type with the same extent as T
-    typedef typename util::same_extent<T, double>::type D;
-    // a size_t type with same extent as T
-    typedef typename util::same_extent<T, size_t>::type I;
-
-    const size_t extent = util::rank<T>::value > 0 ? util::extent<T>::value : 1;
+namespace detail {
 
+template <typename T>
+size_t volumeHistogramBins(size_t bins, dvec2 dataRange) {
     // check whether number of bins exceeds the data range only if it is an integral type
     if (!util::is_floating_point<T>::value) {
         bins = std::min(bins, static_cast<std::size_t>(dataRange.y - dataRange.x + 1));
     }
+    return bins;
+}
 
-    HistogramContainer histograms;
-    for (size_t i = 0; i < extent; ++i) {
-        histograms.add(new NormalizedHistogram(bins));
+/**
+ * Accumulates the bin counts, statistics and percentile sketches of volume data one value at a
+ * time. The histograms of all values seen so far can be extracted at any point using result(),
+ * used by calculateVolumeHistogram and calculateVolumeHistogramProgressive.
+ *
+ * Adding a value to a sketch is much more expensive than binning it. The sketches are therefore
+ * only fed a random subsample of about sketchSamples values out of the \p count values that are
+ * expected to be added, which bounds the rank error of the percentiles to a fraction of a percent.
+ */
+template <typename T>
+class VolumeHistogramAccumulator {
+public:
+    // a double type with the same extent as T
+    using D = typename util::same_extent<T, double>::type;
+
+    static constexpr size_t sketchSamples = size_t{1} << 18;
+
+    VolumeHistogramAccumulator(dvec2 dataRange, size_t bins, size_t count)
+        : dataRange_{dataRange}
+        , bins_{bins}
+        , scale_{static_cast<double>(bins - 1) / (dataRange.y - dataRange.x)}
+        , counts_(channels(), std::vector<double>(bins, 0.0))
+        // The percentiles are estimated from the values, not the bins, to not be limited by the
+        // bin width
+        , sketches_(channels())
+        , sketchStride_{std::max(size_t{1}, count / sketchSamples)} {}
+
+    static constexpr size_t channels() {
+        return util::rank<T>::value > 0 ? util::extent<T>::value : 1;
     }
 
-    D min(std::numeric_limits<double>::max());
-    D max(std::numeric_limits<double>::lowest());
-    D sum(0);
-    D sum2(0);
-    double count(0);
+    void add(const T& value) {
+        const auto val = static_cast<D>(value);
 
-    D val;
-    I ind;
-    size_t v;
+        min_ = glm::min(min_, val);
+        max_ = glm::max(max_, val);
+        sum_ += val;
+        sum2_ += val * val;
+        count_++;
+
+        if (untilSketch_ == 0) {
+            for (size_t i = 0; i < channels(); ++i) sketches_[i].add(util::glmcomp(val, i));
+            untilSketch_ = nextSketchGap();
+        }
+        --untilSketch_;
 
-    const D rangeMin(dataRange.x);
-    const D rangeScaleFactor(static_cast<double>(bins - 1) / (dataRange.y - dataRange.x));
+        for (size_t i = 0; i < channels(); ++i) {
+            const double v = util::glmcomp(val, i);
+            const double bin = (v - dataRange_.x) * scale_;
+            if (bin >= 0.0 && bin < static_cast<double>(bins_)) {
+                counts_[i][static_cast<size_t>(bin)]++;
+            }
+        }
+    }
+
+    HistogramContainer result() const {
+        HistogramContainer histograms;
+        for (size_t i = 0; i < channels(); ++i) {
+            auto hist = new NormalizedHistogram(bins_);
+            histograms.add(hist);
+            *hist->getData() = counts_[i];
+
+            hist->dataRange_ = dataRange_;
+            hist->stats_.min = util::glmcomp(min_, i);
+            hist->stats_.max = util::glmcomp(max_, i);
+            const double sum = util::glmcomp(sum_, i);
+            const double sum2 = util::glmcomp(sum2_, i);
+            hist->stats_.mean = sum / count_;
+            hist->stats_.standardDeviation =
+                std::sqrt((count_ * sum2 - sum * sum) / (count_ * (count_ - 1)));
+
+            hist->calculatePercentiles(sketches_[i]);
+            // The extremes are known exactly
+            hist->stats_.percentiles.front() = hist->stats_.min;
+            hist->stats_.percentiles.back() = hist->stats_.max;
+            hist->performNormalization();
+            hist->calculateHistStats();
+            hist->setValid(true);
+        }
+        return histograms;
+    }
+
+private:
+    // Random gaps with a mean of sketchStride_, to not alias with the structure of the volume
+    size_t nextSketchGap() {
+        if (sketchStride_ == 1) return 1;
+        random_ = random_ * 6364136223846793005ull + 1442695040888963407ull;
+        return 1 + static_cast<size_t>((random_ >> 33) % (2 * sketchStride_ - 1));
+    }
+
+    dvec2 dataRange_;
+    size_t bins_;
+    double scale_;
+    std::vector<std::vector<double>> counts_;
+    std::vector<QuantileSketch> sketches_;
+    size_t sketchStride_;
+    size_t untilSketch_ = 0;
+    std::uint64_t random_ = 0;
+
+    D min_{std::numeric_limits<double>::max()};
+    D max_{std::numeric_limits<double>::lowest()};
+    D sum_{0};
+    D sum2_{0};
+    double count_{0};
+};
+
+}  // namespace detail
+
+template <typename T>
+HistogramContainer calculateVolumeHistogram(const T* data, size3_t dimensions, dvec2 dataRange,
+                                            const bool& stop = false, size_t bins = 2048,
+                                            size3_t sampleRate = size3_t(1)) {
+    bins = detail::volumeHistogramBins<T>(bins, dataRange);
+    const auto samples = (dimensions + sampleRate - size3_t(1)) / sampleRate;
+    detail::VolumeHistogramAccumulator<T> acc(dataRange, bins, glm::compMul(samples));
 
     util::IndexMapper3D mapper(dimensions);
 
@@ -76,45 +177,59 @@ HistogramContainer calculateVolumeHistogram(const T* data, size3_t dimensions, d
     // Column major data, so x is the fastest index.
     for (pos.z = 0; pos.z < dimensions.z; pos.z += sampleRate.z) {
         for (pos.y = 0; pos.y < dimensions.y; pos.y += sampleRate.y) {
+            if (stop) return HistogramContainer{};
             for (pos.x = 0; pos.x < dimensions.x; pos.x += sampleRate.x) {
-                if (stop) return histograms;
-
-                val = static_cast<D>(data[mapper(pos)]);
-
-                min = glm::min(min, val);
-                max = glm::max(max, val);
-                sum += val;
-                sum2 += val * val;
-                count++;
+                acc.add(data[mapper(pos)]);
+            }
+        }
+    }
 
-                ind = static_cast<I>((val - rangeMin) * rangeScaleFactor);
+    return acc.result();
+}
 
-                for (size_t i = 0; i < extent; ++i) {
-                    v = util::glmcomp(ind, i);
-                    if (v < bins) {
-                        histograms[i][v]++;
-                    }
+/**
+ * Calculate the histograms of a volume in successive passes, where each pass refines the result
+ * of the previous ones. The rows of the volume, i.e. the lines along x, are visited with a stride
+ * of 8, 4, 2, and finally 1 in both y and z. Each pass skips the rows that were already visited,
+ * so every voxel is read exactly once and the final result is the same as for
+ * calculateVolumeHistogram without sub sampling.
+ *
+ * @param data the volume data
+ * @param dimensions the dimensions of the volume
+ * @param dataRange the range of the bins
+ * @param stop the calculation is aborted if set to true
+ * @param bins the number of bins
+ * @param callback called after each pass but the last with a HistogramContainer of all the
+ *        rows visited so far, i.e. with estimates based on 1/64, 1/16, and 1/4 of the data
+ * @return the histograms of all the data, or an empty HistogramContainer if stopped
+ */
+template <typename T, typename Callback>
+HistogramContainer calculateVolumeHistogramProgressive(const T* data, size3_t dimensions,
+                                                       dvec2 dataRange, const bool& stop,
+                                                       size_t bins, Callback callback) {
+    bins = detail::volumeHistogramBins<T>(bins, dataRange);
+    detail::VolumeHistogramAccumulator<T> acc(dataRange, bins, glm::compMul(dimensions));
+
+    const std::array<size_t, 4> strides{{8, 4, 2, 1}};
+    for (size_t pass = 0; pass < strides.size(); ++pass) {
+        const auto s = strides[pass];
+        const auto prev = pass == 0 ? size_t{0} : strides[pass - 1];
+
+        for (size_t z = 0; z < dimensions.z; z += s) {
+            for (size_t y = 0; y < dimensions.y; y += s) {
+                if (prev != 0 && z % prev == 0 && y % prev == 0) continue;
+                if (stop) return HistogramContainer{};
+                const T* row = data + (z * dimensions.y + y) * dimensions.x;
+                for (size_t x = 0; x < dimensions.x; ++x) {
+                    acc.add(row[x]);
                 }
             }
         }
-    }
 
-    for (size_t i = 0; i < extent; ++i) {
-        histograms[i].dataRange_ = dataRange;
-        histograms[i].stats_.min = util::glmcomp(min, i);
-        histograms[i].stats_.max = util::glmcomp(max, i);
-        histograms[i].stats_.mean = util::glmcomp(sum, i) / count;
-        histograms[i].stats_.standardDeviation = std::sqrt(
-            (count * util::glmcomp(sum2, i) - util::glmcomp(sum, i) * util::glmcomp(sum, i)) /
-            (count * (count - 1)));
-
-        histograms[i].calculatePercentiles();
-        histograms[i].performNormalization();
-        histograms[i].calculateHistStats();
-        histograms[i].setValid(true);
+        if (pass + 1 < strides.size()) callback(acc.result());
     }
 
-    return histograms;
+    return acc.result();
 }
 
 }  // namespace util
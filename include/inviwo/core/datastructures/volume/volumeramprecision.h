@@ -76,6 +76,9 @@ public:
                                                     size3_t sampleRate = size3_t(1)) const override;
     virtual void calculateHistograms(size_t bins, size3_t sampleRate,
                                      const bool& stop) const override;
+    virtual void calculateHistogramsProgressive(
+        size_t bins, const bool& stop,
+        std::function<void(const HistogramContainer&)> callback) const override;
 
     virtual double getAsDouble(const size3_t& pos) const override;
     virtual dvec2 getAsDVec2(const size3_t& pos) const override;
@@ -370,6 +373,21 @@ void VolumeRAMPrecision<T>::calculateHistograms(size_t bins, size3_t sampleRate,
     }
 }
 
+template <typename T>
+void VolumeRAMPrecision<T>::calculateHistogramsProgressive(
+    size_t bins, const bool& stop,
+    std::function<void(const HistogramContainer&)> callback) const {
+    if (const auto volume = getOwner()) {
+        dvec2 dataRange = volume->dataMap_.dataRange;
+        auto histograms = util::calculateVolumeHistogramProgressive(
+            data_.get(), dimensions_, dataRange, stop, bins,
+            [&](const HistogramContainer& estimate) {
+                if (callback) callback(estimate);
+            });
+        if (!stop) histCont_ = std::move(histograms);
+    }
+}
+
 template <typename T>
 bool VolumeRAMPrecision<T>::hasHistograms() const {
     return !histCont_.empty() && histCont_.isValid();
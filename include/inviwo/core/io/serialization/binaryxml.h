@@ -0,0 +1,84 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_BINARYXML_H
+#define IVW_BINARYXML_H
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <iosfwd>
+
+namespace ticpp {
+class Document;
+}
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * Current version of the binary xml format.
+ * @see writeBinaryXml
+ */
+constexpr unsigned int binaryXmlVersion = 1;
+
+/**
+ * \brief Write a xml document in a compact binary format.
+ * The format keeps the complete document structure, i.e. elements with attributes, text, comments
+ * and declarations, so reading it back gives the same document as parsing the xml text, but
+ * without any text formatting and parsing. It consists of
+ *   - a header with a magic number and the format version
+ *   - a table of all distinct strings in the document, element names, attribute names and
+ *     values, each stored only once
+ *   - the nodes as records prefixed by type and byte length, strings are referenced by index
+ *
+ * @param document the xml document to write
+ * @param stream the stream to write to, should be opened in binary mode
+ * @throws SerializationException if writing fails
+ * @see readBinaryXml
+ */
+IVW_CORE_API void writeBinaryXml(const ticpp::Document& document, std::ostream& stream);
+
+/**
+ * \brief Read a document written by writeBinaryXml and append its nodes to \p document.
+ * Records of unknown node types are skipped.
+ * @throws SerializationException if the data is not valid or of a newer version
+ */
+IVW_CORE_API void readBinaryXml(std::istream& stream, ticpp::Document& document);
+
+/**
+ * Check if the stream starts with binary xml data. Does not change the stream position.
+ */
+IVW_CORE_API bool isBinaryXml(std::istream& stream);
+
+}  // namespace util
+
+}  // namespace inviwo
+
+#endif  // IVW_BINARYXML_H
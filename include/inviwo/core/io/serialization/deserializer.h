@@ -64,7 +64,8 @@ public:
     Deserializer(std::string fileName, bool allowReference = true);
     /**
      * \brief Deserializes content from the stream using refPath to calculate relative paths to
-     * data.
+     * data. The stream can hold either xml or binary data.
+     * @see SerializationFormat
      *
      * @param stream Stream with content that is to be deserialized.
      * @param refPath A path that will be used to decode the location of data during
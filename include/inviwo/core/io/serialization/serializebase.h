@@ -67,6 +67,14 @@ private:
 
 enum class SerializationTarget { Node, Attribute };
 
+/**
+ * Xml is the human readable format used for workspace files. Binary stores the same document in
+ * a compact form that is much faster to write and read, suitable for undo snapshots and other
+ * in-memory copies. Deserializers detect the format automatically.
+ * @see util::writeBinaryXml
+ */
+enum class SerializationFormat { Xml, Binary };
+
 class NodeSwitch;
 class Serializable;
 
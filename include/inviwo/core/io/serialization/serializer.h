@@ -76,6 +76,15 @@ public:
      * @throws SerializationException
      */
     virtual void writeFile(std::ostream& stream, bool format = false);
+    /**
+     * \brief Writes serialized data to stream in the given format.
+     *
+     * @param stream Stream to be written to, should be opened in binary mode for binary data.
+     * @param format Format of the output, xml is written with line breaks and tabs.
+     * @throws SerializationException
+     * @see util::writeBinaryXml
+     */
+    void writeFile(std::ostream& stream, SerializationFormat format);
 
     // std containers
     template <typename T>
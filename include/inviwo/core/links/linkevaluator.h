@@ -35,6 +35,7 @@
 #include <inviwo/core/processors/processorpair.h>
 #include <inviwo/core/links/propertylink.h>
 
+#include <chrono>
 #include <unordered_map>
 
 namespace inviwo {
@@ -49,10 +50,34 @@ class IVW_CORE_API LinkEvaluator {
 public:
     using ProcessorLinkMap = std::unordered_map<ProcessorPair, std::vector<PropertyLink>>;
 
+    struct Stats {
+        size_t evaluations = 0;   ///< Number of times links were evaluated
+        size_t propagations = 0;  ///< Number of destination properties that were set
+        size_t coalesced = 0;     ///< Number of sets avoided by transactions
+        std::chrono::duration<double> time{0};  ///< Time spent setting destination properties
+    };
+
     LinkEvaluator(ProcessorNetwork* network);
 
+    /**
+     * Propagate the value of the given property to all properties linked to it. Within a
+     * transaction the propagation is postponed until the outermost transaction ends.
+     * @see beginTransaction
+     */
     void evaluateLinksFromProperty(Property*);
 
+    /**
+     * Collect all link evaluations until the matching endTransaction. When the outermost
+     * transaction ends, each linked destination is set once, using the value of the last modified
+     * source that reaches it. Transactions can be nested.
+     */
+    void beginTransaction();
+    void endTransaction();
+    bool isInTransaction() const;
+
+    const Stats& getStats() const;
+    void resetStats();
+
     /**
      * Properties that are linked to the given property where the given property is a source
      * property
@@ -83,6 +108,10 @@ private:
     std::vector<Link>& addToSecondaryCache(Property* property);
     void secondaryCacheHelper(std::vector<Link>& links, Property* src, Property* dst);
     std::vector<Link>& getTriggerdLinksForProperty(Property* property);
+    void invalidateSecondaryCache(Property* src);
+
+    void propagate(const std::vector<Link>& links);
+    void propagatePending();
 
     ProcessorNetwork* network_;
 
@@ -95,10 +124,15 @@ private:
     // A cache of all links between two processors.
     ProcessorLinkMap processorLinksCache_;
 
+    // Source properties modified during the current transaction, the last modified one is last
+    std::vector<Property*> pending_;
+    size_t transactions_ = 0;
+    Stats stats_;
+
     // Used to make sure we don't end up in circular links
     std::vector<Property*> visited_;
     struct VisitedHelper {
-        VisitedHelper(std::vector<Property*>& visited, std::vector<Link>& toVisit)
+        VisitedHelper(std::vector<Property*>& visited, const std::vector<Link>& toVisit)
             : visited_(visited), toVisit_(toVisit) {
             for (auto& link : toVisit_) {
                 util::push_back_unique(visited_, link.src_);
@@ -114,7 +148,7 @@ private:
 
     private:
         std::vector<Property*>& visited_;
-        std::vector<Link>& toVisit_;
+        const std::vector<Link>& toVisit_;
     };
 };
 
@@ -0,0 +1,68 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_LINKTRANSACTION_H
+#define IVW_LINKTRANSACTION_H
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/network/processornetwork.h>
+
+namespace inviwo {
+
+/**
+ * A RAII utility for grouping property link evaluations. All links triggered while the
+ * transaction is alive are propagated once when it is destroyed, each linked property is set to
+ * its final value. Useful for interactions that modify the same properties several times.
+ * @see ProcessorNetwork::beginLinkTransaction
+ */
+struct IVW_CORE_API LinkTransaction {
+    LinkTransaction();
+    LinkTransaction(ProcessorNetwork* network);
+    ~LinkTransaction();
+
+    LinkTransaction(LinkTransaction const&) = delete;
+    LinkTransaction& operator=(LinkTransaction const& that) = delete;
+    LinkTransaction(LinkTransaction&& rhs) = delete;
+    LinkTransaction& operator=(LinkTransaction&& that) = delete;
+
+private:
+    ProcessorNetwork* network_;
+};
+
+inline LinkTransaction::LinkTransaction(ProcessorNetwork* network) : network_(network) {
+    if (network_) network_->beginLinkTransaction();
+}
+
+inline LinkTransaction::~LinkTransaction() {
+    if (network_) network_->endLinkTransaction();
+}
+
+}  // namespace inviwo
+
+#endif  // IVW_LINKTRANSACTION_H
@@ -234,6 +234,19 @@ public:
 
     void evaluateLinksFromProperty(Property*);
 
+    /**
+     * Postpone link evaluation until the outermost transaction ends, then set each linked
+     * property once with its final value. Prefer the RAII helper LinkTransaction.
+     * @see LinkEvaluator::beginTransaction
+     */
+    void beginLinkTransaction();
+    void endLinkTransaction();
+    /**
+     * Counts and timings of the link propagation, used for profiling.
+     */
+    const LinkEvaluator::Stats& getLinkStats() const;
+    void resetLinkStats();
+
     bool isEmpty() const;
     bool isInvalidating() const;
     bool isLinking() const;
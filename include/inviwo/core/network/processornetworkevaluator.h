@@ -37,6 +37,10 @@
 #include <inviwo/core/network/processornetworkevaluationobserver.h>
 #include <inviwo/core/network/evaluationerrorhandler.h>
 
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 namespace inviwo {
 
 class Processor;
@@ -52,6 +56,18 @@ public:
     virtual ~ProcessorNetworkEvaluator() = default;
     void setExceptionHandler(EvaluationErrorHandler handler);
 
+    /**
+     * The processors that are evaluated, in topological order. Only processors with a sink
+     * downstream are included.
+     */
+    const std::vector<Processor*>& getSortedProcessors();
+
+    /**
+     * The evaluation order grouped into levels. A processor only depends on processors in
+     * earlier levels, processors within the same level are independent of each other.
+     */
+    const std::vector<std::vector<Processor*>>& getEvaluationLevels();
+
 private:
     // ProcessorNetworkObserver overrides
     virtual void onProcessorNetworkEvaluateRequest() override;
@@ -63,13 +79,40 @@ private:
 
     // ProcessorObserver overrides
     virtual void onProcessorSinkChanged(Processor*) override;
+    virtual void onProcessorInvalidationBegin(Processor*) override;
 
     void requestEvaluate();
     void evaluate();
 
+    /**
+     * A processor does not need to be processed if it was only invalidated by its inports, and
+     * none of the outports connected to them got new data since it was last processed.
+     */
+    bool hasUnchangedInput(Processor* processor) const;
+
+    /**
+     * Maintain a topological order of all processors in the network while connections are
+     * added, using the dynamic ordering of Pearce and Kelly. Only the processors between the
+     * two ends of a new connection are reordered. While the network is locked the order is
+     * invalidated instead and rebuilt once when needed.
+     */
+    void addToOrder(Processor* processor);
+    void removeFromOrder(Processor* processor);
+    void addEdgeToOrder(Processor* from, Processor* to);
+    void rebuildOrder();
+    void updateSchedule();
+
     ProcessorNetwork* processorNetwork_;
-    // the sorted list of processors obtained through topological sorting
+    // topological order of all processors and the position of each processor in it
+    std::vector<Processor*> order_;
+    std::unordered_map<Processor*, size_t> position_;
+    bool orderDirty_;
+    // the sorted list of processors with a sink downstream, and the same grouped by level
     std::vector<Processor*> processorsSorted_;
+    std::vector<std::vector<Processor*>> levels_;
+    bool scheduleDirty_;
+    // processors invalidated by properties or direct calls since they were last processed
+    std::unordered_set<Processor*> invalidatedDirectly_;
     bool evaulationQueued_;
     EvaluationErrorHandler exceptionHandler_;
 };
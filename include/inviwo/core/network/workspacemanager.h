@@ -88,22 +88,28 @@ public:
      *      The same refPath should be given when loading. Most often this should be the path to the
      *      saved file.
      * \param exceptionHandler A callback for handling errors.
+     * \param mode Disk or Undo, undo snapshots do not include the setup information.
+     * \param format Xml, or Binary for fast snapshots, the stream should then be binary.
      */
     void save(std::ostream& stream, const std::string& refPath,
               const ExceptionHandler& exceptionHandler = StandardExceptionHandler(),
-              WorkspaceSaveMode mode = WorkspaceSaveMode::Disk);
+              WorkspaceSaveMode mode = WorkspaceSaveMode::Disk,
+              SerializationFormat format = SerializationFormat::Xml);
 
     /**
      * Save the current workspace to a file
      * \param path the file to save into.
      * \param exceptionHandler A callback for handling errors.
+     * \param mode Disk or Undo, undo snapshots do not include the setup information.
+     * \param format Xml, or Binary for fast snapshots.
      */
     void save(const std::string& path,
               const ExceptionHandler& exceptionHandler = StandardExceptionHandler(),
-              WorkspaceSaveMode mode = WorkspaceSaveMode::Disk);
+              WorkspaceSaveMode mode = WorkspaceSaveMode::Disk,
+              SerializationFormat format = SerializationFormat::Xml);
 
     /**
-     * Load a workspace from a stream
+     * Load a workspace from a stream, in xml or binary format.
      * \param stream the stream to read from.
      * \param refPath a reference that that can be use by the deserializer to calculate relative
      *      paths. The same refPath should be given when loading. Most often this should be the
@@ -114,7 +120,7 @@ public:
               const ExceptionHandler& exceptionHandler = StandardExceptionHandler());
 
     /**
-     * Load a workspace from a file
+     * Load a workspace from a file, in xml or binary format.
      * \param path the file to read from.
      * \param exceptionHandler A callback for handling errors.
      */
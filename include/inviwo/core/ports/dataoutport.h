@@ -38,6 +38,8 @@
 #include <inviwo/core/ports/porttraits.h>
 #include <inviwo/core/util/stringconversion.h>
 
+#include <type_traits>
+
 namespace inviwo {
 
 /**
@@ -61,10 +63,26 @@ public:
 
     virtual void setData(std::shared_ptr<const T> data);
     virtual void setData(const T* data);  // will assume ownership of data.
+    /**
+     * Set data that the caller can still modify. Since the data might be modified in place, this
+     * is always a new data version, also when the same data is set again. The same holds every
+     * time the processor is processed until const data is set.
+     */
+    template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+    void setData(std::shared_ptr<U> data);
     bool hasData() const;
 
 protected:
+    /**
+     * The data version of const data changes when different data is set. Setting the same const
+     * data again is not a change, which lets the network skip processors further down. Data set
+     * through a non-const pointer is not tracked, the producer might render into it without
+     * setting it again.
+     */
+    virtual bool tracksDataVersion() const override;
+
     std::shared_ptr<const T> data_;
+    bool mutableData_ = false;  // data_ was set through a non-const pointer
 };
 
 template <typename T>
@@ -100,24 +118,43 @@ std::shared_ptr<const T> DataOutport<T>::getData() const {
 
 template <typename T>
 void DataOutport<T>::setData(std::shared_ptr<const T> data) {
+    if (data != data_) newDataVersion();
     data_ = data;
+    mutableData_ = false;
     isReady_.update();
 }
 
 template <typename T>
 void DataOutport<T>::setData(const T* data) {
+    if (data != data_.get()) newDataVersion();
     data_.reset(data);
+    mutableData_ = false;
     isReady_.update();
 }
 
+template <typename T>
+template <typename U, typename>
+void DataOutport<T>::setData(std::shared_ptr<U> data) {
+    newDataVersion();
+    setData(std::shared_ptr<const T>(std::move(data)));
+    mutableData_ = true;
+}
+
 template <typename T>
 std::shared_ptr<const T> DataOutport<T>::detachData() {
     std::shared_ptr<const T> data(data_);
+    if (data_) newDataVersion();
     data_.reset();
+    mutableData_ = false;
     isReady_.update();
     return data;
 }
 
+template <typename T>
+bool DataOutport<T>::tracksDataVersion() const {
+    return !mutableData_;
+}
+
 template <typename T>
 bool DataOutport<T>::hasData() const {
     return data_.get() != nullptr;
@@ -232,6 +232,10 @@ public:
 
     virtual void disconnectFrom(Inport* port) override;
 
+protected:
+    // Images are rendered into in place, every evaluation is a new version
+    virtual bool tracksDataVersion() const override;
+
 private:
     std::shared_ptr<Image> image_;
     size2_t defaultDimensions_;
@@ -149,7 +149,9 @@ protected:
     virtual void invalidate(InvalidationLevel invalidationLevel);
     /**
      * Called by Outport::setValid, which is call by Processor::setValid, which is called after
-     * Processor:process. From above in the network.
+     * Processor:process. From above in the network. The inport is only marked as changed if the
+     * data version of the outport differs from when the inport was last reset.
+     * @see Outport::getDataVersion
      */
     virtual void setValid(const Outport* source);
 
@@ -174,6 +176,8 @@ private:
 
     CallBackList onChangeCallback_;
     std::vector<const Outport*> changedSources_;
+    // Data versions of the connected outports when the inport was last reset
+    std::vector<std::pair<const Outport*, size_t>> dataVersions_;
 
     CallBackList onInvalidCallback_;
     InvalidationLevel lastInvalidationLevel_;  // Used for the onInvalid callback.
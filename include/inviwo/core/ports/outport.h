@@ -92,9 +92,26 @@ public:
      */
     virtual void setValid();
 
+    /**
+     * Version of the data in the port, used by the inports to find out if the data changed. Ports
+     * that do not track their data get a new version each time they are set valid.
+     * @see tracksDataVersion
+     */
+    size_t getDataVersion() const;
+
 protected:
     Outport(std::string identifier = "");
 
+    /**
+     * Ports that call newDataVersion() whenever their data changes should return true. Then
+     * processors downstream will not be processed if the data stays the same.
+     */
+    virtual bool tracksDataVersion() const;
+    void newDataVersion();
+
+    // Set valid, and give ports that do not track their data a new version if newData is true
+    void setValidInternal(bool newData);
+
     // These function are only called by the corresponding inport.
     virtual void connectTo(Inport* port);
     virtual void disconnectFrom(Inport* port);
@@ -102,6 +119,7 @@ protected:
     StateCoordinator<bool> isReady_;
     InvalidationLevel invalidationLevel_;
     std::vector<Inport*> connectedInports_;
+    size_t dataVersion_;
 
     CallBackList onConnectCallback_;
     CallBackList onDisconnectCallback_;
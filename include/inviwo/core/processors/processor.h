@@ -267,6 +267,13 @@ public:
      */
     bool isReady() const;
 
+    /**
+     * Returns true while the processor is being invalidated by one of its inports, i.e. from
+     * above in the network, and not by a property or a direct call to invalidate.
+     * @see ProcessorNetworkEvaluator
+     */
+    bool isInvalidatedByInport() const;
+
     /**
      * Deriving classes should override this function to do the main work of the processor.
      * This function is called by the ProcessorNetworkEvaluator when the network is evaluated and
@@ -295,6 +302,14 @@ public:
      */
     virtual void setValid() override;
 
+    /**
+     * Called by the network instead of process and setValid when the processor was only
+     * invalidated by its inports and none of them got new data. Works like setValid but keeps
+     * the data versions of the outports, so processors further down can be skipped as well.
+     * @see Outport::getDataVersion
+     */
+    void setValidUnchanged();
+
     /**
      * Triggers invalidation.
      * Perform only full reimplementation of this function, meaning never call
@@ -380,6 +395,8 @@ protected:
     void removePortFromGroups(Port* port);
 
 private:
+    friend class Inport;
+
     void addPortInternal(Inport* port, const std::string& portGroup);
     void addPortInternal(Outport* port, const std::string& portGroup);
 
@@ -395,6 +412,7 @@ private:
     std::unordered_map<Port*, std::string> portGroups_;
 
     ProcessorNetwork* network_;
+    int inportInvalidations_;
 };
 
 inline ProcessorNetwork* Processor::getNetwork() const { return network_; }
@@ -36,6 +36,8 @@
 #include <inviwo/core/properties/property.h>
 #include <inviwo/core/interaction/events/eventlistener.h>
 
+#include <unordered_map>
+
 namespace inviwo {
 
 class Processor;
@@ -97,8 +99,16 @@ public:
     const std::vector<Property*>& getProperties() const;
     const std::vector<CompositeProperty*>& getCompositeProperties() const;
     std::vector<Property*> getPropertiesRecursive() const;
+    /**
+     * Find a property by identifier using a hash index of the properties of this owner. With
+     * \p recursiveSearch the composite properties are searched as well, depth first.
+     */
     Property* getPropertyByIdentifier(const std::string& identifier,
                                       bool recursiveSearch = false) const;
+    /**
+     * Find a property by its path relative to this owner, i.e. a list of identifiers. Each
+     * path element is a single hash lookup.
+     */
     Property* getPropertyByPath(const std::vector<std::string>& path) const;
     template <class T>
     std::vector<T*> getPropertiesByType(bool recursiveSearch = false) const;
@@ -149,9 +159,23 @@ protected:
     std::vector<CompositeProperty*> compositeProperties_;  //< non-owning references.
 
 private:
+    friend class Property;
+
     Property* removeProperty(std::vector<Property*>::iterator it);
     bool findPropsForComposites(TxElement*);
+    // Called by Property::setIdentifier to keep the index in sync
+    void onPropertyIdentifierChange(Property* property, const std::string& oldIdentifier);
+    // Make the index entry of identifier refer to the first property with that identifier
+    void updatePropertyIndex(const std::string& identifier);
+
     InvalidationLevel invalidationLevel_;
+
+    struct IndexEntry {
+        Property* property;
+        CompositeProperty* composite;  //< property as a composite, or nullptr
+    };
+    // Properties of properties_ by identifier
+    std::unordered_map<std::string, IndexEntry> propertyIndex_;
 };
 
 template <class T>
@@ -109,6 +109,8 @@ public:
     bool getLogToFile() const;
     bool getLogToConsole() const;
     bool getDisableResourceManager() const;
+    bool getTraceToFile() const;
+    const std::string getTraceFileName() const;
 
     int getARGC() const;
     char** getARGV() const;
@@ -135,6 +137,7 @@ private:
     TCLAP::SwitchArg helpQuiet_;
     TCLAP::SwitchArg versionQuiet_;
     TCLAP::SwitchArg disableResourceManager_;
+    TCLAP::ValueArg<std::string> tracefile_;
 
     std::vector<std::tuple<int, TCLAP::Arg*, std::function<void()>>> callbacks_;
 };
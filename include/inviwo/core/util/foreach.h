@@ -36,6 +36,10 @@
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/settings/systemsettings.h>
 #include <string>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
 
 namespace inviwo {
 
@@ -143,6 +147,68 @@ void forEachParallel(const Iterable& iterable, Callback callback, size_t jobs =
     }
 }
 
+/**
+ * Split the index range [0, size) into jobs and call `callback(size_t begin, size_t end)` once for
+ * each job using the Inviwo thread pool. The calling thread takes part in the work, hence it is
+ * safe to call this function from within a pool task, even if all other workers are busy. If there
+ * is no InviwoApplication or the pool size is zero the callback is called once for the whole
+ * range in the calling thread.
+ * The function returns once all jobs are done. The first exception thrown by a callback is
+ * rethrown in the calling thread.
+ *
+ * @param size the number of elements in the range
+ * @param callback to call for each job, `[](size_t begin, size_t end){}`
+ * @param jobs optional parameter specifying how many jobs to create, if jobs==0 (default) it will
+ * create pool size * 4 jobs
+ */
+template <typename Callback>
+void forEachRangeParallel(size_t size, Callback callback, size_t jobs = 0) {
+    const size_t poolSize =
+        InviwoApplication::isInitialized() ? InviwoApplication::getPtr()->getPoolSize() : 0;
+    if (jobs == 0) jobs = 4 * poolSize;
+    jobs = std::min(jobs, size);
+
+    if (poolSize == 0 || jobs <= 1) {
+        if (size > 0) callback(size_t{0}, size);
+        return;
+    }
+
+    struct State {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::exception_ptr exception;
+    };
+    auto state = std::make_shared<State>();
+
+    // Tasks that start after all jobs are claimed return without touching the callback, so it is
+    // fine to capture it by reference even though we don't wait for those tasks.
+    auto work = [state, cb = &callback, size, jobs]() {
+        for (size_t job = state->next++; job < jobs; job = state->next++) {
+            try {
+                (*cb)(size * job / jobs, size * (job + 1) / jobs);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (!state->exception) state->exception = std::current_exception();
+            }
+            if (++state->done == jobs) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->condition.notify_all();
+            }
+        }
+    };
+
+    for (size_t i = 0; i < std::min(poolSize, jobs - 1); ++i) {
+        InviwoApplication::getPtr()->dispatchPool(work);
+    }
+    work();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->condition.wait(lock, [&]() { return state->done == jobs; });
+    if (state->exception) std::rethrow_exception(state->exception);
+}
+
 }  // namespace util
 
 }  // namespace inviwo
@@ -35,8 +35,13 @@
 #include <inviwo/core/util/exception.h>
 #include <inviwo/core/util/stringconversion.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace inviwo {
@@ -189,10 +194,30 @@ public:
     virtual void logAssertion(const char* file, const char* function, int line, std::string msg);
 };
 
+/**
+ * \brief Distributes log messages to all registered loggers.
+ *
+ * Logging is asynchronous, messages are pushed into a bounded lock-free queue and passed on to the
+ * registered loggers by a dedicated dispatch thread. The loggers are never called concurrently.
+ * If the queue is full, messages are dropped and counted, see getNumberOfDroppedMessages().
+ *
+ * Some messages are dispatched directly on the calling thread, after all queued messages:
+ *  - Errors, to make sure they are not lost if the application goes down.
+ *  - Processor messages, since the loggers get a pointer to the processor.
+ *  - Assertions.
+ *
+ * Call flush() to make sure all previous messages have reached the loggers, e.g. before reading
+ * the result of a logger. All messages are flushed when LogCentral is destroyed.
+ */
 class IVW_CORE_API LogCentral : public Singleton<LogCentral>, public Logger {
 public:
+    /**
+     * The number of messages that can be queued before messages are dropped.
+     */
+    static constexpr size_t queueCapacity = 4096;
+
     LogCentral();
-    virtual ~LogCentral() = default;
+    virtual ~LogCentral();
 
     void setVerbosity(LogVerbosity verbosity);
     LogVerbosity getVerbosity();
@@ -224,17 +249,53 @@ public:
     void setMessageBreakLevel(MessageBreakLevel level);
     MessageBreakLevel getMessageBreakLevel() const;
 
+    /**
+     * \brief Pass on all queued messages to the loggers, and block until they are done.
+     * Does nothing when called from within a logger.
+     */
+    void flush();
+
+    /**
+     * The number of messages that have been dropped since the queue was full.
+     */
+    size_t getNumberOfDroppedMessages() const;
+
 private:
     friend Singleton<LogCentral>;
     static LogCentral* instance_;
 
-    LogVerbosity logVerbosity_;
+    struct Message;
+    class MessageQueue;
+
+    void submit(Message&& message);
+    void dispatchQueued();
+    void dispatch(const Message& message);
+    template <typename Callback>
+    void forEachLogger(Callback callback);
+    void breakIfNeeded(LogLevel level) const;
+
 #include <warn/push>
 #include <warn/ignore/dll-interface>
-    std::vector<std::weak_ptr<Logger>> loggers_;
+    std::atomic<LogVerbosity> logVerbosity_;
+    std::atomic<bool> logStacktrace_;
+    std::atomic<MessageBreakLevel> breakLevel_;
+
+    std::unique_ptr<MessageQueue> queue_;
+    std::atomic<size_t> dropped_;
+    size_t reportedDropped_;  //< guarded by dispatchMutex_
+
+    std::recursive_mutex dispatchMutex_;
+    bool dispatching_;                             //< guarded by dispatchMutex_
+    std::vector<std::weak_ptr<Logger>> loggers_;  //< guarded by dispatchMutex_
+
+    std::mutex registerMutex_;
+    std::vector<std::weak_ptr<Logger>> newLoggers_;  //< guarded by registerMutex_
+
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;
+    bool stop_;  //< guarded by wakeMutex_
+    std::thread dispatchThread_;
 #include <warn/pop>
-    bool logStacktrace_ = false;
-    MessageBreakLevel breakLevel_ = MessageBreakLevel::Off;
 };
 
 namespace util {
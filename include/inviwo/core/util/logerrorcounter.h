@@ -35,6 +35,9 @@
 #include <inviwo/core/util/singleton.h>
 #include <inviwo/core/util/logcentral.h>
 
+#include <map>
+#include <mutex>
+
 namespace inviwo {
 
 class IVW_CORE_API LogErrorCounter : public Logger {
@@ -46,6 +49,9 @@ public:
                      const char* fileName, const char* functionName, int lineNumber,
                      std::string logMsg) override;
 
+    /**
+     * Flushes LogCentral, to include all messages logged before the call.
+     */
     size_t getCount(const LogLevel& level) const;
     size_t getInfoCount() const;
     size_t getWarnCount() const;
@@ -54,6 +60,7 @@ public:
     void reset();
 
 private:
+    mutable std::mutex mutex_;
     std::map<LogLevel, size_t> messageCount_;
 };
 
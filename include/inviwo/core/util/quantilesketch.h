@@ -0,0 +1,181 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_QUANTILESKETCH_H
+#define IVW_QUANTILESKETCH_H
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * \brief Mergeable streaming estimate of the quantiles of a sequence of values.
+ *
+ * Implements the merging t-digest of T. Dunning and O. Ertl, "Computing Extremely Accurate
+ * Quantiles Using t-Digests", 2019. Added values are collected in a small buffer which is
+ * periodically merged into a sorted list of weighted centroids. The number of centroids is bounded
+ * by the compression, and centroids are kept small close to the tails, hence extreme quantiles
+ * like the 1st and 99th percentile are estimated with a small rank error while using
+ * O(compression) memory regardless of the number of values.
+ *
+ * Sketches of separate chunks of the data can be built independently, for example in parallel,
+ * and then be combined using merge().
+ *
+ * NaN values are ignored. Queries flush the internal buffer, a sketch can therefore not be queried
+ * while it is modified from another thread.
+ */
+class IVW_CORE_API QuantileSketch {
+public:
+    /**
+     * @param compression controls the trade off between accuracy and size, the sketch will hold
+     * at most about compression / 2 centroids.
+     */
+    explicit QuantileSketch(double compression = 200.0);
+
+    void add(double value) {
+        if (std::isnan(value)) return;
+        buffer_.push_back(Centroid{value, 1.0});
+        totalWeight_ += 1.0;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+        if (buffer_.size() >= bufferSize_) flush();
+    }
+    void add(double value, double weight);
+
+    template <typename Iterator>
+    void add(Iterator begin, Iterator end) {
+        for (; begin != end; ++begin) add(static_cast<double>(*begin));
+    }
+
+    /**
+     * Add all values of \p other to this sketch.
+     */
+    void merge(const QuantileSketch& other);
+
+    /**
+     * Estimate the value below which the fraction \p q of the values are found.
+     * @return the estimated quantile or NaN if the sketch is empty
+     * @throw RangeException if \p q is not in the range [0 1]
+     */
+    double quantile(double q) const;
+    std::vector<double> quantiles(const std::vector<double>& qs) const;
+
+    /**
+     * The total weight of the added values, i.e. the number of values if no weights were used.
+     */
+    double count() const;
+    bool empty() const;
+    /**
+     * The exact minimum of the added values
+     */
+    double min() const;
+    /**
+     * The exact maximum of the added values
+     */
+    double max() const;
+
+    double getCompression() const;
+    size_t getNumberOfCentroids() const;
+
+    void clear();
+
+private:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+    void flush() const;
+
+    double compression_;
+    size_t bufferSize_;
+    double totalWeight_ = 0.0;
+    double min_;
+    double max_;
+    mutable std::vector<Centroid> centroids_;
+    mutable std::vector<Centroid> buffer_;
+};
+
+/**
+ * \brief Exact percentiles using the nearest rank method.
+ * The percentile p is the element at position ceil(p * N) - 1 of the sorted range, where N is the
+ * number of elements in the range. The range is partially reordered using std::nth_element instead
+ * of being sorted, each search being limited to the part of the range above the previous rank.
+ * Empty ranges result in default constructed values.
+ *
+ * @param begin first element of the range
+ * @param end one past the last element of the range
+ * @param percentiles in the range [0 1], in any order
+ * @return values below the percentage given by the percentiles, in the order of \p percentiles
+ * @throw RangeException if any percentile is less than 0 or larger than 1
+ */
+template <typename Iterator>
+auto nearestRankPercentiles(Iterator begin, Iterator end, const std::vector<double>& percentiles) {
+    using T = typename std::iterator_traits<Iterator>::value_type;
+    std::vector<T> result(percentiles.size(), T{});
+
+    const auto size = static_cast<size_t>(std::distance(begin, end));
+    std::vector<size_t> ranks(percentiles.size());
+    for (size_t i = 0; i < percentiles.size(); ++i) {
+        if (percentiles[i] < 0.0 || percentiles[i] > 1.0) {
+            throw RangeException("Percentile must be between 0 and 1",
+                                 IVW_CONTEXT_CUSTOM("util::nearestRankPercentiles"));
+        }
+        ranks[i] = static_cast<size_t>(
+            std::max(std::ceil(static_cast<double>(size) * percentiles[i]) - 1.0, 0.0));
+    }
+    if (size == 0) return result;
+
+    std::vector<size_t> order(percentiles.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return ranks[a] < ranks[b]; });
+
+    auto first = begin;
+    for (auto i : order) {
+        auto nth = std::next(begin, ranks[i]);
+        std::nth_element(first, nth, end);
+        result[i] = *nth;
+        first = nth;
+    }
+    return result;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
+
+#endif  // IVW_QUANTILESKETCH_H
@@ -0,0 +1,361 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_RESULTCACHE_H
+#define IVW_RESULTCACHE_H
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace inviwo {
+
+class Property;
+class PropertyOwner;
+class Volume;
+class Mesh;
+
+/**
+ * \brief Key of a ResultCache, built from the data and the state a result depends on.
+ *
+ * Data is identified by object identity together with its version, a key only matches while the
+ * data objects it was built from are still alive. The version consists of the modification count
+ * (Data::getModificationCount), the model and world matrices, and the data map, for the types
+ * that have them. Data modified in place will thus get a new key. Since processors that are not
+ * invalidated, or are cached themselves, keep returning the same data objects, a chain of cached
+ * processors will hit the cache together when going back to an earlier state. Values and property
+ * state are compared exactly.
+ */
+class IVW_CORE_API ResultCacheKey {
+public:
+    template <typename T>
+    ResultCacheKey& addData(const std::shared_ptr<const T>& data);
+    template <typename T>
+    ResultCacheKey& addData(const std::vector<std::shared_ptr<const T>>& data);
+
+    /**
+     * Add a value that the result depends on, T has to be trivially copyable.
+     */
+    template <typename T>
+    ResultCacheKey& addValue(const T& value);
+    ResultCacheKey& addValue(const std::string& value);
+
+    /**
+     * Add the serialized state of all properties of \p owner except the \p ignored ones. Ignore
+     * properties that do not affect the result, like buttons and properties showing output.
+     */
+    ResultCacheKey& addProperties(const PropertyOwner& owner,
+                                  const std::vector<const Property*>& ignored = {});
+
+    size_t hash() const;
+
+    /**
+     * A key is expired if any of its data has been destroyed, it will never match again.
+     */
+    bool isExpired() const;
+
+    bool operator==(const ResultCacheKey& rhs) const;
+    bool operator!=(const ResultCacheKey& rhs) const;
+
+private:
+    std::vector<std::weak_ptr<const void>> data_;
+    std::vector<const void*> dataPointers_;
+    std::string state_;
+};
+
+struct IVW_CORE_API ResultCacheStatistics {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+};
+
+namespace util {
+
+/**
+ * Size in bytes of the data of a volume or a mesh, used to enforce the budget of a ResultCache.
+ */
+IVW_CORE_API size_t memorySize(const Volume& volume);
+IVW_CORE_API size_t memorySize(const Mesh& mesh);
+
+namespace detail {
+
+template <typename T>
+auto memorySize(const T& data, int) -> decltype(util::memorySize(data)) {
+    return util::memorySize(data);
+}
+template <typename T>
+size_t memorySize(const T&, long) {
+    return sizeof(T);
+}
+
+}  // namespace detail
+
+}  // namespace util
+
+/**
+ * \brief Least recently used cache of processor results with a memory budget.
+ *
+ * An opt-in memoization for processors with expensive, deterministic results. Before computing,
+ * build a ResultCacheKey from the inport data and the properties, and look it up. On a hit the
+ * cached result can be set on the outport directly. On a miss compute the result and put it in
+ * the cache. For asynchronous processors, build the key when the computation is dispatched and
+ * put the result when it is done.
+ *
+ * \code{.cpp}
+ * auto key = ResultCacheKey{}.addData(inport_.getData()).addProperties(*this);
+ * if (auto result = cache_.get(key)) {
+ *     outport_.setData(result);
+ * } else {
+ *     auto result = compute(inport_.getData());
+ *     cache_.put(std::move(key), result);
+ *     outport_.setData(result);
+ * }
+ * \endcode
+ *
+ * When the memory budget is exceeded the least recently used results are evicted. Entries whose
+ * data has been destroyed are removed as well. The cache is not thread safe.
+ */
+template <typename T>
+class ResultCache {
+public:
+    using MemorySize = std::function<size_t(const T&)>;
+    static constexpr size_t defaultMemoryBudget = 256 * 1024 * 1024;
+
+    /**
+     * @param memoryBudget maximum number of bytes of cached results
+     * @param memorySize size in bytes of a result, by default util::memorySize if available for
+     *        T, and otherwise sizeof(T)
+     */
+    explicit ResultCache(size_t memoryBudget = defaultMemoryBudget,
+                         MemorySize memorySize = [](const T& data) {
+                             return util::detail::memorySize(data, 0);
+                         });
+
+    /**
+     * Look up a result, and mark it as the most recently used one.
+     * @return the cached result or nullptr on a miss
+     */
+    std::shared_ptr<const T> get(const ResultCacheKey& key);
+
+    /**
+     * Add a result, results larger than the memory budget are not cached.
+     */
+    void put(ResultCacheKey key, std::shared_ptr<const T> result);
+
+    void clear();
+
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const;
+
+    const ResultCacheStatistics& getStatistics() const;
+
+private:
+    struct Entry {
+        ResultCacheKey key;
+        std::shared_ptr<const T> result;
+        size_t bytes;
+    };
+    using Iterator = typename std::list<Entry>::iterator;
+
+    Iterator find(const ResultCacheKey& key, size_t hash);
+    void erase(Iterator it);
+    void evict();
+
+    size_t memoryBudget_;
+    MemorySize memorySize_;
+    std::list<Entry> entries_;  // most recently used first
+    std::unordered_multimap<size_t, Iterator> index_;
+    ResultCacheStatistics stats_;
+};
+
+namespace detail {
+
+template <typename T>
+auto addModificationCount(ResultCacheKey& key, const T& data, int)
+    -> decltype(data.getModificationCount(), void()) {
+    key.addValue(data.getModificationCount());
+}
+template <typename T>
+void addModificationCount(ResultCacheKey&, const T&, long) {}
+
+template <typename T>
+auto addSpatialState(ResultCacheKey& key, const T& data, int)
+    -> decltype(data.getModelMatrix(), data.getWorldMatrix(), void()) {
+    key.addValue(data.getModelMatrix()).addValue(data.getWorldMatrix());
+}
+template <typename T>
+void addSpatialState(ResultCacheKey&, const T&, long) {}
+
+template <typename T>
+auto addDataMap(ResultCacheKey& key, const T& data, int) -> decltype(data.dataMap_, void()) {
+    key.addValue(data.dataMap_.dataRange)
+        .addValue(data.dataMap_.valueRange)
+        .addValue(data.dataMap_.valueUnit);
+}
+template <typename T>
+void addDataMap(ResultCacheKey&, const T&, long) {}
+
+}  // namespace detail
+
+template <typename T>
+ResultCacheKey& ResultCacheKey::addData(const std::shared_ptr<const T>& data) {
+    data_.emplace_back(data);
+    dataPointers_.push_back(data.get());
+    if (data) {
+        detail::addModificationCount(*this, *data, 0);
+        detail::addSpatialState(*this, *data, 0);
+        detail::addDataMap(*this, *data, 0);
+    }
+    return *this;
+}
+
+template <typename T>
+ResultCacheKey& ResultCacheKey::addData(const std::vector<std::shared_ptr<const T>>& data) {
+    addValue(data.size());
+    for (const auto& item : data) addData(item);
+    return *this;
+}
+
+template <typename T>
+ResultCacheKey& ResultCacheKey::addValue(const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only trivially copyable values can be added to a key");
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    state_.append(bytes, sizeof(T));
+    return *this;
+}
+
+template <typename T>
+ResultCache<T>::ResultCache(size_t memoryBudget, MemorySize memorySize)
+    : memoryBudget_{memoryBudget}, memorySize_{std::move(memorySize)} {}
+
+template <typename T>
+std::shared_ptr<const T> ResultCache<T>::get(const ResultCacheKey& key) {
+    auto it = find(key, key.hash());
+    if (it == entries_.end()) {
+        ++stats_.misses;
+        return nullptr;
+    }
+    ++stats_.hits;
+    entries_.splice(entries_.begin(), entries_, it);
+    return it->result;
+}
+
+template <typename T>
+void ResultCache<T>::put(ResultCacheKey key, std::shared_ptr<const T> result) {
+    if (!result || key.isExpired()) return;
+    const auto hash = key.hash();
+    const auto bytes = memorySize_(*result);
+    if (bytes > memoryBudget_) return;
+
+    auto it = find(key, hash);
+    if (it != entries_.end()) erase(it);
+
+    entries_.push_front(Entry{std::move(key), std::move(result), bytes});
+    index_.emplace(hash, entries_.begin());
+    ++stats_.entries;
+    stats_.bytes += bytes;
+    evict();
+}
+
+template <typename T>
+void ResultCache<T>::clear() {
+    entries_.clear();
+    index_.clear();
+    stats_.entries = 0;
+    stats_.bytes = 0;
+}
+
+template <typename T>
+void ResultCache<T>::setMemoryBudget(size_t bytes) {
+    memoryBudget_ = bytes;
+    evict();
+}
+
+template <typename T>
+size_t ResultCache<T>::getMemoryBudget() const {
+    return memoryBudget_;
+}
+
+template <typename T>
+const ResultCacheStatistics& ResultCache<T>::getStatistics() const {
+    return stats_;
+}
+
+template <typename T>
+auto ResultCache<T>::find(const ResultCacheKey& key, size_t hash) -> Iterator {
+    auto range = index_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second->key == key) return it->second;
+    }
+    return entries_.end();
+}
+
+template <typename T>
+void ResultCache<T>::erase(Iterator it) {
+    auto range = index_.equal_range(it->key.hash());
+    for (auto i = range.first; i != range.second; ++i) {
+        if (i->second == it) {
+            index_.erase(i);
+            break;
+        }
+    }
+    --stats_.entries;
+    stats_.bytes -= it->bytes;
+    entries_.erase(it);
+}
+
+template <typename T>
+void ResultCache<T>::evict() {
+    // Entries with destroyed data can never be hit again
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        auto next = std::next(it);
+        if (it->key.isExpired()) erase(it);
+        it = next;
+    }
+    while (stats_.bytes > memoryBudget_ && !entries_.empty()) {
+        erase(std::prev(entries_.end()));
+        ++stats_.evictions;
+    }
+}
+
+}  // namespace inviwo
+
+#endif  // IVW_RESULTCACHE_H
@@ -33,6 +33,7 @@
 
 #include <inviwo/core/util/logcentral.h>
 
+#include <mutex>
 #include <sstream>
 #include <string>
 
@@ -40,6 +41,7 @@ namespace inviwo {
 
 /**
  * \brief A logger class that logs to a string.
+ * getLog() flushes LogCentral, to include all messages logged before the call.
  */
 class IVW_CORE_API StringLogger : public Logger {
 public:
@@ -52,6 +54,7 @@ public:
     std::string getLog() const;
 
 private:
+    mutable std::mutex mutex_;
     std::stringstream logstream_;
 };
 
@@ -0,0 +1,168 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#ifndef IVW_TRACING_H
+#define IVW_TRACING_H
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace inviwo {
+
+/**
+ * \brief A completed trace scope, as stored in the per thread event buffers of the Tracer.
+ * Names longer than maxNameLength are truncated.
+ */
+struct IVW_CORE_API TraceEvent {
+    static constexpr size_t maxNameLength = 55;
+
+    const char* category;   ///< Category of the event, has to be a string literal
+    std::int64_t start;     ///< Start time in nanoseconds since the trace epoch
+    std::int64_t duration;  ///< Duration in nanoseconds
+    char name[maxNameLength + 1];
+};
+
+/**
+ * \brief Low overhead, always available tracing of timed scopes.
+ *
+ * Every thread records events into its own fixed size ring buffer, without any locking or
+ * allocation. A mutex is only taken the first time a thread records an event, to register its
+ * buffer. When the buffer is full the oldest events are overwritten. When tracing is disabled,
+ * which is the default, a TraceScope costs a single relaxed atomic load.
+ *
+ * The recorded events can be written in the Chrome trace event format, and loaded in a trace
+ * viewer like chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Tracing is enabled from the command line with `--trace <file>`, the trace is then written to
+ * the file when the application is closed.
+ * @see TraceScope
+ * @see IVW_TRACE_SCOPE
+ */
+class IVW_CORE_API Tracer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Tracer() = delete;
+
+    static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+    static void setEnabled(bool enabled);
+
+    /**
+     * Record a completed scope for the calling thread. \p category has to be a string literal,
+     * \p name is copied.
+     */
+    static void record(const char* category, const char* name, Clock::time_point start,
+                       Clock::time_point end);
+
+    /**
+     * Set the name of the calling thread, used as thread name in the exported trace.
+     */
+    static void setThreadName(const std::string& name);
+
+    /**
+     * Set the number of events kept per thread, will be rounded up to a power of two. Only
+     * affects threads that have not yet recorded any event. The default is 16384.
+     */
+    static void setBufferCapacity(size_t events);
+    static size_t getBufferCapacity();
+
+    /**
+     * Discard all events recorded so far.
+     */
+    static void clear();
+
+    /**
+     * The number of events that have been overwritten since the last clear, since a thread's
+     * buffer was full.
+     */
+    static size_t getNumberOfDroppedEvents();
+
+    /**
+     * Write all recorded events in the Chrome trace event JSON format. Threads might keep
+     * recording while writing.
+     */
+    static void writeChromeTrace(std::ostream& os);
+    /**
+     * @see writeChromeTrace(std::ostream&)
+     * @throws FileException if the file could not be opened
+     */
+    static void writeChromeTrace(const std::string& filename);
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+/**
+ * \brief RAII helper that records the time between its construction and destruction in the
+ * Tracer, if tracing is enabled at construction.
+ *
+ * The category has to be a string literal, the name has to outlive the scope. The name is only
+ * copied when the scope ends, a null name disables the scope. Use IVW_TRACE_SCOPE to create one.
+ */
+class TraceScope {
+public:
+    TraceScope(const char* category, const char* name)
+        : category_{category}
+        , name_{Tracer::isEnabled() ? name : nullptr}
+        , start_{name_ ? Tracer::Clock::now() : Tracer::Clock::time_point{}} {}
+    TraceScope(const char* category, const std::string& name)
+        : TraceScope(category, name.c_str()) {}
+    TraceScope(const char* category, std::string&& name) = delete;
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+    ~TraceScope() {
+        if (name_) Tracer::record(category_, name_, start_, Tracer::Clock::now());
+    }
+
+private:
+    const char* category_;
+    const char* name_;
+    Tracer::Clock::time_point start_;
+};
+
+#define IVW_TRACE_CONCAT_PART1(x, y) x##y
+#define IVW_TRACE_CONCAT_PART2(x, y) IVW_TRACE_CONCAT_PART1(x, y)
+
+/**
+ * \def IVW_TRACE_SCOPE(category, name)
+ * Traces the rest of the current scope with the given category and name.
+ * @see TraceScope
+ */
+#define IVW_TRACE_SCOPE(category, name) \
+    ::inviwo::TraceScope IVW_TRACE_CONCAT_PART2(ivwTraceScope, __LINE__)(category, name)
+
+}  // namespace inviwo
+
+#endif  // IVW_TRACING_H
@@ -33,6 +33,7 @@
 #include <modules/animation/animationmoduledefine.h>
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/util/timer.h>
+#include <inviwo/core/util/clock.h>
 #include <inviwo/core/common/inviwoapplication.h>
 
 #include <modules/animation/datastructures/animation.h>
@@ -48,6 +49,9 @@
 #include <inviwo/core/properties/stringproperty.h>
 #include <inviwo/core/properties/minmaxproperty.h>
 
+#include <deque>
+#include <future>
+
 namespace inviwo {
 
 namespace animation {
@@ -58,7 +62,10 @@ namespace animation {
  *   When playing, it should adjust the step sizes to maintain a certain playback speed (frames per
  *  second).
  *
- *   Furthermore, it allows to render the animation into an image sequence.
+ *   Furthermore, it allows to render the animation into an image sequence. When rendering, the
+ *  canvas contents of each frame are downloaded on the main thread and then handed to the thread
+ *  pool for encoding and writing. At most renderMaxQueuedFrames frames are in flight at the same
+ *  time, if the queue is full the rendering waits for the oldest frame to be written.
  */
 class IVW_MODULE_ANIMATION_API AnimationController : public AnimationControllerObservable,
                                                      public PropertyOwner {
@@ -83,6 +90,9 @@ public:
     /// Advances the animation to the next time step in rendering state.
     void tickRender();
 
+    /// Blocks until all frames queued for encoding during rendering are written to disk.
+    void flushRenderQueue();
+
     /// Asks the animation to update the network to reflect the new time.
     void eval(Seconds oldTime, Seconds newTime);
 
@@ -106,6 +116,23 @@ public:
     const AnimationPlaySettings& getRenderingSettings() const { return settingsRendering_; }
     Seconds getCurrentTime() const;
 
+    /// Timings of a frame written in rendering state
+    struct FrameTiming {
+        int frame{0};
+        /// Time from the evaluation of the animation until the frame was captured
+        Clock::duration render{0};
+        /// Time spent on the main thread to download the canvas layers
+        Clock::duration capture{0};
+        /// Time spent encoding the images in the thread pool
+        Clock::duration encode{0};
+        /// Time spent writing the encoded images to disk
+        Clock::duration write{0};
+        std::vector<std::string> errors;
+    };
+
+    /// Returns the timings of all frames written by the last (or current) rendering.
+    const std::vector<FrameTiming>& getRenderTimings() const { return renderState_.timings; }
+
     InviwoApplication* getInviwoApplication() { return app_; }
 
     CompositeProperty playOptions;
@@ -124,6 +151,7 @@ public:
     StringProperty renderBaseName;
     OptionPropertyString renderImageExtension;
     IntProperty renderNumFrames;
+    IntProperty renderMaxQueuedFrames;
     ButtonProperty renderAction;
     ButtonProperty renderActionStop;
 
@@ -137,6 +165,12 @@ protected:
     /// Called to cleanup after rendering
     void afterRender();
 
+    /// Downloads the visible layers of all active canvases and queues them for writing.
+    void captureFrame();
+
+    /// Waits for the oldest queued frame and stores its timings.
+    void collectFrame();
+
     /// The animation to control, non-owning reference.
     Animation* animation_;
 
@@ -179,6 +213,13 @@ protected:
         std::string baseFileName;
         std::vector<RenderCanvasSize> origCanvasSettings;
         std::string canvasIndicator;
+        /// Measures the time from the evaluation of a frame until it is captured
+        Clock frameClock;
+        /// Measures the total time of the rendering
+        Clock totalClock;
+        /// Frames that are currently being encoded and written in the thread pool
+        std::deque<std::future<FrameTiming>> pendingFrames;
+        std::vector<FrameTiming> timings;
     };
 
     /// State needed during rendering
@@ -61,6 +61,11 @@ public:
     Animation(const Animation&) = delete;
     Animation& operator=(const Animation& that) = delete;
 
+    /**
+     * Evaluate all tracks at time \p to in a single pass in priority order. Only enabled and
+     * non-empty tracks are visited, the list of those is kept up to date when tracks change
+     * instead of being filtered on every evaluation.
+     */
     AnimationTimeState operator()(Seconds from, Seconds to, AnimationState state) const;
 
     bool empty() const;
@@ -139,8 +144,15 @@ private:
     virtual void onFirstMoved(Track* t) override;
     virtual void onLastMoved(Track* t) override;
 
+    virtual void onEnabledChanged(Track* t) override;
+    virtual void onKeyframeSequenceAdded(Track* t, KeyframeSequence* s) override;
+    virtual void onKeyframeSequenceRemoved(Track* t, KeyframeSequence* s) override;
+    void updateActiveTracks();
+
     std::vector<std::unique_ptr<Track>> tracks_;
     std::vector<Track*> priorityTracks_;
+    /// Enabled and non-empty tracks in priority order, i.e. the ones we need to evaluate
+    std::vector<Track*> activeTracks_;
 };
 
 }  // namespace animation
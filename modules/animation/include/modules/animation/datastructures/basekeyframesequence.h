@@ -37,6 +37,7 @@
 #include <modules/animation/datastructures/keyframesequence.h>
 #include <inviwo/core/util/indirectiterator.h>
 
+#include <algorithm>
 #include <type_traits>
 
 namespace inviwo {
@@ -83,6 +84,15 @@ public:
     iterator end();
     const_iterator end() const;
 
+    /**
+     * Return the index of the first keyframe with a time larger than \p time, i.e. the same as
+     * std::upper_bound over the keyframes. The lookup uses a sorted index of the keyframe times
+     * and remembers the previous result, making it O(1) when time increases monotonically, as
+     * during playback, and O(log n) otherwise.
+     * @note The lookup cache is not thread safe.
+     */
+    size_t upperBound(Seconds time) const;
+
     /**
      * Add Keyframe and call KeyframeObserver::notifyKeyframeAdded
      */
@@ -103,9 +113,15 @@ public:
 
 protected:
     virtual void onKeyframeTimeChanged(Keyframe* key, Seconds oldTime) override;
+    void invalidateTimeIndex();
 
     std::vector<std::unique_ptr<Key>> keyframes_;
     bool isSelected_{false};
+
+    // Lazily built sorted copy of the keyframe times and the last result of upperBound
+    mutable std::vector<Seconds> times_;
+    mutable bool timesValid_{false};
+    mutable size_t lastIndex_{0};
 };
 
 template <typename Key>
@@ -145,6 +161,7 @@ BaseKeyframeSequence<Key>& BaseKeyframeSequence<Key>::operator=(
             keyframes_.pop_back();
             notifyKeyframeRemoved(key.get(), this);
         }
+        invalidateTimeIndex();
     }
     return *this;
 }
@@ -161,6 +178,7 @@ template <typename Key>
 void BaseKeyframeSequence<Key>::onKeyframeTimeChanged(Keyframe* key, Seconds /*oldTime*/) {
     std::stable_sort(keyframes_.begin(), keyframes_.end(),
                      [](const auto& a, const auto& b) { return *a < *b; });
+    invalidateTimeIndex();
 
     if (keyframes_.front().get() == key || keyframes_.back().get() == key) {
         notifyKeyframeSequenceMoved(this);
@@ -182,6 +200,7 @@ void BaseKeyframeSequence<Key>::add(std::unique_ptr<Key> key) {
         keyframes_.insert(std::upper_bound(keyframes_.begin(), keyframes_.end(), key,
                                            [](const auto& a, const auto& b) { return *a < *b; }),
                           std::move(key));
+    invalidateTimeIndex();
 
     (*it)->addObserver(this);
     notifyKeyframeAdded(it->get(), this);
@@ -192,6 +211,7 @@ std::unique_ptr<Keyframe> BaseKeyframeSequence<Key>::remove(size_t i) {
     if (i < keyframes_.size()) {
         auto key = std::move(keyframes_[i]);
         keyframes_.erase(keyframes_.begin() + i);
+        invalidateTimeIndex();
         notifyKeyframeRemoved(key.get(), this);
         return std::move(key);
     } else {
@@ -206,6 +226,7 @@ std::unique_ptr<Keyframe> BaseKeyframeSequence<Key>::remove(Keyframe* key) {
     if (it != keyframes_.end()) {
         auto res = std::move(*it);
         keyframes_.erase(it);
+        invalidateTimeIndex();
         notifyKeyframeRemoved(res.get(), this);
         return std::move(res);
     } else {
@@ -263,6 +284,33 @@ auto BaseKeyframeSequence<Key>::end() const -> const_iterator {
     return util::makeIndirectIterator<true>(keyframes_.end());
 }
 
+template <typename Key>
+size_t BaseKeyframeSequence<Key>::upperBound(Seconds time) const {
+    if (!timesValid_) {
+        times_.clear();
+        times_.reserve(keyframes_.size());
+        for (const auto& key : keyframes_) times_.push_back(key->getTime());
+        timesValid_ = true;
+    }
+
+    const size_t n = times_.size();
+    const auto isUpperBound = [&](size_t i) {
+        return i <= n && (i == 0 || times_[i - 1] <= time) && (i == n || time < times_[i]);
+    };
+    // During playback we usually stay in the same segment or move on to the next one.
+    if (isUpperBound(lastIndex_)) return lastIndex_;
+    if (isUpperBound(lastIndex_ + 1)) return ++lastIndex_;
+
+    lastIndex_ = static_cast<size_t>(
+        std::distance(times_.begin(), std::upper_bound(times_.begin(), times_.end(), time)));
+    return lastIndex_;
+}
+
+template <typename Key>
+void BaseKeyframeSequence<Key>::invalidateTimeIndex() {
+    timesValid_ = false;
+}
+
 template <typename Key>
 bool BaseKeyframeSequence<Key>::isSelected() const {
     return isSelected_;
@@ -297,6 +345,7 @@ void BaseKeyframeSequence<Key>::deserialize(Deserializer& d) {
             key->addObserver(this);
         })
         .onRemove([&](Elem& key) { notifyKeyframeRemoved(key.get(), this); })(d, keyframes_);
+    invalidateTimeIndex();
 }
 
 }  // namespace animation
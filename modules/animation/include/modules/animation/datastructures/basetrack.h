@@ -90,6 +90,14 @@ public:
     iterator end();
     const_iterator end() const;
 
+    /**
+     * Return the index of the first sequence starting after \p time, i.e. the same as
+     * std::upper_bound over the sequences. The previous result is remembered, which makes the
+     * lookup O(1) when time increases monotonically and O(log n) otherwise.
+     * @note The lookup cache is not thread safe.
+     */
+    size_t upperBound(Seconds time) const;
+
     virtual void add(Seconds time, bool asNewSequence) override;
     virtual void add(std::unique_ptr<KeyframeSequence> sequence) override;
     virtual void add(std::unique_ptr<Seq> sequence);
@@ -112,6 +120,9 @@ protected:
 
     // Sorted list of non-overlapping sequences of key frames
     std::vector<std::unique_ptr<Seq>> sequences_;
+
+    // Last result of upperBound, always validated against sequences_ before use
+    mutable size_t lastSequence_{0};
 };
 
 template <typename Seq>
@@ -257,6 +268,23 @@ auto BaseTrack<Seq>::end() const -> const_iterator {
     return util::makeIndirectIterator<true>(sequences_.end());
 }
 
+template <typename Seq>
+size_t BaseTrack<Seq>::upperBound(Seconds time) const {
+    const size_t n = sequences_.size();
+    const auto isUpperBound = [&](size_t i) {
+        return i <= n && (i == 0 || sequences_[i - 1]->getFirstTime() <= time) &&
+               (i == n || time < sequences_[i]->getFirstTime());
+    };
+    if (isUpperBound(lastSequence_)) return lastSequence_;
+    if (isUpperBound(lastSequence_ + 1)) return ++lastSequence_;
+
+    lastSequence_ = static_cast<size_t>(std::distance(
+        sequences_.begin(),
+        std::upper_bound(sequences_.begin(), sequences_.end(), time,
+                         [](const auto& t, const auto& seq) { return t < *seq; })));
+    return lastSequence_;
+}
+
 /**
  * Track of sequences
  * ----------X======X====X-----------------X=========X-------X=====X--------
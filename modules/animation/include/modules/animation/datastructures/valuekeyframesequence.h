@@ -172,7 +172,7 @@ template <typename Key>
 auto KeyframeSequenceTyped<Key>::operator()(Seconds from, Seconds to) const ->
     typename Key::value_type {
     if (interpolation_) {
-        return (*interpolation_)(this->keyframes_, from, to, easing_);
+        return (*interpolation_)(this->keyframes_, this->upperBound(to), from, to, easing_);
     } else {
         return this->keyframes_.front()->getValue();
     }
@@ -67,6 +67,10 @@ public:
     // keys should be sorted by time
     virtual auto operator()(const std::vector<std::unique_ptr<Key>>& keys, Seconds from, Seconds to,
                             easing::EasingType) const -> typename Key::value_type override;
+
+    virtual auto operator()(const std::vector<std::unique_ptr<Key>>& keys, size_t upper,
+                            Seconds from, Seconds to, easing::EasingType) const ->
+        typename Key::value_type override;
 };
 
 template <typename Key>
@@ -107,30 +111,26 @@ bool ConstantInterpolation<Key>::equal(const Interpolation& other) const {
 }
 template <typename Key>
 auto ConstantInterpolation<Key>::operator()(const std::vector<std::unique_ptr<Key>>& keys,
-                                            Seconds from, Seconds to, easing::EasingType) const ->
+                                            Seconds from, Seconds to,
+                                            easing::EasingType easing) const ->
     typename Key::value_type {
 
-    if (to > from) {
-        auto it = std::upper_bound(
-            keys.begin(), keys.end(), to,
-            [](const auto& time, const auto& key) { return time < key->getTime(); });
+    auto it = std::upper_bound(keys.begin(), keys.end(), to, [](const auto& time, const auto& key) {
+        return time < key->getTime();
+    });
+    return (*this)(keys, static_cast<size_t>(std::distance(keys.begin(), it)), from, to, easing);
+}
 
-        if (it == keys.begin()) {
-            return (*it)->getValue();
-        } else {
-            return (*std::prev(it))->getValue();
-        }
+template <typename Key>
+auto ConstantInterpolation<Key>::operator()(const std::vector<std::unique_ptr<Key>>& keys,
+                                            size_t upper, Seconds from, Seconds to,
+                                            easing::EasingType) const ->
+    typename Key::value_type {
 
+    if (to > from) {
+        return upper == 0 ? keys.front()->getValue() : keys[upper - 1]->getValue();
     } else {
-        auto it = std::upper_bound(
-            keys.begin(), keys.end(), to,
-            [](const auto& time, const auto& key) { return time < key->getTime(); });
-
-        if (it == keys.end()) {
-            return (*std::prev(it))->getValue();
-        } else {
-            return (*it)->getValue();
-        }
+        return upper == keys.size() ? keys.back()->getValue() : keys[upper]->getValue();
     }
 }
 
@@ -87,6 +87,19 @@ public:
     // Override this function to interpolate between key frames
     virtual auto operator()(const std::vector<std::unique_ptr<Key>>& keys, Seconds from, Seconds to,
                             easing::EasingType easing) const -> typename Key::value_type = 0;
+
+    /**
+     * Interpolate between key frames when the position of \p to among the keys is already known.
+     * @param keys sorted by time
+     * @param upper index of the first key with a time larger than \p to, i.e. the result of
+     *        std::upper_bound. Used by KeyframeSequenceTyped to avoid searching the keys.
+     * The default implementation ignores \p upper, override it to avoid the search.
+     */
+    virtual auto operator()(const std::vector<std::unique_ptr<Key>>& keys, size_t upper,
+                            Seconds from, Seconds to, easing::EasingType easing) const ->
+        typename Key::value_type {
+        return (*this)(keys, from, to, easing);
+    }
 };
 
 }  // namespace animation
@@ -68,6 +68,10 @@ public:
      */
     virtual auto operator()(const std::vector<std::unique_ptr<Key>>& keys, Seconds from, Seconds to,
                             easing::EasingType easing) const -> typename Key::value_type override;
+
+    virtual auto operator()(const std::vector<std::unique_ptr<Key>>& keys, size_t upper,
+                            Seconds from, Seconds to, easing::EasingType easing) const ->
+        typename Key::value_type override;
 };
 
 template <typename Key>
@@ -98,22 +102,30 @@ std::string LinearInterpolation<Key>::classIdentifier() {
 
 template <typename Key>
 auto LinearInterpolation<Key>::operator()(const std::vector<std::unique_ptr<Key>>& keys,
-                                          Seconds /*from*/, Seconds to,
+                                          Seconds from, Seconds to,
                                           easing::EasingType easing) const ->
     typename Key::value_type {
 
-    using VT = typename Key::value_type;
-    using DT = typename util::same_extent<VT, double>::type;
-
     auto it = std::upper_bound(keys.begin(), keys.end(), to, [](const auto& time, const auto& key) {
         return time < key->getTime();
     });
+    return (*this)(keys, static_cast<size_t>(std::distance(keys.begin(), it)), from, to, easing);
+}
+
+template <typename Key>
+auto LinearInterpolation<Key>::operator()(const std::vector<std::unique_ptr<Key>>& keys,
+                                          size_t upper, Seconds /*from*/, Seconds to,
+                                          easing::EasingType easing) const ->
+    typename Key::value_type {
+
+    using VT = typename Key::value_type;
+    using DT = typename util::same_extent<VT, double>::type;
 
-    const auto& v1 = (*std::prev(it))->getValue();
-    const auto& t1 = (*std::prev(it))->getTime();
+    const auto& v1 = keys[upper - 1]->getValue();
+    const auto& t1 = keys[upper - 1]->getTime();
 
-    const auto& v2 = (*it)->getValue();
-    const auto& t2 = (*it)->getTime();
+    const auto& v2 = keys[upper]->getValue();
+    const auto& t2 = keys[upper]->getTime();
 
     // We have to take special care here since we might have unsigned types.
     // Lets just convert everything to doubles.
@@ -31,11 +31,14 @@
 #include <modules/animation/animationcontrollerobserver.h>
 #include <modules/animation/datastructures/controltrack.h>
 #include <inviwo/core/io/datawriterfactory.h>
+#include <inviwo/core/io/datawriterexception.h>
+#include <inviwo/core/datastructures/image/layerram.h>
 #include <inviwo/core/network/networklock.h>
 #include <inviwo/core/processors/canvasprocessor.h>
 #include <inviwo/core/util/utilities.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/stringconversion.h>
+#include <inviwo/core/util/filesystem.h>
 
 namespace inviwo {
 
@@ -93,6 +96,8 @@ AnimationController::AnimationController(Animation& animation, InviwoApplication
           }())
     , renderNumFrames("RenderNumFrames", "# Frames", 100, 2, 1000000, 1,
                       InvalidationLevel::InvalidOutput, PropertySemantics::Text)
+    , renderMaxQueuedFrames("RenderMaxQueuedFrames", "Max Queued Frames", 8, 1, 256, 1,
+                            InvalidationLevel::InvalidOutput, PropertySemantics::Text)
     , renderAction("RenderAction", "Render")
     , renderActionStop("RenderActionStop", "Stop")
     , controlOptions("ControlOptions", "Control Track")
@@ -143,6 +148,7 @@ AnimationController::AnimationController(Animation& animation, InviwoApplication
     renderOptions.addProperty(renderAspectRatio);
     renderOptions.addProperty(renderSize);
     renderOptions.addProperty(renderNumFrames);
+    renderOptions.addProperty(renderMaxQueuedFrames);
     renderOptions.addProperty(renderLocation);
     renderOptions.addProperty(renderBaseName);
     renderOptions.addProperty(renderImageExtension);
@@ -235,6 +241,9 @@ void AnimationController::render() {
     // - use at least 4 digits, so we nicely overwrite the files from a previous test rendering with
     // less frames
     renderState_.digits = std::max(renderState_.digits, 4);
+    renderState_.timings.clear();
+    renderState_.totalClock.reset();
+    renderState_.totalClock.start();
 
     // Get all active canvases
     auto network = app_->getProcessorNetwork();
@@ -311,6 +320,9 @@ void AnimationController::render() {
 }
 
 void AnimationController::afterRender() {
+    // Make sure all frames are on disk before we restore the canvases
+    flushRenderQueue();
+
     // Switch Buttons
     renderActionStop.setVisible(false);
     renderAction.setVisible(true);
@@ -418,16 +430,7 @@ void AnimationController::tickRender() {
     // Apparently, we need to be outside of tickRender() to let the system refresh its state
     // The first call to tickRender() is done with renderState_.currentFrame == -1 to bring the
     // system to a proper state
-    // - generate filename pattern
-    if (renderState_.currentFrame >= 0) {
-        std::stringstream fileNamePattern;
-        fileNamePattern << renderBaseName.get() << renderState_.canvasIndicator << std::setfill('0')
-                        << std::setw(renderState_.digits) << renderState_.currentFrame;
-        auto ext = FileExtension::createFileExtensionFromString(renderImageExtension.get());
-        // - save active canvases
-        util::saveAllCanvases(app_->getProcessorNetwork(), renderLocation.get(),
-                              fileNamePattern.str(), ext.extension_, true);
-    }
+    if (renderState_.currentFrame >= 0) captureFrame();
 
     // Next!
     renderState_.currentFrame++;
@@ -447,9 +450,125 @@ void AnimationController::tickRender() {
     }
 
     // Evaluate animation
+    renderState_.frameClock.reset();
+    renderState_.frameClock.start();
     eval(currentTime_, newTime);
 }
 
+void AnimationController::captureFrame() {
+    renderState_.frameClock.stop();
+    Clock captureClock;
+
+    FrameTiming timing;
+    timing.frame = renderState_.currentFrame;
+    timing.render = renderState_.frameClock.getElapsedTime();
+
+    // - generate filename pattern
+    std::stringstream fileNamePattern;
+    fileNamePattern << renderBaseName.get() << renderState_.canvasIndicator << std::setfill('0')
+                    << std::setw(renderState_.digits) << renderState_.currentFrame;
+    const auto name = fileNamePattern.str();
+    const auto ext = FileExtension::createFileExtensionFromString(renderImageExtension.get());
+
+    // - grab the visible layer of the active canvases. The download from the GPU has to be done
+    // here on the main thread, the copy is then owned by the encoding task.
+    struct Job {
+        std::string path;
+        std::shared_ptr<const Layer> layer;
+        std::shared_ptr<DataWriterType<Layer>> writer;
+    };
+    std::vector<Job> jobs;
+
+    auto network = app_->getProcessorNetwork();
+    for (auto canvas : network->getProcessorsByType<CanvasProcessor>()) {
+        if (!canvas->isSink()) continue;
+        const auto layer = canvas->getVisibleLayer();
+        if (!canvas->isValid() || !canvas->isReady() || !layer) {
+            timing.errors.push_back("Canvas \"" + canvas->getIdentifier() +
+                                    "\" is not ready or not valid, no image saved");
+            continue;
+        }
+        auto writer = std::shared_ptr<DataWriterType<Layer>>(
+            app_->getDataWriterFactory()->getWriterForTypeAndExtension<Layer>(ext));
+        if (!writer) {
+            timing.errors.push_back("Could not find a writer for the file extension \"" +
+                                    ext.extension_ + "\"");
+            break;
+        }
+        writer->setOverwrite(true);
+
+        auto fileName = name;
+        replaceInString(fileName, "UPN", canvas->getIdentifier());
+        auto path = renderLocation.get() + "/" + fileName + "." + ext.extension_;
+
+        auto ram = std::shared_ptr<LayerRepresentation>(
+            layer->getRepresentation<LayerRAM>()->clone());
+        jobs.push_back({std::move(path), std::make_shared<Layer>(ram), std::move(writer)});
+    }
+    captureClock.stop();
+    timing.capture = captureClock.getElapsedTime();
+
+    // Back-pressure: don't let the encoding fall too far behind the rendering
+    while (static_cast<int>(renderState_.pendingFrames.size()) >= renderMaxQueuedFrames.get()) {
+        collectFrame();
+    }
+
+    renderState_.pendingFrames.push_back(
+        app_->dispatchPool([jobs = std::move(jobs), ext, timing]() mutable -> FrameTiming {
+            for (auto& job : jobs) {
+                try {
+                    Clock encodeClock;
+                    auto buffer = job.writer->writeDataToBuffer(job.layer.get(), ext.extension_);
+                    encodeClock.stop();
+                    timing.encode += encodeClock.getElapsedTime();
+
+                    Clock writeClock;
+                    if (buffer) {
+                        auto out = filesystem::ofstream(job.path, std::ios::out | std::ios::binary);
+                        out.write(reinterpret_cast<const char*>(buffer->data()),
+                                  static_cast<std::streamsize>(buffer->size()));
+                        if (!out) timing.errors.push_back("Could not write to " + job.path);
+                    } else {
+                        // The writer does not support in-memory encoding, let it write directly
+                        job.writer->writeData(job.layer.get(), job.path);
+                    }
+                    writeClock.stop();
+                    timing.write += writeClock.getElapsedTime();
+                } catch (const Exception& e) {
+                    timing.errors.push_back(e.getMessage());
+                } catch (const std::exception& e) {
+                    timing.errors.push_back(e.what());
+                }
+            }
+            return timing;
+        }));
+}
+
+void AnimationController::collectFrame() {
+    auto timing = renderState_.pendingFrames.front().get();
+    renderState_.pendingFrames.pop_front();
+
+    for (const auto& error : timing.errors) {
+        LogError("Frame " << timing.frame << ": " << error);
+    }
+    util::log(IVW_CONTEXT, "Frame " + toString(timing.frame) + ": render " +
+                               durationToString(timing.render) + ", capture " +
+                               durationToString(timing.capture) + ", encode " +
+                               durationToString(timing.encode) + ", write " +
+                               durationToString(timing.write));
+
+    renderState_.timings.push_back(std::move(timing));
+}
+
+void AnimationController::flushRenderQueue() {
+    if (renderState_.pendingFrames.empty()) return;
+    while (!renderState_.pendingFrames.empty()) collectFrame();
+
+    renderState_.totalClock.stop();
+    LogInfo("Rendered " << renderState_.timings.size() << " frames in "
+                        << msToString(renderState_.totalClock.getElapsedMilliseconds()));
+}
+
 void AnimationController::eval(Seconds oldTime, Seconds newTime) {
     NetworkLock lock;
     auto ts = (*animation_)(oldTime, newTime, state_);
@@ -37,7 +37,7 @@ Animation::Animation() = default;
 
 AnimationTimeState Animation::operator()(Seconds from, Seconds to, AnimationState state) const {
     AnimationTimeState ts{to, state};
-    for (const auto& track : priorityTracks_) {
+    for (const auto& track : activeTracks_) {
         ts = (*track)(from, ts.time, ts.state);
     }
     return ts;
@@ -75,6 +75,7 @@ std::unique_ptr<Track> Animation::remove(size_t i) {
     auto track = std::move(tracks_[i]);
     tracks_.erase(tracks_.begin() + i);
     util::erase_remove(priorityTracks_, track.get());
+    updateActiveTracks();
     notifyTrackRemoved(track.get());
     return track;
 }
@@ -163,8 +164,21 @@ void Animation::doPrioritySort() {
     std::stable_sort(
         priorityTracks_.begin(), priorityTracks_.end(),
         [](const auto& a, const auto& b) { return a->getPriority() > b->getPriority(); });
+    updateActiveTracks();
 }
 
+void Animation::updateActiveTracks() {
+    activeTracks_.clear();
+    std::copy_if(priorityTracks_.begin(), priorityTracks_.end(), std::back_inserter(activeTracks_),
+                 [](const auto& track) { return track->isEnabled() && !track->empty(); });
+}
+
+void Animation::onEnabledChanged(Track*) { updateActiveTracks(); }
+
+void Animation::onKeyframeSequenceAdded(Track*, KeyframeSequence*) { updateActiveTracks(); }
+
+void Animation::onKeyframeSequenceRemoved(Track*, KeyframeSequence*) { updateActiveTracks(); }
+
 void Animation::onFirstMoved(Track*) { notifyFirstMoved(); }
 
 void Animation::onLastMoved(Track*) { notifyLastMoved(); }
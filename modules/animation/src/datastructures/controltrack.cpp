@@ -51,8 +51,7 @@ AnimationTimeState ControlTrack::operator()(Seconds from, Seconds to, AnimationS
     if (!isEnabled() || empty()) return {to, state};
 
     // 'it' will be the first seq. with a first time larger then 'to'.
-    auto it = std::upper_bound(sequences_.begin(), sequences_.end(), to,
-                               [](const auto& a, const auto& b) { return a < *b; });
+    auto it = sequences_.begin() + static_cast<std::ptrdiff_t>(upperBound(to));
 
     if (it == sequences_.begin()) {
         if (from > (*it)->getFirstTime()) {  // case 1
@@ -195,6 +195,42 @@ TEST(AnimationTests, AnimationTest) {
     EXPECT_EQ(dvec3(0.5), doubleProperty.get());
 }
 
+TEST(AnimationTests, KeyframeLookup) {
+    std::vector<std::unique_ptr<ValueKeyframe<float>>> keys;
+    for (int i = 0; i < 100; ++i) {
+        keys.push_back(std::make_unique<ValueKeyframe<float>>(Seconds{0.5 * i}, float(i % 2)));
+    }
+    KeyframeSequenceTyped<ValueKeyframe<float>> sequence(
+        std::move(keys), std::make_unique<LinearInterpolation<ValueKeyframe<float>>>());
+
+    const auto expected = [&](Seconds time) {
+        return static_cast<size_t>(std::distance(
+            sequence.begin(),
+            std::upper_bound(sequence.begin(), sequence.end(), time,
+                             [](const auto& t, const auto& key) { return t < key.getTime(); })));
+    };
+
+    // Monotonic playback
+    for (double t = -1.0; t < 51.0; t += 0.1) {
+        EXPECT_EQ(expected(Seconds{t}), sequence.upperBound(Seconds{t}));
+    }
+    // Random access
+    for (double t : {30.2, 1.0, 49.5, 0.0, 12.25, 12.0, 60.0, -2.0, 25.0}) {
+        EXPECT_EQ(expected(Seconds{t}), sequence.upperBound(Seconds{t}));
+    }
+
+    // The index has to follow changes of the keyframes
+    sequence.add(std::make_unique<ValueKeyframe<float>>(Seconds{12.1}, 0.5f));
+    EXPECT_EQ(expected(Seconds{12.2}), sequence.upperBound(Seconds{12.2}));
+    sequence[10].setTime(Seconds{40.1});
+    EXPECT_EQ(expected(Seconds{40.2}), sequence.upperBound(Seconds{40.2}));
+    sequence.remove(size_t{0});
+    EXPECT_EQ(expected(Seconds{0.6}), sequence.upperBound(Seconds{0.6}));
+
+    EXPECT_FLOAT_EQ(0.5f, sequence(Seconds{0.0}, Seconds{20.25}));
+    EXPECT_FLOAT_EQ(0.5f, sequence(Seconds{20.25}, Seconds{20.75}));
+}
+
 TEST(AnimationTests, KeyframeSerializationTest) {
     ValueKeyframe<dvec3> keyframe{Seconds{4.0}, dvec3(2.0)};
 
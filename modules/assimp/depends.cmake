@@ -2,5 +2,6 @@
 # Dependencies for current module
 # List modules on the format "Inviwo<ModuleName>Module"
 set(dependencies
+	InviwoBaseModule
 )
 set(EnableByDefault ON)
\ No newline at end of file
@@ -45,6 +45,12 @@ enum class AssimpLogLevel : int { None, Error, Warn, Info, Debug };  // increase
  * \brief Inviwo Module Assimp
  *
  *  A GeometryReader (DataReaderType<Geometry>) using the Assimp Library.
+ *
+ *  Imported meshes are cached in the native binary mesh format (see BinaryMeshWriter) in
+ *  getCacheDirectory(). The cache is keyed on the contents of the source file and the import
+ *  flags, subsequent reads of the same file will load the cached mesh instead of running the
+ *  import again. Note that only the file itself is hashed, files referenced by it, like material
+ *  libraries, are not considered.
  */
 class IVW_MODULE_ASSIMP_API AssimpReader : public DataReaderType<Mesh> {
 public:
@@ -60,15 +66,31 @@ public:
     void setFixInvalidDataFlag(bool enable);
     bool getFixInvalidDataFlag() const;
 
+    /**
+     * Enable or disable the import cache (default = enabled)
+     */
+    void setUseCache(bool enable);
+    bool getUseCache() const;
+
+    /**
+     * Directory of the cached meshes, i.e. <user settings>/cache/assimp
+     */
+    static std::string getCacheDirectory();
+
     virtual std::shared_ptr<Mesh> readData(const std::string& filePath) override;
 
 private:
+    unsigned int getImportFlags() const;
+    std::string getCacheFile(const std::string& filePath, unsigned int flags) const;
+    std::shared_ptr<Mesh> import(const std::string& filePath, unsigned int flags) const;
+
     AssimpLogLevel
         logLevel_;  //!< determines the verbosity of the logging during data import (default = Warn)
     bool verboseLog_;
     bool fixInvalidData_;  //!< if true, the imported data will be checked for invalid data, e.g.
                            //!< invalid normals or UV coords, which might be fixed or removed by
                            //!< Assimp
+    bool useCache_;  //!< if true, imported meshes are read from and written to the cache
 };
 
 }  // namespace inviwo
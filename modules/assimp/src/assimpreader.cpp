@@ -34,6 +34,9 @@
 #include <inviwo/core/datastructures/geometry/mesh.h>
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>
 #include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/util/filesystem.h>
+#include <modules/base/io/binarymeshreader.h>
+#include <modules/base/io/binarymeshwriter.h>
 
 #include <warn/push>
 #include <warn/ignore/all>
@@ -51,6 +54,11 @@
 
 #include <array>
 #include <ctime>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <random>
+#include <sstream>
 
 namespace inviwo {
 
@@ -77,11 +85,40 @@ public:
     }
 };
 
+namespace {
+
+// Increment whenever the conversion from the assimp scene to the Mesh changes, to invalidate
+// previously cached meshes
+constexpr std::uint64_t conversionVersion = 1;
+
+// 64 bit FNV-1a hash of the file contents
+std::uint64_t hashFile(const std::string& filePath) {
+    auto in = filesystem::ifstream(filePath, std::ios_base::in | std::ios_base::binary);
+    if (!in) {
+        throw DataReaderException("Error could not open input file: " + filePath,
+                                  IvwContextCustom("AssimpReader"));
+    }
+    std::uint64_t hash = 14695981039346656037ull;
+    std::vector<char> chunk(1 << 20);
+    while (in) {
+        in.read(chunk.data(), chunk.size());
+        const auto count = static_cast<size_t>(in.gcount());
+        for (size_t i = 0; i < count; ++i) {
+            hash ^= static_cast<unsigned char>(chunk[i]);
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+}  // namespace
+
 AssimpReader::AssimpReader()
     : DataReaderType<Mesh>()
     , logLevel_(AssimpLogLevel::Warn)
     , verboseLog_(false)
-    , fixInvalidData_(true) {
+    , fixInvalidData_(true)
+    , useCache_(true) {
     aiString str{};
     Assimp::Importer importer{};
 
@@ -111,7 +148,102 @@ void AssimpReader::setFixInvalidDataFlag(bool enable) { fixInvalidData_ = enable
 
 bool AssimpReader::getFixInvalidDataFlag() const { return fixInvalidData_; }
 
+void AssimpReader::setUseCache(bool enable) { useCache_ = enable; }
+
+bool AssimpReader::getUseCache() const { return useCache_; }
+
+std::string AssimpReader::getCacheDirectory() {
+    return filesystem::getInviwoUserSettingsPath() + "/cache/assimp";
+}
+
 std::shared_ptr<Mesh> AssimpReader::readData(const std::string& filePath) {
+    if (!filesystem::fileExists(filePath)) {
+        throw DataReaderException("Error could not find input file: " + filePath, IvwContext);
+    }
+
+    const auto flags = getImportFlags();
+    if (!useCache_) return import(filePath, flags);
+
+    std::string cacheFile;
+    try {
+        cacheFile = getCacheFile(filePath, flags);
+        if (filesystem::fileExists(cacheFile)) {
+            return BinaryMeshReader{}.readData(cacheFile);
+        }
+    } catch (const Exception& e) {
+        LogWarn("Could not read cached mesh for " << filePath << ", reimporting: "
+                                                   << e.getMessage());
+        // Remove the bad entry, std::rename does not replace an existing file on all platforms
+        if (!cacheFile.empty()) std::remove(cacheFile.c_str());
+    } catch (const std::exception& e) {
+        LogWarn("Could not read cached mesh for " << filePath << ", reimporting: " << e.what());
+        if (!cacheFile.empty()) std::remove(cacheFile.c_str());
+    }
+
+    auto mesh = import(filePath, flags);
+
+    if (!cacheFile.empty()) {
+        // Write to a unique temporary file and rename it when complete, so that a concurrent
+        // reader or an interrupted write never leaves a partial cache entry behind
+        std::stringstream ss;
+        ss << cacheFile << "." << std::hex << std::random_device{}() << ".tmp";
+        const auto tmpFile = ss.str();
+        try {
+            filesystem::createDirectoryRecursively(getCacheDirectory());
+            BinaryMeshWriter writer;
+            writer.setOverwrite(true);
+            writer.writeData(mesh.get(), tmpFile);
+            if (std::rename(tmpFile.c_str(), cacheFile.c_str()) != 0) {
+                std::remove(tmpFile.c_str());
+                // The rename fails if another process already stored the same entry
+                if (!filesystem::fileExists(cacheFile)) {
+                    LogWarn("Could not cache mesh for " << filePath << ": unable to create "
+                                                        << cacheFile);
+                }
+            }
+        } catch (const Exception& e) {
+            std::remove(tmpFile.c_str());
+            LogWarn("Could not cache mesh for " << filePath << ": " << e.getMessage());
+        } catch (const std::exception& e) {
+            std::remove(tmpFile.c_str());
+            LogWarn("Could not cache mesh for " << filePath << ": " << e.what());
+        }
+    }
+    return mesh;
+}
+
+std::string AssimpReader::getCacheFile(const std::string& filePath, unsigned int flags) const {
+    std::uint64_t key = hashFile(filePath);
+    for (std::uint64_t v : {std::uint64_t{flags}, std::uint64_t{BinaryMeshWriter::version},
+                            conversionVersion}) {
+        key = (key ^ v) * 1099511628211ull;
+    }
+    std::stringstream ss;
+    ss << getCacheDirectory() << "/" << std::hex << std::setw(16) << std::setfill('0') << key
+       << ".ivmesh";
+    return ss.str();
+}
+
+unsigned int AssimpReader::getImportFlags() const {
+    //#define AI_CONFIG_PP_SBP_REMOVE "aiPrimitiveType_POINTS | aiPrimitiveType_LINES"
+    //#define AI_CONFIG_PP_FD_REMOVE 1
+
+    unsigned int flags = aiProcess_JoinIdenticalVertices | aiProcess_Triangulate |
+                         aiProcess_GenSmoothNormals | aiProcess_PreTransformVertices |
+                         aiProcess_ValidateDataStructure | aiProcess_ImproveCacheLocality |
+                         aiProcess_RemoveRedundantMaterials | aiProcess_OptimizeMeshes;
+    //      aiProcess_GenUVCoords | aiProcess_CalcTangentSpace | aiProcess_TransformUVCoords |
+    //      aiProcess_FindInstances
+    //      aiProcess_OptimizeGraph | aiProcess_SortByPType | aiProcess_FindDegenerates |
+    // aiProcess_OptimizeGraph is incompatible to aiProcess_PreTransformVertices
+
+    if (fixInvalidData_) {
+        flags |= aiProcess_FindInvalidData;
+    }
+    return flags;
+}
+
+std::shared_ptr<Mesh> AssimpReader::import(const std::string& filePath, unsigned int flags) const {
     Assimp::Importer importer;
 
     std::clock_t start_readmetadata = std::clock();
@@ -139,22 +271,6 @@ std::shared_ptr<Mesh> AssimpReader::readData(const std::string& filePath) {
         }
     }
 
-    //#define AI_CONFIG_PP_SBP_REMOVE "aiPrimitiveType_POINTS | aiPrimitiveType_LINES"
-    //#define AI_CONFIG_PP_FD_REMOVE 1
-
-    unsigned int flags = aiProcess_JoinIdenticalVertices | aiProcess_Triangulate |
-                         aiProcess_GenSmoothNormals | aiProcess_PreTransformVertices |
-                         aiProcess_ValidateDataStructure | aiProcess_ImproveCacheLocality |
-                         aiProcess_RemoveRedundantMaterials | aiProcess_OptimizeMeshes;
-    //      aiProcess_GenUVCoords | aiProcess_CalcTangentSpace | aiProcess_TransformUVCoords |
-    //      aiProcess_FindInstances
-    //      aiProcess_OptimizeGraph | aiProcess_SortByPType | aiProcess_FindDegenerates |
-    // aiProcess_OptimizeGraph is incompatible to aiProcess_PreTransformVertices
-
-    if (fixInvalidData_) {
-        flags |= aiProcess_FindInvalidData;
-    }
-
     const aiScene* scene = importer.ReadFile(filePath, flags);
 
     std::clock_t start_convert = std::clock();
@@ -186,6 +302,8 @@ std::shared_ptr<Mesh> AssimpReader::readData(const std::string& filePath) {
     size_t texture_channels = 0;
     bool use_normals = true;
     bool use_materials = scene->HasMaterials();
+    size_t num_vertices = 0;
+    size_t num_indices = 0;
 
     // we have at least one mesh, so get its geometry type
     DrawType dt = DrawType::NotSpecified;
@@ -210,6 +328,11 @@ std::shared_ptr<Mesh> AssimpReader::readData(const std::string& filePath) {
             use_normals = false;
         }
 
+        num_vertices += m->mNumVertices;
+        for (size_t j = 0; j < m->mNumFaces; ++j) {
+            num_indices += m->mFaces[j].mNumIndices;
+        }
+
         // check if all meshes have the same geometry type
         if (m->mPrimitiveTypes != fst_primitive_type) {
             dt = DrawType::NotSpecified;
@@ -257,6 +380,13 @@ std::shared_ptr<Mesh> AssimpReader::readData(const std::string& filePath) {
     auto ibuff = std::make_shared<IndexBufferRAM>();
     auto inds = std::make_shared<IndexBuffer>(ibuff);
 
+    // allocate all buffers once, the meshes are appended one after another
+    prep->getDataContainer().reserve(num_vertices);
+    if (use_normals) nrep->getDataContainer().reserve(num_vertices);
+    for (size_t i = 0; i < color_channels; ++i) crep[i]->getDataContainer().reserve(num_vertices);
+    for (size_t i = 0; i < texture_channels; ++i) trep[i]->getDataContainer().reserve(num_vertices);
+    ibuff->getDataContainer().reserve(num_indices);
+
     // iterate over the meshes and fill the data structures
     for (size_t i = 0; i < size_t{scene->mNumMeshes}; ++i) {
         aiMesh* m = scene->mMeshes[i];
@@ -0,0 +1,269 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_DISTANCETRANSFORM_H
+#define IVW_DISTANCETRANSFORM_H
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/foreach.h>
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace inviwo {
+
+namespace util {
+
+namespace detail {
+
+/**
+ * One dimensional squared Euclidean distance transform of a sampled function according to
+ *  P. Felzenszwalb and D. Huttenlocher. Distance Transforms of Sampled Functions.
+ *  Theory of Computing, 8(19), pp. 415-428, 2012.
+ *
+ * Computes d(q) = min_p(w * (q - p)^2 + f(p)) for 0 <= q < n in linear time. Samples where f is
+ * infinite are ignored, if all are, d is infinite. If \p fi is not null, the feature index of the
+ * minimizing sample p is copied to \p di. \p v and \p z are scratch buffers of size n and n + 1.
+ */
+template <typename U>
+void distanceTransform1D(const U* f, U* d, const glm::i64* fi, glm::i64* di, glm::i64 n, double w,
+                         glm::i64* v, double* z) {
+    constexpr auto inf = std::numeric_limits<double>::infinity();
+
+    // Construct the lower envelope of the parabolas rooted at the finite samples
+    glm::i64 k = -1;
+    for (glm::i64 q = 0; q < n; ++q) {
+        if (f[q] == std::numeric_limits<U>::infinity()) continue;
+        const double fq = static_cast<double>(f[q]) + w * static_cast<double>(q * q);
+        double s = -inf;
+        while (k >= 0) {
+            const auto p = v[k];
+            const double fp = static_cast<double>(f[p]) + w * static_cast<double>(p * p);
+            s = (fq - fp) / (2.0 * w * static_cast<double>(q - p));
+            if (s > z[k]) break;
+            --k;
+        }
+        ++k;
+        v[k] = q;
+        z[k] = k == 0 ? -inf : s;
+        z[k + 1] = inf;
+    }
+
+    if (k < 0) {
+        std::fill(d, d + n, std::numeric_limits<U>::infinity());
+        if (di) std::fill(di, di + n, glm::i64{-1});
+        return;
+    }
+
+    // Fill in the values of the lower envelope
+    k = 0;
+    for (glm::i64 q = 0; q < n; ++q) {
+        while (z[k + 1] < static_cast<double>(q)) ++k;
+        const auto p = v[k];
+        d[q] = static_cast<U>(w * static_cast<double>((q - p) * (q - p)) + f[p]);
+        if (di) di[q] = fi[p];
+    }
+}
+
+/**
+ * Exact squared Euclidean distance transform of a N dimensional grid, used by
+ * volumeRAMDistanceTransform and layerRAMDistanceTransform.
+ *
+ * The first axis is handled by a forward and a backward scan over each row, the remaining axes by
+ * distanceTransform1D. Lines along the higher axes are strided in memory, so they are gathered in
+ * blocks of neighboring lines into contiguous buffers before the transform and written back in
+ * the same way. All passes run on the thread pool.
+ *
+ * @param src the source data of dimension \p srcDim
+ * @param dst the destination of dimension \p dstDim = \p srcDim * \p upsample
+ * @param squareVoxelSize squared size of a destination voxel along each axis
+ * @param noFeatureDist squared distance to assign if there is no feature at all
+ * @param features optional destination for the linear index in \p src of the closest feature
+ * @see volumeRAMDistanceTransform
+ */
+template <unsigned int N, typename T, typename U, typename Predicate, typename ValueTransform,
+          typename ProgressCallback>
+void separableDistanceTransform(const T* src, const Vector<N, glm::i64>& srcDim, U* dst,
+                                const Vector<N, glm::i64>& dstDim,
+                                const Vector<N, glm::i64>& upsample,
+                                const Vector<N, double>& squareVoxelSize, U noFeatureDist,
+                                glm::i64* features, Predicate predicate,
+                                ValueTransform valueTransform, ProgressCallback callback) {
+    static_assert(std::is_floating_point<U>::value,
+                  "The distance transform requires a floating point destination");
+
+    constexpr U inf = std::numeric_limits<U>::infinity();
+    // Number of neighboring lines processed together in the higher passes
+    constexpr glm::i64 blockSize = 16;
+
+    const glm::i64 size = glm::compMul(dstDim);
+    const glm::i64 rows = size / dstDim[0];
+
+    // first pass, forward and backward scan along x
+    // result: squared distance to the closest feature in x direction
+    callback(0.0);
+    util::forEachRangeParallel(static_cast<size_t>(rows), [&](size_t begin, size_t end) {
+        std::vector<char> mask(static_cast<size_t>(srcDim[0]));
+        const double w = squareVoxelSize[0];
+        const auto sm = upsample[0];
+
+        for (auto r = static_cast<glm::i64>(begin); r < static_cast<glm::i64>(end); ++r) {
+            // Find the source row, this is the only place where we need to map from
+            // destination to source coordinates
+            glm::i64 srcRow = 0;
+            glm::i64 srcStride = 1;
+            for (size_t i = 1, rem = static_cast<size_t>(r); i < N; ++i) {
+                const auto coord = static_cast<glm::i64>(rem % static_cast<size_t>(dstDim[i]));
+                rem /= static_cast<size_t>(dstDim[i]);
+                srcStride *= srcDim[i - 1];
+                srcRow += (coord / upsample[i]) * srcStride;
+            }
+            for (glm::i64 sx = 0; sx < srcDim[0]; ++sx) {
+                mask[sx] = predicate(src[srcRow + sx]) ? 1 : 0;
+            }
+
+            U* row = dst + r * dstDim[0];
+            glm::i64* featureRow = features ? features + r * dstDim[0] : nullptr;
+
+            // forward
+            glm::i64 last = -1;
+            glm::i64 lastSrc = -1;
+            for (glm::i64 sx = 0; sx < srcDim[0]; ++sx) {
+                for (glm::i64 j = 0; j < sm; ++j) {
+                    const auto x = sx * sm + j;
+                    if (mask[sx]) {
+                        last = x;
+                        lastSrc = sx;
+                    }
+                    row[x] = last < 0 ? inf
+                                      : static_cast<U>(w * static_cast<double>((x - last) *
+                                                                               (x - last)));
+                    if (featureRow) featureRow[x] = last < 0 ? -1 : srcRow + lastSrc;
+                }
+            }
+
+            // backward
+            glm::i64 next = -1;
+            glm::i64 nextSrc = -1;
+            for (glm::i64 sx = srcDim[0] - 1; sx >= 0; --sx) {
+                for (glm::i64 j = sm - 1; j >= 0; --j) {
+                    const auto x = sx * sm + j;
+                    if (mask[sx]) {
+                        next = x;
+                        nextSrc = sx;
+                    }
+                    if (next < 0) continue;
+                    const auto d = static_cast<U>(w * static_cast<double>((next - x) * (next - x)));
+                    if (d < row[x]) {
+                        row[x] = d;
+                        if (featureRow) featureRow[x] = srcRow + nextSrc;
+                    }
+                }
+            }
+        }
+    });
+
+    // remaining passes, for each axis a and voxel v find min_i(data(v_a = i) + (v_a - i)^2)
+    // result: squared distance to the closest feature in the subspace of the axes up to a
+    for (size_t a = 1; a < N; ++a) {
+        callback(static_cast<double>(a) / static_cast<double>(N + 1));
+
+        glm::i64 stride = 1;
+        for (size_t i = 0; i < a; ++i) stride *= dstDim[i];
+        const glm::i64 n = dstDim[a];
+        const glm::i64 outer = size / (stride * n);
+        const glm::i64 blocks = (stride + blockSize - 1) / blockSize;
+        const double w = squareVoxelSize[a];
+
+        util::forEachRangeParallel(static_cast<size_t>(outer * blocks), [&](size_t begin,
+                                                                            size_t end) {
+            std::vector<U> f(static_cast<size_t>(blockSize * n));
+            std::vector<U> d(static_cast<size_t>(blockSize * n));
+            std::vector<glm::i64> fi(features ? static_cast<size_t>(blockSize * n) : 0);
+            std::vector<glm::i64> di(features ? static_cast<size_t>(blockSize * n) : 0);
+            std::vector<glm::i64> v(static_cast<size_t>(n));
+            std::vector<double> z(static_cast<size_t>(n + 1));
+
+            for (auto t = static_cast<glm::i64>(begin); t < static_cast<glm::i64>(end); ++t) {
+                const glm::i64 o = t / blocks;
+                const glm::i64 b0 = (t % blocks) * blockSize;
+                const glm::i64 width = std::min(blockSize, stride - b0);
+                const glm::i64 base = o * stride * n + b0;
+
+                // gather the block, each line becomes contiguous
+                for (glm::i64 k = 0; k < n; ++k) {
+                    const U* in = dst + base + k * stride;
+                    for (glm::i64 b = 0; b < width; ++b) f[b * n + k] = in[b];
+                    if (features) {
+                        const glm::i64* inFeature = features + base + k * stride;
+                        for (glm::i64 b = 0; b < width; ++b) fi[b * n + k] = inFeature[b];
+                    }
+                }
+
+                for (glm::i64 b = 0; b < width; ++b) {
+                    distanceTransform1D(f.data() + b * n, d.data() + b * n,
+                                        features ? fi.data() + b * n : nullptr,
+                                        features ? di.data() + b * n : nullptr, n, w, v.data(),
+                                        z.data());
+                }
+
+                // scatter the block back
+                for (glm::i64 k = 0; k < n; ++k) {
+                    U* out = dst + base + k * stride;
+                    for (glm::i64 b = 0; b < width; ++b) out[b] = d[b * n + k];
+                    if (features) {
+                        glm::i64* outFeature = features + base + k * stride;
+                        for (glm::i64 b = 0; b < width; ++b) outFeature[b] = di[b * n + k];
+                    }
+                }
+            }
+        });
+    }
+
+    // scale data
+    callback(static_cast<double>(N) / static_cast<double>(N + 1));
+    util::forEachRangeParallel(static_cast<size_t>(size), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            dst[i] = valueTransform(dst[i] == inf ? noFeatureDist : dst[i]);
+        }
+    });
+    callback(1.0);
+}
+
+}  // namespace detail
+
+}  // namespace util
+
+}  // namespace inviwo
+
+#endif  // IVW_DISTANCETRANSFORM_H
@@ -32,25 +32,23 @@
 
 #include <modules/base/basemoduledefine.h>
 #include <inviwo/core/common/inviwo.h>
-#include <inviwo/core/util/indexmapper.h>
+#include <modules/base/algorithm/distancetransform.h>
 #include <inviwo/core/datastructures/image/layer.h>
 #include <inviwo/core/datastructures/image/layerram.h>
 #include <inviwo/core/datastructures/image/layerramprecision.h>
 
-#ifndef __clang__
-#include <omp.h>
-#endif
-
 namespace inviwo {
 
 namespace util {
 
 /**
- *	Implementation of Euclidean Distance Transform according to Saito's algorithm:
- *  T. Saito and J.I. Toriwaki. New algorithms for Euclidean distance transformations
- *  of an n-dimensional digitized picture with applications. Pattern Recognition, 27(11).
- *  pp. 1551-1565, 1994.
- *  http://www.cs.jhu.edu/~misha/ReadingSeminar/Papers/Saito94.pdf
+ * Exact Euclidean Distance Transform according to the algorithm of Felzenszwalb and Huttenlocher:
+ *  P. Felzenszwalb and D. Huttenlocher. Distance Transforms of Sampled Functions.
+ *  Theory of Computing, 8(19), pp. 415-428, 2012.
+ *  http://cs.brown.edu/people/pfelzens/papers/dt-final.pdf
+ *
+ * The transform is separable and runs in linear time in the number of voxels, each pass is
+ * distributed over the thread pool.
  *
  * Calculates the distance in base mat space
  *     * Predicate is a function of type (const T &value) -> bool to deside if a value in the input
@@ -67,6 +65,20 @@ void layerRAMDistanceTransform(const LayerRAMPrecision<T> *inLayer,
                                const size2_t upsample, Predicate predicate,
                                ValueTransform valueTransform, ProgressCallback callback);
 
+/**
+ * Same as above, but also calculates the feature transform. For each voxel in \p outFeatures the
+ * linear index into \p inLayer of the closest feature is stored, or -1 if there are no
+ * features at all. \p outFeatures has to have the same dimensions as \p outDistanceField.
+ */
+template <typename T, typename U, typename Predicate, typename ValueTransform,
+          typename ProgressCallback>
+void layerRAMDistanceTransform(const LayerRAMPrecision<T> *inLayer,
+                               LayerRAMPrecision<U> *outDistanceField,
+                               LayerRAMPrecision<glm::i64> *outFeatures,
+                               const Matrix<2, U> basis, const size2_t upsample,
+                               Predicate predicate, ValueTransform valueTransform,
+                               ProgressCallback callback);
+
 template <typename T, typename U>
 void layerRAMDistanceTransform(const LayerRAMPrecision<T> *inVolume,
                                LayerRAMPrecision<U> *outDistanceField, const Matrix<2, U> basis,
@@ -96,20 +108,20 @@ void util::layerRAMDistanceTransform(const LayerRAMPrecision<T> *inLayer,
                                      const Matrix<2, U> basis, const size2_t upsample,
                                      Predicate predicate, ValueTransform valueTransform,
                                      ProgressCallback callback) {
+    util::layerRAMDistanceTransform(inLayer, outDistanceField, nullptr, basis, upsample, predicate,
+                                    valueTransform, callback);
+}
 
-#ifndef __clang__
-    omp_set_num_threads(std::thread::hardware_concurrency());
-#endif
-
-    using int64 = glm::int64;
-    using i64vec2 = glm::tvec2<int64>;
-
-    auto square = [](auto a) { return a * a; };
-
-    callback(0.0);
+template <typename T, typename U, typename Predicate, typename ValueTransform,
+          typename ProgressCallback>
+void util::layerRAMDistanceTransform(const LayerRAMPrecision<T> *inLayer,
+                                     LayerRAMPrecision<U> *outDistanceField,
+                                     LayerRAMPrecision<glm::i64> *outFeatures,
+                                     const Matrix<2, U> basis, const size2_t upsample,
+                                     Predicate predicate, ValueTransform valueTransform,
+                                     ProgressCallback callback) {
 
-    const T *src = inLayer->getDataTyped();
-    U *dst = outDistanceField->getDataTyped();
+    using i64vec2 = Vector<2, glm::i64>;
 
     const i64vec2 srcDim{inLayer->getDimensions()};
     const i64vec2 dstDim{outDistanceField->getDimensions()};
@@ -118,7 +130,6 @@ void util::layerRAMDistanceTransform(const LayerRAMPrecision<T> *inLayer,
     const auto squareBasis = glm::transpose(basis) * basis;
     const Vector<2, U> squareBasisDiag{squareBasis[0][0], squareBasis[1][1]};
     const Vector<2, U> squareVoxelSize{squareBasisDiag / Vector<2, U>{dstDim * dstDim}};
-    const Vector<2, U> invSquareVoxelSize{Vector<2, U>{1.0f} / squareVoxelSize};
 
     {
         const auto maxdist = glm::compMax(squareBasisDiag);
@@ -147,81 +158,20 @@ void util::layerRAMDistanceTransform(const LayerRAMPrecision<T> *inLayer,
                 " dst = " + toString(dstDim) + " scaling = " + toString(sm),
             IvwContextCustom("layerRAMDistanceTransform"));
     }
-
-    util::IndexMapper<2, int64> srcInd(srcDim);
-    util::IndexMapper<2, int64> dstInd(dstDim);
-
-    auto is_feature = [&](const int64 x, const int64 y) {
-        return predicate(src[srcInd(x / sm.x, y / sm.y)]);
-    };
-
-// first pass, forward and backward scan along x
-// result: min distance in x direction
-#pragma omp parallel for
-    for (int64 y = 0; y < dstDim.y; ++y) {
-        // forward
-        U dist = static_cast<U>(dstDim.x);
-        for (int64 x = 0; x < dstDim.x; ++x) {
-            if (!is_feature(x, y)) {
-                ++dist;
-            } else {
-                dist = U(0);
-            }
-            dst[dstInd(x, y)] = squareVoxelSize.x * square(dist);
-        }
-
-        // backward
-        dist = static_cast<U>(dstDim.x);
-        for (int64 x = dstDim.x - 1; x >= 0; --x) {
-            if (!is_feature(x, y)) {
-                ++dist;
-            } else {
-                dist = U(0);
-            }
-            dst[dstInd(x, y)] = std::min<U>(dst[dstInd(x, y)], squareVoxelSize.x * square(dist));
-        }
+    if (outFeatures && i64vec2{outFeatures->getDimensions()} != dstDim) {
+        throw Exception("DistanceTransformRAM: Feature dimensions does not match dst = " +
+                            toString(dstDim) +
+                            " features = " + toString(outFeatures->getDimensions()),
+                        IvwContextCustom("layerRAMDistanceTransform"));
     }
 
-    // second pass, scan y direction
-    // for each voxel v(x,y,z) find min_i(data(x,i,z) + (y - i)^2), 0 <= i < dimY
-    // result: min distance in x and y direction
-    callback(0.45);
-#pragma omp parallel
-    {
-        std::vector<U> buff;
-        buff.resize(dstDim.y);
-#pragma omp for
-        for (int64 x = 0; x < dstDim.x; ++x) {
-
-            // cache column data into temporary buffer
-            for (int64 y = 0; y < dstDim.y; ++y) {
-                buff[y] = dst[dstInd(x, y)];
-            }
-
-            for (int64 y = 0; y < dstDim.y; ++y) {
-                auto d = buff[y];
-                if (d != U(0)) {
-                    const auto rMax = static_cast<int64>(std::sqrt(d * invSquareVoxelSize.y)) + 1;
-                    const auto rStart = std::min(rMax, y - 1);
-                    const auto rEnd = std::min(rMax, dstDim.y - y);
-                    for (int64 n = -rStart; n < rEnd; ++n) {
-                        const auto w = buff[y + n] + squareVoxelSize.y * square(n);
-                        if (w < d) d = w;
-                    }
-                }
-                dst[dstInd(x, y)] = d;
-            }
-        }
-    }
+    // Voxels without any feature get the squared length of the diagonal
+    const auto noFeatureDist = glm::compAdd(squareBasisDiag);
 
-    // scale data
-    callback(0.9);
-    const int64 layerSize = dstDim.x * dstDim.y;
-#pragma omp parallel for
-    for (int64 i = 0; i < layerSize; ++i) {
-        dst[i] = valueTransform(dst[i]);
-    }
-    callback(1.0);
+    util::detail::separableDistanceTransform<2>(
+        inLayer->getDataTyped(), srcDim, outDistanceField->getDataTyped(), dstDim, sm,
+        Vector<2, double>{squareVoxelSize}, noFeatureDist,
+        outFeatures ? outFeatures->getDataTyped() : nullptr, predicate, valueTransform, callback);
 }
 
 template <typename T, typename U>
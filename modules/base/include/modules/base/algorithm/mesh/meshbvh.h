@@ -0,0 +1,168 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_MESHBVH_H
+#define IVW_MESHBVH_H
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+#include <inviwo/core/datastructures/geometry/plane.h>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \brief Bounding volume hierarchy over the triangles of a Mesh.
+ *
+ * The hierarchy is built top down using the surface area heuristic evaluated over binned triangle
+ * centroids. The upper levels are split using the thread pool, after which the remaining subtrees
+ * are built in parallel. The nodes are stored in a flat array where the two children of a node are
+ * adjacent, and the triangles are reordered such that each leaf refers to a contiguous range.
+ *
+ * The triangles are taken from all index buffers with DrawType::Triangles and connectivity None,
+ * Strip, or Fan, or from the vertex buffer directly if the mesh has no index buffers. Triangles are
+ * numbered in that order, see getTriangle(). The positions are copied from the position buffer,
+ * hence the hierarchy stays valid even if the mesh is modified, all queries are in data space of
+ * the mesh.
+ *
+ * Use MeshBVH::get to get a hierarchy that is cached together with the mesh and rebuilt when any
+ * of its buffers change.
+ *
+ * MeshPicking renders picking ids on the GPU and MeshPlaneClipper updates its own per vertex
+ * classification incrementally, neither of them uses this hierarchy.
+ */
+class IVW_MODULE_BASE_API MeshBVH {
+public:
+    static constexpr std::uint32_t noTriangle = std::numeric_limits<std::uint32_t>::max();
+
+    struct Node {
+        vec3 min;
+        std::uint32_t first;  ///< index of the left child, or the first triangle of a leaf
+        vec3 max;
+        std::uint32_t count;  ///< number of triangles of a leaf, zero for inner nodes
+
+        bool isLeaf() const { return count > 0; }
+    };
+
+    struct RayHit {
+        std::uint32_t triangle = noTriangle;  ///< index of the closest triangle hit
+        float t = std::numeric_limits<float>::infinity();  ///< ray parameter of the hit
+        vec2 barycentric{0.0f};  ///< weights of the second and third vertex of the triangle
+
+        explicit operator bool() const { return triangle != noTriangle; }
+    };
+
+    struct ClosestPoint {
+        std::uint32_t triangle = noTriangle;  ///< index of the closest triangle
+        vec3 point{0.0f};                     ///< closest point on the triangle
+        float distance = std::numeric_limits<float>::infinity();
+
+        explicit operator bool() const { return triangle != noTriangle; }
+    };
+
+    /**
+     * Build the hierarchy for \p mesh.
+     * @param mesh the mesh, must have a position buffer with floating point values
+     * @param maxLeafSize the largest number of triangles in a leaf
+     * @throws Exception if the mesh has no position buffer or the indices are out of range
+     */
+    explicit MeshBVH(const Mesh& mesh, size_t maxLeafSize = 4);
+
+    /**
+     * Get the hierarchy of \p mesh. The hierarchy is stored with the mesh, see
+     * Mesh::getDerivedData, and is rebuilt if any of the buffers of the mesh has been replaced or
+     * modified since, see Data::getModificationCount.
+     */
+    static std::shared_ptr<const MeshBVH> get(const std::shared_ptr<const Mesh>& mesh);
+
+    /**
+     * Find the closest triangle hit by the ray \p origin + t * \p direction with \p tMin <= t <=
+     * \p tMax. Triangles are hit from both sides.
+     */
+    RayHit raycast(const vec3& origin, const vec3& direction, float tMin = 0.0f,
+                   float tMax = std::numeric_limits<float>::infinity()) const;
+
+    /**
+     * Find the closest point on the mesh to \p point that is closer than \p maxDistance.
+     */
+    ClosestPoint closestPoint(const vec3& point,
+                              float maxDistance = std::numeric_limits<float>::infinity()) const;
+
+    /**
+     * Find all triangles with a bounding box that overlaps the box [\p min, \p max].
+     */
+    std::vector<std::uint32_t> query(const vec3& min, const vec3& max) const;
+
+    /**
+     * Find all triangles that are not completely outside of any of the \p planes, for example the
+     * six planes of a view frustum with their normals pointing inwards. The test is conservative,
+     * triangles outside of the intersection but not outside of a single plane are included.
+     */
+    std::vector<std::uint32_t> query(const std::vector<Plane>& planes) const;
+
+    /**
+     * Test if \p point is enclosed by the mesh by counting ray crossings. The mesh should be
+     * closed, for meshes with holes the result is the majority vote of three rays.
+     */
+    bool isInside(const vec3& point) const;
+
+    /**
+     * Bounding box of all triangles in data space
+     */
+    std::pair<vec3, vec3> getBounds() const;
+
+    /**
+     * The vertex indices of triangle \p triangle
+     */
+    const std::array<std::uint32_t, 3>& getTriangle(std::uint32_t triangle) const;
+    size_t getNumberOfTriangles() const;
+
+    const std::vector<Node>& getNodes() const;
+
+private:
+    bool intersect(const vec3& origin, const vec3& direction, std::uint32_t item, float tMin,
+                   float tMax, RayHit& hit) const;
+    size_t countCrossings(const vec3& origin, const vec3& direction) const;
+
+    std::vector<vec3> positions_;
+    std::vector<std::array<std::uint32_t, 3>> triangles_;
+    // Triangles indices in leaf order, leaf ranges refer to this
+    std::vector<std::uint32_t> items_;
+    std::vector<Node> nodes_;
+};
+
+}  // namespace inviwo
+
+#endif  // IVW_MESHBVH_H
@@ -0,0 +1,109 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#ifndef IVW_MESHPLANECLIPPER_H
+#define IVW_MESHPLANECLIPPER_H
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+#include <inviwo/core/datastructures/geometry/simplemesh.h>
+#include <inviwo/core/datastructures/geometry/plane.h>
+
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \brief Clips triangle meshes against a set of planes.
+ *
+ * Keeps the part of the mesh that is on the inside of all the planes, see Plane::isInside, and
+ * optionally closes the resulting holes with caps aligned with the planes. All planes are handled
+ * in one pass over the triangles. The triangles are split into ranges that are clipped in parallel
+ * on the thread pool, each range writing into its own output arena. Vertices created on the same
+ * mesh edge are welded using an edge hash, hence the output is an indexed triangle mesh without
+ * cracks if the input has none.
+ *
+ * The clipper caches the vertex and triangle classification of the last mesh for each plane. When
+ * only the offset of a plane changes between two calls, as when dragging a plane along its normal,
+ * only the vertices that changed sides are reclassified and only the triangles crossing a plane
+ * are clipped. Triangles fully inside are passed through and triangles fully outside are dropped.
+ *
+ * Supports SimpleMesh and BasicMesh with triangle lists, strips and fans.
+ */
+class IVW_MODULE_BASE_API MeshPlaneClipper {
+public:
+    struct Stats {
+        size_t reclassifiedVertices = 0;  ///< Vertices classified in the last call
+        size_t clippedTriangles = 0;      ///< Triangles crossing a plane in the last call
+        size_t keptTriangles = 0;         ///< Triangles fully inside all planes in the last call
+        size_t capTriangles = 0;          ///< Triangles added to close holes in the last call
+    };
+
+    MeshPlaneClipper();
+    MeshPlaneClipper(const MeshPlaneClipper&) = delete;
+    MeshPlaneClipper& operator=(const MeshPlaneClipper&) = delete;
+    ~MeshPlaneClipper();
+
+    /**
+     * Clip \p mesh against \p planes.
+     * @param mesh the mesh to clip, must be a SimpleMesh or BasicMesh
+     * @param planes the planes to clip against in data space of the mesh
+     * @param capHoles replace removed parts with triangles aligned with the planes
+     * @return a new mesh with positions, texture coordinates, and colors of \p mesh and indexed
+     * triangles, with the model and world matrix of \p mesh.
+     * @throws Exception if mesh is not a SimpleMesh or BasicMesh
+     */
+    std::shared_ptr<SimpleMesh> clip(std::shared_ptr<const Mesh> mesh,
+                                     const std::vector<Plane>& planes, bool capHoles = true);
+
+    /**
+     * Drop all cached data
+     */
+    void clear();
+
+    const Stats& getStats() const;
+
+private:
+    struct MeshData;
+    struct PlaneState;
+
+    void updateMeshData(std::shared_ptr<const Mesh> mesh);
+    void updatePlaneState(PlaneState& state, const Plane& plane);
+
+    std::unique_ptr<MeshData> mesh_;
+    std::vector<std::unique_ptr<PlaneState>> planes_;
+    Stats stats_;
+};
+
+}  // namespace inviwo
+
+#endif  // IVW_MESHPLANECLIPPER_H
@@ -36,7 +36,10 @@
 #include <inviwo/core/datastructures/camera.h>
 #include <inviwo/core/datastructures/geometry/typedmesh.h>
 
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace inviwo {
 
@@ -103,6 +106,17 @@ IVW_MODULE_BASE_API std::shared_ptr<ColoredMesh> cameraFrustum(
     const Camera& camera, vec4 color,
     std::shared_ptr<ColoredMesh> mesh = std::make_shared<ColoredMesh>());
 
+/**
+ * Collect the triangles of all index buffers with DrawType::Triangles, or of the vertices in
+ * order if the mesh has no index buffers. Lists, strips, and fans are supported, degenerate
+ * triangles are skipped and every other strip triangle is flipped to keep the winding.
+ * @param mesh the mesh to collect triangles from
+ * @param numVertices the number of vertices of the mesh, used to validate the indices
+ * @throws Exception if any index is out of range
+ */
+IVW_MODULE_BASE_API std::vector<std::array<std::uint32_t, 3>> triangles(const Mesh& mesh,
+                                                                       std::uint32_t numVertices);
+
 }  // namespace meshutil
 
 }  // namespace inviwo
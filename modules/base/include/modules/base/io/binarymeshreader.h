@@ -0,0 +1,70 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_BINARYMESHREADER_H
+#define IVW_BINARYMESHREADER_H
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/io/datareader.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+
+#include <istream>
+
+namespace inviwo {
+
+/**
+ * \ingroup dataio
+ * \brief Reader for Meshes in the native Inviwo binary mesh format (.ivmesh)
+ *
+ * Each buffer is allocated once with its final size and filled with a single read from the
+ * file, no per element conversion is done.
+ * @see BinaryMeshWriter
+ */
+class IVW_MODULE_BASE_API BinaryMeshReader : public DataReaderType<Mesh> {
+public:
+    BinaryMeshReader();
+    BinaryMeshReader(const BinaryMeshReader&) = default;
+    BinaryMeshReader& operator=(const BinaryMeshReader&) = default;
+    virtual BinaryMeshReader* clone() const override;
+    virtual ~BinaryMeshReader() = default;
+
+    virtual std::shared_ptr<Mesh> readData(const std::string& filePath) override;
+
+    /**
+     * Read a mesh from \p is, which has to be opened in binary mode.
+     * @throw DataReaderException if the stream does not contain a valid mesh of the current
+     * version
+     */
+    static std::shared_ptr<Mesh> readData(std::istream& is);
+};
+
+}  // namespace inviwo
+
+#endif  // IVW_BINARYMESHREADER_H
@@ -0,0 +1,121 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_IMAGESTACKVOLUMELOADER_H
+#define IVW_IMAGESTACKVOLUMELOADER_H
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/io/datareader.h>
+#include <inviwo/core/datastructures/diskrepresentation.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/volume/volumerepresentation.h>
+#include <inviwo/core/util/cloneableptr.h>
+
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+class VolumeRAM;
+
+/**
+ * \ingroup dataio
+ * \brief Loads a stack of images into a VolumeRAM, one image per z slice.
+ *
+ * The slices are decoded concurrently on the thread pool and each one is converted straight into
+ * its z offset of the destination volume, no slice is kept in memory after it has been copied.
+ * Slices without a reader, that can not be read, or that have unexpected dimensions or an
+ * unsupported format are filled with zeros and a warning is reported.
+ *
+ * The loader can be used directly, or as the loader of a VolumeDisk to only decode the stack once
+ * a RAM representation of the volume is requested.
+ * @see ImageStackVolumeSource
+ */
+class IVW_MODULE_BASE_API ImageStackVolumeLoader
+    : public DiskRepresentationLoader<VolumeRepresentation> {
+public:
+    /**
+     * Called with the fraction of decoded slices, always from the thread calling load()
+     */
+    using ProgressCallback = std::function<void(double)>;
+    /**
+     * Called with a warning for each slice that could not be decoded, after all slices are done
+     * and from the thread calling load()
+     */
+    using WarningCallback = std::function<void(const std::string&)>;
+
+    /**
+     * @param files the image files, one per slice
+     * @param readers the reader to use for each of the files, null for files without a reader.
+     *        The readers are cloned.
+     * @param sliceDimensions the expected dimensions of all images
+     * @param format data format of the volume, has to be a floating point format or an integer
+     *        format with at most 32 bits per component
+     */
+    ImageStackVolumeLoader(std::vector<std::string> files,
+                           const std::vector<const DataReaderType<Layer>*>& readers,
+                           size2_t sliceDimensions, const DataFormatBase* format);
+    ImageStackVolumeLoader(const ImageStackVolumeLoader&) = default;
+    ImageStackVolumeLoader& operator=(const ImageStackVolumeLoader&) = default;
+    virtual ImageStackVolumeLoader* clone() const override;
+    virtual ~ImageStackVolumeLoader() = default;
+
+    virtual std::shared_ptr<VolumeRepresentation> createRepresentation() const override;
+    virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation> dest) const override;
+
+    /**
+     * Decode all slices into a new VolumeRAM
+     * @param progress optional callback for reporting progress
+     * @param warning optional callback for the warnings, by default they are logged
+     */
+    std::shared_ptr<VolumeRAM> load(const ProgressCallback& progress = nullptr,
+                                    const WarningCallback& warning = nullptr) const;
+
+    size3_t getDimensions() const;
+    const DataFormatBase* getDataFormat() const;
+
+private:
+    void read(VolumeRAM& dest, const ProgressCallback& progress,
+              const WarningCallback& warning) const;
+
+    static constexpr size_t noReader = std::numeric_limits<size_t>::max();
+
+    std::vector<std::string> files_;
+    std::vector<size_t> readerIndex_;  // index into readers_ for each slice, or noReader
+    std::vector<util::cloneable_ptr<DataReaderType<Layer>>> readers_;
+    size2_t sliceDimensions_;
+    const DataFormatBase* format_;
+};
+
+}  // namespace inviwo
+
+#endif  // IVW_IMAGESTACKVOLUMELOADER_H
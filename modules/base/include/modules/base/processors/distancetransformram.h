@@ -45,6 +45,7 @@
 #include <inviwo/core/properties/optionproperty.h>
 #include <inviwo/core/properties/stringproperty.h>
 #include <inviwo/core/processors/progressbarowner.h>
+#include <inviwo/core/util/resultcache.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 
 namespace inviwo {
@@ -104,6 +105,8 @@ private:
     VolumeOutport outport_;
 
     std::future<std::shared_ptr<const Volume>> newVolume_;
+    ResultCacheKey newVolumeKey_;
+    ResultCache<Volume> cache_;
 
     DoubleProperty threshold_;
     BoolProperty flip_;
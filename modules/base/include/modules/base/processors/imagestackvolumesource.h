@@ -33,6 +33,7 @@
 #include <inviwo/core/common/inviwo.h>
 
 #include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/progressbarowner.h>
 #include <inviwo/core/ports/volumeport.h>
 #include <inviwo/core/properties/boolproperty.h>
 #include <inviwo/core/properties/buttonproperty.h>
@@ -60,6 +61,9 @@ class InviwoApplication;
  * Single channels, i.e. red, green, blue, alpha, and grayscale, will result in a scalar volume
  * whereas rgb and rgba will yield a vec3 or vec4 volume, respectively.
  *
+ * The images are decoded concurrently on the thread pool, each directly into its slice of the
+ * volume.
+ *
  * ### Outports
  *   * __volume__ Volume generated from a stack of input images.
  *
@@ -68,12 +72,14 @@ class InviwoApplication;
  *   * __Skip Unsupported Files__   If true, matching files with unsupported image formats are
  *                                not considered. Otherwise an empty volume slice will be inserted
  *                               for each file.
+ *   * __Load on Demand__         If true, the images are only decoded once the volume data is
+ *                                accessed. Otherwise they are decoded right away.
  *   * __Voxel Spacing__          Used to match the sampling distance of the acquired data and
  *                                affects the physical size of the volume.
  *   * __Data Information__       Metadata of the generated volume data set.
  *
  */
-class IVW_MODULE_BASE_API ImageStackVolumeSource : public Processor {
+class IVW_MODULE_BASE_API ImageStackVolumeSource : public Processor, public ProgressBarOwner {
 public:
     ImageStackVolumeSource(InviwoApplication* app);
     void addFileNameFilters();
@@ -95,6 +101,7 @@ private:
     FilePatternProperty filePattern_;
     ButtonProperty reload_;
     BoolProperty skipUnsupportedFiles_;
+    BoolProperty loadOnDemand_;
 
     BasisProperty basis_;
     VolumeInformationProperty information_;
@@ -31,8 +31,10 @@
 #define IVW_MESHCLIPPING_H
 
 #include <modules/base/basemoduledefine.h>
+#include <modules/base/algorithm/mesh/meshplaneclipper.h>
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/processors/processor.h>
+#include <inviwo/core/ports/datainport.h>
 #include <inviwo/core/ports/meshport.h>
 #include <inviwo/core/datastructures/geometry/simplemesh.h>
 #include <inviwo/core/datastructures/geometry/plane.h>
@@ -46,15 +48,18 @@ namespace inviwo {
 /** \docpage{org.inviwo.MeshClipping, Mesh Clipping}
  * ![](org.inviwo.MeshClipping.png?classIdentifier=org.inviwo.MeshClipping)
  *
- * Remove parts of a mesh that is on the back side of a plane.
- * Replaces removed parts with triangles aligned with the plane.
+ * Remove parts of a mesh that is on the back side of a plane, and of any additional planes.
+ * Replaces removed parts with triangles aligned with the planes.
  * Link the camera property to move the camera along the plane, or to align plane with view
  * direction. Coordinates are specified in world space.
  *
- * Supports SimpleMesh and BasicMesh
+ * Supports SimpleMesh and BasicMesh with triangle lists, strips, and fans. The clipping runs on
+ * the thread pool and only reclassifies the affected vertices when a plane is moved along its
+ * normal, see MeshPlaneClipper.
  *
  * ### Inports
  *   * __inputMesh__ Input mesh
+ *   * __additionalPlanes__ Optional planes in world space to clip against as well
  *
  * ### Outports
  *   * __clippedMesh__ Clipped output mesh
@@ -69,6 +74,7 @@ namespace inviwo {
  *   * __Camera__ Camera used for moving or aligning plane.
  *   * __Align Plane Normal To Camera Normal__ Aligns plane normal with camera
  *   * __Enable clipping__ Pass through mesh if disabled.
+ *   * __Cap Holes__ Replace removed parts with triangles aligned with the planes.
  *
 
  */
@@ -84,21 +90,25 @@ protected:
     virtual void process() override;
 
     /**
-     * Clip mesh against plane. Replaces removed parts with triangles aligned with the plane.
+     * Clip mesh against planes. Replaces removed parts with triangles aligned with the planes if
+     * capping is enabled.
      * @throws Exception if mesh is not a SimpleMesh or BasicMesh
      * @param mesh to clip
-     * @param plane in world space coordinate system.
+     * @param planes in world space coordinate system.
      */
-    std::shared_ptr<Mesh> clipGeometryAgainstPlane(const Mesh *mesh, const Plane &plane);
+    std::shared_ptr<Mesh> clipGeometryAgainstPlanes(std::shared_ptr<const Mesh> mesh,
+                                                    const std::vector<Plane> &planes);
 
 private:
     void onAlignPlaneNormalToCameraNormalPressed();
 
     MeshInport inport_;
+    DataInport<Plane, 0> additionalPlanes_;
     MeshOutport outport_;
     DataOutport<Plane> clippingPlane_;
 
     BoolProperty clippingEnabled_;
+    BoolProperty capHoles_;
     BoolProperty movePointAlongNormal_;
     BoolProperty moveCameraAlongNormal_;
     FloatProperty pointPlaneMove_;
@@ -109,7 +119,7 @@ private:
 
     float previousPointPlaneMove_;
 
-    static const float EPSILON;
+    MeshPlaneClipper clipper_;
 };
 }  // namespace inviwo
 
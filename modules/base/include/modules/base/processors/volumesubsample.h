@@ -38,6 +38,7 @@
 #include <inviwo/core/properties/ordinalproperty.h>
 #include <modules/base/algorithm/volume/volumeramsubsample.h>
 #include <inviwo/core/processors/activityindicator.h>
+#include <inviwo/core/util/resultcache.h>
 
 #include <future>
 
@@ -84,6 +85,8 @@ private:
     IntVec3Property subSampleFactors_;
 
     std::future<std::shared_ptr<Volume>> result_;
+    ResultCacheKey resultKey_;
+    ResultCache<Volume> cache_;
     bool dirty_;
 };
 }  // namespace inviwo
@@ -0,0 +1,675 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/mesh/meshbvh.h>
+#include <modules/base/algorithm/meshutils.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/formatdispatching.h>
+
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+#include <typeinfo>
+
+namespace inviwo {
+
+namespace {
+
+constexpr size_t numBins = 16;
+// Ranges larger than this are binned and bounded in parallel
+constexpr size_t parallelThreshold = 1 << 16;
+// Deeper than this, nodes are split at the median to bound the depth of the tree
+constexpr size_t maxSAHDepth = 64;
+// Larger than the depth of any tree, see maxSAHDepth
+constexpr size_t stackSize = 128;
+
+struct Bounds {
+    vec3 min{std::numeric_limits<float>::max()};
+    vec3 max{std::numeric_limits<float>::lowest()};
+
+    void extend(const vec3& p) {
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+    void extend(const Bounds& b) {
+        min = glm::min(min, b.min);
+        max = glm::max(max, b.max);
+    }
+    float area() const {
+        const auto e = glm::max(max - min, vec3{0.0f});
+        return e.x * e.y + e.y * e.z + e.z * e.x;
+    }
+};
+
+struct Bin {
+    Bounds bounds;
+    size_t count = 0;
+};
+using Bins = std::array<std::array<Bin, numBins>, 3>;
+
+struct Builder {
+    const std::vector<Bounds>& bounds;
+    const std::vector<vec3>& centroids;
+    std::vector<std::uint32_t>& items;
+    size_t maxLeafSize;
+
+    template <typename Func>
+    void forRange(std::uint32_t begin, std::uint32_t end, Func func) const {
+        if (end - begin < parallelThreshold) {
+            func(begin, end);
+        } else {
+            util::forEachRangeParallel(end - begin, [&](size_t b, size_t e) {
+                func(static_cast<std::uint32_t>(begin + b), static_cast<std::uint32_t>(begin + e));
+            });
+        }
+    }
+
+    // Bounds of the triangles and of their centroids
+    std::pair<Bounds, Bounds> rangeBounds(std::uint32_t begin, std::uint32_t end) const {
+        std::mutex mutex;
+        Bounds nodeBounds, centroidBounds;
+        forRange(begin, end, [&](std::uint32_t b, std::uint32_t e) {
+            Bounds nb, cb;
+            for (auto i = b; i < e; ++i) {
+                nb.extend(bounds[items[i]]);
+                cb.extend(centroids[items[i]]);
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            nodeBounds.extend(nb);
+            centroidBounds.extend(cb);
+        });
+        return {nodeBounds, centroidBounds};
+    }
+
+    // Split the range [begin, end) and return the start of the second half, or begin if the
+    // range should become a leaf.
+    std::uint32_t split(std::uint32_t begin, std::uint32_t end, const Bounds& nodeBounds,
+                        const Bounds& centroidBounds, size_t depth) const {
+        const auto count = end - begin;
+        if (count <= maxLeafSize) return begin;
+
+        const auto extent = centroidBounds.max - centroidBounds.min;
+        const auto largest = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2)
+                                                 : (extent.y > extent.z ? 1 : 2);
+
+        auto medianSplit = [&]() {
+            const auto mid = begin + count / 2;
+            std::nth_element(items.begin() + begin, items.begin() + mid, items.begin() + end,
+                             [&](std::uint32_t a, std::uint32_t b) {
+                                 return centroids[a][largest] < centroids[b][largest];
+                             });
+            return mid;
+        };
+
+        if (extent[largest] <= 0.0f || depth >= maxSAHDepth) return medianSplit();
+
+        auto binIndex = [&](const vec3& c, int axis) {
+            if (extent[axis] <= 0.0f) return size_t{0};
+            const auto b = static_cast<size_t>(numBins * (c[axis] - centroidBounds.min[axis]) /
+                                               extent[axis]);
+            return std::min(b, numBins - 1);
+        };
+
+        Bins bins;
+        std::mutex mutex;
+        forRange(begin, end, [&](std::uint32_t b, std::uint32_t e) {
+            Bins local;
+            for (auto i = b; i < e; ++i) {
+                const auto item = items[i];
+                for (int axis = 0; axis < 3; ++axis) {
+                    auto& bin = local[axis][binIndex(centroids[item], axis)];
+                    bin.bounds.extend(bounds[item]);
+                    ++bin.count;
+                }
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            for (int axis = 0; axis < 3; ++axis) {
+                for (size_t i = 0; i < numBins; ++i) {
+                    bins[axis][i].bounds.extend(local[axis][i].bounds);
+                    bins[axis][i].count += local[axis][i].count;
+                }
+            }
+        });
+
+        // Evaluate the surface area heuristic for the planes between the bins, with the cost of
+        // a traversal step equal to that of a triangle intersection
+        float bestCost = std::numeric_limits<float>::max();
+        int bestAxis = -1;
+        size_t bestBin = 0;
+        for (int axis = 0; axis < 3; ++axis) {
+            if (extent[axis] <= 0.0f) continue;
+            std::array<float, numBins> rightCost;
+            Bounds right;
+            size_t rightCount = 0;
+            for (size_t i = numBins - 1; i > 0; --i) {
+                right.extend(bins[axis][i].bounds);
+                rightCount += bins[axis][i].count;
+                rightCost[i] = right.area() * static_cast<float>(rightCount);
+            }
+            Bounds left;
+            size_t leftCount = 0;
+            for (size_t i = 0; i + 1 < numBins; ++i) {
+                left.extend(bins[axis][i].bounds);
+                leftCount += bins[axis][i].count;
+                if (leftCount == 0 || leftCount == count) continue;
+                const auto cost = left.area() * static_cast<float>(leftCount) + rightCost[i + 1];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = i;
+                }
+            }
+        }
+        if (bestAxis < 0) return medianSplit();
+
+        const auto area = nodeBounds.area();
+        const auto splitCost = 1.0f + (area > 0.0f ? bestCost / area : 0.0f);
+        // Splitting is not worth it, keep as a leaf if small enough
+        if (splitCost >= static_cast<float>(count) && count <= 4 * maxLeafSize) return begin;
+
+        const auto mid = std::partition(items.begin() + begin, items.begin() + end,
+                                        [&](std::uint32_t item) {
+                                            return binIndex(centroids[item], bestAxis) <= bestBin;
+                                        }) -
+                         items.begin();
+        return static_cast<std::uint32_t>(mid);
+    }
+
+    // Build the subtree of the range [begin, end) into nodes, with the root at nodes[0].
+    void buildSubtree(std::vector<MeshBVH::Node>& nodes, std::uint32_t begin, std::uint32_t end,
+                      size_t depth) const {
+        struct Task {
+            std::uint32_t node, begin, end;
+            size_t depth;
+        };
+        std::vector<Task> stack{{0, begin, end, depth}};
+        nodes.assign(1, MeshBVH::Node{});
+        while (!stack.empty()) {
+            const auto task = stack.back();
+            stack.pop_back();
+            const auto b = rangeBounds(task.begin, task.end);
+            const auto mid = split(task.begin, task.end, b.first, b.second, task.depth);
+            auto& node = nodes[task.node];
+            node.min = b.first.min;
+            node.max = b.first.max;
+            if (mid == task.begin) {
+                node.first = task.begin;
+                node.count = task.end - task.begin;
+            } else {
+                const auto left = static_cast<std::uint32_t>(nodes.size());
+                node.first = left;
+                node.count = 0;
+                nodes.resize(nodes.size() + 2);
+                stack.push_back({left + 1, mid, task.end, task.depth + 1});
+                stack.push_back({left, task.begin, mid, task.depth + 1});
+            }
+        }
+    }
+};
+
+// Squared distance from p to the box [min, max]
+float distance2(const vec3& p, const vec3& min, const vec3& max) {
+    const auto d = glm::max(glm::max(min - p, p - max), vec3{0.0f});
+    return glm::dot(d, d);
+}
+
+// Entry parameter of the ray into the box [min, max], or infinity if it is missed
+float rayBox(const vec3& origin, const vec3& invDir, const vec3& min, const vec3& max, float tMin,
+             float tMax) {
+    const auto t0 = (min - origin) * invDir;
+    const auto t1 = (max - origin) * invDir;
+    const auto tNear = glm::max(glm::min(t0, t1), vec3{tMin});
+    const auto tFar = glm::min(glm::max(t0, t1), vec3{tMax});
+    const auto enter = glm::compMax(tNear);
+    const auto exit = glm::compMin(tFar);
+    return enter <= exit ? enter : std::numeric_limits<float>::infinity();
+}
+
+// Closest point to p on the triangle (a, b, c), see Ericson, Real-Time Collision Detection
+vec3 closestPointOnTriangle(const vec3& p, const vec3& a, const vec3& b, const vec3& c) {
+    const auto ab = b - a;
+    const auto ac = c - a;
+    const auto ap = p - a;
+    const auto d1 = glm::dot(ab, ap);
+    const auto d2 = glm::dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) return a;
+
+    const auto bp = p - b;
+    const auto d3 = glm::dot(ab, bp);
+    const auto d4 = glm::dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3) return b;
+
+    const auto vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return a + ab * (d1 / (d1 - d3));
+
+    const auto cp = p - c;
+    const auto d5 = glm::dot(ab, cp);
+    const auto d6 = glm::dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6) return c;
+
+    const auto vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return a + ac * (d2 / (d2 - d6));
+
+    const auto va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    const auto denom = 1.0f / (va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+struct MeshState {
+    std::vector<std::pair<const BufferBase*, size_t>> buffers;
+    std::vector<std::pair<DrawType, ConnectivityType>> infos;
+
+    explicit MeshState(const Mesh& mesh) {
+        for (const auto& buffer : mesh.getBuffers()) {
+            buffers.emplace_back(buffer.second.get(), buffer.second->getModificationCount());
+        }
+        for (const auto& ib : mesh.getIndexBuffers()) {
+            buffers.emplace_back(ib.second.get(), ib.second->getModificationCount());
+            infos.emplace_back(ib.first.dt, ib.first.ct);
+        }
+        infos.emplace_back(mesh.getDefaultMeshInfo().dt, mesh.getDefaultMeshInfo().ct);
+    }
+    bool operator==(const MeshState& rhs) const {
+        return buffers == rhs.buffers && infos == rhs.infos;
+    }
+};
+
+struct CacheEntry {
+    MeshState state;
+    std::shared_ptr<const MeshBVH> bvh;
+};
+
+}  // namespace
+
+MeshBVH::MeshBVH(const Mesh& mesh, size_t maxLeafSize) {
+    const auto positionBuffer = mesh.findBuffer(BufferType::PositionAttrib).first;
+    if (!positionBuffer) {
+        throw Exception("Mesh has no position buffer", IVW_CONTEXT_CUSTOM("MeshBVH"));
+    }
+    if (positionBuffer->getDataFormat()->getNumericType() != NumericType::Float) {
+        throw Exception("Only floating point positions are supported",
+                        IVW_CONTEXT_CUSTOM("MeshBVH"));
+    }
+    positionBuffer->getRepresentation<BufferRAM>()->dispatch<void, dispatching::filter::Floats>(
+        [&](auto ram) {
+            const auto& data = ram->getDataContainer();
+            positions_.resize(data.size());
+            std::transform(data.begin(), data.end(), positions_.begin(),
+                           [](const auto& p) { return util::glm_convert<vec3>(p); });
+        });
+
+    const auto numVertices = static_cast<std::uint32_t>(positions_.size());
+    triangles_ = meshutil::triangles(mesh, numVertices);
+
+    const auto numTriangles = static_cast<std::uint32_t>(triangles_.size());
+    if (numTriangles == 0) return;
+
+    std::vector<Bounds> bounds(numTriangles);
+    std::vector<vec3> centroids(numTriangles);
+    items_.resize(numTriangles);
+    util::forEachRangeParallel(numTriangles, [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) {
+            for (auto v : triangles_[t]) bounds[t].extend(positions_[v]);
+            centroids[t] = 0.5f * (bounds[t].min + bounds[t].max);
+            items_[t] = static_cast<std::uint32_t>(t);
+        }
+    });
+
+    const Builder builder{bounds, centroids, items_, std::max<size_t>(1, maxLeafSize)};
+
+    // Split the upper levels one level at a time, each node using the thread pool, until the
+    // ranges are small enough to be built as separate subtrees in parallel.
+    struct Task {
+        std::uint32_t node, begin, end;
+        size_t depth;
+    };
+    const std::uint32_t subtreeSize = std::max<std::uint32_t>(numTriangles / 64, 1 << 12);
+    std::vector<Task> level{{0, 0, numTriangles, 0}};
+    std::vector<Task> subtrees;
+    std::vector<std::uint32_t> splits;
+    nodes_.resize(1);
+    while (!level.empty()) {
+        splits.resize(level.size());
+        util::forEachRangeParallel(
+            level.size(),
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    const auto& task = level[i];
+                    const auto b = builder.rangeBounds(task.begin, task.end);
+                    auto& node = nodes_[task.node];
+                    node.min = b.first.min;
+                    node.max = b.first.max;
+                    splits[i] = builder.split(task.begin, task.end, b.first, b.second, task.depth);
+                }
+            },
+            level.size());
+
+        std::vector<Task> next;
+        for (size_t i = 0; i < level.size(); ++i) {
+            const auto& task = level[i];
+            auto& node = nodes_[task.node];
+            if (splits[i] == task.begin) {
+                node.first = task.begin;
+                node.count = task.end - task.begin;
+                continue;
+            }
+            const auto left = static_cast<std::uint32_t>(nodes_.size());
+            node.first = left;
+            node.count = 0;
+            nodes_.resize(nodes_.size() + 2);
+            for (auto child : {Task{left, task.begin, splits[i], task.depth + 1},
+                               Task{left + 1, splits[i], task.end, task.depth + 1}}) {
+                (child.end - child.begin > subtreeSize ? next : subtrees).push_back(child);
+            }
+        }
+        std::swap(level, next);
+    }
+
+    std::vector<std::vector<Node>> subtreeNodes(subtrees.size());
+    util::forEachRangeParallel(
+        subtrees.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                builder.buildSubtree(subtreeNodes[i], subtrees[i].begin, subtrees[i].end,
+                                     subtrees[i].depth);
+            }
+        },
+        subtrees.size());
+
+    // Splice the subtrees into the node array, the root of each replaces its placeholder
+    for (size_t i = 0; i < subtrees.size(); ++i) {
+        auto& local = subtreeNodes[i];
+        const auto offset = static_cast<std::uint32_t>(nodes_.size()) - 1;
+        for (auto& node : local) {
+            if (!node.isLeaf()) node.first += offset;
+        }
+        nodes_[subtrees[i].node] = local.front();
+        nodes_.insert(nodes_.end(), local.begin() + 1, local.end());
+    }
+}
+
+std::shared_ptr<const MeshBVH> MeshBVH::get(const std::shared_ptr<const Mesh>& mesh) {
+    if (!mesh) return nullptr;
+
+    MeshState state(*mesh);
+    if (auto entry = std::static_pointer_cast<const CacheEntry>(
+            mesh->getDerivedData(typeid(MeshBVH)))) {
+        if (entry->state == state) return entry->bvh;
+    }
+
+    auto bvh = std::make_shared<const MeshBVH>(*mesh);
+    mesh->setDerivedData(typeid(MeshBVH), std::make_shared<CacheEntry>(CacheEntry{state, bvh}));
+    return bvh;
+}
+
+bool MeshBVH::intersect(const vec3& origin, const vec3& direction, std::uint32_t item, float tMin,
+                        float tMax, RayHit& hit) const {
+    // Möller-Trumbore
+    const auto& tri = triangles_[item];
+    const auto& a = positions_[tri[0]];
+    const auto e1 = positions_[tri[1]] - a;
+    const auto e2 = positions_[tri[2]] - a;
+    const auto p = glm::cross(direction, e2);
+    const auto det = glm::dot(e1, p);
+    if (det == 0.0f) return false;
+    const auto invDet = 1.0f / det;
+    const auto s = origin - a;
+    const auto u = glm::dot(s, p) * invDet;
+    if (u < 0.0f || u > 1.0f) return false;
+    const auto q = glm::cross(s, e1);
+    const auto v = glm::dot(direction, q) * invDet;
+    if (v < 0.0f || u + v > 1.0f) return false;
+    const auto t = glm::dot(e2, q) * invDet;
+    if (t < tMin || t > tMax) return false;
+    hit.triangle = item;
+    hit.t = t;
+    hit.barycentric = vec2{u, v};
+    return true;
+}
+
+auto MeshBVH::raycast(const vec3& origin, const vec3& direction, float tMin, float tMax) const
+    -> RayHit {
+    RayHit hit;
+    if (nodes_.empty()) return hit;
+
+    const auto inf = std::numeric_limits<float>::infinity();
+    const auto invDir = 1.0f / direction;
+    // Nodes to visit and the ray parameter where the ray enters them
+    std::array<std::pair<std::uint32_t, float>, stackSize> stack;
+    size_t size = 0;
+    const auto t0 = rayBox(origin, invDir, nodes_[0].min, nodes_[0].max, tMin, tMax);
+    if (t0 != inf) stack[size++] = {0, t0};
+    while (size > 0) {
+        const auto current = stack[--size];
+        if (current.second > tMax) continue;  // A closer hit has been found since
+        const auto& node = nodes_[current.first];
+        if (node.isLeaf()) {
+            for (auto i = node.first; i < node.first + node.count; ++i) {
+                if (intersect(origin, direction, items_[i], tMin, tMax, hit)) tMax = hit.t;
+            }
+            continue;
+        }
+        // Visit the closer child first
+        const auto l = node.first;
+        const auto r = node.first + 1;
+        const auto tl = rayBox(origin, invDir, nodes_[l].min, nodes_[l].max, tMin, tMax);
+        const auto tr = rayBox(origin, invDir, nodes_[r].min, nodes_[r].max, tMin, tMax);
+        if (tl <= tr) {
+            if (tr != inf) stack[size++] = {r, tr};
+            if (tl != inf) stack[size++] = {l, tl};
+        } else {
+            if (tl != inf) stack[size++] = {l, tl};
+            if (tr != inf) stack[size++] = {r, tr};
+        }
+    }
+    return hit;
+}
+
+auto MeshBVH::closestPoint(const vec3& point, float maxDistance) const -> ClosestPoint {
+    ClosestPoint res;
+    if (nodes_.empty()) return res;
+
+    float best2 = maxDistance < std::numeric_limits<float>::infinity()
+                      ? maxDistance * maxDistance
+                      : std::numeric_limits<float>::infinity();
+    std::array<std::uint32_t, stackSize> stack;
+    size_t size = 0;
+    stack[size++] = 0;
+    while (size > 0) {
+        const auto& node = nodes_[stack[--size]];
+        if (distance2(point, node.min, node.max) >= best2) continue;
+        if (node.isLeaf()) {
+            for (auto i = node.first; i < node.first + node.count; ++i) {
+                const auto& tri = triangles_[items_[i]];
+                const auto p = closestPointOnTriangle(point, positions_[tri[0]],
+                                                      positions_[tri[1]], positions_[tri[2]]);
+                const auto d2 = glm::dot(p - point, p - point);
+                if (d2 < best2) {
+                    best2 = d2;
+                    res.triangle = items_[i];
+                    res.point = p;
+                }
+            }
+            continue;
+        }
+        const auto l = node.first;
+        const auto r = node.first + 1;
+        const auto dl = distance2(point, nodes_[l].min, nodes_[l].max);
+        const auto dr = distance2(point, nodes_[r].min, nodes_[r].max);
+        if (dl <= dr) {
+            if (dr < best2) stack[size++] = r;
+            if (dl < best2) stack[size++] = l;
+        } else {
+            if (dl < best2) stack[size++] = l;
+            if (dr < best2) stack[size++] = r;
+        }
+    }
+    if (res) res.distance = std::sqrt(best2);
+    return res;
+}
+
+std::vector<std::uint32_t> MeshBVH::query(const vec3& min, const vec3& max) const {
+    std::vector<std::uint32_t> res;
+    if (nodes_.empty()) return res;
+
+    auto overlaps = [&](const vec3& bmin, const vec3& bmax) {
+        return glm::all(glm::lessThanEqual(bmin, max)) && glm::all(glm::lessThanEqual(min, bmax));
+    };
+    std::array<std::uint32_t, stackSize> stack;
+    size_t size = 0;
+    stack[size++] = 0;
+    while (size > 0) {
+        const auto& node = nodes_[stack[--size]];
+        if (!overlaps(node.min, node.max)) continue;
+        if (node.isLeaf()) {
+            for (auto i = node.first; i < node.first + node.count; ++i) {
+                const auto& tri = triangles_[items_[i]];
+                const auto& a = positions_[tri[0]];
+                const auto& b = positions_[tri[1]];
+                const auto& c = positions_[tri[2]];
+                if (overlaps(glm::min(a, glm::min(b, c)), glm::max(a, glm::max(b, c)))) {
+                    res.push_back(items_[i]);
+                }
+            }
+        } else {
+            stack[size++] = node.first + 1;
+            stack[size++] = node.first;
+        }
+    }
+    return res;
+}
+
+std::vector<std::uint32_t> MeshBVH::query(const std::vector<Plane>& planes) const {
+    std::vector<std::uint32_t> res;
+    if (nodes_.empty()) return res;
+
+    // -1 if the box is outside of a plane, 1 if it is inside all planes, and 0 otherwise
+    auto classify = [&](const vec3& min, const vec3& max) {
+        int result = 1;
+        for (const auto& plane : planes) {
+            const auto& n = plane.getNormal();
+            const vec3 far{n.x >= 0.0f ? max.x : min.x, n.y >= 0.0f ? max.y : min.y,
+                           n.z >= 0.0f ? max.z : min.z};
+            const vec3 near{n.x >= 0.0f ? min.x : max.x, n.y >= 0.0f ? min.y : max.y,
+                            n.z >= 0.0f ? min.z : max.z};
+            if (plane.distance(far) < 0.0f) return -1;
+            if (plane.distance(near) < 0.0f) result = 0;
+        }
+        return result;
+    };
+
+    // Is the triangle completely outside of any of the planes
+    auto outside = [&](const std::array<std::uint32_t, 3>& tri) {
+        return std::any_of(planes.begin(), planes.end(), [&](const Plane& plane) {
+            return std::none_of(tri.begin(), tri.end(),
+                                [&](std::uint32_t v) { return plane.isInside(positions_[v]); });
+        });
+    };
+
+    // A stack of nodes, and whether they are known to be inside all planes
+    std::array<std::pair<std::uint32_t, bool>, stackSize> stack;
+    size_t size = 0;
+    stack[size++] = {0, false};
+    while (size > 0) {
+        const auto current = stack[--size];
+        const auto& node = nodes_[current.first];
+        auto inside = current.second;
+        if (!inside) {
+            const auto c = classify(node.min, node.max);
+            if (c < 0) continue;
+            inside = c > 0;
+        }
+        if (node.isLeaf()) {
+            for (auto i = node.first; i < node.first + node.count; ++i) {
+                if (inside || !outside(triangles_[items_[i]])) res.push_back(items_[i]);
+            }
+        } else {
+            stack[size++] = {node.first + 1, inside};
+            stack[size++] = {node.first, inside};
+        }
+    }
+    return res;
+}
+
+size_t MeshBVH::countCrossings(const vec3& origin, const vec3& direction) const {
+    size_t count = 0;
+    const auto invDir = 1.0f / direction;
+    const auto inf = std::numeric_limits<float>::infinity();
+    std::array<std::uint32_t, stackSize> stack;
+    size_t size = 0;
+    stack[size++] = 0;
+    while (size > 0) {
+        const auto& node = nodes_[stack[--size]];
+        if (rayBox(origin, invDir, node.min, node.max, 0.0f, inf) == inf) continue;
+        if (node.isLeaf()) {
+            RayHit hit;
+            for (auto i = node.first; i < node.first + node.count; ++i) {
+                if (intersect(origin, direction, items_[i], 0.0f, inf, hit)) ++count;
+            }
+        } else {
+            stack[size++] = node.first + 1;
+            stack[size++] = node.first;
+        }
+    }
+    return count;
+}
+
+bool MeshBVH::isInside(const vec3& point) const {
+    if (nodes_.empty()) return false;
+    // Directions that are unlikely to be aligned with any edges of the mesh
+    const std::array<vec3, 3> directions{{glm::normalize(vec3{0.5718f, 0.3217f, 0.7543f}),
+                                          glm::normalize(vec3{-0.6329f, 0.7012f, -0.3280f}),
+                                          glm::normalize(vec3{0.1976f, -0.8513f, 0.4860f})}};
+    int votes = 0;
+    for (const auto& dir : directions) {
+        if (countCrossings(point, dir) % 2 == 1) ++votes;
+    }
+    return votes >= 2;
+}
+
+std::pair<vec3, vec3> MeshBVH::getBounds() const {
+    if (nodes_.empty()) return {vec3{0.0f}, vec3{0.0f}};
+    return {nodes_[0].min, nodes_[0].max};
+}
+
+const std::array<std::uint32_t, 3>& MeshBVH::getTriangle(std::uint32_t triangle) const {
+    return triangles_[triangle];
+}
+
+size_t MeshBVH::getNumberOfTriangles() const { return triangles_.size(); }
+
+auto MeshBVH::getNodes() const -> const std::vector<Node>& { return nodes_; }
+
+}  // namespace inviwo
@@ -0,0 +1,731 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#include <modules/base/algorithm/mesh/meshplaneclipper.h>
+#include <modules/base/algorithm/meshutils.h>
+#include <inviwo/core/datastructures/geometry/basicmesh.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/stdextensions.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <unordered_map>
+
+namespace inviwo {
+
+namespace {
+
+constexpr std::uint32_t noIndex = std::numeric_limits<std::uint32_t>::max();
+
+/*
+ * Identifies the vertices created by the clipping, vertices with equal keys are welded.
+ *   Unique:   not shared with any other vertex
+ *   Original: the mesh vertex a
+ *   Edge:     the point on the mesh edge (a, b), a < b, on plane c
+ *   Line:     the point inside triangle a where the line of intersection of plane b < c hits it
+ *   Center:   the center of cap loop b on plane a
+ */
+enum class KeyType : std::uint32_t { Unique, Original, Edge, Line, Center };
+using VertexKey = std::tuple<std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t>;
+
+VertexKey makeKey(KeyType type, std::uint32_t a = 0, std::uint32_t b = 0, std::uint32_t c = 0) {
+    return VertexKey{static_cast<std::uint32_t>(type), a, b, c};
+}
+KeyType keyType(const VertexKey& key) { return static_cast<KeyType>(std::get<0>(key)); }
+
+struct ClipVertex {
+    vec3 pos;
+    vec3 tex;
+    vec4 color;
+    VertexKey key;
+    // The mesh edge (a, b) the vertex lies on, a == b for mesh vertices and noIndex for vertices
+    // inside a triangle.
+    std::uint32_t a;
+    std::uint32_t b;
+    // The edge to the next vertex of the polygon lies on this plane inside this triangle, or
+    // noIndex if it is a part of a mesh edge or inside a cap.
+    std::uint32_t edgePlane;
+    std::uint32_t edgeTriangle;
+};
+
+// Part of the intersection of the mesh with a plane, oriented as the boundary of the cap.
+struct CapSegment {
+    ClipVertex from;
+    ClipVertex to;
+};
+
+// Output of one range of triangles
+struct Arena {
+    size_t kept = 0;
+    size_t clipped = 0;
+    // Vertices created by the clipping
+    std::vector<ClipVertex> vertices;
+    // Triangles of clipped polygons, values below the number of mesh vertices refer to mesh
+    // vertices, the rest to vertices[value - number of mesh vertices]
+    std::vector<std::uint32_t> indices;
+    // Cap segments for each plane
+    std::vector<std::vector<CapSegment>> segments;
+
+    // Scratch space
+    std::vector<ClipVertex> polygon;
+    std::vector<ClipVertex> tmp;
+};
+
+enum class TriangleStatus { Inside, Outside, Clip };
+
+// The buffers of the mesh and their modification counts, used to detect changes
+std::vector<std::pair<const BufferBase*, size_t>> bufferState(const Mesh& mesh) {
+    std::vector<std::pair<const BufferBase*, size_t>> state;
+    for (const auto& buffer : mesh.getBuffers()) {
+        state.emplace_back(buffer.second.get(), buffer.second->getModificationCount());
+    }
+    for (const auto& ib : mesh.getIndexBuffers()) {
+        state.emplace_back(ib.second.get(), ib.second->getModificationCount());
+    }
+    return state;
+}
+
+}  // namespace
+
+struct MeshPlaneClipper::MeshData {
+    std::weak_ptr<const Mesh> mesh;
+    const std::vector<vec3>* positions = nullptr;
+    const std::vector<vec3>* texCoords = nullptr;
+    const std::vector<vec4>* colors = nullptr;
+    std::vector<std::pair<const BufferBase*, size_t>> buffers;
+
+    std::vector<std::array<std::uint32_t, 3>> triangles;
+    // Vertex to triangle adjacency in compressed row format
+    std::vector<std::uint32_t> vertexOffsets;
+    std::vector<std::uint32_t> vertexTriangles;
+
+    std::uint32_t numVertices() const { return static_cast<std::uint32_t>(positions->size()); }
+    bool referenced(std::uint32_t v) const { return vertexOffsets[v + 1] > vertexOffsets[v]; }
+};
+
+struct MeshPlaneClipper::PlaneState {
+    vec3 normal{0.0f};
+    float offset = 0.0f;
+    // dot(normal, position) for each vertex, a vertex is inside if it is larger or equal to offset
+    std::vector<float> proj;
+    // number of vertices outside the plane for each triangle
+    std::vector<std::uint8_t> outside;
+
+    float distance(std::uint32_t v) const { return proj[v] - offset; }
+    float distance(const vec3& pos) const { return glm::dot(normal, pos) - offset; }
+};
+
+MeshPlaneClipper::MeshPlaneClipper() = default;
+MeshPlaneClipper::~MeshPlaneClipper() = default;
+
+void MeshPlaneClipper::clear() {
+    mesh_.reset();
+    planes_.clear();
+}
+
+auto MeshPlaneClipper::getStats() const -> const Stats& { return stats_; }
+
+void MeshPlaneClipper::updateMeshData(std::shared_ptr<const Mesh> mesh) {
+    auto data = std::make_unique<MeshData>();
+    data->mesh = mesh;
+
+    if (auto simple = dynamic_cast<const SimpleMesh*>(mesh.get())) {
+        data->positions = &simple->getVertexList()->getRAMRepresentation()->getDataContainer();
+        data->texCoords = &simple->getTexCoordList()->getRAMRepresentation()->getDataContainer();
+        data->colors = &simple->getColorList()->getRAMRepresentation()->getDataContainer();
+    } else if (auto basic = dynamic_cast<const BasicMesh*>(mesh.get())) {
+        data->positions = &basic->getVertices()->getRAMRepresentation()->getDataContainer();
+        data->texCoords = &basic->getTexCoords()->getRAMRepresentation()->getDataContainer();
+        data->colors = &basic->getColors()->getRAMRepresentation()->getDataContainer();
+    } else {
+        throw Exception("Unsupported mesh type, only simple and basic meshes are supported",
+                        IVW_CONTEXT_CUSTOM("MeshPlaneClipper"));
+    }
+    data->buffers = bufferState(*mesh);
+
+    if (data->texCoords->size() != data->positions->size() ||
+        data->colors->size() != data->positions->size()) {
+        throw Exception("Mesh buffers have different sizes",
+                        IVW_CONTEXT_CUSTOM("MeshPlaneClipper"));
+    }
+
+    const auto numVertices = data->numVertices();
+    data->triangles = meshutil::triangles(*mesh, numVertices);
+    const auto& triangles = data->triangles;
+
+    // Vertex to triangle adjacency, used to update the triangle classification when only a few
+    // vertices change sides.
+    data->vertexOffsets.assign(numVertices + 1, 0);
+    for (const auto& tri : triangles) {
+        for (auto v : tri) ++data->vertexOffsets[v + 1];
+    }
+    std::partial_sum(data->vertexOffsets.begin(), data->vertexOffsets.end(),
+                     data->vertexOffsets.begin());
+    data->vertexTriangles.resize(data->vertexOffsets.back());
+    {
+        auto pos = data->vertexOffsets;
+        for (std::uint32_t t = 0; t < static_cast<std::uint32_t>(triangles.size()); ++t) {
+            for (auto v : triangles[t]) data->vertexTriangles[pos[v]++] = t;
+        }
+    }
+
+    mesh_ = std::move(data);
+    planes_.clear();
+}
+
+void MeshPlaneClipper::updatePlaneState(PlaneState& state, const Plane& plane) {
+    const auto normal = glm::normalize(plane.getNormal());
+    const auto offset = glm::dot(normal, plane.getPoint());
+    const auto& positions = *mesh_->positions;
+    const auto& triangles = mesh_->triangles;
+    const auto numVertices = mesh_->numVertices();
+
+    auto countTriangles = [&]() {
+        state.outside.resize(triangles.size());
+        util::forEachRangeParallel(triangles.size(), [&](size_t begin, size_t end) {
+            for (size_t t = begin; t < end; ++t) {
+                std::uint8_t count = 0;
+                for (auto v : triangles[t]) count += state.proj[v] < state.offset ? 1 : 0;
+                state.outside[t] = count;
+            }
+        });
+    };
+
+    if (state.proj.size() != numVertices || state.normal != normal) {
+        // New plane orientation, classify everything
+        state.normal = normal;
+        state.offset = offset;
+        state.proj.resize(numVertices);
+        util::forEachRangeParallel(numVertices, [&](size_t begin, size_t end) {
+            for (size_t v = begin; v < end; ++v) state.proj[v] = glm::dot(normal, positions[v]);
+        });
+        countTriangles();
+        stats_.reclassifiedVertices += numVertices;
+        return;
+    }
+    if (state.offset == offset) return;
+
+    // Only the offset changed, find the vertices in between the old and new plane position
+    const auto lower = std::min(state.offset, offset);
+    const auto upper = std::max(state.offset, offset);
+    const size_t jobs = std::max<size_t>(1, std::min<size_t>(numVertices / 65536, 256));
+    std::vector<std::vector<std::uint32_t>> changed(jobs);
+    util::forEachRangeParallel(
+        jobs,
+        [&](size_t jobBegin, size_t jobEnd) {
+            for (size_t job = jobBegin; job < jobEnd; ++job) {
+                const auto begin = static_cast<std::uint32_t>(numVertices * job / jobs);
+                const auto end = static_cast<std::uint32_t>(numVertices * (job + 1) / jobs);
+                for (auto v = begin; v < end; ++v) {
+                    if (state.proj[v] >= lower && state.proj[v] < upper) changed[job].push_back(v);
+                }
+            }
+        },
+        jobs);
+
+    const auto movedOutside = offset > state.offset;
+    state.offset = offset;
+    const auto numChanged = std::accumulate(
+        changed.begin(), changed.end(), size_t{0},
+        [](size_t sum, const std::vector<std::uint32_t>& c) { return sum + c.size(); });
+    stats_.reclassifiedVertices += numChanged;
+
+    if (numChanged > numVertices / 8) {
+        countTriangles();
+    } else {
+        for (const auto& vertices : changed) {
+            for (auto v : vertices) {
+                for (auto i = mesh_->vertexOffsets[v]; i < mesh_->vertexOffsets[v + 1]; ++i) {
+                    auto& count = state.outside[mesh_->vertexTriangles[i]];
+                    count = static_cast<std::uint8_t>(movedOutside ? count + 1 : count - 1);
+                }
+            }
+        }
+    }
+}
+
+std::shared_ptr<SimpleMesh> MeshPlaneClipper::clip(std::shared_ptr<const Mesh> mesh,
+                                                   const std::vector<Plane>& planes,
+                                                   bool capHoles) {
+    if (!mesh) throw Exception("No mesh to clip", IVW_CONTEXT_CUSTOM("MeshPlaneClipper"));
+
+    // Reuse the cached data if it is the same mesh with the same unmodified buffers
+    if (!mesh_ || mesh_->mesh.lock() != mesh || mesh_->buffers != bufferState(*mesh)) {
+        updateMeshData(mesh);
+    }
+
+    stats_ = Stats{};
+    planes_.resize(planes.size());
+    for (size_t p = 0; p < planes.size(); ++p) {
+        if (!planes_[p]) planes_[p] = std::make_unique<PlaneState>();
+        updatePlaneState(*planes_[p], planes[p]);
+    }
+
+    const auto& positions = *mesh_->positions;
+    const auto& texCoords = *mesh_->texCoords;
+    const auto& colors = *mesh_->colors;
+    const auto& triangles = mesh_->triangles;
+    const auto numVertices = mesh_->numVertices();
+    const auto numPlanes = static_cast<std::uint32_t>(planes.size());
+
+    auto triangleStatus = [&](size_t t) {
+        auto status = TriangleStatus::Inside;
+        for (const auto& plane : planes_) {
+            if (plane->outside[t] == 3) return TriangleStatus::Outside;
+            if (plane->outside[t] > 0) status = TriangleStatus::Clip;
+        }
+        return status;
+    };
+
+    auto meshVertex = [&](std::uint32_t v) {
+        return ClipVertex{positions[v], texCoords[v], colors[v], makeKey(KeyType::Original, v),
+                          v, v, noIndex, noIndex};
+    };
+
+    auto distance = [&](const ClipVertex& v, std::uint32_t p) {
+        return keyType(v.key) == KeyType::Original ? planes_[p]->distance(v.a)
+                                                   : planes_[p]->distance(v.pos);
+    };
+
+    // Intersection of the polygon edge from 'cur' to 'next' with plane p
+    auto intersect = [&](const ClipVertex& cur, const ClipVertex& next, float dc, float dn,
+                         std::uint32_t p) {
+        // Does the edge lie on a mesh edge? then interpolate along the whole mesh edge such that
+        // the neighboring triangle gets exactly the same vertex.
+        if (cur.a != noIndex && next.a != noIndex) {
+            std::array<std::uint32_t, 4> ends{{cur.a, cur.b, next.a, next.b}};
+            std::sort(ends.begin(), ends.end());
+            const auto last = std::unique(ends.begin(), ends.end());
+            if (last - ends.begin() == 2) {
+                const auto i = ends[0];
+                const auto j = ends[1];
+                const auto di = planes_[p]->distance(i);
+                const auto dj = planes_[p]->distance(j);
+                const auto t = di / (di - dj);
+                return ClipVertex{glm::mix(positions[i], positions[j], t),
+                                  glm::mix(texCoords[i], texCoords[j], t),
+                                  glm::mix(colors[i], colors[j], t),
+                                  makeKey(KeyType::Edge, i, j, p),
+                                  i,
+                                  j,
+                                  noIndex,
+                                  noIndex};
+            }
+        }
+        const auto t = dc / (dc - dn);
+        const auto key = cur.edgePlane != noIndex && cur.edgeTriangle != noIndex
+                             ? makeKey(KeyType::Line, cur.edgeTriangle, std::min(p, cur.edgePlane),
+                                       std::max(p, cur.edgePlane))
+                             : makeKey(KeyType::Unique);
+        return ClipVertex{glm::mix(cur.pos, next.pos, t),
+                          glm::mix(cur.tex, next.tex, t),
+                          glm::mix(cur.color, next.color, t),
+                          key,
+                          noIndex,
+                          noIndex,
+                          noIndex,
+                          noIndex};
+    };
+
+    // Sutherland-Hodgman clipping of 'polygon' against plane p, the result is written to 'out'.
+    // The new edge along the plane is tagged with the plane and 'triangle'.
+    auto clipPolygon = [&](const std::vector<ClipVertex>& polygon, std::vector<ClipVertex>& out,
+                           std::uint32_t p, std::uint32_t triangle) {
+        out.clear();
+        const auto n = polygon.size();
+        for (size_t i = 0; i < n; ++i) {
+            const auto& cur = polygon[i];
+            const auto& next = polygon[(i + 1) % n];
+            const auto dc = distance(cur, p);
+            const auto dn = distance(next, p);
+            if (dc >= 0.0f) {
+                out.push_back(cur);
+                if (dn < 0.0f) {  // Leaving
+                    if (dc > 0.0f) out.push_back(intersect(cur, next, dc, dn, p));
+                    out.back().edgePlane = p;
+                    out.back().edgeTriangle = triangle;
+                }
+            } else if (dn > 0.0f) {  // Entering
+                auto v = intersect(cur, next, dc, dn, p);
+                v.edgePlane = cur.edgePlane;
+                v.edgeTriangle = cur.edgeTriangle;
+                out.push_back(v);
+            }
+        }
+    };
+
+    // Triangulate the clipped polygon as a fan and add it to the arena
+    auto emitPolygon = [&](Arena& arena, const std::vector<ClipVertex>& polygon) {
+        if (polygon.size() < 3) return;
+        auto ref = [&](const ClipVertex& v) {
+            if (keyType(v.key) == KeyType::Original) return v.a;
+            arena.vertices.push_back(v);
+            return static_cast<std::uint32_t>(numVertices + arena.vertices.size() - 1);
+        };
+        const auto first = ref(polygon[0]);
+        auto prev = ref(polygon[1]);
+        for (size_t i = 2; i < polygon.size(); ++i) {
+            const auto curr = ref(polygon[i]);
+            arena.indices.insert(arena.indices.end(), {first, prev, curr});
+            prev = curr;
+        }
+    };
+
+    // Clip the polygon against all planes but 'skip' and add it to the arena. New edges along
+    // the planes are tagged with 'triangle', noIndex for caps.
+    auto clipAll = [&](Arena& arena, std::uint32_t triangle, std::uint32_t skip) {
+        for (std::uint32_t p = 0; p < numPlanes && arena.polygon.size() >= 3; ++p) {
+            if (p == skip) continue;
+            clipPolygon(arena.polygon, arena.tmp, p, triangle);
+            std::swap(arena.polygon, arena.tmp);
+        }
+        emitPolygon(arena, arena.polygon);
+    };
+
+    // Cap segment of triangle t along plane p, from where the boundary enters the inside to
+    // where it leaves, i.e. opposite to the clipped triangle such that the cap gets the same
+    // orientation as the mesh.
+    auto capSegment = [&](Arena& arena, std::uint32_t t, std::uint32_t p) {
+        auto enter = meshVertex(triangles[t][0]);
+        auto leave = enter;
+        bool hasEnter = false, hasLeave = false;
+        for (size_t i = 0; i < 3; ++i) {
+            const auto cur = meshVertex(triangles[t][i]);
+            const auto next = meshVertex(triangles[t][(i + 1) % 3]);
+            const auto dc = distance(cur, p);
+            const auto dn = distance(next, p);
+            if (dc >= 0.0f && dn < 0.0f) {
+                leave = dc > 0.0f ? intersect(cur, next, dc, dn, p) : cur;
+                hasLeave = true;
+            } else if (dc < 0.0f && dn >= 0.0f) {
+                enter = dn > 0.0f ? intersect(cur, next, dc, dn, p) : next;
+                hasEnter = true;
+            }
+        }
+        if (hasEnter && hasLeave && enter.key != leave.key) {
+            enter.edgePlane = p;
+            enter.edgeTriangle = t;
+            arena.segments[p].push_back(CapSegment{enter, leave});
+        }
+    };
+
+    // Clip the triangles in parallel ranges
+    const auto numTriangles = triangles.size();
+    const size_t jobs = std::max<size_t>(1, std::min<size_t>(numTriangles / 16384, 256));
+    std::vector<Arena> arenas(jobs);
+    util::forEachRangeParallel(
+        jobs,
+        [&](size_t jobBegin, size_t jobEnd) {
+            for (size_t job = jobBegin; job < jobEnd; ++job) {
+                auto& arena = arenas[job];
+                arena.segments.resize(numPlanes);
+                const auto begin = numTriangles * job / jobs;
+                const auto end = numTriangles * (job + 1) / jobs;
+                for (auto t = begin; t < end; ++t) {
+                    const auto tri = static_cast<std::uint32_t>(t);
+                    if (capHoles) {
+                        for (std::uint32_t p = 0; p < numPlanes; ++p) {
+                            const auto outside = planes_[p]->outside[t];
+                            if (outside > 0 && outside < 3) capSegment(arena, tri, p);
+                        }
+                    }
+                    switch (triangleStatus(t)) {
+                        case TriangleStatus::Inside:
+                            ++arena.kept;
+                            break;
+                        case TriangleStatus::Outside:
+                            break;
+                        case TriangleStatus::Clip:
+                            ++arena.clipped;
+                            arena.polygon.clear();
+                            for (auto v : triangles[t]) arena.polygon.push_back(meshVertex(v));
+                            clipAll(arena, tri, noIndex);
+                            break;
+                    }
+                }
+            }
+        },
+        jobs);
+
+    // Connect the cap segments into closed loops and fill them with triangle fans around the
+    // centroid, which are then clipped against the other planes.
+    Arena caps;
+    if (capHoles) {
+        std::vector<CapSegment> segments;
+        std::unordered_map<VertexKey, size_t> startOf;
+        std::vector<char> visited;
+        std::vector<size_t> loop;
+        std::vector<vec2> uv;
+        std::vector<float> weights;
+
+        for (std::uint32_t p = 0; p < numPlanes; ++p) {
+            segments.clear();
+            for (auto& arena : arenas) {
+                segments.insert(segments.end(), arena.segments[p].begin(),
+                                arena.segments[p].end());
+            }
+            startOf.clear();
+            for (size_t i = 0; i < segments.size(); ++i) startOf.emplace(segments[i].from.key, i);
+            visited.assign(segments.size(), 0);
+
+            const auto& n = planes_[p]->normal;
+            const auto uAxis = glm::normalize(
+                std::abs(n.x) < 0.9f ? glm::cross(n, vec3(1, 0, 0)) : glm::cross(n, vec3(0, 1, 0)));
+            const auto vAxis = glm::cross(n, uAxis);
+
+            std::uint32_t numLoops = 0;
+            for (size_t s = 0; s < segments.size(); ++s) {
+                if (visited[s]) continue;
+                loop.clear();
+                bool closed = false;
+                for (size_t cur = s;;) {
+                    visited[cur] = 1;
+                    loop.push_back(cur);
+                    auto it = startOf.find(segments[cur].to.key);
+                    if (it == startOf.end()) break;  // Open boundary, can't cap
+                    if (it->second == s) {
+                        closed = true;
+                        break;
+                    }
+                    if (visited[it->second]) break;
+                    cur = it->second;
+                }
+                if (!closed || loop.size() < 3) continue;
+
+                // Area weighted centroid
+                const auto& o = segments[loop[0]].from.pos;
+                vec3 centroid{0.0f};
+                float area = 0.0f;
+                for (auto i : loop) {
+                    const auto& a = segments[i].from.pos;
+                    const auto& b = segments[i].to.pos;
+                    const auto w = 0.5f * glm::dot(glm::cross(a - o, b - o), n);
+                    centroid += w * (o + a + b) / 3.0f;
+                    area += w;
+                }
+                if (std::abs(area) > std::numeric_limits<float>::epsilon()) {
+                    centroid /= area;
+                } else {
+                    centroid = vec3{0.0f};
+                    for (auto i : loop) centroid += segments[i].from.pos;
+                    centroid /= static_cast<float>(loop.size());
+                }
+                centroid -= n * planes_[p]->distance(centroid);
+
+                // Interpolate texture coordinates and colors with mean value coordinates
+                // (Floater, Hormann) in the plane
+                const vec2 c2{glm::dot(uAxis, centroid), glm::dot(vAxis, centroid)};
+                uv.clear();
+                for (auto i : loop) {
+                    const auto& pos = segments[i].from.pos;
+                    uv.push_back(vec2{glm::dot(uAxis, pos), glm::dot(vAxis, pos)} - c2);
+                }
+                const auto m = uv.size();
+                weights.assign(m, 0.0f);
+                float wsum = 0.0f;
+                for (size_t i = 0; i < m; ++i) {
+                    const auto& prev = uv[(i + m - 1) % m];
+                    const auto& cur = uv[i];
+                    const auto& next = uv[(i + 1) % m];
+                    const auto r = glm::length(cur);
+                    if (r < std::numeric_limits<float>::epsilon()) {
+                        std::fill(weights.begin(), weights.end(), 0.0f);
+                        weights[i] = wsum = 1.0f;
+                        break;
+                    }
+                    auto tanHalf = [](const vec2& a, const vec2& b) {
+                        const auto cross = a.x * b.y - a.y * b.x;
+                        const auto len = glm::length(a) * glm::length(b);
+                        return std::abs(cross) > 0.0f ? (len - glm::dot(a, b)) / cross : 0.0f;
+                    };
+                    weights[i] = (tanHalf(prev, cur) + tanHalf(cur, next)) / r;
+                    wsum += weights[i];
+                }
+                if (std::abs(wsum) < std::numeric_limits<float>::epsilon()) {
+                    std::fill(weights.begin(), weights.end(), 1.0f);
+                    wsum = static_cast<float>(m);
+                }
+                ClipVertex center{centroid,
+                                  vec3{0.0f},
+                                  vec4{0.0f},
+                                  makeKey(KeyType::Center, p, numLoops++),
+                                  noIndex,
+                                  noIndex,
+                                  noIndex,
+                                  noIndex};
+                for (size_t i = 0; i < m; ++i) {
+                    center.tex += segments[loop[i]].from.tex * (weights[i] / wsum);
+                    center.color += segments[loop[i]].from.color * (weights[i] / wsum);
+                }
+
+                for (auto i : loop) {
+                    caps.polygon.clear();
+                    caps.polygon.push_back(center);
+                    caps.polygon.push_back(segments[i].from);
+                    caps.polygon.push_back(segments[i].to);
+                    caps.polygon[2].edgePlane = noIndex;
+                    const auto before = caps.indices.size();
+                    clipAll(caps, noIndex, p);
+                    stats_.capTriangles += (caps.indices.size() - before) / 3;
+                }
+            }
+        }
+    }
+
+    // Map used mesh vertices to output vertices, a mesh vertex is used if it belongs to a
+    // triangle and is inside all the planes.
+    std::vector<std::uint32_t> vertexMap(numVertices, noIndex);
+    std::uint32_t numUsed = 0;
+    {
+        const size_t vjobs = std::max<size_t>(1, std::min<size_t>(numVertices / 65536, 256));
+        std::vector<std::uint32_t> counts(vjobs + 1, 0);
+        auto forEachVertexRange = [&](auto func) {
+            util::forEachRangeParallel(
+                vjobs,
+                [&](size_t jobBegin, size_t jobEnd) {
+                    for (size_t job = jobBegin; job < jobEnd; ++job) {
+                        func(job, static_cast<std::uint32_t>(numVertices * job / vjobs),
+                             static_cast<std::uint32_t>(numVertices * (job + 1) / vjobs));
+                    }
+                },
+                vjobs);
+        };
+        auto used = [&](std::uint32_t v) {
+            if (!mesh_->referenced(v)) return false;
+            for (const auto& plane : planes_) {
+                if (plane->distance(v) < 0.0f) return false;
+            }
+            return true;
+        };
+        forEachVertexRange([&](size_t job, std::uint32_t begin, std::uint32_t end) {
+            for (auto v = begin; v < end; ++v) counts[job + 1] += used(v) ? 1 : 0;
+        });
+        std::partial_sum(counts.begin(), counts.end(), counts.begin());
+        forEachVertexRange([&](size_t job, std::uint32_t begin, std::uint32_t end) {
+            auto next = counts[job];
+            for (auto v = begin; v < end; ++v) {
+                if (used(v)) vertexMap[v] = next++;
+            }
+        });
+        numUsed = counts.back();
+    }
+
+    // Weld the new vertices
+    arenas.push_back(std::move(caps));
+    std::vector<std::vector<std::uint32_t>> localMaps(arenas.size());
+    std::vector<const ClipVertex*> newVertices;
+    {
+        std::unordered_map<VertexKey, std::uint32_t> welded;
+        for (size_t i = 0; i < arenas.size(); ++i) {
+            for (const auto& v : arenas[i].vertices) {
+                auto index = static_cast<std::uint32_t>(numUsed + newVertices.size());
+                if (keyType(v.key) != KeyType::Unique) {
+                    auto res = welded.emplace(v.key, index);
+                    if (!res.second) {
+                        localMaps[i].push_back(res.first->second);
+                        continue;
+                    }
+                }
+                newVertices.push_back(&v);
+                localMaps[i].push_back(index);
+            }
+        }
+    }
+
+    // Assemble the output mesh
+    auto result = std::make_shared<SimpleMesh>(DrawType::Triangles, ConnectivityType::None);
+    result->setModelMatrix(mesh->getModelMatrix());
+    result->setWorldMatrix(mesh->getWorldMatrix());
+    result->setIndicesInfo(DrawType::Triangles, ConnectivityType::None);
+
+    auto& outPositions = static_cast<Buffer<vec3>*>(result->getBuffer(0))
+                             ->getEditableRAMRepresentation()
+                             ->getDataContainer();
+    auto& outTexCoords = static_cast<Buffer<vec3>*>(result->getBuffer(1))
+                             ->getEditableRAMRepresentation()
+                             ->getDataContainer();
+    auto& outColors = static_cast<Buffer<vec4>*>(result->getBuffer(2))
+                          ->getEditableRAMRepresentation()
+                          ->getDataContainer();
+    auto& outIndices = result->getIndices(0)->getEditableRAMRepresentation()->getDataContainer();
+
+    const auto numOut = numUsed + newVertices.size();
+    outPositions.resize(numOut);
+    outTexCoords.resize(numOut);
+    outColors.resize(numOut);
+    util::forEachRangeParallel(numVertices, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+            if (vertexMap[v] == noIndex) continue;
+            outPositions[vertexMap[v]] = positions[v];
+            outTexCoords[vertexMap[v]] = texCoords[v];
+            outColors[vertexMap[v]] = colors[v];
+        }
+    });
+    for (size_t i = 0; i < newVertices.size(); ++i) {
+        outPositions[numUsed + i] = newVertices[i]->pos;
+        outTexCoords[numUsed + i] = newVertices[i]->tex;
+        outColors[numUsed + i] = newVertices[i]->color;
+    }
+
+    std::vector<size_t> indexOffsets(arenas.size() + 1, 0);
+    for (size_t i = 0; i < arenas.size(); ++i) {
+        indexOffsets[i + 1] = indexOffsets[i] + 3 * arenas[i].kept + arenas[i].indices.size();
+        stats_.keptTriangles += arenas[i].kept;
+        stats_.clippedTriangles += arenas[i].clipped;
+    }
+    outIndices.resize(indexOffsets.back());
+    util::forEachRangeParallel(
+        arenas.size(),
+        [&](size_t jobBegin, size_t jobEnd) {
+            for (size_t job = jobBegin; job < jobEnd; ++job) {
+                auto out = outIndices.begin() + indexOffsets[job];
+                if (job < jobs) {
+                    const auto begin = numTriangles * job / jobs;
+                    const auto end = numTriangles * (job + 1) / jobs;
+                    for (auto t = begin; t < end; ++t) {
+                        if (triangleStatus(t) != TriangleStatus::Inside) continue;
+                        for (auto v : triangles[t]) *out++ = vertexMap[v];
+                    }
+                }
+                for (auto i : arenas[job].indices) {
+                    *out++ = i < numVertices ? vertexMap[i] : localMaps[job][i - numVertices];
+                }
+            }
+        },
+        arenas.size());
+
+    return result;
+}
+
+}  // namespace inviwo
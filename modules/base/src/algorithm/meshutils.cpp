@@ -32,12 +32,15 @@
 #include <inviwo/core/datastructures/geometry/mesh.h>
 #include <inviwo/core/datastructures/geometry/typedmesh.h>
 #include <inviwo/core/datastructures/geometry/basicmesh.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
 
 #ifdef WIN32
 #define _USE_MATH_DEFINES
 #endif
 #include <math.h>
+#include <algorithm>
 #include <memory>
+#include <numeric>
 
 namespace inviwo {
 
@@ -760,6 +763,57 @@ std::shared_ptr<ColoredMesh> cameraFrustum(const Camera& camera, vec4 color,
 }
 //! [Using Colored Mesh]
 
+std::vector<std::array<std::uint32_t, 3>> triangles(const Mesh& mesh, std::uint32_t numVertices) {
+    std::vector<std::array<std::uint32_t, 3>> triangles;
+    auto addTriangle = [&](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+        if (a == b || b == c || c == a) return;  // Skip degenerate (strip) triangles
+        triangles.push_back({{a, b, c}});
+    };
+    auto addTriangles = [&](Mesh::MeshInfo info, const std::vector<std::uint32_t>& indices) {
+        if (info.dt != DrawType::Triangles || indices.size() < 3) return;
+        switch (info.ct) {
+            case ConnectivityType::None:
+                for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+                    addTriangle(indices[i], indices[i + 1], indices[i + 2]);
+                }
+                break;
+            case ConnectivityType::Strip:
+                for (size_t i = 0; i + 2 < indices.size(); ++i) {
+                    if (i & 1) {
+                        addTriangle(indices[i], indices[i + 2], indices[i + 1]);
+                    } else {
+                        addTriangle(indices[i], indices[i + 1], indices[i + 2]);
+                    }
+                }
+                break;
+            case ConnectivityType::Fan:
+                for (size_t i = 1; i + 1 < indices.size(); ++i) {
+                    addTriangle(indices[0], indices[i], indices[i + 1]);
+                }
+                break;
+            default:
+                break;
+        }
+    };
+
+    if (mesh.getIndexBuffers().empty()) {
+        std::vector<std::uint32_t> indices(numVertices);
+        std::iota(indices.begin(), indices.end(), 0u);
+        addTriangles(mesh.getDefaultMeshInfo(), indices);
+    } else {
+        for (const auto& ib : mesh.getIndexBuffers()) {
+            const auto& indices = ib.second->getRAMRepresentation()->getDataContainer();
+            if (std::any_of(indices.begin(), indices.end(),
+                            [&](std::uint32_t i) { return i >= numVertices; })) {
+                throw Exception("Mesh index out of range",
+                                IVW_CONTEXT_CUSTOM("meshutil::triangles"));
+            }
+            addTriangles(ib.first, indices);
+        }
+    }
+    return triangles;
+}
+
 }  // namespace meshutil
 
 }  // namespace inviwo
@@ -99,6 +99,8 @@
 #include <modules/base/properties/sequencetimerproperty.h>
 
 // Io
+#include <modules/base/io/binarymeshreader.h>
+#include <modules/base/io/binarymeshwriter.h>
 #include <modules/base/io/binarystlwriter.h>
 #include <modules/base/io/datvolumesequencereader.h>
 #include <modules/base/io/datvolumewriter.h>
@@ -206,6 +208,7 @@ BaseModule::BaseModule(InviwoApplication* app) : InviwoModule(app, "Base") {
     registerProperty<Gaussian2DProperty>();
 
     // Register Data readers
+    registerDataReader(util::make_unique<BinaryMeshReader>());
     registerDataReader(util::make_unique<DatVolumeSequenceReader>());
     registerDataReader(util::make_unique<IvfVolumeReader>());
     registerDataReader(util::make_unique<IvfSequenceVolumeReader>());
@@ -214,6 +217,7 @@ BaseModule::BaseModule(InviwoApplication* app) : InviwoModule(app, "Base") {
     registerDataWriter(util::make_unique<IvfVolumeWriter>());
     registerDataWriter(util::make_unique<StlWriter>());
     registerDataWriter(util::make_unique<BinarySTLWriter>());
+    registerDataWriter(util::make_unique<BinaryMeshWriter>());
     registerDataWriter(util::make_unique<WaveFrontWriter>());
 
     util::for_each_type<OrdinalPropertyAnimator::Types>{}(RegHelper{}, *this);
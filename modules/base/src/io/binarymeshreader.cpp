@@ -0,0 +1,190 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/io/binarymeshreader.h>
+#include <modules/base/io/binarymeshwriter.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/formats.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+
+#include <fstream>
+#include <limits>
+#include <type_traits>
+
+namespace inviwo {
+
+namespace {
+
+// The number of bytes left in the stream. Sizes read from the stream are checked against it
+// before allocating anything, a corrupt size should not end up as a huge allocation.
+size_t remaining(std::istream& is) {
+    const auto pos = is.tellg();
+    if (pos < 0) return std::numeric_limits<size_t>::max();
+    is.seekg(0, std::ios_base::end);
+    const auto end = is.tellg();
+    is.seekg(pos);
+    return end > pos ? static_cast<size_t>(end - pos) : 0;
+}
+
+template <typename T>
+T read(std::istream& is) {
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types");
+    T value;
+    if (!is.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+        throw DataReaderException("Unexpected end of mesh data", IvwContextCustom("BinaryMesh"));
+    }
+    return value;
+}
+
+std::string readString(std::istream& is) {
+    const auto size = read<std::uint32_t>(is);
+    if (size > remaining(is)) {
+        throw DataReaderException("Invalid string size in mesh data: " + toString(size),
+                                  IvwContextCustom("BinaryMesh"));
+    }
+    std::string str(size, '\0');
+    if (!is.read(&str[0], str.size())) {
+        throw DataReaderException("Unexpected end of mesh data", IvwContextCustom("BinaryMesh"));
+    }
+    return str;
+}
+
+mat4 readMatrix(std::istream& is) {
+    mat4 m;
+    if (!is.read(reinterpret_cast<char*>(glm::value_ptr(m)), sizeof(float) * 16)) {
+        throw DataReaderException("Unexpected end of mesh data", IvwContextCustom("BinaryMesh"));
+    }
+    return m;
+}
+
+template <typename E>
+E readEnum(std::istream& is, E end) {
+    const auto value = read<std::int32_t>(is);
+    if (value < 0 || value >= static_cast<std::int32_t>(end)) {
+        throw DataReaderException("Invalid enum value in mesh data: " + toString(value),
+                                  IvwContextCustom("BinaryMesh"));
+    }
+    return static_cast<E>(value);
+}
+
+// Allocate a buffer of the stored format and size and fill it with a single read
+std::shared_ptr<BufferRAM> readBufferRAM(std::istream& is, BufferTarget target) {
+    const DataFormatBase* format = nullptr;
+    try {
+        format = DataFormatBase::get(readString(is));
+    } catch (const DataFormatException& e) {
+        throw DataReaderException(e.getMessage(), IvwContextCustom("BinaryMesh"));
+    }
+    if (format->getId() == DataFormatId::NotSpecialized) {
+        throw DataReaderException("Invalid buffer format in mesh data",
+                                  IvwContextCustom("BinaryMesh"));
+    }
+    const auto usage = read<std::int32_t>(is) == 0 ? BufferUsage::Static : BufferUsage::Dynamic;
+    const auto size = read<std::uint64_t>(is);
+    if (size > remaining(is) / format->getSize()) {
+        throw DataReaderException("Invalid buffer size in mesh data: " + toString(size),
+                                  IvwContextCustom("BinaryMesh"));
+    }
+
+    auto ram = createBufferRAM(static_cast<size_t>(size), format, usage, target);
+    if (!is.read(static_cast<char*>(ram->getData()),
+                 static_cast<std::streamsize>(ram->getSize() * ram->getSizeOfElement()))) {
+        throw DataReaderException("Unexpected end of mesh data", IvwContextCustom("BinaryMesh"));
+    }
+    return ram;
+}
+
+}  // namespace
+
+BinaryMeshReader::BinaryMeshReader() : DataReaderType<Mesh>() {
+    addExtension(FileExtension("ivmesh", "Inviwo Binary Mesh"));
+}
+
+BinaryMeshReader* BinaryMeshReader::clone() const { return new BinaryMeshReader(*this); }
+
+std::shared_ptr<Mesh> BinaryMeshReader::readData(const std::string& filePath) {
+    if (!filesystem::fileExists(filePath)) {
+        throw DataReaderException("Error could not find input file: " + filePath, IvwContext);
+    }
+    auto f = filesystem::ifstream(filePath, std::ios_base::in | std::ios_base::binary);
+    if (!f) {
+        throw DataReaderException("Error could not open input file: " + filePath, IvwContext);
+    }
+    return readData(f);
+}
+
+std::shared_ptr<Mesh> BinaryMeshReader::readData(std::istream& is) {
+    const auto magic = read<std::array<char, 8>>(is);
+    if (magic != BinaryMeshWriter::magic) {
+        throw DataReaderException("Not an Inviwo binary mesh", IvwContextCustom("BinaryMesh"));
+    }
+    const auto version = read<std::uint32_t>(is);
+    if (version != BinaryMeshWriter::version) {
+        throw DataReaderException("Unsupported binary mesh version: " + toString(version),
+                                  IvwContextCustom("BinaryMesh"));
+    }
+
+    const auto dt = readEnum(is, DrawType::NumberOfDrawTypes);
+    const auto ct = readEnum(is, ConnectivityType::NumberOfConnectivityTypes);
+    auto mesh = std::make_shared<Mesh>(dt, ct);
+    mesh->setModelMatrix(readMatrix(is));
+    mesh->setWorldMatrix(readMatrix(is));
+
+    const auto numBuffers = read<std::uint32_t>(is);
+    for (std::uint32_t i = 0; i < numBuffers; ++i) {
+        const auto type = readEnum(is, BufferType::NumberOfBufferTypes);
+        const auto location = read<std::int32_t>(is);
+        auto ram = readBufferRAM(is, BufferTarget::Data);
+        auto buffer = ram->dispatch<std::shared_ptr<BufferBase>>([&](auto typed) {
+            using BufferRAMType = typename std::decay<decltype(*typed)>::type;
+            using ValueType = util::PrecisionValueType<decltype(typed)>;
+            return std::make_shared<Buffer<ValueType, BufferRAMType::target>>(
+                std::shared_ptr<BufferRAMType>(ram, typed));
+        });
+        mesh->addBuffer(Mesh::BufferInfo(type, location), buffer);
+    }
+
+    const auto numIndexBuffers = read<std::uint32_t>(is);
+    for (std::uint32_t i = 0; i < numIndexBuffers; ++i) {
+        const auto idt = readEnum(is, DrawType::NumberOfDrawTypes);
+        const auto ict = readEnum(is, ConnectivityType::NumberOfConnectivityTypes);
+        auto ram =
+            std::dynamic_pointer_cast<IndexBufferRAM>(readBufferRAM(is, BufferTarget::Index));
+        if (!ram) {
+            throw DataReaderException("Index buffers have to be of type uint32",
+                                      IvwContextCustom("BinaryMesh"));
+        }
+        mesh->addIndicies(Mesh::MeshInfo(idt, ict), std::make_shared<IndexBuffer>(ram));
+    }
+
+    return mesh;
+}
+
+}  // namespace inviwo
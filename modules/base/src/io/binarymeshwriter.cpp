@@ -0,0 +1,126 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/io/binarymeshwriter.h>
+#include <inviwo/core/util/stdextensions.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/io/datawriterexception.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+
+#include <fstream>
+#include <sstream>
+#include <type_traits>
+
+namespace inviwo {
+
+constexpr std::array<char, 8> BinaryMeshWriter::magic;
+constexpr std::uint32_t BinaryMeshWriter::version;
+
+namespace {
+
+template <typename T>
+void write(std::ostream& os, const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types");
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void write(std::ostream& os, const std::string& str) {
+    write(os, static_cast<std::uint32_t>(str.size()));
+    os.write(str.data(), str.size());
+}
+
+void write(std::ostream& os, const mat4& m) {
+    os.write(reinterpret_cast<const char*>(glm::value_ptr(m)), sizeof(float) * 16);
+}
+
+void write(std::ostream& os, const BufferRAM& ram) {
+    write(os, std::string(ram.getDataFormat()->getString()));
+    write(os, static_cast<std::int32_t>(ram.getBufferUsage()));
+    write(os, static_cast<std::uint64_t>(ram.getSize()));
+    os.write(static_cast<const char*>(ram.getData()), ram.getSize() * ram.getSizeOfElement());
+}
+
+}  // namespace
+
+BinaryMeshWriter::BinaryMeshWriter() : DataWriterType<Mesh>() {
+    addExtension(FileExtension("ivmesh", "Inviwo Binary Mesh"));
+}
+
+BinaryMeshWriter* BinaryMeshWriter::clone() const { return new BinaryMeshWriter(*this); }
+
+void BinaryMeshWriter::writeData(const Mesh* data, const std::string filePath) const {
+    if (filesystem::fileExists(filePath) && !getOverwrite()) {
+        throw DataWriterException("File already exists: " + filePath, IvwContext);
+    }
+    auto f = filesystem::ofstream(filePath, std::ios_base::out | std::ios_base::binary);
+    if (!f) {
+        throw DataWriterException("Could not open file for writing: " + filePath, IvwContext);
+    }
+    writeData(data, f);
+    if (!f) {
+        throw DataWriterException("Error writing to file: " + filePath, IvwContext);
+    }
+}
+
+std::unique_ptr<std::vector<unsigned char>> BinaryMeshWriter::writeDataToBuffer(
+    const Mesh* data, const std::string& /*fileExtension*/) const {
+    std::stringstream ss(std::ios_base::out | std::ios_base::binary);
+    writeData(data, ss);
+    auto stringdata = ss.str();
+    return util::make_unique<std::vector<unsigned char>>(stringdata.begin(), stringdata.end());
+}
+
+void BinaryMeshWriter::writeData(const Mesh* data, std::ostream& os) {
+    os.write(magic.data(), magic.size());
+    write(os, version);
+
+    const auto meshInfo = data->getDefaultMeshInfo();
+    write(os, static_cast<std::int32_t>(meshInfo.dt));
+    write(os, static_cast<std::int32_t>(meshInfo.ct));
+    write(os, data->getModelMatrix());
+    write(os, data->getWorldMatrix());
+
+    const auto& buffers = data->getBuffers();
+    write(os, static_cast<std::uint32_t>(buffers.size()));
+    for (const auto& buffer : buffers) {
+        write(os, static_cast<std::int32_t>(buffer.first.type));
+        write(os, static_cast<std::int32_t>(buffer.first.location));
+        write(os, *buffer.second->getRepresentation<BufferRAM>());
+    }
+
+    const auto& indexBuffers = data->getIndexBuffers();
+    write(os, static_cast<std::uint32_t>(indexBuffers.size()));
+    for (const auto& indices : indexBuffers) {
+        write(os, static_cast<std::int32_t>(indices.first.dt));
+        write(os, static_cast<std::int32_t>(indices.first.ct));
+        write(os, *indices.second->getRepresentation<BufferRAM>());
+    }
+}
+
+}  // namespace inviwo
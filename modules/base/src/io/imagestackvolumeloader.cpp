@@ -0,0 +1,208 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/io/imagestackvolumeloader.h>
+
+#include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/util/foreach.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+namespace inviwo {
+
+namespace {
+
+template <typename Format>
+struct FloatOrIntMax32
+    : std::integral_constant<bool, Format::numtype == NumericType::Float || Format::compsize <= 4> {
+};
+
+}  // namespace
+
+constexpr size_t ImageStackVolumeLoader::noReader;
+
+ImageStackVolumeLoader::ImageStackVolumeLoader(
+    std::vector<std::string> files, const std::vector<const DataReaderType<Layer>*>& readers,
+    size2_t sliceDimensions, const DataFormatBase* format)
+    : files_{std::move(files)}, sliceDimensions_{sliceDimensions}, format_{format} {
+
+    if (files_.size() != readers.size()) {
+        throw Exception("Expected one reader per file", IVW_CONTEXT);
+    }
+    if ((format_->getNumericType() != NumericType::Float) && (format_->getPrecision() > 32)) {
+        throw DataReaderException(
+            fmt::format("Unsupported integer bit depth ({})", format_->getPrecision()),
+            IVW_CONTEXT);
+    }
+
+    // Only keep one clone of each distinct reader
+    std::vector<const DataReaderType<Layer>*> unique;
+    readerIndex_.reserve(readers.size());
+    for (auto reader : readers) {
+        if (!reader) {
+            readerIndex_.push_back(noReader);
+            continue;
+        }
+        auto it = std::find(unique.begin(), unique.end(), reader);
+        if (it == unique.end()) {
+            unique.push_back(reader);
+            readers_.emplace_back(reader->clone());
+            it = std::prev(unique.end());
+        }
+        readerIndex_.push_back(static_cast<size_t>(std::distance(unique.begin(), it)));
+    }
+}
+
+ImageStackVolumeLoader* ImageStackVolumeLoader::clone() const {
+    return new ImageStackVolumeLoader(*this);
+}
+
+std::shared_ptr<VolumeRepresentation> ImageStackVolumeLoader::createRepresentation() const {
+    return load();
+}
+
+void ImageStackVolumeLoader::updateRepresentation(
+    std::shared_ptr<VolumeRepresentation> dest) const {
+    auto volumeDst = std::static_pointer_cast<VolumeRAM>(dest);
+
+    if (getDimensions() != volumeDst->getDimensions()) {
+        throw Exception("Mismatching volume dimensions, can't update", IVW_CONTEXT);
+    }
+    if (format_ != volumeDst->getDataFormat()) {
+        throw Exception("Mismatching volume formats, can't update", IVW_CONTEXT);
+    }
+    read(*volumeDst, nullptr, nullptr);
+}
+
+std::shared_ptr<VolumeRAM> ImageStackVolumeLoader::load(const ProgressCallback& progress,
+                                                        const WarningCallback& warning) const {
+    auto volumeRAM = createVolumeRAM(getDimensions(), format_);
+    read(*volumeRAM, progress, warning);
+    return volumeRAM;
+}
+
+size3_t ImageStackVolumeLoader::getDimensions() const {
+    return size3_t{sliceDimensions_, files_.size()};
+}
+
+const DataFormatBase* ImageStackVolumeLoader::getDataFormat() const { return format_; }
+
+void ImageStackVolumeLoader::read(VolumeRAM& dest, const ProgressCallback& progress,
+                                  const WarningCallback& warning) const {
+    const size_t sliceSize = glm::compMul(sliceDimensions_);
+    const size_t slices = files_.size();
+
+    // Warnings are collected and reported from the calling thread once all slices are done
+    std::vector<std::string> warnings(slices);
+    std::atomic<size_t> done{0};
+    // The calling thread takes part in the work, progress is reported whenever it finishes a
+    // slice
+    const auto caller = std::this_thread::get_id();
+
+    dest.dispatch<void, FloatOrIntMax32>([&](auto volumeprecision) {
+        using ValueType = util::PrecisionValueType<decltype(volumeprecision)>;
+        auto volData = volumeprecision->getDataTyped();
+
+        const auto decode = [&](size_t slice, DataReaderType<Layer>* reader) -> std::string {
+            const auto& file = files_[slice];
+            std::shared_ptr<Layer> layer;
+            const LayerRAM* layerRAM = nullptr;
+            try {
+                layer = reader->readData(file);
+                // Forces the image to be decoded
+                layerRAM = layer->template getRepresentation<LayerRAM>();
+            } catch (const Exception& e) {
+                return fmt::format("Could not load image: {}, {}", file, e.getMessage());
+            }
+
+            const auto format = layerRAM->getDataFormat();
+            if ((format->getNumericType() != NumericType::Float) &&
+                (format->getPrecision() > 32)) {
+                return fmt::format("Unsupported integer bit depth: {}, for image: {}",
+                                   format->getPrecision(), file);
+            }
+            if (layerRAM->getDimensions() != sliceDimensions_) {
+                return fmt::format("Unexpected dimensions: {} , expected: {}, for image: {}",
+                                   layerRAM->getDimensions(), sliceDimensions_, file);
+            }
+
+            layerRAM->template dispatch<void, FloatOrIntMax32>([&](auto layerpr) {
+                const auto data = layerpr->getDataTyped();
+                std::transform(
+                    data, data + sliceSize, volData + slice * sliceSize,
+                    [](auto value) { return util::glm_convert_normalized<ValueType>(value); });
+            });
+            return {};
+        };
+
+        util::forEachRangeParallel(slices, [&](size_t begin, size_t end) {
+            // Each job uses its own copies of the readers
+            std::vector<std::unique_ptr<DataReaderType<Layer>>> readers(readers_.size());
+            for (size_t slice = begin; slice < end; ++slice) {
+                DataReaderType<Layer>* reader = nullptr;
+                if (readerIndex_[slice] != noReader) {
+                    auto& clone = readers[readerIndex_[slice]];
+                    if (!clone) clone.reset(readers_[readerIndex_[slice]]->clone());
+                    reader = clone.get();
+                }
+
+                if (reader) warnings[slice] = decode(slice, reader);
+                if (!reader || !warnings[slice].empty()) {
+                    std::fill(volData + slice * sliceSize, volData + (slice + 1) * sliceSize,
+                              ValueType{0});
+                }
+                ++done;
+                if (progress && std::this_thread::get_id() == caller) {
+                    progress(static_cast<double>(done) / static_cast<double>(slices));
+                }
+            }
+        });
+    });
+    if (progress) progress(1.0);
+
+    for (const auto& message : warnings) {
+        if (message.empty()) continue;
+        if (warning) {
+            warning(message);
+        } else {
+            LogWarnCustom("ImageStackVolumeLoader", message);
+        }
+    }
+}
+
+}  // namespace inviwo
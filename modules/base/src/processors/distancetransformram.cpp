@@ -122,6 +122,7 @@ void DistanceTransformRAM::process() {
     if (util::is_future_ready(newVolume_)) {
         try {
             auto vol = newVolume_.get();
+            cache_.put(std::move(newVolumeKey_), vol);
             dataRangeOutput_.set(vol->dataMap_.dataRange);
             outport_.setData(vol);
             hasNewData_ = false;
@@ -143,6 +144,20 @@ void DistanceTransformRAM::process() {
 }
 
 void DistanceTransformRAM::updateOutport() {
+    auto key = ResultCacheKey{}
+                   .addData(volumePort_.getData())
+                   .addProperties(*this, {&dataRangeOutput_, &btnForceUpdate_});
+    if (auto vol = cache_.get(key)) {
+        distTransformDirty_ = false;
+        btnForceUpdate_.setDisplayName("Update Distance Map");
+        dataRangeOutput_.set(vol->dataMap_.dataRange);
+        outport_.setData(vol);
+        // The outport is only invalidated when a result is done, do it here instead
+        outport_.invalidate(InvalidationLevel::InvalidOutput);
+        return;
+    }
+    newVolumeKey_ = std::move(key);
+
     auto done = [this]() {
         dispatchFront([this]() {
             distTransformDirty_ = false;
@@ -32,18 +32,16 @@
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/datastructures/image/layer.h>
 #include <inviwo/core/datastructures/image/layerram.h>
-#include <inviwo/core/datastructures/image/layerramprecision.h>
-#include <inviwo/core/datastructures/image/imageram.h>
 #include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
-#include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/io/datareaderfactory.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/vectoroperations.h>
-#include <inviwo/core/util/zip.h>
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/io/datareaderexception.h>
+#include <modules/base/io/imagestackvolumeloader.h>
 
 #include <algorithm>
 
@@ -52,15 +50,6 @@
 
 namespace inviwo {
 
-namespace {
-
-template <typename Format>
-struct FloatOrIntMax32
-    : std::integral_constant<bool, Format::numtype == NumericType::Float || Format::compsize <= 4> {
-};
-
-}  // namespace
-
 // The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
 const ProcessorInfo ImageStackVolumeSource::processorInfo_{
     "org.inviwo.ImageStackVolumeSource",  // Class identifier
@@ -77,6 +66,7 @@ ImageStackVolumeSource::ImageStackVolumeSource(InviwoApplication* app)
     , filePattern_("filePattern", "File Pattern", "####.jpeg", "")
     , reload_("reload", "Reload data")
     , skipUnsupportedFiles_("skipUnsupportedFiles", "Skip Unsupported Files", false)
+    , loadOnDemand_("loadOnDemand", "Load on Demand", false)
     , basis_("Basis", "Basis and offset")
     , information_("Information", "Data information")
     , readerFactory_{app->getDataReaderFactory()} {
@@ -85,6 +75,7 @@ ImageStackVolumeSource::ImageStackVolumeSource(InviwoApplication* app)
     addProperty(filePattern_);
     addProperty(reload_);
     addProperty(skipUnsupportedFiles_);
+    addProperty(loadOnDemand_);
     addProperty(basis_);
     addProperty(information_);
 
@@ -104,7 +95,8 @@ void ImageStackVolumeSource::addFileNameFilters() {
 void ImageStackVolumeSource::process() {
     util::OnScopeExit guard{[&]() { outport_.setData(nullptr); }};
 
-    if (filePattern_.isModified() || reload_.isModified() || skipUnsupportedFiles_.isModified()) {
+    if (filePattern_.isModified() || reload_.isModified() || skipUnsupportedFiles_.isModified() ||
+        loadOnDemand_.isModified()) {
         volume_ = load();
         if (volume_) {
             basis_.updateForNewEntity(*volume_, deserialized_);
@@ -189,85 +181,42 @@ std::shared_ptr<Volume> ImageStackVolumeSource::load() {
             IVW_CONTEXT);
     }
 
-    return referenceRAM->dispatch<std::shared_ptr<Volume>, FloatOrIntMax32>(
-        [&](auto reflayerprecision) {
-            using ValueType = util::PrecisionValueType<decltype(reflayerprecision)>;
-            using PrimitiveType = typename DataFormat<ValueType>::primitive;
-
-            const size2_t layerDims = reflayerprecision->getDimensions();
-            const size_t sliceOffset = glm::compMul(layerDims);
-
-            // create matching volume representation
-            auto volumeRAM =
-                std::make_shared<VolumeRAMPrecision<ValueType>>(size3_t{layerDims, slices.size()});
-            auto volData = volumeRAM->getDataTyped();
-
-            const auto fill = [&](size_t s) {
-                std::fill(volData + s * sliceOffset, volData + (s + 1) * sliceOffset, ValueType{0});
-            };
-
-            const auto read = [&](const auto& file, auto reader) -> std::shared_ptr<Layer> {
-                try {
-                    return reader->readData(file);
-                } catch (DataReaderException const& e) {
-                    LogProcessorWarn(
-                        fmt::format("Could not load image: {}, {}", file, e.getMessage()));
-                    return nullptr;
-                }
-            };
-
-            for (auto&& elem : util::enumerate(slices)) {
-                const auto slice = elem.first();
-                const auto file = elem.second().first;
-                const auto reader = elem.second().second;
-                if (!reader) {
-                    fill(slice);
-                    continue;
-                }
-
-                const auto layer = read(file, reader);
-                if (!layer) {
-                    fill(slice);
-                    continue;
-                }
-                const auto layerRAM = layer->template getRepresentation<LayerRAM>();
-
-                const auto format = layerRAM->getDataFormat();
-                if ((format->getNumericType() != NumericType::Float) &&
-                    (format->getPrecision() > 32)) {
-                    LogProcessorWarn(fmt::format("Unsupported integer bit depth: {}, for image: {}",
-                                                 format->getPrecision(), file));
-                    fill(slice);
-                    continue;
-                }
-
-                if (layerRAM->getDimensions() != layerDims) {
-                    LogProcessorWarn(
-                        fmt::format("Unexpected dimensions: {} , expected: {}, for image: {}",
-                                    layer->getDimensions(), layerDims, file));
-                    fill(slice);
-                    continue;
-                }
-                layerRAM->template dispatch<void, FloatOrIntMax32>([&](auto layerpr) {
-                    const auto data = layerpr->getDataTyped();
-                    std::transform(
-                        data, data + sliceOffset, volData + slice * sliceOffset,
-                        [](auto value) { return util::glm_convert_normalized<ValueType>(value); });
-                });
-            }
+    std::vector<std::string> sliceFiles;
+    std::vector<const DataReaderType<Layer>*> sliceReaders;
+    for (const auto& slice : slices) {
+        sliceFiles.push_back(slice.first);
+        sliceReaders.push_back(slice.second);
+    }
+    auto loader = std::make_unique<ImageStackVolumeLoader>(
+        std::move(sliceFiles), sliceReaders, referenceRAM->getDimensions(), refFormat);
+    const auto dims = loader->getDimensions();
+
+    std::shared_ptr<Volume> volume;
+    if (loadOnDemand_) {
+        // Decode the slices once a representation of the volume is requested
+        volume = std::make_shared<Volume>(dims, refFormat);
+        auto diskRepr = std::make_shared<VolumeDisk>(filePattern_.getFilePatternPath(), dims,
+                                                     refFormat);
+        diskRepr->setLoader(loader.release());
+        volume->addRepresentation(diskRepr);
+    } else {
+        // The loader reports progress from this thread
+        const auto progress = [this](double f) {
+            f < 1.0 ? progressBar_.show() : progressBar_.hide();
+            updateProgress(static_cast<float>(f));
+        };
+        const auto warning = [this](const std::string& message) { LogProcessorWarn(message); };
+        volume = std::make_shared<Volume>(loader->load(progress, warning));
+    }
 
-            auto volume = std::make_shared<Volume>(volumeRAM);
-            volume->dataMap_.dataRange =
-                dvec2{DataFormat<PrimitiveType>::lowest(), DataFormat<PrimitiveType>::max()};
-            volume->dataMap_.valueRange =
-                dvec2{DataFormat<PrimitiveType>::lowest(), DataFormat<PrimitiveType>::max()};
+    volume->dataMap_.dataRange = dvec2{refFormat->getLowest(), refFormat->getMax()};
+    volume->dataMap_.valueRange = dvec2{refFormat->getLowest(), refFormat->getMax()};
 
-            const auto size = vec3(0.01f) * static_cast<vec3>(volumeRAM->getDimensions());
-            volume->setBasis(glm::diagonal3x3(size));
-            volume->setOffset(-0.5 * size);
+    const auto size = vec3(0.01f) * static_cast<vec3>(dims);
+    volume->setBasis(glm::diagonal3x3(size));
+    volume->setOffset(-0.5 * size);
 
-            return volume;
-        });
+    return volume;
 }
 
 void ImageStackVolumeSource::deserialize(Deserializer& d) {
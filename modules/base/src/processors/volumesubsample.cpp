@@ -68,9 +68,23 @@ void VolumeSubsample::process() {
 
     if (enabled_.get() && factors != size3_t(1, 1, 1)) {
         if (waitForCompletion_.get()) {
-            outport_.setData(subsample(inport_.getData(), factors));
+            auto key = ResultCacheKey{}.addData(inport_.getData()).addValue(factors);
+            auto volume = cache_.get(key);
+            if (!volume) {
+                volume = subsample(inport_.getData(), factors);
+                cache_.put(std::move(key), volume);
+            }
+            outport_.setData(volume);
         } else {
             if (!result_.valid()) {
+                auto key = ResultCacheKey{}.addData(inport_.getData()).addValue(factors);
+                if (auto volume = cache_.get(key)) {
+                    // The outport is only invalidated when a result is done, do it here instead
+                    outport_.setData(volume);
+                    outport_.invalidate(InvalidationLevel::InvalidOutput);
+                    return;
+                }
+                resultKey_ = std::move(key);
                 getActivityIndicator().setActive(true);
                 result_ = dispatchPool(
                     [this](std::shared_ptr<const Volume> volume,
@@ -84,7 +98,9 @@ void VolumeSubsample::process() {
                     },
                     inport_.getData(), factors);
             } else if (util::is_future_ready(result_)) {
-                outport_.setData(result_.get());
+                auto volume = result_.get();
+                cache_.put(std::move(resultKey_), volume);
+                outport_.setData(volume);
                 getActivityIndicator().setActive(false);
                 dirty_ = false;
             }
@@ -36,6 +36,9 @@
 
 #include <modules/base/algorithm/volume/marchingcubes.h>
 #include <modules/base/algorithm/volume/marchingcubesopt.h>
+#include <modules/base/algorithm/volume/volumeramdistancetransform.h>
+
+#include "saitodistancetransform.h"
 
 #include <benchmark/benchmark.h>
 
@@ -130,12 +133,46 @@ static void MiniNew(benchmark::State& state) {
     state.counters["Voxels"] = state.range(0) * state.range(0) * state.range(0);
 }
 
+// A spherical blob in the center, the distances grow large towards the corners
+static auto makeDistanceTransformInput(size_t size) {
+    auto v = std::shared_ptr<Volume>(util::makeSphericalVolume(size3_t{size}));
+    return std::make_pair(v, std::make_unique<VolumeRAMPrecision<float>>(size3_t{size}));
+}
+
+static void DistanceTransformOld(benchmark::State& state) {
+    auto input = makeDistanceTransformInput(static_cast<size_t>(state.range(0)));
+    const auto src = static_cast<const VolumeRAMPrecision<float>*>(
+        input.first->getRepresentation<VolumeRAM>());
+    for (auto _ : state) {
+        bench::saitoDistanceTransform(
+            src, input.second.get(), mat3(1.0f), size3_t{1},
+            [](const float& val) { return val > 0.5f; },
+            [](const float& squareDist) { return std::sqrt(squareDist); });
+        benchmark::ClobberMemory();
+    }
+    state.counters["Voxels"] = state.range(0) * state.range(0) * state.range(0);
+}
+
+static void DistanceTransformNew(benchmark::State& state) {
+    auto input = makeDistanceTransformInput(static_cast<size_t>(state.range(0)));
+    const auto src = static_cast<const VolumeRAMPrecision<float>*>(
+        input.first->getRepresentation<VolumeRAM>());
+    for (auto _ : state) {
+        util::volumeRAMDistanceTransform(src, input.second.get(), mat3(1.0f), size3_t{1});
+        benchmark::ClobberMemory();
+    }
+    state.counters["Voxels"] = state.range(0) * state.range(0) * state.range(0);
+}
+
 BENCHMARK(SphereOld)->RangeMultiplier(2)->Range(8, 8 << 5);
 BENCHMARK(SphereNew)->RangeMultiplier(2)->Range(8, 8 << 6);
 
 BENCHMARK(RippleOld)->RangeMultiplier(2)->Range(8, 8 << 4);
 BENCHMARK(RippleNew)->RangeMultiplier(2)->Range(8, 8 << 5);
 
+BENCHMARK(DistanceTransformOld)->RangeMultiplier(2)->Range(8, 8 << 4);
+BENCHMARK(DistanceTransformNew)->RangeMultiplier(2)->Range(8, 8 << 5);
+
 // BENCHMARK(MiniOld)->RangeMultiplier(2)->Range(8, 8 << 5);
 // BENCHMARK(MiniNew)->RangeMultiplier(2)->Range(8, 8 << 5);
 
@@ -0,0 +1,137 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#ifndef IVW_SAITODISTANCETRANSFORM_H
+#define IVW_SAITODISTANCETRANSFORM_H
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace inviwo {
+
+namespace bench {
+
+/**
+ * The previous implementation of util::volumeRAMDistanceTransform based on Saito's algorithm, kept
+ * as a reference for the benchmarks. The run time of the second and third pass grows with the
+ * distance to the closest feature.
+ *  T. Saito and J.I. Toriwaki. New algorithms for Euclidean distance transformations
+ *  of an n-dimensional digitized picture with applications. Pattern Recognition, 27(11).
+ *  pp. 1551-1565, 1994.
+ */
+template <typename T, typename U, typename Predicate, typename ValueTransform>
+void saitoDistanceTransform(const VolumeRAMPrecision<T> *inVolume,
+                            VolumeRAMPrecision<U> *outDistanceField, const Matrix<3, U> basis,
+                            const size3_t upsample, Predicate predicate,
+                            ValueTransform valueTransform) {
+    using int64 = glm::int64;
+    using i64vec3 = glm::tvec3<int64>;
+
+    auto square = [](auto a) { return a * a; };
+
+    const T *src = inVolume->getDataTyped();
+    U *dst = outDistanceField->getDataTyped();
+
+    const i64vec3 srcDim{inVolume->getDimensions()};
+    const i64vec3 dstDim{outDistanceField->getDimensions()};
+    const i64vec3 sm{upsample};
+
+    const auto squareBasis = glm::transpose(basis) * basis;
+    const Vector<3, U> squareBasisDiag{squareBasis[0][0], squareBasis[1][1], squareBasis[2][2]};
+    const Vector<3, U> squareVoxelSize{squareBasisDiag / Vector<3, U>{dstDim * dstDim}};
+    const Vector<3, U> invSquareVoxelSize{Vector<3, U>{1.0f} / squareVoxelSize};
+
+    util::IndexMapper<3, int64> srcInd(srcDim);
+    util::IndexMapper<3, int64> dstInd(dstDim);
+
+    auto is_feature = [&](const int64 x, const int64 y, const int64 z) {
+        return predicate(src[srcInd(x / sm.x, y / sm.y, z / sm.z)]);
+    };
+
+    // first pass, forward and backward scan along x
+    for (int64 z = 0; z < dstDim.z; ++z) {
+        for (int64 y = 0; y < dstDim.y; ++y) {
+            U dist = static_cast<U>(dstDim.x);
+            for (int64 x = 0; x < dstDim.x; ++x) {
+                dist = is_feature(x, y, z) ? U(0) : dist + 1;
+                dst[dstInd(x, y, z)] = squareVoxelSize.x * square(dist);
+            }
+            dist = static_cast<U>(dstDim.x);
+            for (int64 x = dstDim.x - 1; x >= 0; --x) {
+                dist = is_feature(x, y, z) ? U(0) : dist + 1;
+                dst[dstInd(x, y, z)] =
+                    std::min<U>(dst[dstInd(x, y, z)], squareVoxelSize.x * square(dist));
+            }
+        }
+    }
+
+    // second and third pass, scan y and z direction
+    auto scan = [&](int64 n, U voxelSize, U invVoxelSize, auto index, int64 outer, int64 inner) {
+        std::vector<U> buff(static_cast<size_t>(n));
+        for (int64 o = 0; o < outer; ++o) {
+            for (int64 i = 0; i < inner; ++i) {
+                for (int64 k = 0; k < n; ++k) buff[k] = dst[index(i, k, o)];
+                for (int64 k = 0; k < n; ++k) {
+                    auto d = buff[k];
+                    if (d != U(0)) {
+                        const auto rMax = static_cast<int64>(std::sqrt(d * invVoxelSize)) + 1;
+                        const auto rStart = std::min(rMax, k - 1);
+                        const auto rEnd = std::min(rMax, n - k);
+                        for (int64 m = -rStart; m < rEnd; ++m) {
+                            const auto w = buff[k + m] + voxelSize * square(m);
+                            if (w < d) d = w;
+                        }
+                    }
+                    dst[index(i, k, o)] = d;
+                }
+            }
+        }
+    };
+    scan(dstDim.y, squareVoxelSize.y, invSquareVoxelSize.y,
+         [&](int64 x, int64 y, int64 z) { return dstInd(x, y, z); }, dstDim.z, dstDim.x);
+    scan(dstDim.z, squareVoxelSize.z, invSquareVoxelSize.z,
+         [&](int64 x, int64 z, int64 y) { return dstInd(x, y, z); }, dstDim.y, dstDim.x);
+
+    const int64 volSize = dstDim.x * dstDim.y * dstDim.z;
+    for (int64 i = 0; i < volSize; ++i) {
+        dst[i] = valueTransform(dst[i]);
+    }
+}
+
+}  // namespace bench
+
+}  // namespace inviwo
+
+#endif  // IVW_SAITODISTANCETRANSFORM_H
@@ -0,0 +1,138 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/io/binarymeshreader.h>
+#include <modules/base/io/binarymeshwriter.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/io/datareaderexception.h>
+
+#include <cstring>
+#include <sstream>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<Mesh> makeMesh() {
+    auto mesh = std::make_shared<Mesh>(DrawType::Triangles, ConnectivityType::Strip);
+    mesh->setModelMatrix(mat4{2.0f});
+    mesh->setWorldMatrix(glm::translate(vec3{1.0f, 2.0f, 3.0f}));
+
+    mesh->addBuffer(Mesh::BufferInfo(BufferType::PositionAttrib),
+                    util::makeBuffer(std::vector<vec3>{{0, 0, 0}, {1, 0, 0}, {0, 1, 0}}));
+    mesh->addBuffer(Mesh::BufferInfo(BufferType::ColorAttrib, 12),
+                    util::makeBuffer(std::vector<vec4>{{1, 0, 0, 1}, {0, 1, 0, 1}, {0, 0, 1, 1}}));
+    mesh->addBuffer(Mesh::BufferInfo(BufferType::ScalarMetaAttrib),
+                    util::makeBuffer(std::vector<double>{0.5, 1.5, 2.5}));
+    mesh->addIndicies(Mesh::MeshInfo(DrawType::Lines, ConnectivityType::Loop),
+                      util::makeIndexBuffer({0, 1, 2}));
+    return mesh;
+}
+
+template <typename T>
+const std::vector<T>& data(const BufferBase& buffer) {
+    return static_cast<const Buffer<T>&>(buffer).getRAMRepresentation()->getDataContainer();
+}
+
+}  // namespace
+
+TEST(BinaryMesh, roundTrip) {
+    const auto mesh = makeMesh();
+
+    std::stringstream ss(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    BinaryMeshWriter::writeData(mesh.get(), ss);
+    const auto res = BinaryMeshReader::readData(ss);
+
+    EXPECT_EQ(mesh->getDefaultMeshInfo(), res->getDefaultMeshInfo());
+    EXPECT_EQ(mesh->getModelMatrix(), res->getModelMatrix());
+    EXPECT_EQ(mesh->getWorldMatrix(), res->getWorldMatrix());
+
+    ASSERT_EQ(mesh->getNumberOfBuffers(), res->getNumberOfBuffers());
+    for (size_t i = 0; i < mesh->getNumberOfBuffers(); ++i) {
+        EXPECT_EQ(mesh->getBufferInfo(i), res->getBufferInfo(i));
+        EXPECT_EQ(mesh->getBuffer(i)->getDataFormat(), res->getBuffer(i)->getDataFormat());
+        EXPECT_EQ(*mesh->getBuffer(i), *res->getBuffer(i));
+    }
+    EXPECT_EQ(data<double>(*mesh->getBuffer(2)), data<double>(*res->getBuffer(2)));
+
+    ASSERT_EQ(mesh->getNumberOfIndicies(), res->getNumberOfIndicies());
+    EXPECT_EQ(mesh->getIndexMeshInfo(0), res->getIndexMeshInfo(0));
+    EXPECT_EQ(mesh->getIndices(0)->getRAMRepresentation()->getDataContainer(),
+              res->getIndices(0)->getRAMRepresentation()->getDataContainer());
+}
+
+TEST(BinaryMesh, invalidData) {
+    const auto mesh = makeMesh();
+
+    std::stringstream ss(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    BinaryMeshWriter::writeData(mesh.get(), ss);
+    auto str = ss.str();
+
+    std::stringstream truncated(str.substr(0, str.size() - 4),
+                                std::ios_base::in | std::ios_base::binary);
+    EXPECT_THROW(BinaryMeshReader::readData(truncated), DataReaderException);
+
+    str[0] = 'X';
+    std::stringstream wrongMagic(str, std::ios_base::in | std::ios_base::binary);
+    EXPECT_THROW(BinaryMeshReader::readData(wrongMagic), DataReaderException);
+}
+
+TEST(BinaryMesh, invalidSizes) {
+    const auto mesh = makeMesh();
+
+    std::stringstream ss(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    BinaryMeshWriter::writeData(mesh.get(), ss);
+    const auto str = ss.str();
+
+    // magic, version, mesh info, matrices, number of buffers and the first buffer info
+    const size_t formatPos = 8 + 4 + 2 * 4 + 2 * 64 + 4 + 2 * 4;
+    std::uint32_t formatSize = 0;
+    std::memcpy(&formatSize, &str[formatPos], sizeof(formatSize));
+    const size_t sizePos = formatPos + 4 + formatSize + 4;
+
+    const auto readWith = [&](size_t pos, auto value) {
+        auto corrupt = str;
+        std::memcpy(&corrupt[pos], &value, sizeof(value));
+        std::stringstream is(corrupt, std::ios_base::in | std::ios_base::binary);
+        return BinaryMeshReader::readData(is);
+    };
+
+    EXPECT_NO_THROW(readWith(sizePos, std::uint64_t{3}));
+    EXPECT_THROW(readWith(sizePos, std::uint64_t{1} << 60), DataReaderException);
+    EXPECT_THROW(readWith(sizePos, std::uint64_t{str.size()}), DataReaderException);
+    EXPECT_THROW(readWith(formatPos, std::uint32_t{0xFFFFFFF0}), DataReaderException);
+    EXPECT_THROW(readWith(formatPos + 4, 'X'), DataReaderException);
+}
+
+}  // namespace inviwo
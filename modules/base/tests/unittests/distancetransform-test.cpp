@@ -0,0 +1,151 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/algorithm/volume/volumeramdistancetransform.h>
+#include <modules/base/algorithm/image/layerramdistancetransform.h>
+
+#include <random>
+
+namespace inviwo {
+
+namespace {
+
+// Brute force reference, squared distance between the centers of destination voxels and the
+// closest feature voxel in the source, scaled by the size of a destination voxel.
+template <typename T>
+double bruteForceDistance(const T* src, const size3_t& srcDim, const size3_t& upsample,
+                          const dvec3& voxelSize, const size3_t& pos) {
+    double minDist = std::numeric_limits<double>::infinity();
+    for (size_t z = 0; z < srcDim.z * upsample.z; ++z) {
+        for (size_t y = 0; y < srcDim.y * upsample.y; ++y) {
+            for (size_t x = 0; x < srcDim.x * upsample.x; ++x) {
+                const size3_t s{x / upsample.x, y / upsample.y, z / upsample.z};
+                if (src[s.x + srcDim.x * (s.y + srcDim.y * s.z)] == 0) continue;
+                const auto d = (dvec3{x, y, z} - dvec3{pos}) * voxelSize;
+                minDist = std::min(minDist, glm::dot(d, d));
+            }
+        }
+    }
+    return minDist;
+}
+
+}  // namespace
+
+TEST(DistanceTransformTests, VolumeMatchesBruteForce) {
+    const size3_t srcDim{9, 7, 5};
+    const size3_t upsample{1, 2, 3};
+    const size3_t dstDim = srcDim * upsample;
+    const mat3 basis{vec3{1.0f, 0.0f, 0.0f}, vec3{0.0f, 2.0f, 0.0f}, vec3{0.0f, 0.0f, 1.5f}};
+    const dvec3 voxelSize{1.0 / dstDim.x, 2.0 / dstDim.y, 1.5 / dstDim.z};
+
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<int> dist(0, 15);
+
+    VolumeRAMPrecision<unsigned char> src(srcDim);
+    auto srcData = src.getDataTyped();
+    for (size_t i = 0; i < glm::compMul(srcDim); ++i) {
+        srcData[i] = dist(gen) == 0 ? 1 : 0;
+    }
+
+    VolumeRAMPrecision<float> dst(dstDim);
+    VolumeRAMPrecision<glm::i64> features(dstDim);
+    util::volumeRAMDistanceTransform(
+        &src, &dst, &features, basis, upsample, [](const unsigned char& v) { return v != 0; },
+        [](const float& squareDist) { return squareDist; }, [](double) {});
+
+    const auto dstData = dst.getDataTyped();
+    const auto featureData = features.getDataTyped();
+    for (size_t z = 0; z < dstDim.z; ++z) {
+        for (size_t y = 0; y < dstDim.y; ++y) {
+            for (size_t x = 0; x < dstDim.x; ++x) {
+                const size_t i = x + dstDim.x * (y + dstDim.y * z);
+                const auto expected =
+                    bruteForceDistance(srcData, srcDim, upsample, voxelSize, {x, y, z});
+                EXPECT_NEAR(expected, dstData[i], 1.0e-4 * (1.0 + expected));
+
+                // The feature has to be a feature voxel, and one of the closest
+                const auto feature = featureData[i];
+                ASSERT_GE(feature, 0);
+                ASSERT_LT(feature, static_cast<glm::i64>(glm::compMul(srcDim)));
+                EXPECT_NE(0, srcData[feature]);
+            }
+        }
+    }
+}
+
+TEST(DistanceTransformTests, LayerWithoutFeatures) {
+    const size2_t dim{16, 8};
+    LayerRAMPrecision<float> src(dim);
+    std::fill(src.getDataTyped(), src.getDataTyped() + glm::compMul(dim), 0.0f);
+
+    LayerRAMPrecision<float> dst(dim);
+    LayerRAMPrecision<glm::i64> features(dim);
+    const mat2 basis{vec2{2.0f, 0.0f}, vec2{0.0f, 1.0f}};
+    util::layerRAMDistanceTransform(
+        &src, &dst, &features, basis, size2_t{1}, [](const float& v) { return v > 0.5f; },
+        [](const float& squareDist) { return squareDist; }, [](double) {});
+
+    for (size_t i = 0; i < glm::compMul(dim); ++i) {
+        EXPECT_FLOAT_EQ(5.0f, dst.getDataTyped()[i]);
+        EXPECT_EQ(-1, features.getDataTyped()[i]);
+    }
+}
+
+TEST(DistanceTransformTests, LayerSingleFeature) {
+    const size2_t dim{11, 13};
+    LayerRAMPrecision<float> src(dim);
+    std::fill(src.getDataTyped(), src.getDataTyped() + glm::compMul(dim), 0.0f);
+    const size2_t pos{3, 8};
+    src.getDataTyped()[pos.x + dim.x * pos.y] = 1.0f;
+
+    LayerRAMPrecision<float> dst(dim);
+    LayerRAMPrecision<glm::i64> features(dim);
+    const mat2 basis{vec2{static_cast<float>(dim.x), 0.0f},
+                     vec2{0.0f, static_cast<float>(dim.y)}};
+    util::layerRAMDistanceTransform(
+        &src, &dst, &features, basis, size2_t{1}, [](const float& v) { return v > 0.5f; },
+        [](const float& squareDist) { return std::sqrt(squareDist); }, [](double) {});
+
+    for (size_t y = 0; y < dim.y; ++y) {
+        for (size_t x = 0; x < dim.x; ++x) {
+            const auto expected = glm::distance(dvec2{x, y}, dvec2{pos});
+            EXPECT_NEAR(expected, dst.getDataTyped()[x + dim.x * y], 1.0e-4);
+            EXPECT_EQ(static_cast<glm::i64>(pos.x + dim.x * pos.y),
+                      features.getDataTyped()[x + dim.x * y]);
+        }
+    }
+}
+
+}  // namespace inviwo
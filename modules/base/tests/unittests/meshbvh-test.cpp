@@ -0,0 +1,210 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/algorithm/mesh/meshbvh.h>
+#include <inviwo/core/datastructures/geometry/simplemesh.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+
+#include <random>
+
+namespace inviwo {
+
+namespace {
+
+// Random small triangles in the unit cube
+std::shared_ptr<SimpleMesh> makeTriangleSoup(size_t count, std::mt19937& gen) {
+    std::uniform_real_distribution<float> pos(0.0f, 1.0f);
+    std::uniform_real_distribution<float> offset(-0.05f, 0.05f);
+    auto mesh = std::make_shared<SimpleMesh>(DrawType::Triangles, ConnectivityType::None);
+    for (size_t i = 0; i < count; ++i) {
+        const vec3 center{pos(gen), pos(gen), pos(gen)};
+        for (int j = 0; j < 3; ++j) {
+            const vec3 p = center + vec3{offset(gen), offset(gen), offset(gen)};
+            mesh->addIndex(mesh->addVertex(p, p, vec4{1.0f}));
+        }
+    }
+    return mesh;
+}
+
+// Closed box [0.2, 0.8]^3 with two triangles per side
+std::shared_ptr<SimpleMesh> makeBox() {
+    auto mesh = std::make_shared<SimpleMesh>(DrawType::Triangles, ConnectivityType::None);
+    for (int i = 0; i < 8; ++i) {
+        const vec3 p{i & 1 ? 0.8f : 0.2f, i & 2 ? 0.8f : 0.2f, i & 4 ? 0.8f : 0.2f};
+        mesh->addVertex(p, p, vec4{1.0f});
+    }
+    mesh->addIndices(0, 2, 1, 1, 2, 3, 4, 5, 6, 5, 7, 6, 0, 1, 4, 1, 5, 4, 2, 6, 3, 3, 6, 7, 0,
+                     4, 2, 2, 4, 6, 1, 3, 5, 3, 7, 5);
+    return mesh;
+}
+
+float rayTriangle(const vec3& o, const vec3& d, const vec3& a, const vec3& b, const vec3& c) {
+    const auto n = glm::cross(b - a, c - a);
+    const auto denom = glm::dot(n, d);
+    if (denom == 0.0f) return std::numeric_limits<float>::infinity();
+    const auto t = glm::dot(n, a - o) / denom;
+    const auto p = o + t * d;
+    const auto inside = glm::dot(glm::cross(b - a, p - a), n) >= 0.0f &&
+                        glm::dot(glm::cross(c - b, p - b), n) >= 0.0f &&
+                        glm::dot(glm::cross(a - c, p - c), n) >= 0.0f;
+    return inside && t >= 0.0f ? t : std::numeric_limits<float>::infinity();
+}
+
+}  // namespace
+
+TEST(MeshBVHTests, RaycastMatchesBruteForce) {
+    std::mt19937 gen(0);
+    auto mesh = makeTriangleSoup(5000, gen);
+    const MeshBVH bvh(*mesh);
+    const auto& pos = mesh->getVertexList()->getRAMRepresentation()->getDataContainer();
+    ASSERT_EQ(size_t{5000}, bvh.getNumberOfTriangles());
+
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (int i = 0; i < 200; ++i) {
+        const vec3 origin{dist(gen) + 0.5f, dist(gen) + 0.5f, dist(gen) + 0.5f};
+        const auto dir = glm::normalize(vec3{dist(gen), dist(gen), dist(gen)});
+
+        float expected = std::numeric_limits<float>::infinity();
+        for (std::uint32_t t = 0; t < 5000; ++t) {
+            expected = std::min(expected, rayTriangle(origin, dir, pos[3 * t], pos[3 * t + 1],
+                                                      pos[3 * t + 2]));
+        }
+        const auto hit = bvh.raycast(origin, dir);
+        if (expected == std::numeric_limits<float>::infinity()) {
+            EXPECT_FALSE(hit);
+        } else {
+            ASSERT_TRUE(hit);
+            EXPECT_NEAR(expected, hit.t, 1e-4f);
+        }
+    }
+}
+
+TEST(MeshBVHTests, ClosestPointMatchesBruteForce) {
+    std::mt19937 gen(1);
+    auto mesh = makeTriangleSoup(2000, gen);
+    const MeshBVH bvh(*mesh);
+    const auto& pos = mesh->getVertexList()->getRAMRepresentation()->getDataContainer();
+
+    std::uniform_real_distribution<float> dist(-0.5f, 1.5f);
+    for (int i = 0; i < 100; ++i) {
+        const vec3 p{dist(gen), dist(gen), dist(gen)};
+        const auto res = bvh.closestPoint(p);
+        ASSERT_TRUE(res);
+        EXPECT_NEAR(glm::distance(p, res.point), res.distance, 1e-5f);
+        // No vertex can be closer than the closest point
+        for (const auto& v : pos) EXPECT_LE(res.distance, glm::distance(p, v) + 1e-5f);
+        // The closest point lies on the reported triangle
+        const auto& tri = bvh.getTriangle(res.triangle);
+        const auto n =
+            glm::normalize(glm::cross(pos[tri[1]] - pos[tri[0]], pos[tri[2]] - pos[tri[0]]));
+        EXPECT_NEAR(0.0f, glm::dot(n, res.point - pos[tri[0]]), 1e-5f);
+    }
+    EXPECT_FALSE(bvh.closestPoint(vec3{10.0f}, 1.0f));
+}
+
+TEST(MeshBVHTests, QueriesMatchBruteForce) {
+    std::mt19937 gen(2);
+    auto mesh = makeTriangleSoup(3000, gen);
+    const MeshBVH bvh(*mesh);
+    const auto& pos = mesh->getVertexList()->getRAMRepresentation()->getDataContainer();
+
+    const vec3 min{0.2f, 0.3f, 0.1f};
+    const vec3 max{0.6f, 0.5f, 0.9f};
+    auto boxResult = bvh.query(min, max);
+    std::sort(boxResult.begin(), boxResult.end());
+    std::vector<std::uint32_t> boxExpected;
+    for (std::uint32_t t = 0; t < 3000; ++t) {
+        const auto tmin = glm::min(pos[3 * t], glm::min(pos[3 * t + 1], pos[3 * t + 2]));
+        const auto tmax = glm::max(pos[3 * t], glm::max(pos[3 * t + 1], pos[3 * t + 2]));
+        if (glm::all(glm::lessThanEqual(tmin, max)) && glm::all(glm::lessThanEqual(min, tmax))) {
+            boxExpected.push_back(t);
+        }
+    }
+    EXPECT_EQ(boxExpected, boxResult);
+
+    const std::vector<Plane> planes{Plane(vec3{0.3f}, vec3{1.0f, 0.2f, 0.0f}),
+                                    Plane(vec3{0.7f}, vec3{-0.3f, -1.0f, 0.1f})};
+    auto planeResult = bvh.query(planes);
+    std::sort(planeResult.begin(), planeResult.end());
+    std::vector<std::uint32_t> planeExpected;
+    for (std::uint32_t t = 0; t < 3000; ++t) {
+        const auto outside = std::any_of(planes.begin(), planes.end(), [&](const Plane& p) {
+            return !p.isInside(pos[3 * t]) && !p.isInside(pos[3 * t + 1]) &&
+                   !p.isInside(pos[3 * t + 2]);
+        });
+        if (!outside) planeExpected.push_back(t);
+    }
+    EXPECT_EQ(planeExpected, planeResult);
+}
+
+TEST(MeshBVHTests, PointInMesh) {
+    auto box = makeBox();
+    const MeshBVH bvh(*box);
+    EXPECT_TRUE(bvh.isInside(vec3{0.5f}));
+    EXPECT_TRUE(bvh.isInside(vec3{0.21f, 0.79f, 0.5f}));
+    EXPECT_FALSE(bvh.isInside(vec3{0.1f, 0.5f, 0.5f}));
+    EXPECT_FALSE(bvh.isInside(vec3{0.5f, 0.5f, 0.9f}));
+
+    const auto bounds = bvh.getBounds();
+    EXPECT_EQ(vec3{0.2f}, bounds.first);
+    EXPECT_EQ(vec3{0.8f}, bounds.second);
+}
+
+TEST(MeshBVHTests, CacheIsRebuiltWhenBuffersChange) {
+    std::shared_ptr<SimpleMesh> box = makeBox();
+    const auto bvh = MeshBVH::get(box);
+    EXPECT_EQ(bvh, MeshBVH::get(box));
+
+    auto& positions = static_cast<Buffer<vec3>*>(box->getBuffer(0))
+                          ->getEditableRAMRepresentation()
+                          ->getDataContainer();
+    for (auto& p : positions) p *= 2.0f;
+    const auto rebuilt = MeshBVH::get(box);
+    EXPECT_NE(bvh, rebuilt);
+    EXPECT_EQ(vec3{1.6f}, rebuilt->getBounds().second);
+}
+
+TEST(MeshBVHTests, CacheIsReleasedWithMesh) {
+    std::shared_ptr<SimpleMesh> box = makeBox();
+    std::weak_ptr<const MeshBVH> bvh = MeshBVH::get(box);
+    EXPECT_FALSE(bvh.expired());
+
+    std::unique_ptr<Mesh> copy{box->clone()};
+    EXPECT_EQ(nullptr, copy->getDerivedData(typeid(MeshBVH)));
+
+    box.reset();
+    EXPECT_TRUE(bvh.expired());
+}
+
+}  // namespace inviwo
@@ -0,0 +1,164 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/algorithm/mesh/meshplaneclipper.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+
+#include <array>
+#include <map>
+
+namespace inviwo {
+
+namespace {
+
+// Unit cube with n x n quads on each side, with shared vertices and outward facing triangles
+std::shared_ptr<SimpleMesh> makeCube(int n) {
+    auto mesh = std::make_shared<SimpleMesh>(DrawType::Triangles, ConnectivityType::None);
+    std::map<std::array<int, 3>, unsigned int> vertices;
+    auto vertex = [&](std::array<int, 3> c) {
+        auto it = vertices.find(c);
+        if (it != vertices.end()) return it->second;
+        const vec3 pos{static_cast<float>(c[0]) / n, static_cast<float>(c[1]) / n,
+                       static_cast<float>(c[2]) / n};
+        const auto index = mesh->addVertex(pos, pos, vec4{pos, 1.0f});
+        vertices[c] = index;
+        return index;
+    };
+    for (int axis = 0; axis < 3; ++axis) {
+        for (int side = 0; side < 2; ++side) {
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < n; ++j) {
+                    auto corner = [&](int u, int v) {
+                        std::array<int, 3> c;
+                        c[axis] = side * n;
+                        c[(axis + 1) % 3] = u;
+                        c[(axis + 2) % 3] = v;
+                        return vertex(c);
+                    };
+                    const auto a = corner(i, j);
+                    const auto b = corner(i + 1, j);
+                    const auto c = corner(i + 1, j + 1);
+                    const auto d = corner(i, j + 1);
+                    if (side == 1) {
+                        mesh->addIndices(a, b, c, a, c, d);
+                    } else {
+                        mesh->addIndices(a, c, b, a, d, c);
+                    }
+                }
+            }
+        }
+    }
+    return mesh;
+}
+
+double volume(const SimpleMesh& mesh) {
+    const auto& pos = mesh.getVertexList()->getRAMRepresentation()->getDataContainer();
+    const auto& ind = mesh.getIndexList()->getRAMRepresentation()->getDataContainer();
+    double sum = 0.0;
+    for (size_t i = 0; i + 2 < ind.size(); i += 3) {
+        sum += glm::dot(dvec3{pos[ind[i]]}, glm::cross(dvec3{pos[ind[i + 1]]},
+                                                        dvec3{pos[ind[i + 2]]}));
+    }
+    return sum / 6.0;
+}
+
+// Every edge has to be used exactly once in each direction
+bool isClosed(const SimpleMesh& mesh) {
+    const auto& ind = mesh.getIndexList()->getRAMRepresentation()->getDataContainer();
+    std::map<std::pair<unsigned int, unsigned int>, int> edges;
+    for (size_t i = 0; i + 2 < ind.size(); i += 3) {
+        for (size_t k = 0; k < 3; ++k) ++edges[{ind[i + k], ind[i + (k + 1) % 3]}];
+    }
+    for (const auto& edge : edges) {
+        auto it = edges.find({edge.first.second, edge.first.first});
+        if (edge.second != 1 || it == edges.end() || it->second != 1) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST(MeshPlaneClipperTests, SinglePlaneIsClosed) {
+    auto cube = makeCube(7);
+    MeshPlaneClipper clipper;
+
+    auto res = clipper.clip(cube, {Plane(vec3{0.3f, 0.0f, 0.0f}, vec3{1.0f, 0.0f, 0.0f})});
+    EXPECT_TRUE(isClosed(*res));
+    EXPECT_NEAR(0.7, volume(*res), 1e-5);
+
+    const auto diagonal = glm::normalize(vec3{1.0f, 1.0f, 1.0f});
+    res = clipper.clip(cube, {Plane(vec3{0.5f}, diagonal)});
+    EXPECT_TRUE(isClosed(*res));
+    EXPECT_NEAR(0.5, volume(*res), 1e-5);
+
+    // Plane through a row of vertices
+    res = clipper.clip(cube, {Plane(vec3{3.0f / 7.0f, 0.0f, 0.0f}, vec3{1.0f, 0.0f, 0.0f})});
+    EXPECT_TRUE(isClosed(*res));
+    EXPECT_NEAR(4.0 / 7.0, volume(*res), 1e-5);
+}
+
+TEST(MeshPlaneClipperTests, MultiplePlanes) {
+    auto cube = makeCube(5);
+    MeshPlaneClipper clipper;
+    auto res = clipper.clip(cube, {Plane(vec3{0.3f, 0.0f, 0.0f}, vec3{1.0f, 0.0f, 0.0f}),
+                                   Plane(vec3{0.0f, 0.6f, 0.0f}, vec3{0.0f, -1.0f, 0.0f}),
+                                   Plane(vec3{0.0f, 0.0f, 0.55f}, vec3{0.0f, 0.0f, 1.0f})});
+    EXPECT_NEAR(0.7 * 0.6 * 0.45, volume(*res), 1e-5);
+
+    res = clipper.clip(cube, {Plane(vec3{2.0f, 0.0f, 0.0f}, vec3{1.0f, 0.0f, 0.0f})});
+    EXPECT_EQ(size_t{0}, res->getIndexList()->getSize());
+
+    res = clipper.clip(cube, {Plane(vec3{-2.0f, 0.0f, 0.0f}, vec3{1.0f, 0.0f, 0.0f})});
+    EXPECT_EQ(cube->getIndexList()->getSize(), res->getIndexList()->getSize());
+    EXPECT_EQ(size_t{0}, clipper.getStats().capTriangles);
+}
+
+TEST(MeshPlaneClipperTests, MovedPlaneMatchesNewClipper) {
+    auto cube = makeCube(9);
+    MeshPlaneClipper clipper;
+    const vec3 normal = glm::normalize(vec3{1.0f, 0.2f, 0.1f});
+    for (float offset : {0.3f, 0.35f, 0.5f, 0.45f, 0.1f}) {
+        const std::vector<Plane> planes{Plane(normal * offset, normal)};
+        auto moved = clipper.clip(cube, planes);
+        auto fresh = MeshPlaneClipper{}.clip(cube, planes);
+
+        const auto& a = moved->getIndexList()->getRAMRepresentation()->getDataContainer();
+        const auto& b = fresh->getIndexList()->getRAMRepresentation()->getDataContainer();
+        EXPECT_EQ(b, a);
+        EXPECT_NEAR(volume(*fresh), volume(*moved), 1e-6);
+        EXPECT_TRUE(isClosed(*moved));
+    }
+}
+
+}  // namespace inviwo
@@ -78,6 +78,10 @@ public:
     virtual ~BrushingAndLinkingOutport() = default;
 
     virtual std::string getClassIdentifier() const override;
+
+protected:
+    // The manager is modified in place, every evaluation is a new version
+    virtual bool tracksDataVersion() const override;
 };
 
 template <>
@@ -117,4 +117,6 @@ std::string BrushingAndLinkingOutport::getClassIdentifier() const {
     return PortTraits<BrushingAndLinkingOutport>::classIdentifier();
 }
 
+bool BrushingAndLinkingOutport::tracksDataVersion() const { return false; }
+
 }  // namespace inviwo
@@ -42,7 +42,7 @@
 #include <inviwo/core/ports/datainport.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 
-#include <set>
+#include <vector>
 
 namespace inviwo {
 
@@ -74,7 +74,8 @@ private:
     DataInport<Volume, 0, true> inport_;
     DataOutport<DataFrame> outport_;
 
-    std::set<size_t> filteredIDs_;
+    std::vector<size_t> filteredIDs_;  //!< sorted indices of the voxels to output, if filtered
+    bool filterDirty_ = true;
     BoolProperty reduce_;
     FloatProperty probability_;
 
@@ -29,14 +29,14 @@
 
 #include <inviwo/dataframe/processors/volumesequencetodataframe.h>
 
-#include <inviwo/core/util/volumeramutils.h>
 #include <inviwo/core/datastructures/buffer/buffer.h>
 #include <inviwo/core/datastructures/buffer/bufferram.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
-#include <inviwo/core/util/imageramutils.h>
-#include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/foreach.h>
 
 #include <algorithm>
+#include <limits>
 #include <random>
 
 namespace inviwo {
@@ -72,7 +72,10 @@ VolumeSequenceToDataFrame::VolumeSequenceToDataFrame()
     addProperty(omitOutliers_);
     addProperty(threshold_);
 
-    reduce_.onChange([this]() { probability_.setVisible(reduce_.get()); });
+    reduce_.onChange([this]() {
+        probability_.setVisible(reduce_.get());
+        filterDirty_ = true;
+    });
 
     probability_.onChange([this]() {
         if (reduce_.get()) {
@@ -80,7 +83,10 @@ VolumeSequenceToDataFrame::VolumeSequenceToDataFrame()
         }
     });
 
-    omitOutliers_.onChange([this]() { threshold_.setVisible(omitOutliers_.get()); });
+    omitOutliers_.onChange([this]() {
+        threshold_.setVisible(omitOutliers_.get());
+        filterDirty_ = true;
+    });
 
     threshold_.onChange([this]() {
         if (omitOutliers_.get()) {
@@ -90,127 +96,142 @@ VolumeSequenceToDataFrame::VolumeSequenceToDataFrame()
 }
 
 void VolumeSequenceToDataFrame::recomputeReduceBuffer() {
-    if (!inport_.hasData()) return;
-
     filteredIDs_.clear();
+    if (!inport_.hasData() || !(reduce_.get() || omitOutliers_.get())) return;
 
     auto volumeSequence = inport_.getVectorData();
-    auto first = (volumeSequence[0])->getRepresentation<VolumeRAM>();
-
-    auto dims = first->getDimensions();
-    size_t size = dims.x * dims.y * dims.z;
-
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> dis(0.0f, 1.0f);
+    const auto dims = volumeSequence[0]->getDimensions();
+    const size_t size = dims.x * dims.y * dims.z;
 
-    std::vector<const glm::f32 *> volumeData;
-
-    const auto probability = probability_.get();
+    const auto probability = reduce_.get() ? probability_.get() : 1.0f;
     const auto omitOutliers = omitOutliers_.get();
     const auto threshold = threshold_.get();
 
+    // Voxels above the threshold in any of the volumes are omitted, while the voxels with the
+    // smallest and largest value below the threshold in each volume are always kept
+    std::vector<char> outliers(omitOutliers ? size : 0, 0);
+    std::vector<size_t> extrema;
     if (omitOutliers) {
-        for (auto vol : volumeSequence) {
+        for (const auto& vol : volumeSequence) {
             if (vol->getDataFormat()->getNumericType() != NumericType::Float) continue;
-            if (vol->getDataFormat()->getComponents() != 1)
+            if (vol->getDataFormat()->getComponents() != 1) {
                 LogWarn("This volume is omitted because it has more than one channel.");
-            volumeData.push_back(
-                static_cast<const glm::f32 *>(vol->getRepresentation<VolumeRAM>()->getData()));
+                continue;
+            }
+            if (vol->getDimensions() != dims) {
+                LogWarn("This volume is omitted because its dimensions differ.");
+                continue;
+            }
+            vol->getRepresentation<VolumeRAM>()->dispatch<void, dispatching::filter::Float1s>(
+                [&](auto vr) {
+                    const auto data = vr->getDataTyped();
+                    size_t minIdx = size;
+                    size_t maxIdx = size;
+                    float minVal = std::numeric_limits<float>::max();
+                    float maxVal = std::numeric_limits<float>::lowest();
+                    for (size_t i = 0; i < size; i++) {
+                        const auto v = static_cast<float>(data[i]);
+                        if (v > threshold) {
+                            outliers[i] = 1;
+                        } else if (v < threshold) {
+                            if (v < minVal) {
+                                minVal = v;
+                                minIdx = i;
+                            }
+                            if (v > maxVal) {
+                                maxVal = v;
+                                maxIdx = i;
+                            }
+                        }
+                    }
+                    if (minIdx != size) extrema.push_back(minIdx);
+                    if (maxIdx != size) extrema.push_back(maxIdx);
+                });
         }
     }
 
-    std::vector<vec2> minMaxes;
-    minMaxes.resize(volumeData.size(),
-                    vec2(std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest()));
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_real_distribution<float> dis(0.0f, 1.0f);
 
     for (size_t i = 0; i < size; i++) {
-        for (size_t j = 0; j < volumeData.size(); j++) {
-            if (volumeData[j][i] < threshold)
-                minMaxes[j] = vec2(std::min(volumeData[j][i], minMaxes[j].x),
-                                   std::max(volumeData[j][i], minMaxes[j].y));
-        }
-        if (dis(gen) <= probability) {
-            if (omitOutliers) {
-                bool add = true;
-                for (size_t j = 0; j < volumeData.size(); j++) {
-                    if (volumeData[j][i] > threshold) {
-                        add = false;
-                        break;
-                    }
-                }
-                if (add) {
-                    filteredIDs_.insert(i);
-                }
-            } else {
-                filteredIDs_.insert(i);
-            }
-        }
+        if (omitOutliers && outliers[i]) continue;
+        if (probability >= 1.0f || dis(gen) <= probability) filteredIDs_.push_back(i);
     }
 
-    for (size_t j = 0; j < volumeData.size(); j++) {
-        const auto &minMax = minMaxes[j];
-        bool foundMin = false;
-        bool foundMax = false;
-
-        for (size_t i = 0; i < size; i++) {
-            if (foundMin && foundMax) break;
-            if (minMax.y == volumeData[j][i] && !foundMax) {
-                filteredIDs_.insert(i);
-                foundMax = true;
-            }
-            if (minMax.x == volumeData[j][i] && !foundMin) {
-                filteredIDs_.insert(i);
-                foundMin = true;
-            }
-        }
-    }
+    // Keep the indices sorted and unique, for a sequential gather in process()
+    std::sort(extrema.begin(), extrema.end());
+    const auto middle = filteredIDs_.insert(filteredIDs_.end(), extrema.begin(), extrema.end());
+    std::inplace_merge(filteredIDs_.begin(), middle, filteredIDs_.end());
+    filteredIDs_.erase(std::unique(filteredIDs_.begin(), filteredIDs_.end()), filteredIDs_.end());
 }
 
-void VolumeSequenceToDataFrame::initializeResources() { recomputeReduceBuffer(); }
+void VolumeSequenceToDataFrame::initializeResources() { filterDirty_ = true; }
 
 void VolumeSequenceToDataFrame::process() {
     if (!inport_.hasData()) return;
+    if (filterDirty_ || inport_.isChanged()) {
+        recomputeReduceBuffer();
+        filterDirty_ = false;
+    }
+
     auto volumeSequence = inport_.getVectorData();
     auto outports = inport_.getConnectedOutports();
-    auto first = (volumeSequence[0])->getRepresentation<VolumeRAM>();
 
-    auto dims = first->getDimensions();
-    size_t size = dims.x * dims.y * dims.z;
+    const auto dims = volumeSequence[0]->getDimensions();
+    const size_t size = dims.x * dims.y * dims.z;
 
-    auto dataFrame = std::make_shared<DataFrame>(static_cast<std::uint32_t>(
-        reduce_.get() || omitOutliers_.get() ? filteredIDs_.size() : size));
+    const bool filter = reduce_.get() || omitOutliers_.get();
+    const size_t rows = filter ? filteredIDs_.size() : size;
 
-    auto indexMapper = util::IndexMapper3D(dims);
+    auto dataFrame = std::make_shared<DataFrame>(static_cast<std::uint32_t>(rows));
 
     size_t volumeNumber = 1;
     for (const auto volume : volumeSequence) {
         const auto numericType = volume->getDataFormat()->getNumericType();
         if (numericType != NumericType::Float) continue;
-        std::vector<std::vector<float> *> channelBuffer_;
-        auto volumeRAM = volume->getRepresentation<VolumeRAM>();
+        if (volume->getDimensions() != dims) {
+            LogWarn("This volume is omitted because its dimensions differ.");
+            volumeNumber++;
+            continue;
+        }
+
+        std::vector<float*> channels;
         const auto numCh = volume->getDataFormat()->getComponents();
         for (size_t c = 0; c < numCh; c++) {
             auto identifier = outports[volumeNumber - 1]->getProcessor()->getIdentifier();
-            auto col = dataFrame->addColumn<float>(
-                identifier, reduce_.get() || omitOutliers_.get() ? filteredIDs_.size() : size);
-            channelBuffer_.push_back(
-                &col->getTypedBuffer()->getEditableRAMRepresentation()->getDataContainer());
+            auto col = dataFrame->addColumn<float>(identifier, rows);
+            channels.push_back(
+                col->getTypedBuffer()->getEditableRAMRepresentation()->getDataContainer().data());
         }
         volumeNumber++;
 
-        util::forEachVoxelParallel(*volumeRAM, [&, this](const size3_t &pos) {
-            const auto idx = indexMapper(pos);
-            if (filteredIDs_.find(idx) == filteredIDs_.end()) return;
-            const auto v = volumeRAM->getAsDVec4(pos);
-            for (size_t c = 0; c < numCh; c++) {
-                channelBuffer_[c]->at(idx) = float(v[c]);
-            }
-        });
+        // Dispatch once on the format and write each channel into its own column. Without a
+        // filter this is a straight de-interleaving copy, otherwise a gather of the sorted ids.
+        volume->getRepresentation<VolumeRAM>()->dispatch<void, dispatching::filter::Floats>(
+            [&](auto vr) {
+                using ValueType = util::PrecisionValueType<decltype(vr)>;
+                constexpr size_t comp = DataFormat<ValueType>::comp;
+                const auto data = vr->getDataTyped();
+                const auto ids = filteredIDs_.data();
+
+                util::forEachRangeParallel(rows, [&](size_t begin, size_t end) {
+                    for (size_t c = 0; c < comp; c++) {
+                        auto dst = channels[c];
+                        if (filter) {
+                            for (size_t i = begin; i < end; i++) {
+                                dst[i] = static_cast<float>(util::glmcomp(data[ids[i]], c));
+                            }
+                        } else {
+                            for (size_t i = begin; i < end; i++) {
+                                dst[i] = static_cast<float>(util::glmcomp(data[i], c));
+                            }
+                        }
+                    }
+                });
+            });
     }
     outport_.setData(dataFrame);
 }
 
-
-
 }  // namespace inviwo
@@ -30,6 +30,10 @@
 #include <inviwo/dataframe/processors/volumetodataframe.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <algorithm>
 
 namespace inviwo {
 
@@ -87,58 +91,53 @@ void VolumeToDataFrame::process() {
                               (rangeZ_.getEnd() - rangeZ_.getStart());
 
             auto dataFrame = std::make_shared<DataFrame>(static_cast<glm::u32>(size));
-            std::vector<std::vector<float>*> channelBuffer_;
+            const auto column = [&](const std::string& name, auto type) {
+                using T = decltype(type);
+                return dataFrame->addColumn<T>(name, size)
+                    ->getTypedBuffer()
+                    ->getEditableRAMRepresentation()
+                    ->getDataContainer()
+                    .data();
+            };
+
+            std::vector<float*> channels;
             const auto numCh = volume->getDataFormat()->getComponents();
             for (size_t c = 0; c < numCh; c++) {
-                auto col = dataFrame->addColumn<float>("Channel " + toString(c + 1), size);
-                channelBuffer_.push_back(
-                    &col->getTypedBuffer()->getEditableRAMRepresentation()->getDataContainer());
+                channels.push_back(column("Channel " + toString(c + 1), float{}));
             }
-            auto& magnitudes = dataFrame->addColumn<float>("Magnitude", size)
-                                   ->getTypedBuffer()
-                                   ->getEditableRAMRepresentation()
-                                   ->getDataContainer();
-            auto& indx = dataFrame->addColumn<int>("Index X", size)
-                             ->getTypedBuffer()
-                             ->getEditableRAMRepresentation()
-                             ->getDataContainer();
-            auto& indy = dataFrame->addColumn<int>("Index Y", size)
-                             ->getTypedBuffer()
-                             ->getEditableRAMRepresentation()
-                             ->getDataContainer();
-            auto& indz = dataFrame->addColumn<int>("Index Z", size)
-                             ->getTypedBuffer()
-                             ->getEditableRAMRepresentation()
-                             ->getDataContainer();
-            auto& posx = dataFrame->addColumn<float>("Position X", size)
-                             ->getTypedBuffer()
-                             ->getEditableRAMRepresentation()
-                             ->getDataContainer();
-            auto& posy = dataFrame->addColumn<float>("Position Y", size)
-                             ->getTypedBuffer()
-                             ->getEditableRAMRepresentation()
-                             ->getDataContainer();
-            auto& posz = dataFrame->addColumn<float>("Position Z", size)
-                             ->getTypedBuffer()
-                             ->getEditableRAMRepresentation()
-                             ->getDataContainer();
+            auto magnitudes = column("Magnitude", float{});
+            auto indx = column("Index X", int{});
+            auto indy = column("Index Y", int{});
+            auto indz = column("Index Z", int{});
+            auto posx = column("Position X", float{});
+            auto posy = column("Position Y", float{});
+            auto posz = column("Position Z", float{});
 
             const auto indexToModel = volume->getCoordinateTransformer().getIndexToModelMatrix();
 
+            const size3_t start{rangeX_.getStart(), rangeY_.getStart(), rangeZ_.getStart()};
+            const size3_t extent{rangeX_.getEnd() - start.x, rangeY_.getEnd() - start.y,
+                                 rangeZ_.getEnd() - start.z};
+
             volume->getRepresentation<VolumeRAM>()->dispatch<void>([&](auto vr) {
-                const auto im = util::IndexMapper3D(vr->getDimensions());
                 using ValueType = util::PrecisionValueType<decltype(vr)>;
+                const auto im = util::IndexMapper3D(vr->getDimensions());
                 const auto data = vr->getDataTyped();
-                auto i = 0;
-                size3_t ind;
-                for (ind.z = rangeZ_.getStart(); ind.z < rangeZ_.getEnd(); ind.z++) {
-                    for (ind.y = rangeY_.getStart(); ind.y < rangeY_.getEnd(); ind.y++) {
-                        for (ind.x = rangeX_.getStart(); ind.x < rangeX_.getEnd(); ind.x++) {
-                            const auto v = util::glm_convert<dvec4>(data[im(ind)]);
+
+                // Each row along x is contiguous in both the volume and the columns, the rows are
+                // converted in parallel
+                util::forEachRangeParallel(extent.y * extent.z, [&](size_t begin, size_t end) {
+                    for (size_t row = begin; row < end; ++row) {
+                        size3_t ind{start.x, start.y + row % extent.y, start.z + row / extent.y};
+                        const ValueType* src = data + im(ind);
+                        const size_t offset = row * extent.x;
+                        for (size_t x = 0; x < extent.x; ++x, ++ind.x) {
+                            const size_t i = offset + x;
                             double m = 0.0;
                             for (size_t c = 0; c < DataFormat<ValueType>::comp; c++) {
-                                (*channelBuffer_[c])[i] = static_cast<float>(v[c]);
-                                m += v[c] * v[c];
+                                const auto v = static_cast<double>(util::glmcomp(src[x], c));
+                                channels[c][i] = static_cast<float>(v);
+                                m += v * v;
                             }
                             magnitudes[i] = static_cast<float>(std::sqrt(m));
 
@@ -151,16 +150,15 @@ void VolumeToDataFrame::process() {
                             posx[i] = static_cast<float>(pos.x);
                             posy[i] = static_cast<float>(pos.y);
                             posz[i] = static_cast<float>(pos.z);
-                            ++i;
                         }
                     }
-                }
+                });
             });
             outport_.setData(dataFrame);
             break;
         }
         case Mode::XDir: {
-            const auto size = rangeX_.getEnd() - rangeY_.getStart();
+            const auto size = rangeX_.getEnd() - rangeX_.getStart();
             auto dataFrame = std::make_shared<DataFrame>(static_cast<glm::u32>(size));
 
             volume->getRepresentation<VolumeRAM>()->dispatch<void>([this, dataFrame,
@@ -176,10 +174,9 @@ void VolumeToDataFrame::process() {
                         auto& line = col->getTypedBuffer()
                                          ->getEditableRAMRepresentation()
                                          ->getDataContainer();
-                        size_t i = 0;
-                        for (ind.x = rangeX_.getStart(); ind.x < rangeX_.getEnd(); ind.x++) {
-                            line[i++] = data[im(ind)];
-                        }
+                        ind.x = rangeX_.getStart();
+                        const auto src = data + im(ind);
+                        std::copy(src, src + size, line.begin());
                     }
                 }
             });
@@ -34,6 +34,8 @@
 #endif
 #endif
 
+#include <inviwo/core/util/logcentral.h>
+#include <inviwo/core/util/consolelogger.h>
 #include <inviwo/testutil/configurablegtesteventlistener.h>
 
 #include <warn/push>
@@ -42,6 +44,12 @@
 #include <warn/pop>
 
 int main(int argc, char** argv) {
+    // Processors under test log warnings
+    inviwo::LogCentral::init();
+    auto logger = std::make_shared<inviwo::ConsoleLogger>();
+    inviwo::LogCentral::getPtr()->setVerbosity(inviwo::LogVerbosity::Error);
+    inviwo::LogCentral::getPtr()->registerLogger(logger);
+
     int ret = -1;
     {
 #ifdef IVW_ENABLE_MSVC_MEM_LEAK_TEST
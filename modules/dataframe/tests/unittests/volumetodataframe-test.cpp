@@ -0,0 +1,208 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/dataframe/processors/volumesequencetodataframe.h>
+#include <inviwo/dataframe/processors/volumetodataframe.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/ports/volumeport.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/minmaxproperty.h>
+#include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <numeric>
+
+namespace inviwo {
+
+namespace {
+
+// Provides a volume to the processor under test, the identifier names the columns
+class VolumeProvider : public Processor {
+public:
+    VolumeProvider(const std::string& id, std::shared_ptr<Volume> volume)
+        : Processor(id, id), outport_("outport") {
+        addPort(outport_);
+        outport_.setData(volume);
+    }
+    virtual void process() override {}
+    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+    static const ProcessorInfo processorInfo_;
+
+    VolumeOutport outport_;
+};
+
+const ProcessorInfo VolumeProvider::processorInfo_{
+    "org.inviwo.VolumeProvider",  // Class identifier
+    "VolumeProvider",             // Display name
+    "Testing",                    // Category
+    CodeState::Stable,            // Code state
+    Tags::CPU,                    // Tags
+};
+
+template <typename T, typename F>
+std::shared_ptr<Volume> makeVolume(size3_t dims, F value) {
+    auto ram = std::make_shared<VolumeRAMPrecision<T>>(dims);
+    auto data = ram->getDataTyped();
+    for (size_t i = 0; i < glm::compMul(dims); ++i) data[i] = value(i);
+    return std::make_shared<Volume>(ram);
+}
+
+template <typename P>
+P& property(Processor& processor, const std::string& identifier) {
+    auto property = dynamic_cast<P*>(processor.getPropertyByIdentifier(identifier));
+    if (!property) throw Exception("Property not found: " + identifier, IvwContextCustom("Test"));
+    return *property;
+}
+
+std::shared_ptr<const DataFrame> getDataFrame(const Processor& processor) {
+    return static_cast<DataOutport<DataFrame>*>(processor.getOutports()[0])->getData();
+}
+
+void checkColumn(const DataFrame& dataFrame, size_t col, const std::string& header,
+                 const std::vector<double>& expected) {
+    SCOPED_TRACE("column " + toString(col));
+    ASSERT_LT(col, dataFrame.getNumberOfColumns());
+    const auto column = dataFrame.getColumn(col);
+    EXPECT_EQ(header, column->getHeader());
+    ASSERT_EQ(expected.size(), column->getSize());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i], column->getAsDouble(i)) << "row " << i;
+    }
+}
+
+// A scalar volume "a" and a two channel volume "b" connected to a VolumeSequenceToDataFrame
+struct SequenceFixture {
+    static constexpr size_t size = 27;
+    static double a(size_t i) { return static_cast<double>((i * 7) % size); }
+    static dvec2 b(size_t i) { return dvec2(0.5 * i, -2.0 * i); }
+
+    SequenceFixture()
+        : providerA{"a", makeVolume<float>(size3_t{3}, [](size_t i) { return float(a(i)); })}
+        , providerB{"b", makeVolume<vec2>(size3_t{3}, [](size_t i) { return vec2(b(i)); })} {
+        processor.getInports()[0]->connectTo(providerA.getOutports()[0]);
+        processor.getInports()[0]->connectTo(providerB.getOutports()[0]);
+    }
+
+    void check(const std::vector<size_t>& ids) {
+        const auto dataFrame = getDataFrame(processor);
+        ASSERT_TRUE(dataFrame);
+        ASSERT_EQ(4, dataFrame->getNumberOfColumns());
+        std::vector<double> index, colA, colB0, colB1;
+        for (size_t i = 0; i < ids.size(); ++i) {
+            index.push_back(static_cast<double>(i));
+            colA.push_back(a(ids[i]));
+            colB0.push_back(b(ids[i]).x);
+            colB1.push_back(b(ids[i]).y);
+        }
+        checkColumn(*dataFrame, 0, "index", index);
+        checkColumn(*dataFrame, 1, "a", colA);
+        checkColumn(*dataFrame, 2, "b", colB0);
+        checkColumn(*dataFrame, 3, "b", colB1);
+    }
+
+    VolumeProvider providerA;
+    VolumeProvider providerB;
+    VolumeSequenceToDataFrame processor;
+};
+
+}  // namespace
+
+TEST(VolumeSequenceToDataFrame, unfiltered) {
+    SequenceFixture fixture;
+    property<BoolProperty>(fixture.processor, "reduce").set(false);
+    property<BoolProperty>(fixture.processor, "omitOutliers").set(false);
+    fixture.processor.process();
+
+    std::vector<size_t> ids(SequenceFixture::size);
+    std::iota(ids.begin(), ids.end(), size_t{0});
+    fixture.check(ids);
+}
+
+TEST(VolumeSequenceToDataFrame, filtered) {
+    SequenceFixture fixture;
+    // Keep every voxel that is not an outlier, the two channel volume is not considered for
+    // outliers but gathered at the same voxels
+    property<BoolProperty>(fixture.processor, "reduce").set(true);
+    property<FloatProperty>(fixture.processor, "probability").set(1.0f);
+    property<BoolProperty>(fixture.processor, "omitOutliers").set(true);
+    property<FloatProperty>(fixture.processor, "threshold").set(10.0f);
+    fixture.processor.process();
+
+    std::vector<size_t> ids;
+    for (size_t i = 0; i < SequenceFixture::size; ++i) {
+        if (SequenceFixture::a(i) <= 10.0) ids.push_back(i);
+    }
+    fixture.check(ids);
+}
+
+TEST(VolumeToDataFrame, xDir) {
+    const size3_t dims{6, 4, 3};
+    VolumeProvider provider{"volume",
+                            makeVolume<float>(dims, [](size_t i) { return float(i) * 0.25f; })};
+    VolumeToDataFrame processor;
+    processor.getInports()[0]->connectTo(provider.getOutports()[0]);
+
+    property<BaseOptionProperty>(processor, "mode").setSelectedIdentifier("xdir");
+    const auto setRange = [&](const std::string& identifier, size_t dim, size2_t range) {
+        auto& minMax = property<IntSizeTMinMaxProperty>(processor, identifier);
+        minMax.setRangeMax(dim);
+        minMax.set(range);
+    };
+    const size2_t xRange{2, 5};
+    setRange("xrange", dims.x, xRange);
+    setRange("yrange", dims.y, size2_t{1, 3});
+    setRange("zrange", dims.z, size2_t{1, 3});
+    processor.process();
+
+    const auto dataFrame = getDataFrame(processor);
+    ASSERT_TRUE(dataFrame);
+    // the index column and one column per line along x
+    ASSERT_EQ(1 + 2 * 2, dataFrame->getNumberOfColumns());
+    EXPECT_EQ(xRange.y - xRange.x, dataFrame->getNumberOfRows());
+
+    const util::IndexMapper3D im(dims);
+    size_t col = 1;
+    for (size_t z = 1; z < 3; ++z) {
+        for (size_t y = 1; y < 3; ++y) {
+            std::vector<double> expected;
+            for (size_t x = xRange.x; x < xRange.y; ++x) {
+                expected.push_back(im(size3_t{x, y, z}) * 0.25);
+            }
+            checkColumn(*dataFrame, col++, "y:" + toString(y) + " z:" + toString(z), expected);
+        }
+    }
+}
+
+}  // namespace inviwo
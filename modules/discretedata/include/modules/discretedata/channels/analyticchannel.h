@@ -86,6 +86,17 @@ public:
     }
 
 protected:
+    /**
+     * \brief Evaluate the function for all indices in [start, end)
+     * Writes directly into dest, without going through fillRaw for each element.
+     */
+    void fillRawBlock(T* dest, ind start, ind end) const override {
+        Vec* destVec = reinterpret_cast<Vec*>(dest);
+        for (ind index = start; index < end; ++index) {
+            dataFunction_(*destVec++, index);
+        }
+    }
+
     virtual CachedGetter<AnalyticChannel>* newIterator() override {
         return new CachedGetter<AnalyticChannel>(this);
     }
@@ -157,6 +157,12 @@ protected:
         memcpy(dest, &buffer_[index * N], sizeof(T) * N);
     }
 
+    virtual void fillRawBlock(T* dest, ind start, ind end) const override {
+        std::copy(buffer_.begin() + start * N, buffer_.begin() + end * N, dest);
+    }
+
+    virtual const T* rawData() const override { return buffer_.data(); }
+
     /**
      * \brief Vector containing the buffer data
      * Resizeable only by DataSet. Handle with care:
@@ -0,0 +1,67 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/discretedata/discretedatatypes.h>
+
+namespace inviwo {
+namespace discretedata {
+
+/**
+ * \brief Non-owning view of a contiguous block of channel elements.
+ *
+ * Handed out by DataChannel::span and DataChannel::forEachBlock. The view is invalidated when
+ * the underlying buffer is resized or, for blocks filled on demand, when the callback returns.
+ */
+template <typename VecNT>
+class ChannelSpan {
+public:
+    using value_type = typename std::remove_cv<VecNT>::type;
+    using iterator = VecNT*;
+
+    ChannelSpan() = default;
+    ChannelSpan(VecNT* data, ind size) : data_{data}, size_{size} {}
+
+    VecNT* data() const { return data_; }
+    ind size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    iterator begin() const { return data_; }
+    iterator end() const { return data_ + size_; }
+
+    VecNT& operator[](ind index) const { return data_[index]; }
+
+private:
+    VecNT* data_ = nullptr;
+    ind size_ = 0;
+};
+
+}  // namespace discretedata
+}  // namespace inviwo
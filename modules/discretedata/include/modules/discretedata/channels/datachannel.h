@@ -34,6 +34,11 @@
 #include <modules/discretedata/channels/channel.h>
 #include <modules/discretedata/channels/channelgetter.h>
 #include <modules/discretedata/channels/channeliterator.h>
+#include <modules/discretedata/channels/channelspan.h>
+#include <inviwo/core/util/foreach.h>
+
+#include <algorithm>
+#include <vector>
 
 namespace inviwo {
 namespace discretedata {
@@ -48,6 +53,19 @@ public:
 protected:
     virtual void fillRaw(T* dest, ind index) const = 0;
     virtual ChannelGetter<T, N>* newIterator() = 0;
+
+    /**
+     * \brief Fill the elements [start, end) into dest, N values of T per element.
+     * The default calls fillRaw per element, override when a whole block can be filled at once.
+     */
+    virtual void fillRawBlock(T* dest, ind start, ind end) const {
+        for (ind index = start; index < end; ++index, dest += N) fillRaw(dest, index);
+    }
+
+    /**
+     * \brief Pointer to the elements if they are stored contiguously in memory, else nullptr.
+     */
+    virtual const T* rawData() const { return nullptr; }
 };
 
 /**
@@ -68,6 +86,8 @@ class DataChannel : public BaseChannel<T, N> {
 
 public:
     static constexpr ind num_comp = N;
+    //! Default number of elements per block in forEachBlock
+    static constexpr ind defaultBlockSize = 4096;
     using value_type = T;
 
     template <typename VecNT>
@@ -106,6 +126,52 @@ public:
         fill(dest, index);
     }
 
+    /**
+     * \brief Copy the elements [start, end) to dest
+     * Only one virtual call for the whole block instead of one per element.
+     * Thread safe.
+     * @param dest Position to write to, expect (end - start) many VecNT
+     * @param start First linear index
+     * @param end One past the last linear index
+     * @param parallel Split the block over the thread pool, the channel has to support
+     * concurrent reads, i.e. the function of an AnalyticChannel needs to be thread safe.
+     */
+    template <typename VecNT>
+    void fillBlock(VecNT* dest, ind start, ind end, bool parallel = false) const;
+
+    /**
+     * \brief Contiguous view of all elements
+     * Only available if the channel is stored in memory, as a BufferChannel, otherwise the
+     * returned span is empty. Use forEachBlock to handle any channel.
+     */
+    template <typename VecNT = DefaultVec>
+    ChannelSpan<const VecNT> span() const {
+        static_assert(sizeof(VecNT) == sizeof(T) * N,
+                      "Size and type do not agree with the vector type.");
+        const T* raw = this->rawData();
+        return ChannelSpan<const VecNT>(reinterpret_cast<const VecNT*>(raw),
+                                        raw ? this->size() : 0);
+    }
+
+    /**
+     * \brief Visit all elements in consecutive blocks
+     * Calls callback(ChannelSpan<const VecNT> block, ind start) for each block. Channels stored in
+     * memory hand out views of their data, all others fill a scratch block per call using
+     * fillBlock. Prefer this over the iterators for passes over large channels.
+     * @param callback Functor taking a block and the linear index of its first element
+     * @param blockSize Maximal number of elements per block
+     */
+    template <typename VecNT = DefaultVec, typename Callback>
+    void forEachBlock(Callback callback, ind blockSize = defaultBlockSize) const;
+
+    /**
+     * \brief Visit all elements in consecutive blocks using the thread pool
+     * Same as forEachBlock, but blocks are processed concurrently and in no particular order.
+     * The callback has to be thread safe.
+     */
+    template <typename VecNT = DefaultVec, typename Callback>
+    void forEachBlockParallel(Callback callback, ind blockSize = defaultBlockSize) const;
+
     template <typename VecNT = DefaultVec>
     iterator<VecNT> begin() {
         return iterator<VecNT>(this->newIterator(), 0);
@@ -196,6 +262,68 @@ template <typename T, ind N>
 DataChannel<T, N>::DataChannel(const std::string& name, GridPrimitive definedOn)
     : BaseChannel<T, N>(name, DataFormat<T>::id(), definedOn) {}
 
+template <typename T, ind N>
+template <typename VecNT>
+void DataChannel<T, N>::fillBlock(VecNT* dest, ind start, ind end, bool parallel) const {
+    static_assert(sizeof(VecNT) == sizeof(T) * N,
+                  "Size and type do not agree with the vector type.");
+    T* rawDest = reinterpret_cast<T*>(dest);
+    if (!parallel) {
+        this->fillRawBlock(rawDest, start, end);
+        return;
+    }
+    util::forEachRangeParallel(static_cast<size_t>(end - start), [&](size_t begin, size_t stop) {
+        this->fillRawBlock(rawDest + begin * N, start + static_cast<ind>(begin),
+                           start + static_cast<ind>(stop));
+    });
+}
+
+template <typename T, ind N>
+template <typename VecNT, typename Callback>
+void DataChannel<T, N>::forEachBlock(Callback callback, ind blockSize) const {
+    static_assert(sizeof(VecNT) == sizeof(T) * N,
+                  "Size and type do not agree with the vector type.");
+    const ind numElements = this->size();
+    if (auto raw = reinterpret_cast<const VecNT*>(this->rawData())) {
+        for (ind start = 0; start < numElements; start += blockSize) {
+            const ind count = std::min(blockSize, numElements - start);
+            callback(ChannelSpan<const VecNT>(raw + start, count), start);
+        }
+        return;
+    }
+
+    std::vector<VecNT> block(static_cast<size_t>(std::min(blockSize, numElements)));
+    for (ind start = 0; start < numElements; start += blockSize) {
+        const ind end = std::min(start + blockSize, numElements);
+        fillBlock(block.data(), start, end);
+        callback(ChannelSpan<const VecNT>(block.data(), end - start), start);
+    }
+}
+
+template <typename T, ind N>
+template <typename VecNT, typename Callback>
+void DataChannel<T, N>::forEachBlockParallel(Callback callback, ind blockSize) const {
+    static_assert(sizeof(VecNT) == sizeof(T) * N,
+                  "Size and type do not agree with the vector type.");
+    const ind numElements = this->size();
+    const ind numBlocks = (numElements + blockSize - 1) / blockSize;
+    const auto raw = reinterpret_cast<const VecNT*>(this->rawData());
+
+    util::forEachRangeParallel(static_cast<size_t>(numBlocks), [&](size_t begin, size_t stop) {
+        std::vector<VecNT> block(raw ? 0 : static_cast<size_t>(std::min(blockSize, numElements)));
+        for (auto b = static_cast<ind>(begin); b < static_cast<ind>(stop); ++b) {
+            const ind start = b * blockSize;
+            const ind end = std::min(start + blockSize, numElements);
+            if (raw) {
+                callback(ChannelSpan<const VecNT>(raw + start, end - start), start);
+            } else {
+                fillBlock(block.data(), start, end);
+                callback(ChannelSpan<const VecNT>(block.data(), end - start), start);
+            }
+        }
+    });
+}
+
 template <typename T, ind N>
 template <typename VecNT>
 void DataChannel<T, N>::getMin(VecNT& dest) const {
@@ -247,12 +375,14 @@ void DataChannel<T, N>::computeMinMax() const {
     this->fill(minT, 0);
     this->fill(maxT, 0);
 
-    for (const Vec& val : this->all<Vec>()) {
-        for (ind dim = 0; dim < N; ++dim) {
-            minT[dim] = std::min(minT[dim], val[dim]);
-            maxT[dim] = std::max(maxT[dim], val[dim]);
+    this->template forEachBlock<Vec>([&](ChannelSpan<const Vec> block, ind) {
+        for (const Vec& val : block) {
+            for (ind dim = 0; dim < N; ++dim) {
+                minT[dim] = std::min(minT[dim], val[dim]);
+                maxT[dim] = std::max(maxT[dim], val[dim]);
+            }
         }
-    }
+    });
 
     for (ind dim = 0; dim < N; ++dim) {
         min_[dim] = static_cast<double>(minT[dim]);
@@ -0,0 +1,79 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/discretedata/discretedatamoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <modules/discretedata/discretedatatypes.h>
+#include <modules/discretedata/channels/channelspan.h>
+
+namespace inviwo {
+namespace discretedata {
+
+class Connectivity;
+
+/**
+ * \brief Precomputed connections from all elements of one GridPrimitive type to another.
+ *
+ * Stored in compressed sparse row layout: the connections of element i are
+ * indices[offsets[i]] to indices[offsets[i + 1] - 1].
+ * Created by Connectivity::getConnectionTable.
+ */
+class IVW_MODULE_DISCRETEDATA_API ConnectionTable {
+public:
+    ConnectionTable(std::vector<ind> offsets, std::vector<ind> indices);
+
+    /**
+     * \brief Evaluate Connectivity::getConnections for all elements of type 'from'
+     * Runs on the thread pool.
+     */
+    static ConnectionTable build(const Connectivity& grid, GridPrimitive from, GridPrimitive to,
+                                 bool isPosition = false);
+
+    //! Number of elements connections are stored for
+    ind size() const { return static_cast<ind>(offsets_.size()) - 1; }
+
+    //! All elements connected to the given element
+    ChannelSpan<const ind> operator[](ind index) const {
+        return ChannelSpan<const ind>(indices_.data() + offsets_[index],
+                                      offsets_[index + 1] - offsets_[index]);
+    }
+
+    const std::vector<ind>& getOffsets() const { return offsets_; }
+    const std::vector<ind>& getIndices() const { return indices_; }
+
+private:
+    std::vector<ind> offsets_;
+    std::vector<ind> indices_;
+};
+
+}  // namespace discretedata
+}  // namespace inviwo
@@ -35,6 +35,10 @@
 #include <modules/discretedata/discretedatatypes.h>
 #include <modules/discretedata/connectivity/cell.h>
 #include <modules/discretedata/connectivity/elementiterator.h>
+#include <modules/discretedata/connectivity/connectiontable.h>
+
+#include <map>
+#include <mutex>
 
 namespace inviwo {
 namespace discretedata {
@@ -91,6 +95,20 @@ public:
     virtual void getConnections(std::vector<ind>& result, ind index, GridPrimitive from,
                                 GridPrimitive to, bool isPosition = false) const = 0;
 
+    /**
+     * \brief Get the connections of all elements of one type at once
+     * The table is built in parallel on first request and kept until clearConnectionTables is
+     * called, it is shared by all DataSets referring to this grid. Prefer this over
+     * getConnections in algorithms sweeping over all elements.
+     * @param from Dimension the indices of the table live in
+     * @param to Dimension the connected indices live in
+     */
+    std::shared_ptr<const ConnectionTable> getConnectionTable(GridPrimitive from,
+                                                              GridPrimitive to) const;
+
+    //! Release all connection tables built by getConnectionTable
+    void clearConnectionTables();
+
     /**
      * \brief Range of all elements to iterate over
      * @param dim Dimension to return the elements of
@@ -117,6 +135,11 @@ protected:
 
     //! Saves the known number of primitves
     mutable std::vector<ind> numGridPrimitives_;
+
+private:
+    mutable std::mutex connectionTablesMutex_;
+    using ConnectionTableKey = std::pair<GridPrimitive, GridPrimitive>;
+    mutable std::map<ConnectionTableKey, std::shared_ptr<const ConnectionTable>> connectionTables_;
 };
 
 }  // namespace discretedata
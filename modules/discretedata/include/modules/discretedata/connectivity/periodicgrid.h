@@ -60,11 +60,12 @@ public:
     virtual void getConnections(std::vector<ind>& result, ind index, GridPrimitive from,
                                 GridPrimitive to, bool isPosition = false) const override;
 
-protected:
-    void sameLevelConnection(std::vector<ind>& result, ind idxLin,
-                             const std::vector<ind>& size) const;
+    virtual void getStencil(Stencil& result, ind index, GridPrimitive from, GridPrimitive to,
+                            bool isPosition = false) const override;
 
 protected:
+    void sameLevelConnection(Stencil& result, ind idxLin, const std::vector<ind>& size) const;
+
     std::vector<bool> isDimPeriodic_;
 };
 
@@ -32,6 +32,8 @@
 #include <modules/discretedata/connectivity/connectivity.h>
 #include <modules/discretedata/util.h>
 
+#include <array>
+
 namespace inviwo {
 namespace discretedata {
 
@@ -43,6 +45,28 @@ class ElementIterator;
  */
 class IVW_MODULE_DISCRETEDATA_API StructuredGrid : public Connectivity {
 public:
+    /**
+     * \brief Connected indices of a single element, stored inline without heap allocation
+     * Large enough for the corners of a cell of the highest supported dimension.
+     */
+    class Stencil {
+    public:
+        static constexpr ind maxDimensions = static_cast<ind>(GridPrimitive::HyperVolume);
+        static constexpr ind capacity = ind(1) << maxDimensions;
+
+        const ind* begin() const { return indices_.data(); }
+        const ind* end() const { return indices_.data() + size_; }
+        ind size() const { return size_; }
+        ind operator[](ind index) const { return indices_[index]; }
+
+        void clear() { size_ = 0; }
+        void push_back(ind index) { indices_[size_++] = index; }
+
+    private:
+        std::array<ind, capacity> indices_;
+        ind size_ = 0;
+    };
+
     /**
      * \brief Create an nD grid
      * @param gridDimension Dimension of grid (not vertices)
@@ -60,13 +84,30 @@ public:
     virtual void getConnections(std::vector<ind>& result, ind index, GridPrimitive from,
                                 GridPrimitive to, bool positions = false) const override;
 
+    /**
+     * \brief Get the connections of a single element without allocating memory
+     * Same as getConnections, use when querying many elements one by one.
+     * @param result All connected indices in dimension 'to'
+     * @param index Index of element in dimension 'from'
+     * @param from Dimension the index lives in
+     * @param to Dimension the result lives in
+     */
+    virtual void getStencil(Stencil& result, ind index, GridPrimitive from, GridPrimitive to,
+                            bool isPosition = false) const;
+
     static void sameLevelConnection(std::vector<ind>& result, ind idxLin,
                                     const std::vector<ind>& size);
 
     static std::vector<ind> indexFromLinear(ind idxLin, const std::vector<ind>& size);
 
 protected:
+    using IndexND = std::array<ind, Stencil::maxDimensions>;
+    static IndexND indexFromLinear(ind idxLin, const std::vector<ind>& size, ind numDimensions);
+
     std::vector<ind> numCellsPerDimension_;
+    std::vector<ind> numVerticesPerDimension_;
+    //! Linear index offset to the next vertex in each dimension
+    std::vector<ind> vertexStrides_;
 };
 
 }  // namespace discretedata
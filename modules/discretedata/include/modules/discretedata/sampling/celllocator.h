@@ -0,0 +1,147 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/discretedata/discretedatamoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <modules/discretedata/discretedatatypes.h>
+#include <modules/discretedata/channels/datachannel.h>
+#include <modules/discretedata/connectivity/connectivity.h>
+#include <modules/discretedata/connectivity/connectiontable.h>
+
+#include <array>
+
+namespace inviwo {
+namespace discretedata {
+
+/**
+ * \brief Acceleration structure to find the cell containing a given position
+ *
+ * The bounding boxes of all volume cells of a Connectivity are sorted into a uniform grid of bins.
+ * A query only tests the cells of the bin containing the position. Tetrahedra are interpolated
+ * with barycentric, hexahedra with trilinear weights. Hexahedron corners are expected in the
+ * order of StructuredGrid, i.e. bit d of the corner index is set for the upper side along axis d.
+ * Other cell types are ignored.
+ */
+class IVW_MODULE_DISCRETEDATA_API CellLocator {
+public:
+    //! Maximal number of corners of a supported cell
+    static constexpr ind maxCorners = 8;
+
+    /**
+     * \brief The cell containing a position and the interpolation weights of its corners
+     */
+    struct Location {
+        //! Containing cell, -1 if outside of all cells
+        ind cell = -1;
+        ind numVertices = 0;
+        std::array<ind, maxCorners> vertices;
+        std::array<double, maxCorners> weights;
+
+        bool isValid() const { return cell >= 0; }
+    };
+
+    /**
+     * \brief Build the locator for the volume cells of the grid
+     * @param grid Connectivity with GridPrimitive::Volume as dimension
+     * @param positions Vertex positions, a DataChannel<float, 3> or DataChannel<double, 3>
+     * @throws Exception if the grid is not a volume grid or the positions are not supported
+     */
+    CellLocator(std::shared_ptr<const Connectivity> grid, const Channel& positions);
+
+    /**
+     * \brief Find the cell containing the position
+     * Thread safe.
+     * @param pos Position in the space of the vertex positions
+     * @param result Location to write to, result.cell is -1 if no cell contains the position
+     * @param hint Cell to test first, e.g. the result of the previous query of coherent positions
+     * @return true if a cell containing the position was found
+     */
+    bool locate(const dvec3& pos, Location& result, ind hint = -1) const;
+
+    /**
+     * \brief Locate a batch of positions using the thread pool
+     * Consecutive positions are assumed to be coherent, the previous result is tested first.
+     */
+    void locate(const std::vector<dvec3>& positions, std::vector<Location>& result) const;
+
+    /**
+     * \brief Interpolate a channel defined on the vertices at a location
+     * @return the interpolated value, zero if the location is not valid
+     */
+    template <typename T, ind N>
+    static Vector<static_cast<unsigned>(N), double> interpolate(const DataChannel<T, N>& channel,
+                                                                const Location& location);
+
+    //! Lower corner of the bounding box of all cells
+    const dvec3& getMin() const { return min_; }
+    //! Upper corner of the bounding box of all cells
+    const dvec3& getMax() const { return max_; }
+
+    const std::shared_ptr<const Connectivity>& getGrid() const { return grid_; }
+
+private:
+    bool computeWeights(ind cell, const dvec3& pos, Location& result) const;
+    size3_t getBin(const dvec3& pos) const;
+
+    std::shared_ptr<const Connectivity> grid_;
+    std::vector<dvec3> positions_;
+    ConnectionTable corners_;
+
+    std::vector<dvec3> cellMin_;
+    std::vector<dvec3> cellMax_;
+    dvec3 min_;
+    dvec3 max_;
+
+    size3_t numBins_;
+    dvec3 binSize_;
+    //! Cells overlapping each bin, in compressed sparse row layout like ConnectionTable
+    std::vector<ind> binOffsets_;
+    std::vector<ind> binCells_;
+};
+
+template <typename T, ind N>
+Vector<static_cast<unsigned>(N), double> CellLocator::interpolate(const DataChannel<T, N>& channel,
+                                                                  const Location& location) {
+    static_assert(N >= 1 && N <= 4, "Only channels with up to four components are supported.");
+    Vector<static_cast<unsigned>(N), double> result(0.0);
+    std::array<T, N> value;
+    for (ind v = 0; v < location.numVertices; ++v) {
+        channel.fill(value, location.vertices[v]);
+        for (ind c = 0; c < N; ++c) {
+            util::glmcomp(result, c) += location.weights[v] * static_cast<double>(value[c]);
+        }
+    }
+    return result;
+}
+
+}  // namespace discretedata
+}  // namespace inviwo
@@ -0,0 +1,256 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/discretedata/discretedatamoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/spatialsampler.h>
+#include <inviwo/core/datastructures/spatialdata.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/foreach.h>
+
+#include <modules/discretedata/dataset.h>
+#include <modules/discretedata/sampling/celllocator.h>
+
+namespace inviwo {
+namespace discretedata {
+
+namespace detail {
+
+/**
+ * Spatial entity spanning the bounding box of the cells of a CellLocator.
+ * Data space of the DataSetSampler is the unit cube in this box.
+ */
+class CellLocatorEntity : public SpatialEntity<3> {
+public:
+    CellLocatorEntity(const CellLocator& locator) {
+        setBasis(glm::diagonal3x3(vec3(locator.getMax() - locator.getMin())));
+        setOffset(vec3(locator.getMin()));
+    }
+    virtual CellLocatorEntity* clone() const override { return new CellLocatorEntity(*this); }
+};
+
+/**
+ * Holds the entity of a DataSetSampler, a base class so that it is constructed before the
+ * SpatialSampler referring to it.
+ */
+struct CellLocatorEntityHolder {
+    CellLocatorEntityHolder(const CellLocator& locator) : entity_{locator} {}
+    CellLocatorEntity entity_;
+};
+
+}  // namespace detail
+
+/**
+ * \brief SpatialSampler for a vertex channel of a DataSet with volume cells
+ *
+ * Data space is the unit cube in the bounding box of the cells, model space the space of the
+ * vertex positions. Uses a CellLocator to find the cell and interpolation weights, positions
+ * outside of all cells sample to zero.
+ */
+template <unsigned int DataDims, typename T = double>
+class DataSetSampler : private detail::CellLocatorEntityHolder,
+                       public SpatialSampler<3, DataDims, double> {
+public:
+    using DataChannelType = DataChannel<T, static_cast<ind>(DataDims)>;
+
+    DataSetSampler(std::shared_ptr<const CellLocator> locator,
+                   std::shared_ptr<const DataChannelType> data,
+                   CoordinateSpace space = CoordinateSpace::Data);
+
+    /**
+     * \brief Sample a channel of a DataSet
+     * Builds a new CellLocator, share a locator between samplers of the same grid where possible.
+     * @param dataSet Set holding the channels, the grid needs to consist of volume cells
+     * @param positionChannel Name of the vertex position channel
+     * @param dataChannel Name of the vertex channel to sample
+     * @throws Exception if a channel is not found or has the wrong type
+     */
+    DataSetSampler(const DataSet& dataSet, const std::string& positionChannel,
+                   const std::string& dataChannel, CoordinateSpace space = CoordinateSpace::Data);
+
+    DataSetSampler(const DataSetSampler&) = delete;
+    DataSetSampler& operator=(const DataSetSampler&) = delete;
+    virtual ~DataSetSampler() = default;
+
+    const CellLocator& getLocator() const { return *locator_; }
+
+protected:
+    virtual Vector<DataDims, double> sampleDataSpace(const dvec3& pos) const override;
+    virtual bool withinBoundsDataSpace(const dvec3& pos) const override;
+
+private:
+    static std::shared_ptr<const CellLocator> createLocator(const DataSet& dataSet,
+                                                            const std::string& positionChannel);
+    static std::shared_ptr<const DataChannelType> getDataChannel(const DataSet& dataSet,
+                                                                 const std::string& dataChannel);
+
+    dvec3 toModel(const dvec3& pos) const {
+        return locator_->getMin() + pos * (locator_->getMax() - locator_->getMin());
+    }
+
+    /**
+     * Locate a data space position. The last location of each thread is kept, so a withinBounds
+     * followed by a sample of the same position only locates once, and the previous cell is
+     * tested first for coherent positions.
+     */
+    const CellLocator::Location& locate(const dvec3& pos) const;
+
+    std::shared_ptr<const CellLocator> locator_;
+    std::shared_ptr<const DataChannelType> data_;
+};
+
+template <unsigned int DataDims, typename T>
+DataSetSampler<DataDims, T>::DataSetSampler(std::shared_ptr<const CellLocator> locator,
+                                            std::shared_ptr<const DataChannelType> data,
+                                            CoordinateSpace space)
+    : detail::CellLocatorEntityHolder(*locator)
+    , SpatialSampler<3, DataDims, double>(entity_, space)
+    , locator_{locator}
+    , data_{data} {}
+
+template <unsigned int DataDims, typename T>
+DataSetSampler<DataDims, T>::DataSetSampler(const DataSet& dataSet,
+                                            const std::string& positionChannel,
+                                            const std::string& dataChannel, CoordinateSpace space)
+    : DataSetSampler(createLocator(dataSet, positionChannel), getDataChannel(dataSet, dataChannel),
+                     space) {}
+
+template <unsigned int DataDims, typename T>
+std::shared_ptr<const CellLocator> DataSetSampler<DataDims, T>::createLocator(
+    const DataSet& dataSet, const std::string& positionChannel) {
+    auto positions = dataSet.getChannel(positionChannel, GridPrimitive::Vertex);
+    if (!positions) {
+        throw Exception("No vertex channel named '" + positionChannel + "'",
+                        IVW_CONTEXT_CUSTOM("DataSetSampler"));
+    }
+    return std::make_shared<CellLocator>(dataSet.grid, *positions);
+}
+
+template <unsigned int DataDims, typename T>
+auto DataSetSampler<DataDims, T>::getDataChannel(const DataSet& dataSet,
+                                                 const std::string& dataChannel)
+    -> std::shared_ptr<const DataChannelType> {
+    auto data = dataSet.getChannel<T, static_cast<ind>(DataDims)>(dataChannel);
+    if (!data) {
+        throw Exception("No vertex channel named '" + dataChannel + "' with " +
+                            toString(DataDims) + " components of type " + DataFormat<T>::str(),
+                        IVW_CONTEXT_CUSTOM("DataSetSampler"));
+    }
+    return data;
+}
+
+template <unsigned int DataDims, typename T>
+const CellLocator::Location& DataSetSampler<DataDims, T>::locate(const dvec3& pos) const {
+    struct LastLocation {
+        // A weak_ptr keeps the control block alive, a new locator can never compare equal
+        std::weak_ptr<const CellLocator> locator;
+        dvec3 pos{0.0};
+        CellLocator::Location location;
+    };
+    thread_local LastLocation last;
+
+    const bool sameLocator =
+        !last.locator.owner_before(locator_) && !locator_.owner_before(last.locator);
+    const dvec3 modelPos = toModel(pos);
+    if (sameLocator && last.pos == modelPos) return last.location;
+
+    const ind hint = sameLocator ? last.location.cell : -1;
+    if (!sameLocator) last.locator = locator_;
+    last.pos = modelPos;
+    locator_->locate(modelPos, last.location, hint);
+    return last.location;
+}
+
+template <unsigned int DataDims, typename T>
+Vector<DataDims, double> DataSetSampler<DataDims, T>::sampleDataSpace(const dvec3& pos) const {
+    return CellLocator::interpolate(*data_, locate(pos));
+}
+
+template <unsigned int DataDims, typename T>
+bool DataSetSampler<DataDims, T>::withinBoundsDataSpace(const dvec3& pos) const {
+    return locate(pos).isValid();
+}
+
+/**
+ * \brief Resample a vertex channel onto a regular volume covering the bounding box of the cells
+ * Each voxel is sampled at its center, matching the basis and offset of the volume. Voxels are
+ * located in parallel, voxels outside of all cells are set to zero.
+ * @param locator Cell locator of the grid the channel is defined on
+ * @param channel Vertex channel with up to four components
+ * @param dimensions Number of voxels along each axis
+ */
+template <typename T, ind N>
+std::shared_ptr<Volume> resampleToVolume(const CellLocator& locator,
+                                         const DataChannel<T, N>& channel, size3_t dimensions) {
+    static_assert(N >= 1 && N <= 4, "Only channels with up to four components are supported.");
+    using VoxelType = Vector<static_cast<unsigned>(N), T>;
+
+    auto ram = std::make_shared<VolumeRAMPrecision<VoxelType>>(dimensions);
+    auto data = ram->getDataTyped();
+
+    const dvec3 min = locator.getMin();
+    const dvec3 extent = locator.getMax() - locator.getMin();
+    const dvec3 voxelSize = extent / dvec3(dimensions);
+    const size_t sliceSize = dimensions.x * dimensions.y;
+
+    // Each job handles full rows, the previous voxel's cell is tested first
+    util::forEachRangeParallel(dimensions.y * dimensions.z, [&](size_t begin, size_t end) {
+        CellLocator::Location location;
+        for (size_t row = begin; row < end; ++row) {
+            const size_t y = row % dimensions.y;
+            const size_t z = row / dimensions.y;
+            for (size_t x = 0; x < dimensions.x; ++x) {
+                const dvec3 pos = min + (dvec3(x, y, z) + 0.5) * voxelSize;
+                locator.locate(pos, location, location.cell);
+                data[z * sliceSize + y * dimensions.x + x] =
+                    static_cast<VoxelType>(CellLocator::interpolate(channel, location));
+            }
+        }
+    });
+
+    auto volume = std::make_shared<Volume>(ram);
+    volume->setBasis(glm::diagonal3x3(vec3(extent)));
+    volume->setOffset(vec3(min));
+
+    std::array<T, N> channelMin;
+    std::array<T, N> channelMax;
+    channel.getMinMax(channelMin, channelMax);
+    const dvec2 range(static_cast<double>(*std::min_element(channelMin.begin(), channelMin.end())),
+                      static_cast<double>(*std::max_element(channelMax.begin(), channelMax.end())));
+    volume->dataMap_.dataRange = range;
+    volume->dataMap_.valueRange = range;
+    return volume;
+}
+
+}  // namespace discretedata
+}  // namespace inviwo
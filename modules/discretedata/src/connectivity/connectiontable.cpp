@@ -0,0 +1,77 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/discretedata/connectivity/connectiontable.h>
+#include <modules/discretedata/connectivity/connectivity.h>
+
+#include <inviwo/core/util/foreach.h>
+
+#include <algorithm>
+#include <mutex>
+
+namespace inviwo {
+namespace discretedata {
+
+ConnectionTable::ConnectionTable(std::vector<ind> offsets, std::vector<ind> indices)
+    : offsets_{std::move(offsets)}, indices_{std::move(indices)} {}
+
+ConnectionTable ConnectionTable::build(const Connectivity& grid, GridPrimitive from,
+                                       GridPrimitive to, bool isPosition) {
+    const ind numElements = grid.getNumElements(from);
+    std::vector<ind> offsets(static_cast<size_t>(numElements) + 1, 0);
+
+    // Each job gathers the connections of a consecutive range of elements,
+    // the counts go directly to the offsets and are accumulated afterwards.
+    std::mutex mutex;
+    std::vector<std::pair<ind, std::vector<ind>>> ranges;
+    util::forEachRangeParallel(static_cast<size_t>(numElements), [&](size_t begin, size_t end) {
+        std::vector<ind> indices;
+        std::vector<ind> connections;
+        for (size_t i = begin; i < end; ++i) {
+            connections.clear();
+            grid.getConnections(connections, static_cast<ind>(i), from, to, isPosition);
+            offsets[i + 1] = static_cast<ind>(connections.size());
+            indices.insert(indices.end(), connections.begin(), connections.end());
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        ranges.emplace_back(static_cast<ind>(begin), std::move(indices));
+    });
+
+    for (size_t i = 1; i < offsets.size(); ++i) offsets[i] += offsets[i - 1];
+
+    std::vector<ind> indices(static_cast<size_t>(offsets.back()));
+    for (auto& range : ranges) {
+        std::copy(range.second.begin(), range.second.end(), indices.begin() + offsets[range.first]);
+    }
+
+    return ConnectionTable(std::move(offsets), std::move(indices));
+}
+
+}  // namespace discretedata
+}  // namespace inviwo
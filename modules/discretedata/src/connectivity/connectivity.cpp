@@ -43,6 +43,21 @@ ind Connectivity::getNumElements(GridPrimitive elementType) const {
     return numGridPrimitives_[(int)elementType];
 }
 
+std::shared_ptr<const ConnectionTable> Connectivity::getConnectionTable(GridPrimitive from,
+                                                                      GridPrimitive to) const {
+    std::lock_guard<std::mutex> lock(connectionTablesMutex_);
+    auto& table = connectionTables_[{from, to}];
+    if (!table) {
+        table = std::make_shared<ConnectionTable>(ConnectionTable::build(*this, from, to));
+    }
+    return table;
+}
+
+void Connectivity::clearConnectionTables() {
+    std::lock_guard<std::mutex> lock(connectionTablesMutex_);
+    connectionTables_.clear();
+}
+
 ElementRange Connectivity::all(GridPrimitive dim) const { return ElementRange(dim, this); }
 
 CellType Connectivity::getCellType(GridPrimitive dim, ind) const {
@@ -55,13 +55,22 @@ PeriodicGrid::PeriodicGrid(GridPrimitive gridDimension, const std::vector<ind>&
 
 void PeriodicGrid::getConnections(std::vector<ind>& result, ind idxLin, GridPrimitive from,
                                   GridPrimitive to, bool isPosition) const {
-    result.clear();
+    Stencil stencil;
+    getStencil(stencil, idxLin, from, to, isPosition);
+    result.assign(stencil.begin(), stencil.end());
+}
 
+void PeriodicGrid::getStencil(Stencil& result, ind idxLin, GridPrimitive from, GridPrimitive to,
+                              bool isPosition) const {
     if (isPosition) {
         // Position-wise, there is no difference from a StructuredGrid.
-        StructuredGrid::getConnections(result, idxLin, from, to, isPosition);
+        StructuredGrid::getStencil(result, idxLin, from, to, isPosition);
         return;
     }
+
+    result.clear();
+    const ind numDimensions = static_cast<ind>(numCellsPerDimension_.size());
+
     if (from == to && from == gridDimension_) {
         // In this variant, the last cell is the same as the first within each dimension.
         sameLevelConnection(result, idxLin, numCellsPerDimension_);
@@ -69,117 +78,78 @@ void PeriodicGrid::getConnections(std::vector<ind>& result, ind idxLin, GridPrim
     }
 
     if (from == to && from == GridPrimitive::Vertex) {
-        std::vector<ind> vertDims;
-        for (ind dim : numCellsPerDimension_) {
-            vertDims.push_back(dim + 1);
-        }
-
         // In this variant, the last vertex is the same as the first within each dimension.
-        sameLevelConnection(result, idxLin, vertDims);
+        sameLevelConnection(result, idxLin, numVerticesPerDimension_);
         return;
     }
 
     if (from == gridDimension_ && to == GridPrimitive::Vertex) {
-        // Prepare corners
-        const ind numDimensions = numCellsPerDimension_.size();
-        const ind numCorners = ind(1) << numDimensions;
-        result.resize(numCorners);
-
-        // Vertex Strides - how much to add to the linear index to go forward by 1 in each dimension
-        std::vector<ind> VStrides(numDimensions);
-        ind dimProduct(1);
-        for (ind dim(0); dim < numDimensions; dim++) {
-            VStrides[dim] = dimProduct;
-            dimProduct *= (numCellsPerDimension_[dim] + 1);
-        }
         // Linear Index to nD Cell Index.
-        std::vector<ind> cellIndex = StructuredGrid::indexFromLinear(idxLin, numCellsPerDimension_);
+        const IndexND cellIndex = indexFromLinear(idxLin, numCellsPerDimension_, numDimensions);
 
         // The given cell index is also the index of its lower-left-front corner vertex
         // Let's compute the linear index for this vertex
-        ind lowerLeftFrontVertexLinearIndex = cellIndex[0];
-        for (ind dim(1); dim < numDimensions; dim++) {
-            lowerLeftFrontVertexLinearIndex += cellIndex[dim] * VStrides[dim];
+        ind lowerLeftFrontVertexLinearIndex = 0;
+        for (ind dim = 0; dim < numDimensions; ++dim) {
+            lowerLeftFrontVertexLinearIndex += cellIndex[dim] * vertexStrides_[dim];
         }
 
-        result[0] = lowerLeftFrontVertexLinearIndex;
-        for (ind i(1); i < numCorners; i++) {
-            // Base is the lower-left-front corner.
-            result[i] = lowerLeftFrontVertexLinearIndex;
+        const ind numCorners = ind(1) << numDimensions;
+        for (ind i = 0; i < numCorners; ++i) {
             // Add strides to the lower-left-front corner.
-            for (ind d(0); d < numDimensions; d++) {
+            ind corner = lowerLeftFrontVertexLinearIndex;
+            for (ind d = 0; d < numDimensions; ++d) {
                 if (i & (ind(1) << d)) {
                     // Last cell in a periodic dimension does not connect to the last vertex, but
                     // the first one.
                     if (isPeriodic(d) && cellIndex[d] == numCellsPerDimension_[d])
-                        result[i] -= VStrides[d] * (numCellsPerDimension_[d]);
+                        corner -= vertexStrides_[d] * numCellsPerDimension_[d];
                     else
-                        result[i] += VStrides[d];
+                        corner += vertexStrides_[d];
                 }
             }
+            result.push_back(corner);
         }
-
         return;
     }
 
     if (from == GridPrimitive::Vertex && to == gridDimension_) {
-        // Compute dimensions for vertices
-        std::vector<ind> vertDims;
-        for (ind dim : numCellsPerDimension_) {
-            vertDims.push_back(dim + 1);
-        }
-
-        const ind NumDimensions = vertDims.size();
-
         // Linear Index to nD Vertex Index.
-        std::vector<ind> VertexIndex = indexFromLinear(idxLin, vertDims);
-
-        // Prepare neighbors.
-        const ind MaxNeighbors = ind(1) << NumDimensions;
-        result.reserve(MaxNeighbors);
-
-        // Compute neighbors.
-        std::vector<ind> CurrentNeighbor;
-        for (ind i(0); i < MaxNeighbors; i++) {
-            // Base index is the vertex index. The same cell index is the upper-right one of the
-            // neighbors.
-            CurrentNeighbor = VertexIndex;
-
-            // Generate new neighbor index
-            for (ind d(0); d < NumDimensions; d++) {
-                if (i & (ind(1) << d)) CurrentNeighbor[d]--;
-            }
+        const IndexND vertexIndex =
+            indexFromLinear(idxLin, numVerticesPerDimension_, numDimensions);
 
+        // The cell with the same index is the upper-right one of the neighbors.
+        const ind maxNeighbors = ind(1) << numDimensions;
+        for (ind i = 0; i < maxNeighbors; ++i) {
             // Is it in the allowed range? And compute linear index while checking.
-            bool bOk(true);
-            ind CurrentNeighborLinearIndex(0);
-            ind DimensionProduct(1);
-            for (ind d(0); bOk && d < NumDimensions; d++) {
-                if (CurrentNeighbor[d] < 0) {
+            bool bOk = true;
+            ind neighborLinearIndex = 0;
+            ind dimensionProduct = 1;
+            for (ind d = 0; bOk && d < numDimensions; ++d) {
+                ind coord = vertexIndex[d] - ((i >> d) & 1);
+                if (coord < 0) {
                     if (isPeriodic(d)) {
                         // Map to last cell in dimension, the one going over the boundary.
-                        CurrentNeighbor[d] = numCellsPerDimension_[d] - 2;
+                        coord = numCellsPerDimension_[d] - 2;
                     } else {
                         bOk = false;
                     }
                 }
-                if (CurrentNeighbor[d] == numCellsPerDimension_[d]) {
+                if (coord == numCellsPerDimension_[d]) {
                     if (isPeriodic(d)) {
                         // Map to first cell in dimension.
-                        CurrentNeighbor[d] = 0;
+                        coord = 0;
                     } else {
                         bOk = false;
                     }
                 }
 
-                CurrentNeighborLinearIndex += CurrentNeighbor[d] * DimensionProduct;
-                DimensionProduct *= numCellsPerDimension_[d];
+                neighborLinearIndex += coord * dimensionProduct;
+                dimensionProduct *= numCellsPerDimension_[d];
             }
 
-            // If so, let's add it.
-            if (bOk) result.push_back(CurrentNeighborLinearIndex);
+            if (bOk) result.push_back(neighborLinearIndex);
         }
-
         return;
     }
 
@@ -191,10 +161,8 @@ ind PeriodicGrid::getNumCellsInDimension(ind dim) const {
     return numCellsPerDimension_[dim];
 }
 
-void PeriodicGrid::sameLevelConnection(std::vector<ind>& result, ind idxLin,
+void PeriodicGrid::sameLevelConnection(Stencil& result, ind idxLin,
                                        const std::vector<ind>& size) const {
-
-    result.clear();
     ind dimensionProduct = 1;
     ind index = idxLin;
     for (ind dim = 0; dim < (ind)size.size(); ++dim) {
@@ -42,12 +42,16 @@ StructuredGrid::StructuredGrid(GridPrimitive gridDimension, const std::vector<in
                "GridPrimitive need to be at least Edge for a structured grid");
     IVW_ASSERT(static_cast<ind>(numCellsPerDim.size()) == static_cast<ind>(gridDimension),
                "Grid dimension should match cell dimension.");
+    IVW_ASSERT(static_cast<ind>(gridDimension) <= Stencil::maxDimensions,
+               "Grid dimension exceeds the maximal supported dimension.");
     numCellsPerDimension_ = std::vector<ind>(numCellsPerDim);
 
     ind numCells = 1;
     ind numVerts = 1;
     for (ind dim = static_cast<ind>(GridPrimitive::Vertex); dim < static_cast<ind>(gridDimension);
          ++dim) {
+        vertexStrides_.push_back(numVerts);
+        numVerticesPerDimension_.push_back(numCellsPerDimension_[dim] + 1);
         numCells *= numCellsPerDimension_[dim];
         numVerts *= numCellsPerDimension_[dim] + 1;
     }
@@ -80,114 +84,94 @@ void StructuredGrid::sameLevelConnection(std::vector<ind>& result, const ind idx
 }
 
 void StructuredGrid::getConnections(std::vector<ind>& result, ind idxLin, GridPrimitive from,
-                                    GridPrimitive to, bool) const {
-    if (from == to && from == gridDimension_) {
-        // Linear Index to nD Cell Index.
-        return sameLevelConnection(result, idxLin, numCellsPerDimension_);
-    }
+                                    GridPrimitive to, bool isPosition) const {
+    Stencil stencil;
+    getStencil(stencil, idxLin, from, to, isPosition);
+    result.assign(stencil.begin(), stencil.end());
+}
 
-    if (from == to && from == GridPrimitive::Vertex) {
-        std::vector<ind> vertDims;
-        for (ind dim : numCellsPerDimension_) {
-            vertDims.push_back(dim + 1);
-        }
+void StructuredGrid::getStencil(Stencil& result, ind idxLin, GridPrimitive from,
+                                GridPrimitive to, bool) const {
+    result.clear();
+    const ind numDimensions = static_cast<ind>(numCellsPerDimension_.size());
 
-        return sameLevelConnection(result, idxLin, vertDims);
-    }
+    if (from == to && (from == gridDimension_ || from == GridPrimitive::Vertex)) {
+        const auto& size =
+            from == GridPrimitive::Vertex ? numVerticesPerDimension_ : numCellsPerDimension_;
 
-    if (from == gridDimension_ && to == GridPrimitive::Vertex) {
-        // Prepare corners
-        const ind numDimensions = numCellsPerDimension_.size();
-        const ind numCorners = ind(1) << numDimensions;
-        result.resize(numCorners);
-
-        // Vertex Strides - how much to add to the linear index to go forward by 1 in each dimension
-        std::vector<ind> vStrides(numDimensions);
-        ind dimProduct(1);
-        for (ind dim(0); dim < numDimensions; dim++) {
-            vStrides[dim] = dimProduct;
-            dimProduct *= (numCellsPerDimension_[dim] + 1);
-        }
+        ind remainder = idxLin;
+        ind dimensionProduct = 1;
+        for (ind dim = 0; dim < numDimensions; ++dim) {
+            const ind coord = remainder % size[dim];
+            remainder /= size[dim];
 
-        // Linear Index to nD Cell Index.
-        ind idxRemainder = idxLin;
-        std::vector<ind> cellIndex(numDimensions, -1);
-        for (ind dim(0); dim < numDimensions; dim++) {
-            cellIndex[dim] = idxRemainder % numCellsPerDimension_[dim];
-            idxRemainder = (ind)(idxRemainder / numCellsPerDimension_[dim]);
+            if (coord > 0) result.push_back(idxLin - dimensionProduct);
+            if (coord < size[dim] - 1) result.push_back(idxLin + dimensionProduct);
+            dimensionProduct *= size[dim];
         }
+        return;
+    }
 
+    if (from == gridDimension_ && to == GridPrimitive::Vertex) {
         // The given cell index is also the index of its lower-left-front corner vertex
         // Let's compute the linear index for this vertex
-        ind lowerLeftFrontVertexLinearIndex = cellIndex[0];
-        for (ind dim(1); dim < numDimensions; dim++) {
-            lowerLeftFrontVertexLinearIndex += cellIndex[dim] * vStrides[dim];
+        ind remainder = idxLin;
+        ind lowerLeftFrontVertexLinearIndex = 0;
+        for (ind dim = 0; dim < numDimensions; ++dim) {
+            lowerLeftFrontVertexLinearIndex +=
+                (remainder % numCellsPerDimension_[dim]) * vertexStrides_[dim];
+            remainder /= numCellsPerDimension_[dim];
         }
 
-        result[0] = lowerLeftFrontVertexLinearIndex;
-        for (ind i(1); i < numCorners; i++) {
-            // Base is the lower-left-front corner.
-            result[i] = lowerLeftFrontVertexLinearIndex;
-
+        const ind numCorners = ind(1) << numDimensions;
+        for (ind i = 0; i < numCorners; ++i) {
             // Add strides to the lower-left-front corner.
-            for (ind d(0); d < numDimensions; d++) {
-                if (i & (ind(1) << d)) result[i] += vStrides[d];
+            ind corner = lowerLeftFrontVertexLinearIndex;
+            for (ind d = 0; d < numDimensions; ++d) {
+                if (i & (ind(1) << d)) corner += vertexStrides_[d];
             }
+            result.push_back(corner);
         }
         return;
     }
 
     if (from == GridPrimitive::Vertex && to == gridDimension_) {
-        // Compute dimensions for vertices
-        std::vector<ind> vertDims;
-        for (ind dim : numCellsPerDimension_) {
-            vertDims.push_back(dim + 1);
-        }
-
-        const ind numDimensions = vertDims.size();
+        const IndexND vertexIndex =
+            indexFromLinear(idxLin, numVerticesPerDimension_, numDimensions);
 
-        // Linear Index to nD Vertex Index.
-        std::vector<ind> vertexIndex = indexFromLinear(idxLin, vertDims);
-
-        // Prepare neighbors
+        // The cell with the same index is the upper-right one of the neighbors.
         const ind maxNeighbors = ind(1) << numDimensions;
-        result.reserve(maxNeighbors);
-
-        // Compute neighbors
-        std::vector<ind> currentNeighbor;
-        for (ind i(0); i < maxNeighbors; i++) {
-            // Base index is the vertex index.
-            // The same cell index is the upper-right one of the neighbors.
-            currentNeighbor = vertexIndex;
-
-            // Generate new neighbor index
-            for (ind d(0); d < numDimensions; d++) {
-                if (i & (ind(1) << d)) currentNeighbor[d]--;
-            }
-
+        for (ind i = 0; i < maxNeighbors; ++i) {
             // Is it in the allowed range? And compute linear index while checking.
-            bool bOk(true);
-            ind currentNeighborLinearIndex(0);
-            ind dimensionProduct(1);
-            for (ind d(0); bOk && d < numDimensions; d++) {
-                if (currentNeighbor[d] < 0 || currentNeighbor[d] >= numCellsPerDimension_[d]) {
-                    bOk = false;
-                }
-
-                currentNeighborLinearIndex += currentNeighbor[d] * dimensionProduct;
+            bool bOk = true;
+            ind neighborLinearIndex = 0;
+            ind dimensionProduct = 1;
+            for (ind d = 0; bOk && d < numDimensions; ++d) {
+                const ind coord = vertexIndex[d] - ((i >> d) & 1);
+                if (coord < 0 || coord >= numCellsPerDimension_[d]) bOk = false;
+
+                neighborLinearIndex += coord * dimensionProduct;
                 dimensionProduct *= numCellsPerDimension_[d];
             }
 
-            // If so, let's add it.
-            if (bOk) result.push_back(currentNeighborLinearIndex);
+            if (bOk) result.push_back(neighborLinearIndex);
         }
-
         return;
     }
 
     assert(false && "Not implemented yet.");
 }
 
+StructuredGrid::IndexND StructuredGrid::indexFromLinear(ind idxLin, const std::vector<ind>& size,
+                                                        ind numDimensions) {
+    IndexND index{};
+    for (ind dim = 0; dim < numDimensions; ++dim) {
+        index[dim] = idxLin % size[dim];
+        idxLin /= size[dim];
+    }
+    return index;
+}
+
 ind StructuredGrid::getNumCellsInDimension(ind dim) const {
     assert(numCellsPerDimension_[dim] >= 0 && "Number of elements not known yet.");
     return numCellsPerDimension_[dim];
@@ -0,0 +1,249 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/discretedata/sampling/celllocator.h>
+
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/foreach.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace inviwo {
+namespace discretedata {
+
+namespace {
+
+// Tolerance in local cell coordinates for positions on a cell boundary
+constexpr double boundaryEpsilon = 1e-6;
+
+template <typename T>
+bool copyPositions(const Channel& channel, std::vector<dvec3>& positions) {
+    auto typed = dynamic_cast<const DataChannel<T, 3>*>(&channel);
+    if (!typed) return false;
+
+    positions.resize(static_cast<size_t>(typed->size()));
+    typed->template forEachBlock<std::array<T, 3>>(
+        [&](ChannelSpan<const std::array<T, 3>> block, ind start) {
+            for (ind i = 0; i < block.size(); ++i) {
+                positions[start + i] = dvec3(block[i][0], block[i][1], block[i][2]);
+            }
+        });
+    return true;
+}
+
+bool tetrahedronWeights(const dvec3* corners, const dvec3& pos, double* weights) {
+    const dmat3 edges(corners[1] - corners[0], corners[2] - corners[0], corners[3] - corners[0]);
+    if (glm::determinant(edges) == 0.0) return false;
+
+    const dvec3 lambda = glm::inverse(edges) * (pos - corners[0]);
+    weights[0] = 1.0 - lambda.x - lambda.y - lambda.z;
+    weights[1] = lambda.x;
+    weights[2] = lambda.y;
+    weights[3] = lambda.z;
+    return std::all_of(weights, weights + 4, [](double w) { return w >= -boundaryEpsilon; });
+}
+
+// Invert the trilinear map of the hexahedron with Newton iterations
+bool hexahedronWeights(const dvec3* corners, const dvec3& pos, double* weights) {
+    constexpr int maxIterations = 16;
+
+    dvec3 u(0.5);
+    for (int iteration = 0; iteration < maxIterations; ++iteration) {
+        dvec3 x(0.0);
+        dmat3 jacobian(0.0);
+        for (int i = 0; i < 8; ++i) {
+            const dvec3 bits((i & 1) ? 1.0 : 0.0, (i & 2) ? 1.0 : 0.0, (i & 4) ? 1.0 : 0.0);
+            const dvec3 w = bits * u + (1.0 - bits) * (1.0 - u);
+            const dvec3 dw = 2.0 * bits - 1.0;
+            x += w.x * w.y * w.z * corners[i];
+            jacobian[0] += dw.x * w.y * w.z * corners[i];
+            jacobian[1] += w.x * dw.y * w.z * corners[i];
+            jacobian[2] += w.x * w.y * dw.z * corners[i];
+        }
+        if (glm::determinant(jacobian) == 0.0) return false;
+        const dvec3 step = glm::inverse(jacobian) * (x - pos);
+        u -= step;
+        if (glm::compMax(glm::abs(step)) < 1e-10) break;
+    }
+
+    if (glm::any(glm::lessThan(u, dvec3(-boundaryEpsilon))) ||
+        glm::any(glm::greaterThan(u, dvec3(1.0 + boundaryEpsilon)))) {
+        return false;
+    }
+    u = glm::clamp(u, 0.0, 1.0);
+    for (int i = 0; i < 8; ++i) {
+        const dvec3 bits((i & 1) ? 1.0 : 0.0, (i & 2) ? 1.0 : 0.0, (i & 4) ? 1.0 : 0.0);
+        const dvec3 w = bits * u + (1.0 - bits) * (1.0 - u);
+        weights[i] = w.x * w.y * w.z;
+    }
+    return true;
+}
+
+}  // namespace
+
+CellLocator::CellLocator(std::shared_ptr<const Connectivity> grid, const Channel& positions)
+    : grid_{grid}
+    , corners_{ConnectionTable::build(*grid, GridPrimitive::Volume, GridPrimitive::Vertex, true)} {
+    if (grid_->getDimension() != GridPrimitive::Volume) {
+        throw Exception("Cell location requires a grid of volume cells", IVW_CONTEXT);
+    }
+    if (!copyPositions<double>(positions, positions_) &&
+        !copyPositions<float>(positions, positions_)) {
+        throw Exception("Positions need to be a DataChannel<double, 3> or DataChannel<float, 3>",
+                        IVW_CONTEXT);
+    }
+
+    // Bounding box of each cell
+    const ind numCells = corners_.size();
+    cellMin_.resize(static_cast<size_t>(numCells));
+    cellMax_.resize(static_cast<size_t>(numCells));
+    util::forEachRangeParallel(static_cast<size_t>(numCells), [&](size_t begin, size_t end) {
+        for (size_t cell = begin; cell < end; ++cell) {
+            dvec3 cellMin(std::numeric_limits<double>::max());
+            dvec3 cellMax(std::numeric_limits<double>::lowest());
+            for (ind vertex : corners_[static_cast<ind>(cell)]) {
+                cellMin = glm::min(cellMin, positions_[vertex]);
+                cellMax = glm::max(cellMax, positions_[vertex]);
+            }
+            cellMin_[cell] = cellMin;
+            cellMax_[cell] = cellMax;
+        }
+    });
+
+    min_ = dvec3(std::numeric_limits<double>::max());
+    max_ = dvec3(std::numeric_limits<double>::lowest());
+    for (ind cell = 0; cell < numCells; ++cell) {
+        min_ = glm::min(min_, cellMin_[cell]);
+        max_ = glm::max(max_, cellMax_[cell]);
+    }
+    if (numCells == 0) min_ = max_ = dvec3(0.0);
+
+    // About one bin per cell, distributed according to the extent along each axis
+    const dvec3 extent = max_ - min_;
+    const double maxExtent = glm::compMax(extent);
+    const double binEdge =
+        maxExtent > 0.0 ? std::cbrt(glm::compMul(glm::max(extent, dvec3(maxExtent * 1e-3))) /
+                                    static_cast<double>(std::max(numCells, ind{1})))
+                        : 1.0;
+    numBins_ = glm::clamp(size3_t(glm::ceil(extent / binEdge)), size3_t(1), size3_t(512));
+    binSize_ = glm::max(extent / dvec3(numBins_), dvec3(std::numeric_limits<double>::min()));
+
+    // Sort the cells into all bins they overlap
+    const size_t totalBins = numBins_.x * numBins_.y * numBins_.z;
+    auto forEachBin = [&](ind cell, auto callback) {
+        const size3_t first = getBin(cellMin_[cell]);
+        const size3_t last = getBin(cellMax_[cell]);
+        for (size_t z = first.z; z <= last.z; ++z) {
+            for (size_t y = first.y; y <= last.y; ++y) {
+                for (size_t x = first.x; x <= last.x; ++x) {
+                    callback(x + numBins_.x * (y + numBins_.y * z));
+                }
+            }
+        }
+    };
+
+    binOffsets_.assign(totalBins + 1, 0);
+    for (ind cell = 0; cell < numCells; ++cell) {
+        forEachBin(cell, [&](size_t bin) { ++binOffsets_[bin + 1]; });
+    }
+    for (size_t bin = 1; bin <= totalBins; ++bin) binOffsets_[bin] += binOffsets_[bin - 1];
+
+    binCells_.resize(static_cast<size_t>(binOffsets_.back()));
+    std::vector<ind> fill(binOffsets_.begin(), binOffsets_.end() - 1);
+    for (ind cell = 0; cell < numCells; ++cell) {
+        forEachBin(cell, [&](size_t bin) { binCells_[fill[bin]++] = cell; });
+    }
+}
+
+size3_t CellLocator::getBin(const dvec3& pos) const {
+    const dvec3 bin = glm::floor((pos - min_) / binSize_);
+    return glm::clamp(size3_t(glm::max(bin, dvec3(0.0))), size3_t(0), numBins_ - size3_t(1));
+}
+
+bool CellLocator::computeWeights(ind cell, const dvec3& pos, Location& result) const {
+    const auto corners = corners_[cell];
+    if (corners.size() != 4 && corners.size() != 8) return false;
+
+    std::array<dvec3, maxCorners> cornerPositions;
+    for (ind i = 0; i < corners.size(); ++i) cornerPositions[i] = positions_[corners[i]];
+
+    const bool inside =
+        corners.size() == 4
+            ? tetrahedronWeights(cornerPositions.data(), pos, result.weights.data())
+            : hexahedronWeights(cornerPositions.data(), pos, result.weights.data());
+    if (!inside) return false;
+
+    result.cell = cell;
+    result.numVertices = corners.size();
+    std::copy(corners.begin(), corners.end(), result.vertices.begin());
+    return true;
+}
+
+bool CellLocator::locate(const dvec3& pos, Location& result, ind hint) const {
+    result.cell = -1;
+    result.numVertices = 0;
+
+    const dvec3 tolerance = boundaryEpsilon * (max_ - min_);
+    if (glm::any(glm::lessThan(pos, min_ - tolerance)) ||
+        glm::any(glm::greaterThan(pos, max_ + tolerance))) {
+        return false;
+    }
+
+    if (hint >= 0 && hint < corners_.size() && computeWeights(hint, pos, result)) return true;
+
+    const size3_t bin = getBin(pos);
+    const size_t binIndex = bin.x + numBins_.x * (bin.y + numBins_.y * bin.z);
+    for (ind i = binOffsets_[binIndex]; i < binOffsets_[binIndex + 1]; ++i) {
+        const ind cell = binCells_[i];
+        if (cell == hint) continue;
+        if (glm::any(glm::lessThan(pos, cellMin_[cell] - tolerance)) ||
+            glm::any(glm::greaterThan(pos, cellMax_[cell] + tolerance))) {
+            continue;
+        }
+        if (computeWeights(cell, pos, result)) return true;
+    }
+    return false;
+}
+
+void CellLocator::locate(const std::vector<dvec3>& positions,
+                         std::vector<Location>& result) const {
+    result.resize(positions.size());
+    util::forEachRangeParallel(positions.size(), [&](size_t begin, size_t end) {
+        ind hint = -1;
+        for (size_t i = begin; i < end; ++i) {
+            locate(positions[i], result[i], hint);
+            if (result[i].isValid()) hint = result[i].cell;
+        }
+    });
+}
+
+}  // namespace discretedata
+}  // namespace inviwo
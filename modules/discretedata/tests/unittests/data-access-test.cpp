@@ -39,6 +39,7 @@
 #include <modules/discretedata/connectivity/elementiterator.h>
 #include <modules/discretedata/connectivity/connectioniterator.h>
 #include <modules/discretedata/connectivity/structuredgrid.h>
+#include <modules/discretedata/connectivity/periodicgrid.h>
 
 namespace inviwo {
 namespace discretedata {
@@ -73,5 +74,46 @@ TEST(AccessingData, Connectivity) {
     EXPECT_TRUE(allFine && "Connectivity is not bi-directional.");
 }
 
+TEST(AccessingData, ConnectionTable) {
+    const std::vector<ind> size = {4, 5, 6};
+    std::vector<std::shared_ptr<const StructuredGrid>> grids = {
+        std::make_shared<StructuredGrid>(GridPrimitive::Volume, size),
+        std::make_shared<PeriodicGrid>(GridPrimitive::Volume, size,
+                                       std::vector<bool>{true, false, true})};
+
+    const std::vector<std::pair<GridPrimitive, GridPrimitive>> primitivePairs = {
+        {GridPrimitive::Volume, GridPrimitive::Volume},
+        {GridPrimitive::Vertex, GridPrimitive::Vertex},
+        {GridPrimitive::Volume, GridPrimitive::Vertex},
+        {GridPrimitive::Vertex, GridPrimitive::Volume}};
+
+    std::vector<ind> connections;
+    StructuredGrid::Stencil stencil;
+    for (auto& grid : grids) {
+        for (auto& primitives : primitivePairs) {
+            auto table = grid->getConnectionTable(primitives.first, primitives.second);
+            ASSERT_EQ(table->size(), grid->getNumElements(primitives.first));
+            // Built once and shared from then on.
+            EXPECT_EQ(table, grid->getConnectionTable(primitives.first, primitives.second));
+
+            for (ind idx = 0; idx < table->size(); ++idx) {
+                grid->getConnections(connections, idx, primitives.first, primitives.second);
+                grid->getStencil(stencil, idx, primitives.first, primitives.second);
+                auto row = (*table)[idx];
+
+                ASSERT_EQ(row.size(), static_cast<ind>(connections.size()));
+                ASSERT_EQ(stencil.size(), static_cast<ind>(connections.size()));
+                EXPECT_TRUE(std::equal(row.begin(), row.end(), connections.begin()));
+                EXPECT_TRUE(std::equal(stencil.begin(), stencil.end(), connections.begin()));
+            }
+        }
+    }
+
+    // Corners of the first cell
+    grids.front()->getStencil(stencil, 0, GridPrimitive::Volume, GridPrimitive::Vertex);
+    const std::vector<ind> corners = {0, 1, 5, 6, 30, 31, 35, 36};
+    EXPECT_TRUE(std::equal(stencil.begin(), stencil.end(), corners.begin(), corners.end()));
+}
+
 }  // namespace discretedata
 }  // namespace inviwo
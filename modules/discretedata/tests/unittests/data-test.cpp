@@ -38,6 +38,8 @@
 
 #include <inviwo/core/util/glm.h>
 
+#include <atomic>
+
 namespace inviwo {
 namespace discretedata {
 
@@ -148,5 +150,69 @@ TEST(CreatingCopyingIndexing, DataChannels) {
     }
 }
 
+TEST(BlockAccess, DataChannels) {
+    const ind numElements = 10007;
+    const ind blockSize = 1000;
+
+    auto base = [](glm::vec3& dest, ind idx) {
+        dest[0] = 1.0f;
+        dest[1] = static_cast<float>(idx);
+        dest[2] = static_cast<float>(idx % 7);
+    };
+
+    std::vector<float> data;
+    for (ind idx = 0; idx < numElements; ++idx) {
+        data.push_back(1.0f);
+        data.push_back(static_cast<float>(idx));
+        data.push_back(static_cast<float>(idx % 7));
+    }
+    BufferFloat buffer(data, "Buffer");
+    AnalyticChannel<float, 3, glm::vec3> analytic(base, numElements, "Analytic");
+
+    // Only channels stored in memory expose a span.
+    EXPECT_EQ(buffer.span().size(), numElements);
+    EXPECT_TRUE(analytic.span().empty());
+
+    // Block fill, sequential and parallel, agrees with element wise access.
+    std::vector<glm::vec3> bufferBlock(numElements);
+    std::vector<glm::vec3> analyticBlock(numElements);
+    buffer.fillBlock(bufferBlock.data(), 0, numElements);
+    analytic.fillBlock(analyticBlock.data(), 0, numElements, true);
+    for (ind idx = 0; idx < numElements; ++idx) {
+        glm::vec3 expected;
+        base(expected, idx);
+        EXPECT_EQ(bufferBlock[idx], expected);
+        EXPECT_EQ(analyticBlock[idx], expected);
+    }
+
+    // Blocks cover all elements in order.
+    ind numVisited = 0;
+    analytic.forEachBlock<glm::vec3>(
+        [&](ChannelSpan<const glm::vec3> block, ind start) {
+            EXPECT_EQ(start, numVisited);
+            EXPECT_LE(block.size(), blockSize);
+            for (ind i = 0; i < block.size(); ++i) EXPECT_EQ(block[i], bufferBlock[start + i]);
+            numVisited += block.size();
+        },
+        blockSize);
+    EXPECT_EQ(numVisited, numElements);
+
+    std::atomic<ind> numVisitedParallel{0};
+    buffer.forEachBlockParallel<glm::vec3>(
+        [&](ChannelSpan<const glm::vec3> block, ind start) {
+            for (ind i = 0; i < block.size(); ++i) {
+                if (block[i] != analyticBlock[start + i]) return;
+            }
+            numVisitedParallel += block.size();
+        },
+        blockSize);
+    EXPECT_EQ(numVisitedParallel, numElements);
+
+    glm::vec3 min, max;
+    analytic.getMinMax(min, max);
+    EXPECT_EQ(min, glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(max, glm::vec3(1.0f, numElements - 1.0f, 6.0f));
+}
+
 }  // namespace discretedata
 }  // namespace inviwo
@@ -0,0 +1,214 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/discretedata/dataset.h>
+#include <modules/discretedata/channels/bufferchannel.h>
+#include <modules/discretedata/connectivity/structuredgrid.h>
+#include <modules/discretedata/sampling/celllocator.h>
+#include <modules/discretedata/sampling/datasetsampler.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+
+#include <random>
+
+namespace inviwo {
+namespace discretedata {
+
+namespace {
+
+// A unit cube split into five tetrahedra
+class TetrahedralCube : public Connectivity {
+public:
+    TetrahedralCube() : Connectivity(GridPrimitive::Volume) {
+        numGridPrimitives_[static_cast<ind>(GridPrimitive::Vertex)] = 8;
+        numGridPrimitives_[static_cast<ind>(GridPrimitive::Volume)] = 5;
+    }
+
+    virtual void getConnections(std::vector<ind>& result, ind index, GridPrimitive,
+                                GridPrimitive, bool) const override {
+        static constexpr ind tetrahedra[5][4] = {
+            {0, 3, 5, 6}, {1, 0, 3, 5}, {0, 2, 6, 3}, {5, 3, 6, 7}, {4, 5, 6, 0}};
+        result.assign(tetrahedra[index], tetrahedra[index] + 4);
+    }
+};
+
+dvec3 warp(const dvec3& p) {
+    return dvec3(p.x + 0.3 * std::sin(p.y), 1.5 * p.y + 0.05 * p.x * p.z, p.z + 0.1 * p.x * p.y);
+}
+
+}  // namespace
+
+TEST(CellLocation, CurvilinearGrid) {
+    const std::vector<ind> size = {6, 5, 7};
+    auto grid = std::make_shared<StructuredGrid>(GridPrimitive::Volume, size);
+
+    // Warped vertex positions and the grid coordinates of each vertex
+    std::vector<double> positions;
+    std::vector<double> coordinates;
+    for (ind k = 0; k <= size[2]; ++k) {
+        for (ind j = 0; j <= size[1]; ++j) {
+            for (ind i = 0; i <= size[0]; ++i) {
+                const dvec3 pos = warp(dvec3(i, j, k));
+                positions.insert(positions.end(), {pos.x, pos.y, pos.z});
+                coordinates.insert(coordinates.end(), {double(i), double(j), double(k)});
+            }
+        }
+    }
+    DataSet dataSet(grid);
+    dataSet.addChannel(new BufferChannel<double, 3>(positions, "Position"));
+    auto coordinateChannel = std::make_shared<BufferChannel<double, 3>>(coordinates, "Coordinate");
+    dataSet.addChannel(coordinateChannel);
+
+    CellLocator locator(grid, *dataSet.getChannel("Position"));
+
+    // Positions mapped from random points inside random cells, the interpolated grid
+    // coordinates have to match the points.
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::vector<dvec3> points;
+    std::vector<dvec3> expected;
+    std::vector<ind> corners;
+    for (int sample = 0; sample < 500; ++sample) {
+        const ind cell = static_cast<ind>(rng() % grid->getNumElements(GridPrimitive::Volume));
+        grid->getConnections(corners, cell, GridPrimitive::Volume, GridPrimitive::Vertex, true);
+
+        const dvec3 u(dist(rng), dist(rng), dist(rng));
+        dvec3 pos(0.0);
+        dvec3 coordinate(0.0);
+        for (int v = 0; v < 8; ++v) {
+            const dvec3 bits((v & 1) ? 1.0 : 0.0, (v & 2) ? 1.0 : 0.0, (v & 4) ? 1.0 : 0.0);
+            const dvec3 w = bits * u + (1.0 - bits) * (1.0 - u);
+            pos += w.x * w.y * w.z * dvec3(positions[3 * corners[v]], positions[3 * corners[v] + 1],
+                                           positions[3 * corners[v] + 2]);
+            coordinate += w.x * w.y * w.z * dvec3(coordinates[3 * corners[v]],
+                                                  coordinates[3 * corners[v] + 1],
+                                                  coordinates[3 * corners[v] + 2]);
+        }
+        points.push_back(pos);
+        expected.push_back(coordinate);
+    }
+
+    std::vector<CellLocator::Location> locations;
+    locator.locate(points, locations);
+    for (size_t i = 0; i < points.size(); ++i) {
+        ASSERT_TRUE(locations[i].isValid());
+        const dvec3 coordinate = CellLocator::interpolate(*coordinateChannel, locations[i]);
+        EXPECT_NEAR(coordinate.x, expected[i].x, 1e-9);
+        EXPECT_NEAR(coordinate.y, expected[i].y, 1e-9);
+        EXPECT_NEAR(coordinate.z, expected[i].z, 1e-9);
+    }
+
+    CellLocator::Location outside;
+    EXPECT_FALSE(locator.locate(dvec3(-100.0, 0.0, 0.0), outside));
+    EXPECT_FALSE(outside.isValid());
+
+    // The sampler interpolates the same way, data space spans the bounding box of the cells
+    DataSetSampler<3> sampler(dataSet, "Position", "Coordinate");
+    const dvec3 dataPos =
+        (points.front() - locator.getMin()) / (locator.getMax() - locator.getMin());
+    EXPECT_TRUE(sampler.withinBounds(dataPos));
+    const dvec3 sampled = sampler.sample(dataPos);
+    EXPECT_NEAR(sampled.x, expected.front().x, 1e-6);
+    EXPECT_NEAR(sampled.y, expected.front().y, 1e-6);
+    EXPECT_NEAR(sampled.z, expected.front().z, 1e-6);
+}
+
+TEST(CellLocation, Tetrahedra) {
+    std::vector<double> positions;
+    for (int v = 0; v < 8; ++v) {
+        positions.insert(positions.end(), {double(v & 1), double((v >> 1) & 1), double(v >> 2)});
+    }
+    BufferChannel<double, 3> positionChannel(positions, "Position");
+    CellLocator locator(std::make_shared<TetrahedralCube>(), positionChannel);
+
+    // Barycentric interpolation reproduces linear functions, such as the position itself
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    CellLocator::Location location;
+    for (int sample = 0; sample < 500; ++sample) {
+        const dvec3 pos(dist(rng), dist(rng), dist(rng));
+        ASSERT_TRUE(locator.locate(pos, location, location.cell));
+        EXPECT_EQ(location.numVertices, 4);
+        const dvec3 interpolated = CellLocator::interpolate(positionChannel, location);
+        EXPECT_NEAR(interpolated.x, pos.x, 1e-12);
+        EXPECT_NEAR(interpolated.y, pos.y, 1e-12);
+        EXPECT_NEAR(interpolated.z, pos.z, 1e-12);
+    }
+}
+
+TEST(CellLocation, ResampleToVolume) {
+    std::vector<double> positions;
+    for (int v = 0; v < 8; ++v) {
+        positions.insert(positions.end(),
+                         {2.0 * (v & 1), 1.0 + ((v >> 1) & 1), -1.0 + 0.5 * (v >> 2)});
+    }
+    auto positionChannel = std::make_shared<BufferChannel<double, 3>>(positions, "Position");
+    auto locator =
+        std::make_shared<const CellLocator>(std::make_shared<TetrahedralCube>(), *positionChannel);
+
+    // Resampling the positions gives each voxel the model space position of its center
+    const size3_t dims{4, 3, 2};
+    const auto volume = resampleToVolume(*locator, *positionChannel, dims);
+    ASSERT_EQ(dims, volume->getDimensions());
+    const auto ram = volume->getRepresentation<VolumeRAM>();
+    const mat4 indexToModel = volume->getCoordinateTransformer().getIndexToModelMatrix();
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                const dvec3 value = ram->getAsDVec3(size3_t(x, y, z));
+                const dvec3 center{indexToModel * vec4(x, y, z, 1.0f)};
+                EXPECT_NEAR(value.x, center.x, 1e-5);
+                EXPECT_NEAR(value.y, center.y, 1e-5);
+                EXPECT_NEAR(value.z, center.z, 1e-5);
+            }
+        }
+    }
+
+    // Repeated and interleaved queries of the sampler give the same result
+    DataSetSampler<3> sampler(locator, positionChannel);
+    const dvec3 inside{0.25, 0.5, 0.75};
+    const dvec3 expected{0.5, 1.5, -0.625};
+    EXPECT_TRUE(sampler.withinBounds(inside));
+    for (int i = 0; i < 2; ++i) {
+        const dvec3 sampled = sampler.sample(inside);
+        EXPECT_NEAR(sampled.x, expected.x, 1e-12);
+        EXPECT_NEAR(sampled.y, expected.y, 1e-12);
+        EXPECT_NEAR(sampled.z, expected.z, 1e-12);
+    }
+    EXPECT_FALSE(sampler.withinBounds(dvec3{2.0, 0.5, 0.5}));
+    EXPECT_EQ(dvec3(0.0), sampler.sample(dvec3{2.0, 0.5, 0.5}));
+    EXPECT_TRUE(sampler.withinBounds(inside));
+}
+
+}  // namespace discretedata
+}  // namespace inviwo
@@ -6923,6 +6923,10 @@ int nifti_read_subregion_image( nifti_image * nim,
 
   /* get the file open */
   fp = nifti_image_load_prep( nim );
+  if(znz_isnull(fp))
+    {
+    return -1;
+    }
   /* the current offset is just past the nifti header, save
    * location so that SEEK_SET can be used below
    */
@@ -6948,6 +6952,7 @@ int nifti_read_subregion_image( nifti_image * nim,
     if(g_opts.debug > 1)
       {
       fprintf(stderr,"allocation of %d bytes failed\n",total_alloc_size);
+      znzclose(fp);
       return -1;
       }
     }
@@ -6999,6 +7004,7 @@ int nifti_read_subregion_image( nifti_image * nim,
                 if(g_opts.debug > 1)
                   {
                   fprintf(stderr,"read of %d bytes failed\n",read_amount);
+                  znzclose(fp);
                   return -1;
                   }
                 }
@@ -7011,6 +7017,7 @@ int nifti_read_subregion_image( nifti_image * nim,
       }
     }
   }
+  znzclose(fp);
   return bytes;
 }
 
@@ -62,8 +62,15 @@ public:
 
     virtual ~NiftiReader() = default;
 
+    /**
+     * Read a Nifti file. The first time step is always read directly. The remaining ones of 4D
+     * files are read concurrently if the whole series takes up at most preloadLimit bytes,
+     * otherwise they are loaded when first accessed.
+     */
     virtual std::shared_ptr<VolumeSequence> readData(const std::string& filePath) override;
 
+    static constexpr size_t preloadLimit = size_t{1} << 30;
+
     /**
      * \brief Convert from Nifti defined data types to inviwo DataFormat.
      *
@@ -76,6 +83,10 @@ public:
 /**
  * \brief A loader of Nifti files. Used to create VolumeRAM representations.
  * This class us used by the NiftiReader.
+ *
+ * The region is read directly into the destination and then mirrored in place along the flipped
+ * axes by swapping slices, rows, and voxels, in parallel over the slices. Several loaders sharing
+ * the same nifti_image can be used concurrently.
  */
 class IVW_MODULE_NIFTI_API NiftiVolumeRAMLoader
     : public DiskRepresentationLoader<VolumeRepresentation> {
@@ -88,52 +99,29 @@ public:
     virtual std::shared_ptr<VolumeRepresentation> createRepresentation() const override;
     virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation> dest) const override;
 
+    /**
+     * \brief Mirror volume data in place along the given axes.
+     *
+     * @param data volume data with x being the fastest index
+     * @param dimensions of the volume
+     * @param bytesPerVoxel size of each voxel in bytes
+     * @param flipAxis whether to mirror the data along x, y, and z
+     */
+    static void flip(void* data, size3_t dimensions, size_t bytesPerVoxel,
+                     std::array<bool, 3> flipAxis);
+
     using type = std::shared_ptr<VolumeRAM>;
 
     template <typename Result, typename T>
     std::shared_ptr<VolumeRAM> operator()() const {
         using F = typename T::type;
 
-        const std::size_t size = region_size[0] * region_size[1] * region_size[2] * region_size[3] *
-                                 region_size[4] * region_size[5] * region_size[6];
-        auto data = util::make_unique<F[]>(size);
-
-        if (!data) {
-            throw DataReaderException(
-                "Error: Could not allocate memory for loading raw file: " + std::string(nim->fname),
-                IvwContext);
-        }
-        auto dataPointer = reinterpret_cast<void*>(data.get());
-        auto readBytes =
-            nifti_read_subregion_image(nim.get(), const_cast<int*>(start_index.data()),
-                                       const_cast<int*>(region_size.data()), &dataPointer);
-        if (readBytes < 0) {
-            throw DataReaderException(
-                "Error: Could not read data from file: " + std::string(nim->fname), IvwContext);
-        }
-        // Flip data along axes if necessary
-        if (flipAxis[0] || flipAxis[1] || flipAxis[2]) {
-            auto tmp = util::make_unique<F[]>(size);
-            std::memcpy(tmp.get(), dataPointer, size * sizeof(F));
-            auto dim = size3_t{region_size[0], region_size[1], region_size[2]};
-            util::IndexMapper3D mapper(dim);
-            for (auto z = 0; z < region_size[2]; ++z) {
-                auto idz = flipAxis[2] ? region_size[2] - 1 - z : z;
-                for (auto y = 0; y < region_size[1]; ++y) {
-                    auto idy = flipAxis[1] ? region_size[1] - 1 - y : y;
-                    for (auto x = 0; x < region_size[0]; ++x) {
-                        auto idx = flipAxis[0] ? region_size[0] - 1 - x : x;
-                        auto from = mapper(x, y, z);
-                        auto to = mapper(idx, idy, idz);
-                        data[to] = tmp[from];
-                    }
-                }
-            }
-        }
-
-        auto repr = std::make_shared<VolumeRAMPrecision<F>>(
-            data.get(), size3_t{region_size[0], region_size[1], region_size[2]});
+        const size3_t dims{region_size[0], region_size[1], region_size[2]};
+        // Every voxel is read, so there is no need to initialize the data
+        std::unique_ptr<F[]> data(new F[glm::compMul(dims)]);
+        auto repr = std::make_shared<VolumeRAMPrecision<F>>(data.get(), dims);
         data.release();
+        updateRepresentation(repr);
         return repr;
     }
 
@@ -31,6 +31,7 @@
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/datastructures/volume/volumedisk.h>
 #include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/foreach.h>
 #include <inviwo/core/util/formatconversion.h>
 #include <inviwo/core/util/formatdispatching.h>
 #include <inviwo/core/util/stringconversion.h>
@@ -38,6 +39,9 @@
 
 #include <modules/base/algorithm/dataminmax.h>
 
+#include <algorithm>
+#include <cstring>
+
 namespace inviwo {
 
 NiftiReader::NiftiReader() : DataReaderType<VolumeSequence>() {
@@ -299,12 +303,35 @@ std::shared_ptr<NiftiReader::VolumeSequence> NiftiReader::readData(const std::st
     }
 
     auto volumes = std::make_shared<VolumeSequence>();
-    // Lazy loading of time steps
-    for (int t = 1; t < niftiImage->dim[4]; ++t) {
+    const auto timesteps = static_cast<size_t>(std::max(niftiImage->dim[4], 1));
+
+    // Read the remaining time steps concurrently if they all fit within the preload limit,
+    // otherwise they are loaded lazily
+    const bool preload = timesteps * glm::compMul(dim) * format->getSize() <= preloadLimit;
+    std::vector<std::shared_ptr<VolumeRAM>> timestepRAMs(preload ? timesteps : 0);
+    if (preload) {
+        util::forEachRangeParallel(
+            timesteps - 1,
+            [&](size_t begin, size_t end) {
+                auto index = start_index;
+                for (size_t t = begin + 1; t < end + 1; ++t) {
+                    index[3] = static_cast<int>(t);
+                    NiftiVolumeRAMLoader timestepLoader(niftiImage, index, region_size, flipAxis);
+                    timestepRAMs[t] =
+                        std::static_pointer_cast<VolumeRAM>(timestepLoader.createRepresentation());
+                }
+            },
+            timesteps - 1);
+    }
 
+    for (size_t t = 1; t < timesteps; ++t) {
         volumes->push_back(std::shared_ptr<Volume>(volume->clone()));
+        if (preload) {
+            volumes->back()->addRepresentation(timestepRAMs[t]);
+            continue;
+        }
         auto diskRepr = std::make_shared<VolumeDisk>(filePath, dim, format);
-        start_index[3] = t;
+        start_index[3] = static_cast<int>(t);
         diskRepr->setLoader(
             new NiftiVolumeRAMLoader(niftiImage, start_index, region_size, flipAxis));
         volumes->back()->addRepresentation(diskRepr);
@@ -349,24 +376,87 @@ void NiftiVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresenta
     }
     // Flip data along axes if necessary
     if (flipAxis[0] || flipAxis[1] || flipAxis[2]) {
-        std::unique_ptr<char[]> tmp(new char[volumeDst->getNumberOfBytes()]);
-        std::memcpy(tmp.get(), data, volumeDst->getNumberOfBytes());
-        auto dim = size3_t{region_size[0], region_size[1], region_size[2]};
-        util::IndexMapper3D mapper(dim);
-        auto sizeOfDataType = volumeDst->getDataFormat()->getSize();
-        for (auto z = 0; z < region_size[2]; ++z) {
-            auto idz = flipAxis[2] ? region_size[2] - 1 - z : z;
-            for (auto y = 0; y < region_size[1]; ++y) {
-                auto idy = flipAxis[1] ? region_size[1] - 1 - y : y;
-                for (auto x = 0; x < region_size[0]; ++x) {
-                    auto idx = flipAxis[0] ? dim.x - 1 - x : x;
-                    auto from = mapper(x, y, z);
-                    auto to = mapper(idx, idy, idz);
-                    std::memcpy(static_cast<char*>(data) + to * sizeOfDataType,
-                                tmp.get() + from * sizeOfDataType, sizeOfDataType);
+        flip(data, volumeDst->getDimensions(), volumeDst->getDataFormat()->getSize(), flipAxis);
+    }
+}
+
+namespace {
+
+// Reverse the order of count elements of N bytes each
+template <size_t N>
+void reverseElements(char* data, size_t count) {
+    std::array<char, N> tmp;
+    for (size_t i = 0, j = count - 1; i < j; ++i, --j) {
+        std::memcpy(tmp.data(), data + i * N, N);
+        std::memcpy(data + i * N, data + j * N, N);
+        std::memcpy(data + j * N, tmp.data(), N);
+    }
+}
+
+void reverseElements(char* data, size_t count, size_t bytes) {
+    switch (bytes) {
+        case 1:
+            std::reverse(data, data + count);
+            break;
+        case 2:
+            reverseElements<2>(data, count);
+            break;
+        case 3:
+            reverseElements<3>(data, count);
+            break;
+        case 4:
+            reverseElements<4>(data, count);
+            break;
+        case 8:
+            reverseElements<8>(data, count);
+            break;
+        default:
+            for (size_t i = 0, j = count - 1; i < j; ++i, --j) {
+                std::swap_ranges(data + i * bytes, data + (i + 1) * bytes, data + j * bytes);
+            }
+            break;
+    }
+}
+
+}  // namespace
+
+void NiftiVolumeRAMLoader::flip(void* data, size3_t dimensions, size_t bytesPerVoxel,
+                                std::array<bool, 3> flipAxis) {
+    if (glm::compMul(dimensions) == 0) return;
+
+    auto bytes = static_cast<char*>(data);
+    const size_t rowSize = dimensions.x * bytesPerVoxel;
+    const size_t sliceSize = rowSize * dimensions.y;
+
+    // Mirror along z by swapping pairs of slices
+    if (flipAxis[2]) {
+        util::forEachRangeParallel(dimensions.z / 2, [&](size_t begin, size_t end) {
+            for (size_t z = begin; z < end; ++z) {
+                auto slice = bytes + z * sliceSize;
+                std::swap_ranges(slice, slice + sliceSize,
+                                 bytes + (dimensions.z - 1 - z) * sliceSize);
+            }
+        });
+    }
+
+    // Mirror along y by swapping pairs of rows and along x by reversing each row
+    if (flipAxis[0] || flipAxis[1]) {
+        util::forEachRangeParallel(dimensions.z, [&](size_t begin, size_t end) {
+            for (size_t z = begin; z < end; ++z) {
+                auto slice = bytes + z * sliceSize;
+                if (flipAxis[1]) {
+                    for (size_t y = 0; y < dimensions.y / 2; ++y) {
+                        std::swap_ranges(slice + y * rowSize, slice + (y + 1) * rowSize,
+                                         slice + (dimensions.y - 1 - y) * rowSize);
+                    }
+                }
+                if (flipAxis[0]) {
+                    for (size_t y = 0; y < dimensions.y; ++y) {
+                        reverseElements(slice + y * rowSize, dimensions.x, bytesPerVoxel);
+                    }
                 }
             }
-        }
+        });
     }
 }
 
@@ -34,7 +34,15 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/datastructures/buffer/buffer.h>
 #include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/quantilesketch.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <mutex>
 #include <ostream>
+#include <stdexcept>
 
 namespace inviwo {
 
@@ -56,9 +64,75 @@ std::basic_ostream<Elem, Traits>& operator<<(std::basic_ostream<Elem, Traits>& o
     return os;
 }
 
+/**
+ * \brief Build a QuantileSketch of the given range.
+ * The range is split into chunks which are sketched in parallel on the thread pool and then merged.
+ * NaNs are ignored.
+ */
+template <typename Iterator>
+util::QuantileSketch quantileSketch(Iterator begin, Iterator end, double compression = 200.0) {
+    const auto size = static_cast<size_t>(std::distance(begin, end));
+    util::QuantileSketch sketch(compression);
+    std::mutex mutex;
+    util::forEachRangeParallel(size, [&](size_t first, size_t last) {
+        util::QuantileSketch chunk(compression);
+        chunk.add(std::next(begin, first), std::next(begin, last));
+        std::lock_guard<std::mutex> lock(mutex);
+        sketch.merge(chunk);
+    });
+    return sketch;
+}
+
+namespace detail {
+
+/**
+ * Ranges with more elements than this are handled by percentiles using a QuantileSketch.
+ */
+constexpr size_t exactPercentilesLimit = size_t{1} << 22;
+
+template <typename T>
+void checkPercentiles(const std::vector<double>& percentiles) {
+    for (auto percentile : percentiles) {
+        if (percentile < 0.0 || percentile > 1.0) {
+            if (util::is_floating_point<T>::value) {
+                throw std::invalid_argument("Percentile must be between 0 and 1");
+            } else {
+                throw Exception("Percentile must be between 0 and 1");
+            }
+        }
+    }
+}
+
+template <typename T, typename Iterator>
+std::vector<T> percentiles(Iterator begin, Iterator end, const std::vector<double>& percentiles) {
+    const auto size = static_cast<size_t>(std::distance(begin, end));
+    if (size <= exactPercentilesLimit) {
+        std::vector<T> data;
+        data.reserve(size);
+        std::copy_if(begin, end, std::back_inserter(data),
+                     [](const T& a) { return !util::isnan(a); });
+        return util::nearestRankPercentiles(data.begin(), data.end(), percentiles);
+    }
+
+    const auto sketch = quantileSketch(begin, end);
+    std::vector<T> result;
+    result.reserve(percentiles.size());
+    for (auto percentile : percentiles) {
+        const auto value = sketch.quantile(percentile);
+        result.push_back(
+            static_cast<T>(util::is_floating_point<T>::value ? value : std::round(value)));
+    }
+    return result;
+}
+
+}  // namespace detail
+
 /**
  * \brief Compute value below a percentage of observations in the data.
  * Uses the nearest rank method, i.e. ceil(percentile * N), where N = number of elements in data.
+ * The data is not sorted, instead the ranks are found using std::nth_element on a copy. Inputs with
+ * more than detail::exactPercentilesLimit elements are instead estimated using a QuantileSketch
+ * built in parallel, see quantileSketch.
  *
  * NaNs (Not a Numbers) are excluded from the computation.
  * The following example will return {1,2}
@@ -70,43 +144,13 @@ std::basic_ostream<Elem, Traits>& operator<<(std::basic_ostream<Elem, Traits>& o
  * @param data to compute percentiles on
  * @param percentiles in the range [0 1]
  * @return values below the percentage given by the percentiles.
- * @throw Exception if any percentile is less than 0 or larger than 1
+ * @throw Exception if any percentile is less than 0 or larger than 1, std::invalid_argument for
+ * floating point data
  */
-template <typename T, typename std::enable_if<!util::is_floating_point<T>::value, int>::type = 0>
-std::vector<T> percentiles(std::vector<T> data, const std::vector<double>& percentiles) {
-    std::sort(data.begin(), data.end());
-    std::vector<T> result;
-    result.reserve(percentiles.size());
-    auto nElements = data.size();
-    for (auto percentile : percentiles) {
-        if (percentile < 0.f || percentile > 1.f) {
-            throw Exception("Percentile must be between 0 and 1");
-        }
-        // Take care of percentile == 1 using std::min
-        result.push_back(
-            data[static_cast<size_t>(std::max(std::ceil(nElements * percentile) - 1., 0.))]);
-    }
-    return result;
-}
-
-// Float/double types have special values
-template <typename T, typename std::enable_if<util::is_floating_point<T>::value, int>::type = 0>
-std::vector<T> percentiles(std::vector<T> data, const std::vector<double>& percentiles) {
-    auto noNaN =
-        std::partition(data.begin(), data.end(), [](const auto& a) { return util::isnan(a); });
-    std::sort(noNaN, data.end());
-    std::vector<T> result;
-    result.reserve(percentiles.size());
-    size_t nElements = std::distance(noNaN, data.end());
-    for (auto percentile : percentiles) {
-        if (percentile < 0.f || percentile > 1.f) {
-            throw std::invalid_argument("Percentile must be between 0 and 1");
-        }
-        // Take care of percentile == 1 using std::min
-        result.push_back(
-            data[static_cast<size_t>(std::max(std::ceil(nElements * percentile) - 1., 0.))]);
-    }
-    return result;
+template <typename T>
+std::vector<T> percentiles(const std::vector<T>& data, const std::vector<double>& percentiles) {
+    detail::checkPercentiles<T>(percentiles);
+    return detail::percentiles<T>(data.begin(), data.end(), percentiles);
 }
 
 }  // namespace statsutil
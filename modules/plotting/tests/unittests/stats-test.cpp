@@ -34,6 +34,8 @@
 
 #include <modules/plotting/utils/statsutils.h>
 
+#include <limits>
+
 namespace inviwo {
 
 TEST(StatsUtilsTest, init) {
@@ -66,6 +68,11 @@ TEST(StatsUtilsTest, init) {
     EXPECT_DOUBLE_EQ(20., percentiles[2]) << " 40 percentile";
     EXPECT_DOUBLE_EQ(35., percentiles[3]) << " 50 percentile";
     EXPECT_DOUBLE_EQ(50., percentiles[4]) << " 100 percentile";
+
+    // NaNs are excluded
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    auto dataNaN = std::vector<double>({nan, 20., 15., nan, 50., 40., 35.});
+    EXPECT_EQ(percentiles, statsutil::percentiles(dataNaN, {0.05, .30, 0.40, 0.5, 1.0}));
 }
 
 }  // namespace inviwo
@@ -0,0 +1,90 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_DDSSTREAM_H
+#define IVW_DDSSTREAM_H
+
+#include <modules/pvm/pvmmoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \brief Decoded contents of a DDS file, the compressed container used by the PVM format.
+ *
+ * The DDS encoding is a single differential bit stream of the data bytes after they have been
+ * split into `skip` interleaved planes, in one piece for version 1 ("DDS v3d") files and in
+ * chunks of `skip * 2^24` bytes for version 2 ("DDS v3e") files. Each value depends on the
+ * previously decoded ones, so the bit stream is decoded serially in the constructor. The planes
+ * are not restored though, instead the bytes are gathered into their original order on demand by
+ * copy(), which is thread safe and lets the caller restore disjoint ranges in parallel straight
+ * into their final destination.
+ */
+class IVW_MODULE_PVM_API DDSStream {
+public:
+    /**
+     * Decode the DDS file \p filePath.
+     * @throw DataReaderException if the file can not be opened or is not a DDS file
+     */
+    DDSStream(const std::string& filePath);
+
+    /**
+     * Number of decoded bytes
+     */
+    size_t size() const;
+
+    /**
+     * Byte \p i of the original stream
+     */
+    unsigned char operator[](size_t i) const;
+
+    /**
+     * Copy the bytes [\p begin, \p end) of the original stream into \p dest.
+     */
+    void copy(size_t begin, size_t end, unsigned char* dest) const;
+
+    /**
+     * Read a null-terminated string starting at byte \p pos of the original stream and advance
+     * \p pos past the terminator. The string ends at the end of the stream if no terminator is
+     * found.
+     */
+    std::string readString(size_t& pos) const;
+
+private:
+    size_t skip_ = 1;
+    size_t chunkSize_ = 0;
+    std::vector<unsigned char> data_;
+};
+
+}  // namespace inviwo
+
+#endif  // IVW_DDSSTREAM_H
@@ -0,0 +1,206 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/pvm/ddsstream.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+namespace inviwo {
+
+namespace {
+
+constexpr std::array<char, 8> ddsId{{'D', 'D', 'S', ' ', 'v', '3', 'd', '\n'}};
+constexpr std::array<char, 8> ddsId2{{'D', 'D', 'S', ' ', 'v', '3', 'e', '\n'}};
+
+// Version 2 files are interleaved in chunks of skip * ddsInterleave bytes
+constexpr size_t ddsInterleave = size_t{1} << 24;
+// Number of bits used to store the length of a run
+constexpr int ddsRunLength = 7;
+
+/**
+ * Reads the MSB first bit stream of a DDS file from memory. Reading past the end returns zeros,
+ * which is how the stream is padded when written.
+ */
+class BitReader {
+public:
+    BitReader(const unsigned char* data, size_t size) : data_{data}, size_{size} {}
+
+    unsigned int read(int bits) {
+        if (bits == 0) return 0;
+        if (available_ < bits) refill();
+        available_ -= bits;
+        return static_cast<unsigned int>(buffer_ >> available_) & ((1u << bits) - 1u);
+    }
+
+private:
+    void refill() {
+        while (available_ <= 56) {
+            buffer_ = (buffer_ << 8) | (pos_ < size_ ? data_[pos_] : 0u);
+            ++pos_;
+            available_ += 8;
+        }
+    }
+
+    const unsigned char* data_;
+    size_t size_;
+    size_t pos_ = 0;
+    std::uint64_t buffer_ = 0;
+    int available_ = 0;
+};
+
+// A width code of 0 means 0 bits, any other code is one less than the number of bits
+int decodeBits(unsigned int code) { return code >= 1 ? static_cast<int>(code) + 1 : 0; }
+
+// Number of bytes of plane p in a chunk of len bytes split into skip planes
+size_t planeSize(size_t len, size_t skip, size_t p) { return (len + skip - 1 - p) / skip; }
+
+}  // namespace
+
+DDSStream::DDSStream(const std::string& filePath) {
+    auto file = filesystem::ifstream(filePath, std::ios_base::in | std::ios_base::binary);
+    if (!file) {
+        throw DataReaderException("Error: Could not open file: " + filePath,
+                                  IvwContextCustom("DDSStream"));
+    }
+    const std::vector<unsigned char> encoded{std::istreambuf_iterator<char>(file),
+                                             std::istreambuf_iterator<char>()};
+
+    if (encoded.size() < ddsId.size()) {
+        throw DataReaderException("Error: Not a DDS file: " + filePath,
+                                  IvwContextCustom("DDSStream"));
+    }
+    int version = 0;
+    if (std::memcmp(encoded.data(), ddsId.data(), ddsId.size()) == 0) {
+        version = 1;
+    } else if (std::memcmp(encoded.data(), ddsId2.data(), ddsId2.size()) == 0) {
+        version = 2;
+    } else {
+        throw DataReaderException("Error: Not a DDS file: " + filePath,
+                                  IvwContextCustom("DDSStream"));
+    }
+
+    BitReader reader(encoded.data() + ddsId.size(), encoded.size() - ddsId.size());
+    skip_ = reader.read(2) + 1;
+    const size_t strip = reader.read(16) + 1;
+    chunkSize_ = version == 2 ? skip_ * ddsInterleave : 0;
+
+    // Each byte is stored as a difference to a prediction from the previous row of strip bytes,
+    // in runs of values with the same bit width. Guess the size from a typical compression ratio
+    // and grow geometrically if needed.
+    data_.resize(std::max(encoded.size() * 4, size_t{1} << 20));
+    size_t cnt = 0;
+    int act = 0;
+    while (const auto run = reader.read(ddsRunLength)) {
+        const int bits = decodeBits(reader.read(3));
+        const int offset = (1 << bits) / 2;
+
+        if (cnt + run > data_.size()) data_.resize(std::max(2 * data_.size(), cnt + run));
+        auto out = data_.data();
+
+        for (unsigned int i = 0; i < run; ++i, ++cnt) {
+            act += static_cast<int>(reader.read(bits)) - offset;
+            if (cnt > strip) act += out[cnt - strip] - out[cnt - strip - 1];
+            act &= 0xff;
+            out[cnt] = static_cast<unsigned char>(act);
+        }
+    }
+    data_.resize(cnt);
+    data_.shrink_to_fit();
+
+    if (data_.empty()) {
+        throw DataReaderException("Error: No data in DDS file: " + filePath,
+                                  IvwContextCustom("DDSStream"));
+    }
+}
+
+size_t DDSStream::size() const { return data_.size(); }
+
+unsigned char DDSStream::operator[](size_t i) const {
+    if (skip_ == 1) return data_[i];
+
+    const size_t chunk = chunkSize_ != 0 ? chunkSize_ : data_.size();
+    const size_t base = i / chunk * chunk;
+    const size_t len = std::min(chunk, data_.size() - base);
+    const size_t p = (i - base) % skip_;
+
+    size_t pos = base + (i - base) / skip_;
+    for (size_t q = 0; q < p; ++q) pos += planeSize(len, skip_, q);
+    return data_[pos];
+}
+
+void DDSStream::copy(size_t begin, size_t end, unsigned char* dest) const {
+    if (skip_ == 1) {
+        std::copy(data_.begin() + begin, data_.begin() + end, dest);
+        return;
+    }
+
+    const size_t chunk = chunkSize_ != 0 ? chunkSize_ : data_.size();
+    for (size_t i = begin; i < end;) {
+        const size_t base = i / chunk * chunk;
+        const size_t len = std::min(chunk, data_.size() - base);
+        const size_t stop = std::min(end, base + len);
+
+        // Read from one position in each plane and write the bytes out in their original order,
+        // planes before the first one are already one byte ahead.
+        const size_t m = (i - base) / skip_;
+        size_t p = (i - base) % skip_;
+        std::array<const unsigned char*, 4> planes{};
+        const unsigned char* plane = data_.data() + base;
+        for (size_t q = 0; q < skip_; ++q) {
+            planes[q] = plane + m + (q < p ? 1 : 0);
+            plane += planeSize(len, skip_, q);
+        }
+
+        for (; i < stop; ++i) {
+            *dest++ = *planes[p]++;
+            if (++p == skip_) p = 0;
+        }
+    }
+}
+
+std::string DDSStream::readString(size_t& pos) const {
+    std::string str;
+    for (; pos < data_.size(); ++pos) {
+        const auto c = (*this)[pos];
+        if (c == '\0') {
+            ++pos;
+            break;
+        }
+        str.push_back(static_cast<char>(c));
+    }
+    return str;
+}
+
+}  // namespace inviwo
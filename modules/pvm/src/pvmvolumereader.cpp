@@ -28,13 +28,19 @@
  *********************************************************************************/
 
 #include <modules/pvm/pvmvolumereader.h>
+#include <modules/pvm/ddsstream.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/util/exception.h>
 #include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/foreach.h>
 #include <inviwo/core/util/formatconversion.h>
 #include <inviwo/core/util/stringconversion.h>
 #include <inviwo/core/io/datareaderexception.h>
-#include <tidds/ddsbase.h>
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <sstream>
 
 namespace inviwo {
 
@@ -66,35 +72,59 @@ std::shared_ptr<Volume> PVMVolumeReader::readData(const std::string& filePath) {
 }
 
 std::shared_ptr<Volume> PVMVolumeReader::readPVMData(std::string filePath) {
+    // Decode the whole file, the header, voxels and meta data are all part of the DDS stream
+    const DDSStream stream(filePath);
+
+    // The header is a few short lines of text, "PVM" followed by the dimensions for version 1
+    // and "PVM2" or "PVM3" followed by the dimensions and voxel spacing for version 2 and 3. The
+    // last line is the number of bytes per voxel.
+    std::string headerStr(std::min(stream.size(), size_t{256}), '\0');
+    stream.copy(0, headerStr.size(), reinterpret_cast<unsigned char*>(&headerStr[0]));
+    std::istringstream header(headerStr);
+
+    const auto readLine = [&]() {
+        std::string line;
+        if (!std::getline(header, line) || header.eof()) {
+            throw DataReaderException("Error: Invalid header in PVM file: " + filePath,
+                                      IvwContextCustom("PVMVolumeReader"));
+        }
+        return std::istringstream(line);
+    };
+
+    int version = 0;
+    std::string magic;
+    readLine() >> magic;
+    if (magic == "PVM") {
+        version = 1;
+    } else if (magic == "PVM2") {
+        version = 2;
+    } else if (magic == "PVM3") {
+        version = 3;
+    } else {
+        throw DataReaderException("Error: Could not read data in PVM file: " + filePath,
+                                  IvwContextCustom("PVMVolumeReader"));
+    }
 
     size3_t dim(0);
-    glm::mat3 basis(2.0f);
-    glm::vec3 spacing(0.0f);
-
-    // Reading MPVM volume
-    unsigned char* data = nullptr;
-    unsigned int bytesPerVoxel = 0;
-    unsigned char* description = nullptr;
-    unsigned char* courtesy = nullptr;
-    unsigned char* parameter = nullptr;
-    unsigned char* comment = nullptr;
-
-    try {
-        uvec3 udim{0};
-        data =
-            readPVMvolume(filePath.c_str(), &udim.x, &udim.y, &udim.z, &bytesPerVoxel, &spacing.x,
-                          &spacing.y, &spacing.z, &description, &courtesy, &parameter, &comment);
-        dim = udim;
-
-    } catch (Exception& e) {
-        LogErrorCustom("PVMVolumeReader", e.what());
+    readLine() >> dim.x >> dim.y >> dim.z;
+    if (glm::any(glm::equal(dim, size3_t(0)))) {
+        throw DataReaderException("Error: Unable to find dimensions in .pvm file: " + filePath,
+                                  IvwContextCustom("PVMVolumeReader"));
     }
 
-    if (data == nullptr) {
-        throw DataReaderException("Error: Could not read data in PVM file: " + filePath,
-                                  IvwContextCustom("PVMVolumeReader"));
+    vec3 spacing(1.0f);
+    if (version > 1) {
+        readLine() >> spacing.x >> spacing.y >> spacing.z;
+        if (glm::any(glm::lessThanEqual(spacing, vec3(0.0f)))) {
+            throw DataReaderException("Error: Invalid voxel spacing in .pvm file: " + filePath,
+                                      IvwContextCustom("PVMVolumeReader"));
+        }
     }
 
+    unsigned int bytesPerVoxel = 0;
+    readLine() >> bytesPerVoxel;
+    const auto offset = static_cast<size_t>(header.tellg());
+
     const DataFormatBase* format = nullptr;
 
     switch (bytesPerVoxel) {
@@ -113,69 +143,74 @@ std::shared_ptr<Volume> PVMVolumeReader::readPVMData(std::string filePath) {
                 IvwContextCustom("PVMVolumeReader"));
     }
 
-    if (dim == size3_t(0)) {
-        throw DataReaderException("Error: Unable to find dimensions in .pvm file: " + filePath,
+    const size_t voxels = dim.x * dim.y * dim.z;
+    const size_t bytes = voxels * bytesPerVoxel;
+    if (offset + bytes > stream.size()) {
+        throw DataReaderException("Error: Unexpected end of file in .pvm file: " + filePath,
                                   IvwContextCustom("PVMVolumeReader"));
     }
 
     auto volume = std::make_shared<Volume>();
+    volume->dataMap_.initWithFormat(format);
 
-    if (format == DataUInt16::get()) {
-        size_t bytes = format->getSize();
-        size_t size = dim.x * dim.y * dim.z * bytes;
-        swapbytes(data, static_cast<unsigned int>(size));
-        // This format does not contain information about data range
-        // so we need to compute it for correct results
-        auto minmax = std::minmax_element(reinterpret_cast<DataUInt16::type*>(data),
-                                          reinterpret_cast<DataUInt16::type*>(data + size));
-        volume->dataMap_.dataRange = dvec2(*minmax.first, *minmax.second);
-    }
-
-    // Additional information
-    std::stringstream ss;
-
-    if (description) {
-        ss << description;
-        volume->setMetaData<StringMetaData>("description", ss.str());
-    }
+    // Restore the voxels straight into the volume representation, in parallel since every range
+    // of the stream can be restored independently
+    auto volRAM = createVolumeRAM(dim, format);
+    auto dest = static_cast<unsigned char*>(volRAM->getData());
 
-    if (courtesy) {
-        ss.clear();
-        ss.str("");
-        ss << courtesy;
-        volume->setMetaData<StringMetaData>("courtesy", ss.str());
-    }
-
-    if (parameter) {
-        ss.clear();
-        ss.str("");
-        ss << parameter;
-        volume->setMetaData<StringMetaData>("parameter", ss.str());
+    if (format == DataUInt16::get()) {
+        // The voxels are stored big endian and this format does not contain information about
+        // data range so we need to compute it for correct results. Both are done on each range
+        // right after restoring it while it still is in the cache.
+        auto data = static_cast<DataUInt16::type*>(volRAM->getData());
+        std::mutex mutex;
+        auto min = std::numeric_limits<DataUInt16::type>::max();
+        auto max = std::numeric_limits<DataUInt16::type>::lowest();
+
+        util::forEachRangeParallel(voxels, [&](size_t begin, size_t end) {
+            stream.copy(offset + 2 * begin, offset + 2 * end, dest + 2 * begin);
+
+            auto rangeMin = std::numeric_limits<DataUInt16::type>::max();
+            auto rangeMax = std::numeric_limits<DataUInt16::type>::lowest();
+            for (size_t i = begin; i < end; ++i) {
+                const auto value =
+                    static_cast<DataUInt16::type>((dest[2 * i] << 8) | dest[2 * i + 1]);
+                data[i] = value;
+                rangeMin = std::min(rangeMin, value);
+                rangeMax = std::max(rangeMax, value);
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            min = std::min(min, rangeMin);
+            max = std::max(max, rangeMax);
+        });
+
+        volume->dataMap_.dataRange = dvec2(min, max);
+    } else {
+        util::forEachRangeParallel(bytes, [&](size_t begin, size_t end) {
+            stream.copy(offset + begin, offset + end, dest + begin);
+        });
     }
 
-    if (comment) {
-        ss.clear();
-        ss.str("");
-        ss << comment;
-        volume->setMetaData<StringMetaData>("comment", ss.str());
+    // Additional information, stored as four null-terminated strings after the voxels
+    if (version == 3) {
+        size_t pos = offset + bytes;
+        for (auto key : {"description", "courtesy", "parameter", "comment"}) {
+            const auto str = stream.readString(pos);
+            if (!str.empty()) volume->setMetaData<StringMetaData>(key, str);
+        }
     }
 
-    if (spacing != vec3(0.0f)) {
-        basis[0][0] = dim.x * spacing.x;
-        basis[1][1] = dim.y * spacing.y;
-        basis[2][2] = dim.z * spacing.z;
-    }
+    glm::mat3 basis(1.0f);
+    basis[0][0] = dim.x * spacing.x;
+    basis[1][1] = dim.y * spacing.y;
+    basis[2][2] = dim.z * spacing.z;
 
     volume->setBasis(basis);
     volume->setOffset(-0.5f * (basis[0] + basis[1] + basis[2]));
     volume->setDimensions(dim);
 
-    volume->dataMap_.initWithFormat(format);
-
     volume->setDataFormat(format);
-
-    // Create RAM volume s all data has already is in memory
-    auto volRAM = createVolumeRAM(dim, format, data);
     volume->addRepresentation(volRAM);
 
     return volume;
@@ -0,0 +1,134 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/filesystem.h>
+#include <modules/pvm/pvmvolumereader.h>
+
+#include <tidds/ddsbase.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+
+namespace {
+
+/**
+ * Write a smooth 16 bit PVM volume of size^3 voxels, similar to scanned data in how well it
+ * compresses, and return the file name.
+ */
+std::string writeVolume(size_t size) {
+    const auto fileName = "pvm-benchmark-" + toString(size) + ".pvm";
+    if (filesystem::fileExists(fileName)) return fileName;
+
+    std::vector<unsigned char> data(size * size * size * 2);
+    for (size_t z = 0; z < size; ++z) {
+        for (size_t y = 0; y < size; ++y) {
+            for (size_t x = 0; x < size; ++x) {
+                const auto i = (z * size + y) * size + x;
+                const auto v = static_cast<unsigned int>(
+                    32767.0 * (1.0 + std::sin(0.05 * x) * std::cos(0.07 * y) * std::sin(0.03 * z)));
+                data[2 * i] = static_cast<unsigned char>(v >> 8);
+                data[2 * i + 1] = static_cast<unsigned char>(v & 0xff);
+            }
+        }
+    }
+    const auto s = static_cast<unsigned int>(size);
+    writePVMvolume(fileName.c_str(), data.data(), s, s, s, 2, 1.0f, 1.0f, 1.0f, nullptr, nullptr,
+                   nullptr, nullptr);
+    return fileName;
+}
+
+}  // namespace
+
+// The previous reader, tidds followed by a separate byte swap and data range pass
+static void ReadOld(benchmark::State& state) {
+    const auto fileName = writeVolume(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        unsigned int dim[3];
+        unsigned int components;
+        float spacing[3];
+        auto data = readPVMvolume(fileName.c_str(), &dim[0], &dim[1], &dim[2], &components,
+                                  &spacing[0], &spacing[1], &spacing[2], nullptr, nullptr,
+                                  nullptr, nullptr);
+        const auto bytes = dim[0] * dim[1] * dim[2] * components;
+        swapbytes(data, bytes);
+        auto minmax = std::minmax_element(reinterpret_cast<DataUInt16::type*>(data),
+                                          reinterpret_cast<DataUInt16::type*>(data + bytes));
+        benchmark::DoNotOptimize(minmax);
+        free(data);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * state.range(0) *
+                            state.range(0) * 2);
+}
+
+static void ReadNew(benchmark::State& state) {
+    const auto fileName = writeVolume(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        auto volume = PVMVolumeReader::readPVMData(fileName);
+        benchmark::DoNotOptimize(volume);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * state.range(0) *
+                            state.range(0) * 2);
+}
+
+BENCHMARK(ReadOld)->RangeMultiplier(2)->Range(64, 512)->Unit(benchmark::kMillisecond);
+BENCHMARK(ReadNew)->RangeMultiplier(2)->Range(64, 512)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+    // Needed for the thread pool used by the reader
+    InviwoApplication app("Inviwo-Benchmarks-PVM");
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+
+    for (size_t size = 64; size <= 512; size *= 2) {
+        std::remove(("pvm-benchmark-" + toString(size) + ".pvm").c_str());
+    }
+
+    return 0;
+}
+
+#include <warn/pop>
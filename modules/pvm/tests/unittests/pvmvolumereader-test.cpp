@@ -0,0 +1,243 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/pvm/ddsstream.h>
+#include <modules/pvm/pvmvolumereader.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/metadata/metadata.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include <tidds/ddsbase.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+// Removes the file when going out of scope
+struct TempFile {
+    TempFile(const std::string& name)
+        : path{filesystem::getWorkingDirectory() + "/pvm-unittest-" + name} {}
+    ~TempFile() { std::remove(path.c_str()); }
+    std::string path;
+};
+
+// Smooth data with some noise, to get a mix of bit widths in the encoding
+std::vector<unsigned char> makeData(size_t size, size_t stride, unsigned int seed) {
+    std::mt19937 gen(seed);
+    std::vector<unsigned char> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<unsigned char>((i % stride) * 3 + (i / stride) % 7 + gen() % 5);
+    }
+    return data;
+}
+
+// The result of the tidds reader, freed when going out of scope
+struct TiddsVolume {
+    TiddsVolume(const std::string& path) {
+        data = readPVMvolume(path.c_str(), &dim.x, &dim.y, &dim.z, &components, &scale.x,
+                             &scale.y, &scale.z, &description, &courtesy, &parameter, &comment);
+    }
+    ~TiddsVolume() { free(data); }
+
+    unsigned char* data = nullptr;
+    glm::uvec3 dim{0};
+    unsigned int components = 0;
+    vec3 scale{0.0f};
+    unsigned char* description = nullptr;
+    unsigned char* courtesy = nullptr;
+    unsigned char* parameter = nullptr;
+    unsigned char* comment = nullptr;
+};
+
+void testDDSStream(size_t size, unsigned int skip, unsigned int strip) {
+    SCOPED_TRACE("size: " + toString(size) + " skip: " + toString(skip));
+    TempFile file("stream.dds");
+    auto data = makeData(size, strip, skip);
+    // nofree, the data is interleaved in place and restored afterwards
+    writeDDSfile(file.path.c_str(), data.data(), data.size(), skip, strip, 1);
+
+    size_t bytes = 0;
+    auto expected = readDDSfile(file.path.c_str(), &bytes);
+    ASSERT_NE(nullptr, expected);
+    const DDSStream stream(file.path);
+    ASSERT_EQ(bytes, stream.size());
+    ASSERT_EQ(data.size(), stream.size());
+
+    std::vector<unsigned char> result(stream.size());
+    stream.copy(0, stream.size(), result.data());
+    EXPECT_TRUE(std::equal(result.begin(), result.end(), expected));
+
+    std::mt19937 gen(42);
+    for (int i = 0; i < 20; ++i) {
+        auto begin = gen() % stream.size();
+        auto end = gen() % stream.size();
+        if (begin > end) std::swap(begin, end);
+        std::vector<unsigned char> range(end - begin);
+        stream.copy(begin, end, range.data());
+        EXPECT_TRUE(std::equal(range.begin(), range.end(), expected + begin))
+            << "range [" << begin << ", " << end << ")";
+        EXPECT_EQ(expected[begin], stream[begin]) << "index " << begin;
+    }
+    free(expected);
+}
+
+void testReader(unsigned int version, unsigned int components, size3_t dim) {
+    SCOPED_TRACE("version: " + toString(version) + " components: " + toString(components));
+    TempFile file("volume.pvm");
+
+    auto data = makeData(glm::compMul(dim) * components, dim.x * components, components);
+    // writePVMvolume picks the version from the meta data and scale
+    const vec3 scale = version == 1 ? vec3{1.0f} : vec3{0.5f, 1.0f, 2.0f};
+    const auto meta = [&](const char* str) {
+        return version == 3 ? reinterpret_cast<const unsigned char*>(str) : nullptr;
+    };
+    writePVMvolume(file.path.c_str(), data.data(), static_cast<unsigned int>(dim.x),
+                   static_cast<unsigned int>(dim.y), static_cast<unsigned int>(dim.z),
+                   components, scale.x, scale.y, scale.z, meta("description"), nullptr,
+                   meta("parameter"), meta("comment"));
+
+    const TiddsVolume expected(file.path);
+    ASSERT_NE(nullptr, expected.data);
+    const auto volume = PVMVolumeReader::readPVMData(file.path);
+
+    ASSERT_EQ(size3_t(expected.dim), volume->getDimensions());
+    EXPECT_EQ(dim, volume->getDimensions());
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_FLOAT_EQ(dim[i] * expected.scale[i], volume->getBasis()[i][i]);
+    }
+
+    const auto ram = volume->getRepresentation<VolumeRAM>();
+    const size_t size = glm::compMul(dim);
+    switch (components) {
+        case 1: {
+            EXPECT_EQ(DataUInt8::get(), volume->getDataFormat());
+            const auto values = static_cast<const unsigned char*>(ram->getData());
+            EXPECT_TRUE(std::equal(values, values + size, expected.data));
+            break;
+        }
+        case 2: {
+            EXPECT_EQ(DataUInt16::get(), volume->getDataFormat());
+            // PVM stores 16 bit values big endian
+            const auto values = static_cast<const DataUInt16::type*>(ram->getData());
+            DataUInt16::type min = std::numeric_limits<DataUInt16::type>::max();
+            DataUInt16::type max = 0;
+            bool equal = true;
+            for (size_t i = 0; i < size; ++i) {
+                const auto value = static_cast<DataUInt16::type>(
+                    (expected.data[2 * i] << 8) | expected.data[2 * i + 1]);
+                equal &= value == values[i];
+                min = std::min(min, value);
+                max = std::max(max, value);
+            }
+            EXPECT_TRUE(equal);
+            EXPECT_EQ(dvec2(min, max), volume->dataMap_.dataRange);
+            EXPECT_EQ(dvec2(0.0, DataUInt16::max()), volume->dataMap_.valueRange);
+            break;
+        }
+        case 3: {
+            EXPECT_EQ(DataVec3UInt8::get(), volume->getDataFormat());
+            const auto values = static_cast<const unsigned char*>(ram->getData());
+            EXPECT_TRUE(std::equal(values, values + 3 * size, expected.data));
+            break;
+        }
+    }
+
+    const auto checkMeta = [&](const std::string& key, const unsigned char* str) {
+        SCOPED_TRACE(key);
+        const auto metaData = volume->getMetaData<StringMetaData>(key);
+        if (str) {
+            ASSERT_NE(nullptr, metaData);
+            EXPECT_EQ(std::string(reinterpret_cast<const char*>(str)), metaData->get());
+        } else {
+            EXPECT_EQ(nullptr, metaData);
+        }
+    };
+    checkMeta("description", expected.description);
+    checkMeta("courtesy", expected.courtesy);
+    checkMeta("parameter", expected.parameter);
+    checkMeta("comment", expected.comment);
+    if (version == 3) {
+        EXPECT_NE(nullptr, expected.description);
+        EXPECT_EQ(nullptr, expected.courtesy);
+    }
+}
+
+}  // namespace
+
+TEST(DDSStream, matchesTidds) {
+    for (unsigned int skip = 1; skip <= 4; ++skip) {
+        testDDSStream(1, skip, 1);
+        testDDSStream(1000 + skip, skip, 17);
+        testDDSStream(12345, skip, 100);
+    }
+}
+
+TEST(DDSStream, matchesTiddsChunked) {
+    // Streams larger than 16 MiB are written as "DDS v3e", interleaved in chunks
+    testDDSStream((size_t{1} << 24) * 2 + 777, 2, 256);
+    testDDSStream((size_t{1} << 24) * 3 + 12345, 3, 300);
+}
+
+TEST(DDSStream, invalidFile) {
+    TempFile file("invalid.dds");
+    {
+        auto f = filesystem::ofstream(file.path, std::ios_base::out | std::ios_base::binary);
+        f << "Not a DDS file";
+    }
+    EXPECT_THROW(DDSStream{file.path}, DataReaderException);
+}
+
+TEST(PVMVolumeReader, matchesTidds) {
+    for (unsigned int version = 1; version <= 3; ++version) {
+        for (unsigned int components = 1; components <= 3; ++components) {
+            testReader(version, components, size3_t{37, 23, 11});
+        }
+    }
+}
+
+TEST(PVMVolumeReader, matchesTiddsChunked) {
+    // More than 16 MiB of voxels, read from a "DDS v3e" stream
+    testReader(3, 2, size3_t{208, 208, 208});
+}
+
+}  // namespace inviwo
@@ -83,6 +83,7 @@ private:
 
     bool stopHistCalculation_ = false;
     std::future<void> histCalculation_;
+    HistogramContainer histogramEstimate_;  //!< shown while the histograms are calculated
 
     dvec2 maskHorizontal_;
 
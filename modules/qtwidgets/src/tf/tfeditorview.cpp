@@ -75,6 +75,7 @@ TFEditorView::TFEditorView(util::TFPropertyConcept* tfProperty, QGraphicsScene*
 
         callbackOnInvalid = volumeInport_->onInvalid([this]() {
             stopHistCalculation_ = true;
+            histogramEstimate_ = HistogramContainer{};
             resetCachedContent();
             update();
         });
@@ -82,6 +83,7 @@ TFEditorView::TFEditorView(util::TFPropertyConcept* tfProperty, QGraphicsScene*
         callbackOnConnect = volumeInport_->onConnect(portChange);
         callbackOnDisconnect = volumeInport_->onDisconnect([this]() {
             stopHistCalculation_ = true;
+            histogramEstimate_ = HistogramContainer{};
             histograms_.clear();
             resetCachedContent();
             update();
@@ -290,21 +292,44 @@ const HistogramContainer* TFEditorView::getNormalizedHistograms() {
 
                 const auto done = [this]() {
                     histCalculation_.get();
+                    histogramEstimate_ = HistogramContainer{};
                     updateHistogram();
                     resetCachedContent();
                     update();
                 };
 
+                // Show the estimates of the progressive calculation until the final result is
+                // available. Estimates of a volume that has since been replaced are ignored.
+                const auto estimate = [this](std::shared_ptr<const Volume> volume,
+                                             const HistogramContainer& histograms) {
+                    auto hist = std::make_shared<HistogramContainer>(histograms);
+                    dispatchFront([this, volume, hist]() {
+                        if (stopHistCalculation_ || !volumeInport_->hasData() ||
+                            volumeInport_->getData() != volume) {
+                            return;
+                        }
+                        histogramEstimate_ = std::move(*hist);
+                        updateHistogram();
+                        resetCachedContent();
+                        update();
+                    });
+                };
+
                 const auto histcalc = [& stop = stopHistCalculation_,
-                                       volume = volumeInport_->getData(), done]() -> void {
+                                       volume = volumeInport_->getData(), done,
+                                       estimate]() -> void {
                     auto ram = volume->getRepresentation<VolumeRAM>();
-                    ram->calculateHistograms(2048, size3_t(1), stop);
+                    ram->calculateHistogramsProgressive(
+                        2048, stop, [&](const HistogramContainer& histograms) {
+                            estimate(volume, histograms);
+                        });
                     dispatchFront(done);
                     return;
                 };
                 stopHistCalculation_ = false;
                 histCalculation_ = dispatchPool(histcalc);
             }
+            if (!histogramEstimate_.empty()) return &histogramEstimate_;
         }
     }
 
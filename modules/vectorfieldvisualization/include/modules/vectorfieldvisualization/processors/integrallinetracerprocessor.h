@@ -41,6 +41,7 @@
 #include <inviwo/core/ports/imageport.h>
 #include <inviwo/core/util/utilities.h>
 #include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/resultcache.h>
 #include <modules/vectorfieldvisualization/algorithms/integrallineoperations.h>
 #include <modules/vectorfieldvisualization/integrallinetracer.h>
 #include <modules/vectorfieldvisualization/ports/seedpointsport.h>
@@ -69,6 +70,8 @@ private:
     CompositeProperty metaData_;
     BoolProperty calculateCurvature_;
     BoolProperty calculateTortuosity_;
+
+    ResultCache<IntegralLineSet> cache_;
 };
 
 template <typename Tracer>
@@ -81,7 +84,16 @@ IntegralLineTracerProcessor<Tracer>::IntegralLineTracerProcessor()
 
     , metaData_("metaData", "Meta Data")
     , calculateCurvature_("calculateCurvature", "Calculate Curvature", false)
-    , calculateTortuosity_("calculateTortuosity", "Calculate Tortuosity", false) {
+    , calculateTortuosity_("calculateTortuosity", "Calculate Tortuosity", false)
+    , cache_{ResultCache<IntegralLineSet>::defaultMemoryBudget, [](const IntegralLineSet& lines) {
+                 // positions and meta data are mostly dvec3, good enough as an estimate
+                 size_t bytes = 0;
+                 for (const auto& line : lines) {
+                     bytes += line.getPositions().size() * sizeof(dvec3) *
+                              (1 + line.getMetaDataKeys().size());
+                 }
+                 return bytes;
+             }} {
     addPort(sampler_);
     addPort(seeds_);
     addPort(annotationSamplers_);
@@ -104,6 +116,17 @@ IntegralLineTracerProcessor<Tracer>::~IntegralLineTracerProcessor() {}
 template <typename Tracer>
 void IntegralLineTracerProcessor<Tracer>::process() {
     auto sampler = sampler_.getData();
+
+    auto key = ResultCacheKey{}.addData(sampler).addData(seeds_.getVectorData());
+    for (auto meta : annotationSamplers_.getSourceVectorData()) {
+        key.addValue(meta.first->getProcessor()->getIdentifier()).addData(meta.second);
+    }
+    key.addProperties(*this);
+    if (auto cached = cache_.get(key)) {
+        lines_.setData(cached);
+        return;
+    }
+
     auto lines =
         std::make_shared<IntegralLineSet>(sampler->getModelMatrix(), sampler->getWorldMatrix());
 
@@ -136,6 +159,7 @@ void IntegralLineTracerProcessor<Tracer>::process() {
         util::tortuosity(*lines);
     }
 
+    cache_.put(std::move(key), lines);
     lines_.setData(lines);
 }
 
@@ -65,6 +65,7 @@
 #include <inviwo/core/util/consolelogger.h>
 #include <inviwo/core/util/filelogger.h>
 #include <inviwo/core/util/timer.h>
+#include <inviwo/core/util/tracing.h>
 #include <inviwo/core/util/settings/systemsettings.h>
 
 namespace inviwo {
@@ -140,6 +141,9 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string displayN
     , propertyPresetManager_{std::make_unique<PropertyPresetManager>(this)}
     , portInspectorManager_{std::make_unique<PortInspectorManager>(this)} {
 
+    Tracer::setThreadName("Main");
+    if (commandLineParser_.getTraceToFile()) Tracer::setEnabled(true);
+
     // Keep the pool at size 0 if are quiting directly to make sure that we don't have
     // unfinished results in the worker threads
     if (!commandLineParser_.getQuitApplicationAfterStartup()) {
@@ -206,7 +210,26 @@ InviwoApplication::InviwoApplication() : InviwoApplication(0, nullptr, "Inviwo")
 InviwoApplication::InviwoApplication(std::string displayName)
     : InviwoApplication(0, nullptr, displayName) {}
 
-InviwoApplication::~InviwoApplication() { resizePool(0); }
+InviwoApplication::~InviwoApplication() {
+    resizePool(0);
+
+    if (commandLineParser_.getTraceToFile()) {
+        auto filename = commandLineParser_.getTraceFileName();
+        if (!filesystem::isAbsolutePath(filename)) {
+            auto outputDir = commandLineParser_.getOutputPath();
+            if (outputDir.empty()) outputDir = filesystem::getWorkingDirectory();
+            filename = outputDir + "/" + filename;
+        }
+        try {
+            Tracer::writeChromeTrace(filename);
+        } catch (const Exception& e) {
+            LogError(e.getMessage());
+        }
+    }
+
+    // Make sure all messages have reached the console and file loggers before they go away
+    if (LogCentral::isInitialized()) LogCentral::getPtr()->flush();
+}
 
 void InviwoApplication::registerModules(
     std::vector<std::unique_ptr<InviwoModuleFactoryObject>> moduleFactories) {
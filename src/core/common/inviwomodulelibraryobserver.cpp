@@ -88,7 +88,8 @@ void InviwoModuleLibraryObserver::reloadModules() {
     // Serialize network
     std::stringstream stream;
     try {
-        app_->getWorkspaceManager()->save(stream, app_->getBasePath());
+        app_->getWorkspaceManager()->save(stream, app_->getBasePath(), StandardExceptionHandler(),
+                                          WorkspaceSaveMode::Disk, SerializationFormat::Binary);
     } catch (SerializationException& exception) {
         util::log(exception.getContext(), "Unable to save network due to " + exception.getMessage(),
                   LogLevel::Error);
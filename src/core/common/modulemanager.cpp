@@ -36,10 +36,15 @@
 #include <inviwo/core/util/vectoroperations.h>
 #include <inviwo/core/util/utilities.h>
 #include <inviwo/core/util/capabilities.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/tracing.h>
 #include <inviwo/core/network/processornetwork.h>
 
-#include <string>
+#include <algorithm>
+#include <chrono>
 #include <functional>
+#include <sstream>
+#include <string>
 
 namespace inviwo {
 
@@ -74,6 +79,9 @@ bool ModuleManager::isRuntimeModuleReloadingEnabled() {
 }
 
 void ModuleManager::registerModules(std::vector<std::unique_ptr<InviwoModuleFactoryObject>> mfo) {
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+
     factoryObjects_.insert(factoryObjects_.end(), std::make_move_iterator(mfo.begin()),
                            std::make_move_iterator(mfo.end()));
 
@@ -85,7 +93,10 @@ void ModuleManager::registerModules(std::vector<std::unique_ptr<InviwoModuleFact
         if (getModuleByIdentifier(obj->name)) continue;  // already loaded
         if (!checkDependencies(*obj)) continue;
         try {
+            IVW_TRACE_SCOPE("module", obj->name);
+            const auto constructionStart = Clock::now();
             registerModule(obj->create(app_));
+            getTiming(obj->name).construction = Clock::now() - constructionStart;
         } catch (const ModuleInitException& e) {
             auto dereg = deregisterDependetModules(e.getModulesToDeregister());
             auto err = (!dereg.empty() ? "\nUnregistered dependent modules: " +
@@ -98,15 +109,51 @@ void ModuleManager::registerModules(std::vector<std::unique_ptr<InviwoModuleFact
 
     app_->postProgress("Loading Capabilities");
     for (auto& module : modules_) {
+        if (module->getCapabilities().empty()) continue;
+        const std::string identifier = module->getIdentifier();
+        IVW_TRACE_SCOPE("module", identifier);
+        const auto capabilitiesStart = Clock::now();
         for (auto& elem : module->getCapabilities()) {
             elem->retrieveStaticInfo();
             elem->printInfo();
         }
+        getTiming(identifier).capabilities = Clock::now() - capabilitiesStart;
     }
 
+    logTimings(Clock::now() - start);
+
     onModulesDidRegister_.invoke();
 }
 
+const std::vector<ModuleManager::ModuleTiming>& ModuleManager::getModuleTimings() const {
+    return timings_;
+}
+
+auto ModuleManager::getTiming(const std::string& module) -> ModuleTiming& {
+    auto it = util::find_if(timings_, [&](const auto& t) { return iCaseCmp(t.name, module); });
+    if (it != timings_.end()) return *it;
+    timings_.push_back(ModuleTiming{module});
+    return timings_.back();
+}
+
+void ModuleManager::logTimings(std::chrono::nanoseconds total) const {
+    auto sorted = timings_;
+    std::sort(sorted.begin(), sorted.end(),
+              [](const auto& a, const auto& b) { return a.total() > b.total(); });
+    sorted.resize(std::min(sorted.size(), size_t{5}));
+
+    std::stringstream ss;
+    ss << "Registered " << modules_.size() << " modules in " << durationToString(total)
+       << ". Slowest:";
+    for (const auto& t : sorted) {
+        ss << "\n  " << t.name << ": " << durationToString(t.total())
+           << " (load " << durationToString(t.load)
+           << ", construction " << durationToString(t.construction)
+           << ", capabilities " << durationToString(t.capabilities) << ")";
+    }
+    LogInfo(ss.str());
+}
+
 std::function<bool(const std::string&)> ModuleManager::getEnabledFilter() {
     // Load enabled modules if file "application_name-enabled-modules.txt" exists,
     // otherwise load all modules
@@ -202,33 +249,52 @@ void ModuleManager::registerModules(RuntimeModuleLoading) {
     auto isLoaded = [loaded = util::getLoadedLibraries()](const auto& path) {
         return util::contains_if(loaded, [&](const auto& lib) { return iCaseCmp(path, lib); });
     };
-    std::vector<std::unique_ptr<InviwoModuleFactoryObject>> modules;
-    for (const auto& filePath : libraryFiles) {
-        const auto tmpPath = [&]() -> std::string {
-            if (isRuntimeModuleReloadingEnabled() && util::hasAddLibrarySearchDirsFunction()) {
-                auto dstPath = tmpDir + "/" + filesystem::getFileNameWithExtension(filePath);
-                if (isLoaded(filePath)) {
-                    // Already loaded modules are loaded from the application dir
-                    dstPath = filePath;
-                    protected_.insert(util::stripModuleFileNameDecoration(filePath));
-                } else if (filesystem::fileModificationTime(filePath) !=
-                           filesystem::fileModificationTime(dstPath)) {
-                    // Load a copy of the file to make sure that we can overwrite the file.
-                    filesystem::copyFile(filePath, dstPath);
-                }
-                return dstPath;
+    const std::vector<std::string> files(libraryFiles.begin(), libraryFiles.end());
+    std::vector<std::string> loadPaths(files);
+    if (isRuntimeModuleReloadingEnabled() && util::hasAddLibrarySearchDirsFunction()) {
+        std::vector<char> loaded(files.size(), 0);
+        for (size_t i = 0; i < files.size(); ++i) {
+            if (isLoaded(files[i])) {
+                // Already loaded modules are loaded from the application dir
+                loaded[i] = 1;
+                protected_.insert(util::stripModuleFileNameDecoration(files[i]));
             } else {
-                return filePath;
+                loadPaths[i] = tmpDir + "/" + filesystem::getFileNameWithExtension(files[i]);
             }
-        }();
+        }
+        // Load a copy of the file to make sure that we can overwrite the file. Copying all the
+        // libraries is a large part of the startup time, so do it in parallel.
+        IVW_TRACE_SCOPE("module", "Copy libraries");
+        util::forEachRangeParallel(
+            files.size(),
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    if (loaded[i]) continue;
+                    if (filesystem::fileModificationTime(files[i]) !=
+                        filesystem::fileModificationTime(loadPaths[i])) {
+                        filesystem::copyFile(files[i], loadPaths[i]);
+                    }
+                }
+            },
+            files.size());
+    }
+
+    std::vector<std::unique_ptr<InviwoModuleFactoryObject>> modules;
+    for (size_t i = 0; i < files.size(); ++i) {
+        const auto& filePath = files[i];
+        const auto& tmpPath = loadPaths[i];
 
         try {
+            IVW_TRACE_SCOPE("module", filePath);
+            const auto loadStart = std::chrono::steady_clock::now();
             // Load library. Will throw exception if failed to load
             auto sharedLib = util::make_unique<SharedLibrary>(tmpPath);
             // Only consider libraries with Inviwo module creation function
             if (auto moduleFunc = sharedLib->findSymbolTyped<f_getModule>("createModule")) {
                 // Add module factory object
                 modules.emplace_back(moduleFunc());
+                getTiming(modules.back()->name).load =
+                    std::chrono::steady_clock::now() - loadStart;
                 auto moduleName = toLower(modules.back()->name);
                 if (modules.back()->protectedModule == ProtectedModule::on) {
                     protected_.insert(modules.back()->name);
@@ -76,6 +76,21 @@ Mesh& Mesh::operator=(const Mesh& that) {
 
 Mesh* Mesh::clone() const { return new Mesh(*this); }
 
+std::shared_ptr<void> Mesh::getDerivedData(std::type_index key) const {
+    std::lock_guard<std::mutex> lock(derivedMutex_);
+    auto it = derived_.find(key);
+    return it != derived_.end() ? it->second : nullptr;
+}
+
+void Mesh::setDerivedData(std::type_index key, std::shared_ptr<void> data) const {
+    std::lock_guard<std::mutex> lock(derivedMutex_);
+    if (data) {
+        derived_[key] = std::move(data);
+    } else {
+        derived_.erase(key);
+    }
+}
+
 const Mesh::BufferVector& Mesh::getBuffers() const { return buffers_; }
 
 const Mesh::IndexVector& Mesh::getIndexBuffers() const { return indices_; }
@@ -28,9 +28,12 @@
  *********************************************************************************/
 
 #include <inviwo/core/datastructures/histogram.h>
+#include <inviwo/core/util/quantilesketch.h>
+
 #include <algorithm>
 #include <numeric>
 #include <functional>
+#include <utility>
 
 namespace inviwo {
 
@@ -39,6 +42,8 @@ NormalizedHistogram::NormalizedHistogram(size_t numberOfBins)
 
 NormalizedHistogram::NormalizedHistogram(const NormalizedHistogram& rhs)
     : stats_(rhs.stats_)
+    , histStats_(rhs.histStats_)
+    , dataRange_(rhs.dataRange_)
     , data_(rhs.data_)
     , maximumBinCount_(rhs.maximumBinCount_)
     , valid_(rhs.valid_) {}
@@ -46,6 +51,8 @@ NormalizedHistogram::NormalizedHistogram(const NormalizedHistogram& rhs)
 NormalizedHistogram& NormalizedHistogram::operator=(const NormalizedHistogram& that) {
     if (this != &that) {
         stats_ = that.stats_;
+        histStats_ = that.histStats_;
+        dataRange_ = that.dataRange_;
         data_.resize(that.data_.size());
         std::copy(that.data_.begin(), that.data_.end(), data_.begin());
         maximumBinCount_ = that.getMaximumBinValue();
@@ -106,28 +113,34 @@ void NormalizedHistogram::calculatePercentiles() {
     }
 }
 
+void NormalizedHistogram::calculatePercentiles(const util::QuantileSketch& sketch) {
+    stats_.percentiles.resize(101);
+    for (size_t i = 0; i < stats_.percentiles.size(); ++i) {
+        stats_.percentiles[i] = sketch.quantile(static_cast<double>(i) / 100.0);
+    }
+}
+
 void NormalizedHistogram::calculateHistStats() {
-    std::vector<double> temp = std::vector<double>(data_.size(), 0.0);
-    std::copy(data_.begin(), data_.end(), temp.begin());
-    std::sort(temp.begin(), temp.end());
+    const auto minmax = std::minmax_element(data_.begin(), data_.end());
     double sum = std::accumulate(data_.begin(), data_.end(), 0.0);
     double sum2 = std::accumulate(data_.begin(), data_.end(), 0.0,
                                   [](double a, double b) { return a + b * b; });
 
-    histStats_.min = *temp.begin();
-    histStats_.max = *(temp.end() - 1);
+    histStats_.min = *minmax.first;
+    histStats_.max = *minmax.second;
     histStats_.mean = sum / static_cast<double>(data_.size());
     histStats_.standardDeviation =
         std::sqrt((data_.size() * sum2 - sum * sum) / (data_.size() * (data_.size() - 1)));
 
-    histStats_.percentiles.resize(101, 0.0);
-    for (size_t i = 1; i < histStats_.percentiles.size(); ++i) {
-        histStats_.percentiles[i] = temp.at(
-            static_cast<size_t>(std::ceil(static_cast<double>(i) /
-                                          static_cast<double>(histStats_.percentiles.size() - 1) *
-                                          static_cast<double>(data_.size()))) -
-            1);
+    std::vector<double> percentiles(100);
+    for (size_t i = 0; i < percentiles.size(); ++i) {
+        percentiles[i] = static_cast<double>(i + 1) / 100.0;
     }
+    std::vector<double> temp(data_);
+    const auto values = util::nearestRankPercentiles(temp.begin(), temp.end(), percentiles);
+
+    histStats_.percentiles.resize(101, 0.0);
+    std::copy(values.begin(), values.end(), histStats_.percentiles.begin() + 1);
 }
 
 HistogramContainer::HistogramContainer() {}
@@ -141,10 +154,8 @@ HistogramContainer::HistogramContainer(HistogramContainer&& rhs) : histograms_(r
 }
 
 HistogramContainer& HistogramContainer::operator=(HistogramContainer&& that) {
-    if (this != &that) {
-        histograms_ = that.histograms_;
-        that.histograms_.clear();
-    }
+    // The old histograms are deleted together with that
+    std::swap(histograms_, that.histograms_);
     return *this;
 }
 
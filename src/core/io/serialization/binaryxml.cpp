@@ -0,0 +1,393 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/io/serialization/binaryxml.h>
+#include <inviwo/core/io/serialization/serializationexception.h>
+#include <inviwo/core/io/serialization/ticpp.h>
+
+#include <algorithm>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+constexpr char magic[4] = {'I', 'V', 'W', 'B'};
+
+enum class RecordType : unsigned char { Element = 1, Text = 2, Comment = 3, Declaration = 4 };
+
+bool isSupported(const TiXmlNode& node) {
+    switch (node.Type()) {
+        case TiXmlNode::ELEMENT:
+        case TiXmlNode::TEXT:
+        case TiXmlNode::COMMENT:
+        case TiXmlNode::DECLARATION:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// ticpp does not give access to the wrapped TinyXML document, but visitors get it
+struct DocumentAccess : TiXmlVisitor {
+    virtual bool VisitEnter(const TiXmlDocument& doc) override {
+        document = &doc;
+        return false;
+    }
+    const TiXmlDocument* document = nullptr;
+};
+
+const TiXmlDocument& getDocument(const TxDocument& doc) {
+    DocumentAccess access;
+    doc.Accept(&access);
+    return *access.document;
+}
+
+size_t varintSize(size_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+class BinaryXmlWriter {
+public:
+    BinaryXmlWriter(std::ostream& stream) : stream_(stream) {}
+
+    void write(const TiXmlNode& document) {
+        // Collect all strings in document order, then compute the record sizes bottom up since
+        // they depend on the string indices.
+        for (auto child = document.FirstChild(); child; child = child->NextSibling()) {
+            collect(*child);
+        }
+        const auto count = childCount(document);
+        for (auto child = document.FirstChild(); child; child = child->NextSibling()) {
+            if (isSupported(*child)) size(*child);
+        }
+
+        stream_.write(magic, sizeof(magic));
+        writeVarint(binaryXmlVersion);
+        writeVarint(strings_.size());
+        for (auto str : strings_) {
+            writeVarint(str->size());
+            stream_.write(str->data(), str->size());
+        }
+        writeVarint(count);
+        for (auto child = document.FirstChild(); child; child = child->NextSibling()) {
+            if (isSupported(*child)) writeRecord(*child);
+        }
+        if (!stream_) {
+            throw SerializationException("Unable to write binary xml",
+                                         IVW_CONTEXT_CUSTOM("BinaryXml"));
+        }
+    }
+
+private:
+    void intern(const std::string& str) {
+        if (index_.emplace(str, strings_.size()).second) {
+            strings_.push_back(&index_.find(str)->first);
+        }
+    }
+
+    void collect(const TiXmlNode& node) {
+        switch (node.Type()) {
+            case TiXmlNode::ELEMENT: {
+                const auto& element = *node.ToElement();
+                intern(element.ValueStr());
+                for (auto attr = element.FirstAttribute(); attr; attr = attr->Next()) {
+                    intern(attr->NameTStr());
+                    intern(attr->ValueStr());
+                }
+                for (auto child = node.FirstChild(); child; child = child->NextSibling()) {
+                    collect(*child);
+                }
+                break;
+            }
+            case TiXmlNode::TEXT:
+            case TiXmlNode::COMMENT:
+                intern(node.ValueStr());
+                break;
+            case TiXmlNode::DECLARATION: {
+                const auto& decl = *node.ToDeclaration();
+                intern(decl.Version());
+                intern(decl.Encoding());
+                intern(decl.Standalone());
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    size_t ref(const std::string& str) const { return index_.find(str)->second; }
+
+    static size_t childCount(const TiXmlNode& node) {
+        size_t count = 0;
+        for (auto child = node.FirstChild(); child; child = child->NextSibling()) {
+            if (isSupported(*child)) ++count;
+        }
+        return count;
+    }
+
+    // Size of the record body of node, memoized for writing.
+    size_t size(const TiXmlNode& node) {
+        size_t size = 0;
+        switch (node.Type()) {
+            case TiXmlNode::ELEMENT: {
+                const auto& element = *node.ToElement();
+                size += varintSize(ref(element.ValueStr()));
+                size_t attrCount = 0;
+                for (auto attr = element.FirstAttribute(); attr; attr = attr->Next()) {
+                    size += varintSize(ref(attr->NameTStr())) + varintSize(ref(attr->ValueStr()));
+                    ++attrCount;
+                }
+                size += varintSize(attrCount);
+                size += varintSize(childCount(node));
+                for (auto child = node.FirstChild(); child; child = child->NextSibling()) {
+                    if (!isSupported(*child)) continue;
+                    const auto childSize = this->size(*child);
+                    size += 1 + varintSize(childSize) + childSize;
+                }
+                break;
+            }
+            case TiXmlNode::TEXT:
+                size = 1 + varintSize(ref(node.ValueStr()));
+                break;
+            case TiXmlNode::COMMENT:
+                size = varintSize(ref(node.ValueStr()));
+                break;
+            case TiXmlNode::DECLARATION: {
+                const auto& decl = *node.ToDeclaration();
+                size = varintSize(ref(decl.Version())) + varintSize(ref(decl.Encoding())) +
+                       varintSize(ref(decl.Standalone()));
+                break;
+            }
+            default:
+                break;
+        }
+        sizes_[&node] = size;
+        return size;
+    }
+
+    void writeRecord(const TiXmlNode& node) {
+        switch (node.Type()) {
+            case TiXmlNode::ELEMENT: {
+                writeHeader(RecordType::Element, node);
+                const auto& element = *node.ToElement();
+                writeVarint(ref(element.ValueStr()));
+                size_t attrCount = 0;
+                for (auto attr = element.FirstAttribute(); attr; attr = attr->Next()) ++attrCount;
+                writeVarint(attrCount);
+                for (auto attr = element.FirstAttribute(); attr; attr = attr->Next()) {
+                    writeVarint(ref(attr->NameTStr()));
+                    writeVarint(ref(attr->ValueStr()));
+                }
+                writeVarint(childCount(node));
+                for (auto child = node.FirstChild(); child; child = child->NextSibling()) {
+                    if (isSupported(*child)) writeRecord(*child);
+                }
+                break;
+            }
+            case TiXmlNode::TEXT:
+                writeHeader(RecordType::Text, node);
+                stream_.put(static_cast<char>(node.ToText()->CDATA() ? 1 : 0));
+                writeVarint(ref(node.ValueStr()));
+                break;
+            case TiXmlNode::COMMENT:
+                writeHeader(RecordType::Comment, node);
+                writeVarint(ref(node.ValueStr()));
+                break;
+            case TiXmlNode::DECLARATION: {
+                writeHeader(RecordType::Declaration, node);
+                const auto& decl = *node.ToDeclaration();
+                writeVarint(ref(decl.Version()));
+                writeVarint(ref(decl.Encoding()));
+                writeVarint(ref(decl.Standalone()));
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    void writeHeader(RecordType type, const TiXmlNode& node) {
+        stream_.put(static_cast<char>(type));
+        writeVarint(sizes_[&node]);
+    }
+
+    void writeVarint(size_t value) {
+        char buffer[10];
+        size_t n = 0;
+        while (value >= 0x80) {
+            buffer[n++] = static_cast<char>((value & 0x7f) | 0x80);
+            value >>= 7;
+        }
+        buffer[n++] = static_cast<char>(value);
+        stream_.write(buffer, n);
+    }
+
+    std::ostream& stream_;
+    std::unordered_map<std::string, size_t> index_;
+    std::vector<const std::string*> strings_;
+    std::unordered_map<const TiXmlNode*, size_t> sizes_;
+};
+
+class BinaryXmlReader {
+public:
+    BinaryXmlReader(std::istream& stream)
+        : data_{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()}
+        , pos_{data_.data()}
+        , end_{data_.data() + data_.size()} {}
+
+    void read(TiXmlNode& document) {
+        if (!std::equal(std::begin(magic), std::end(magic), take(sizeof(magic)))) {
+            error("Not binary xml data");
+        }
+        const auto version = readVarint();
+        if (version > binaryXmlVersion) {
+            error("Unsupported binary xml version " + std::to_string(version) +
+                  ", the latest supported version is " + std::to_string(binaryXmlVersion));
+        }
+        const auto stringCount = readVarint();
+        strings_.reserve(std::min(stringCount, static_cast<size_t>(end_ - pos_)));
+        for (size_t i = 0; i < stringCount; ++i) {
+            const auto length = readVarint();
+            const auto str = take(length);
+            strings_.emplace_back(str, length);
+        }
+        readChildren(document, readVarint());
+    }
+
+private:
+    void readChildren(TiXmlNode& parent, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            const auto type = static_cast<RecordType>(*take(1));
+            const auto size = readVarint();
+            if (static_cast<size_t>(end_ - pos_) < size) error("Unexpected end of binary xml data");
+            const auto recordEnd = pos_ + size;
+
+            switch (type) {
+                case RecordType::Element: {
+                    auto element = new TiXmlElement(readString());
+                    parent.LinkEndChild(element);
+                    const auto attrCount = readVarint();
+                    for (size_t a = 0; a < attrCount; ++a) {
+                        const auto& name = readString();
+                        element->SetAttribute(name, readString());
+                    }
+                    readChildren(*element, readVarint());
+                    break;
+                }
+                case RecordType::Text: {
+                    const bool cdata = *take(1) != 0;
+                    auto text = new TiXmlText(readString());
+                    text->SetCDATA(cdata);
+                    parent.LinkEndChild(text);
+                    break;
+                }
+                case RecordType::Comment:
+                    parent.LinkEndChild(new TiXmlComment(readString().c_str()));
+                    break;
+                case RecordType::Declaration: {
+                    const auto& version = readString();
+                    const auto& encoding = readString();
+                    parent.LinkEndChild(new TiXmlDeclaration(version, encoding, readString()));
+                    break;
+                }
+                default:  // Unknown record from a newer version, skip it
+                    pos_ = recordEnd;
+                    break;
+            }
+            if (pos_ != recordEnd) error("Corrupt binary xml record");
+        }
+    }
+
+    const char* take(size_t size) {
+        if (static_cast<size_t>(end_ - pos_) < size) error("Unexpected end of binary xml data");
+        const auto begin = pos_;
+        pos_ += size;
+        return begin;
+    }
+
+    size_t readVarint() {
+        size_t value = 0;
+        for (size_t shift = 0; shift < sizeof(size_t) * 8; shift += 7) {
+            const auto byte = static_cast<unsigned char>(*take(1));
+            value |= static_cast<size_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) return value;
+        }
+        error("Invalid binary xml integer");
+        return value;
+    }
+
+    const std::string& readString() {
+        const auto index = readVarint();
+        if (index >= strings_.size()) error("Invalid binary xml string index");
+        return strings_[index];
+    }
+
+    [[noreturn]] void error(const std::string& message) const {
+        throw SerializationException(message, IVW_CONTEXT_CUSTOM("BinaryXml"));
+    }
+
+    std::string data_;
+    const char* pos_;
+    const char* end_;
+    std::vector<std::string> strings_;
+};
+
+}  // namespace
+
+void writeBinaryXml(const TxDocument& document, std::ostream& stream) {
+    BinaryXmlWriter{stream}.write(getDocument(document));
+}
+
+void readBinaryXml(std::istream& stream, TxDocument& document) {
+    // The document is only accessed as const through the visitor, but is not const itself
+    BinaryXmlReader{stream}.read(const_cast<TiXmlDocument&>(getDocument(document)));
+}
+
+bool isBinaryXml(std::istream& stream) {
+    // A xml document starts with '<', white space or a byte order mark, never with the first
+    // character of the magic number, so one character is enough to tell them apart.
+    return stream.peek() == magic[0];
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -29,6 +29,7 @@
 
 #include <inviwo/core/io/serialization/serializebase.h>
 #include <inviwo/core/io/serialization/serializable.h>
+#include <inviwo/core/io/serialization/binaryxml.h>
 #include <inviwo/core/common/inviwo.h>
 
 namespace inviwo {
@@ -121,7 +122,11 @@ SerializeBase::SerializeBase(std::string fileName, bool allowReference)
 
 SerializeBase::SerializeBase(std::istream& stream, const std::string& path, bool allowReference)
     : fileName_(path), allowRef_(allowReference), retrieveChild_(true) {
-    stream >> doc_;
+    if (util::isBinaryXml(stream)) {
+        util::readBinaryXml(stream, doc_);
+    } else {
+        stream >> doc_;
+    }
 }
 
 const std::string& SerializeBase::getFileName() const { return fileName_; }
@@ -29,6 +29,7 @@
 
 #include <inviwo/core/io/serialization/serializable.h>
 #include <inviwo/core/io/serialization/serializer.h>
+#include <inviwo/core/io/serialization/binaryxml.h>
 #include <inviwo/core/util/exception.h>
 
 namespace inviwo {
@@ -96,4 +97,17 @@ void Serializer::writeFile(std::ostream& stream, bool format) {
     }
 }
 
+void Serializer::writeFile(std::ostream& stream, SerializationFormat format) {
+    switch (format) {
+        case SerializationFormat::Binary:
+            refDataContainer_.setReferenceAttributes();
+            util::writeBinaryXml(doc_, stream);
+            break;
+        case SerializationFormat::Xml:
+        default:
+            writeFile(stream, true);
+            break;
+    }
+}
+
 }  // namespace inviwo
@@ -37,9 +37,27 @@
 #include <inviwo/core/network/processornetwork.h>
 #include <inviwo/core/network/networklock.h>
 #include <inviwo/core/properties/compositeproperty.h>
+#include <inviwo/core/util/stringconversion.h>
+#include <inviwo/core/util/tracing.h>
+
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
 
 namespace inviwo {
 
+namespace {
+
+bool isOwnedBy(Property* property, Property* owner) {
+    for (auto p = dynamic_cast<Property*>(property->getOwner()); p;
+         p = dynamic_cast<Property*>(p->getOwner())) {
+        if (p == owner) return true;
+    }
+    return false;
+}
+
+}  // namespace
+
 LinkEvaluator::LinkEvaluator(ProcessorNetwork* network) : network_(network) {}
 
 void LinkEvaluator::addLink(const PropertyLink& propertyLink) {
@@ -59,7 +77,7 @@ void LinkEvaluator::addLink(const PropertyLink& propertyLink) {
         propertyLinkPrimaryCache_.erase(src);
     }
 
-    propertyLinkSecondaryCache_.clear();
+    invalidateSecondaryCache(src);
 }
 
 bool LinkEvaluator::canLink(const Property* src, const Property* dst) const {
@@ -91,9 +109,12 @@ void LinkEvaluator::removeLink(const PropertyLink& propertyLink) {
 
     if (cachelist.empty()) {
         propertyLinkPrimaryCache_.erase(src);
+        // Without outgoing links a pending source has nothing left to propagate, and the
+        // property might be about to be deleted.
+        util::erase_remove(pending_, src);
     }
 
-    propertyLinkSecondaryCache_.clear();
+    invalidateSecondaryCache(src);
 }
 
 std::vector<PropertyLink> LinkEvaluator::getLinksBetweenProcessors(Processor* p1, Processor* p2) {
@@ -129,6 +150,17 @@ std::vector<LinkEvaluator::Link>& LinkEvaluator::addToSecondaryCache(Property* s
     return propertyLinkSecondaryCache_[src];
 }
 
+void LinkEvaluator::invalidateSecondaryCache(Property* src) {
+    // A cached entry only depends on the links of the properties it reaches, and on the links of
+    // their composite owners and sub properties. Entries not touching src can be kept.
+    const auto dependsOnSrc = [src](const Link& link) {
+        return link.dst_ == src || isOwnedBy(link.dst_, src) || isOwnedBy(src, link.dst_);
+    };
+    util::map_erase_remove_if(propertyLinkSecondaryCache_, [&](const auto& item) {
+        return item.first == src || util::contains_if(item.second, dependsOnSrc);
+    });
+}
+
 void LinkEvaluator::secondaryCacheHelper(std::vector<Link>& links, Property* src, Property* dst) {
     // Check that we don't use a previous source or destination as the new destination.
     if (!util::contains_if(
@@ -164,14 +196,80 @@ bool LinkEvaluator::isLinking() const { return !visited_.empty(); }
 void LinkEvaluator::evaluateLinksFromProperty(Property* modifiedProperty) {
     if (util::contains(visited_, modifiedProperty)) return;
 
+    auto& links = getTriggerdLinksForProperty(modifiedProperty);
+    if (links.empty()) return;
+
+    if (transactions_ > 0) {
+        if (util::contains(pending_, modifiedProperty)) {
+            util::erase_remove(pending_, modifiedProperty);
+            stats_.coalesced += links.size();
+        }
+        pending_.push_back(modifiedProperty);
+        return;
+    }
+
     NetworkLock lock(network_);
 
-    auto& links = getTriggerdLinksForProperty(modifiedProperty);
+    const auto traceName = Tracer::isEnabled() ? joinString(modifiedProperty->getPath(), ".")
+                                               : std::string{};
+    IVW_TRACE_SCOPE("link", traceName.empty() ? nullptr : traceName.c_str());
+
+    propagate(links);
+}
+
+void LinkEvaluator::beginTransaction() { ++transactions_; }
+
+void LinkEvaluator::endTransaction() {
+    if (transactions_ == 0) return;
+    if (--transactions_ == 0 && !pending_.empty()) propagatePending();
+}
+
+bool LinkEvaluator::isInTransaction() const { return transactions_ > 0; }
+
+const LinkEvaluator::Stats& LinkEvaluator::getStats() const { return stats_; }
+
+void LinkEvaluator::resetStats() { stats_ = Stats{}; }
+
+void LinkEvaluator::propagate(const std::vector<Link>& links) {
     VisitedHelper helper(visited_, links);
 
+    const auto start = std::chrono::steady_clock::now();
     for (auto& link : links) {
         link.converter_->convert(link.src_, link.dst_);
     }
+    ++stats_.evaluations;
+    stats_.propagations += links.size();
+    stats_.time += std::chrono::steady_clock::now() - start;
+}
+
+void LinkEvaluator::propagatePending() {
+    NetworkLock lock(network_);
+    IVW_TRACE_SCOPE("link", "transaction");
+
+    const auto sources = std::move(pending_);
+    pending_.clear();
+
+    // Every destination takes its value from the last modified source that reaches it, and a
+    // property that was set directly keeps its value unless a source modified after it reaches
+    // it. Since everything reachable from a destination is reachable from that source as well,
+    // keeping the links of each source in order means a property is always set before it is used.
+    std::unordered_map<Property*, Property*> origin;
+    for (auto src : sources) {
+        origin[src] = src;
+        for (auto& link : getTriggerdLinksForProperty(src)) origin[link.dst_] = src;
+    }
+
+    std::vector<Link> links;
+    size_t total = 0;
+    for (auto src : sources) {
+        const auto& srcLinks = getTriggerdLinksForProperty(src);
+        total += srcLinks.size();
+        std::copy_if(srcLinks.begin(), srcLinks.end(), std::back_inserter(links),
+                     [&](const Link& link) { return origin[link.dst_] == src; });
+    }
+    stats_.coalesced += total - links.size();
+
+    propagate(links);
 }
 
 }  // namespace inviwo
@@ -280,6 +280,16 @@ void ProcessorNetwork::evaluateLinksFromProperty(Property* source) {
     linkEvaluator_.evaluateLinksFromProperty(source);
 }
 
+void ProcessorNetwork::beginLinkTransaction() { linkEvaluator_.beginTransaction(); }
+
+void ProcessorNetwork::endLinkTransaction() { linkEvaluator_.endTransaction(); }
+
+const LinkEvaluator::Stats& ProcessorNetwork::getLinkStats() const {
+    return linkEvaluator_.getStats();
+}
+
+void ProcessorNetwork::resetLinkStats() { linkEvaluator_.resetStats(); }
+
 void ProcessorNetwork::clear() {
     NetworkLock lock(this);
 
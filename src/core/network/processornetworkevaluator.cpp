@@ -34,23 +34,59 @@
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/network/networkutils.h>
 #include <inviwo/core/network/networklock.h>
-#include <inviwo/core/util/clock.h>
+#include <inviwo/core/util/tracing.h>
+
+#include <algorithm>
+#include <unordered_set>
 
 namespace inviwo {
 
+namespace {
+
+template <typename Func>
+void forEachSuccessor(Processor* processor, Func f) {
+    for (auto outport : processor->getOutports()) {
+        for (auto inport : outport->getConnectedInports()) f(inport->getProcessor());
+    }
+}
+
+template <typename Func>
+void forEachPredecessor(Processor* processor, Func f) {
+    for (auto inport : processor->getInports()) {
+        for (auto outport : inport->getConnectedOutports()) f(outport->getProcessor());
+    }
+}
+
+}  // namespace
+
 ProcessorNetworkEvaluator::ProcessorNetworkEvaluator(ProcessorNetwork* processorNetwork)
     : processorNetwork_(processorNetwork)
-    , processorsSorted_(util::topologicalSort(processorNetwork_))
+    , orderDirty_(true)
+    , scheduleDirty_(true)
     , evaulationQueued_(false)
     , exceptionHandler_(StandardEvaluationErrorHandler()) {
 
     processorNetwork_->addObserver(this);
+    processorNetwork_->forEachProcessor([this](Processor* p) {
+        p->ProcessorObservable::addObserver(this);
+        invalidatedDirectly_.insert(p);
+    });
 }
 
 void ProcessorNetworkEvaluator::setExceptionHandler(EvaluationErrorHandler handler) {
     exceptionHandler_ = handler;
 }
 
+const std::vector<Processor*>& ProcessorNetworkEvaluator::getSortedProcessors() {
+    updateSchedule();
+    return processorsSorted_;
+}
+
+const std::vector<std::vector<Processor*>>& ProcessorNetworkEvaluator::getEvaluationLevels() {
+    updateSchedule();
+    return levels_;
+}
+
 void ProcessorNetworkEvaluator::onProcessorNetworkEvaluateRequest() {
     // Direct request, thus we don't want to queue the evaluation anymore
     evaulationQueued_ = false;
@@ -99,14 +135,23 @@ void ProcessorNetworkEvaluator::evaluate() {
 
     notifyObserversProcessorNetworkEvaluationBegin();
 
-    IVW_CPU_PROFILING_IF(500, "Evaluated Processor Network");
+    IVW_TRACE_SCOPE("network", "Evaluate network");
 
+    updateSchedule();
+    // Network changes during evaluation only mark the schedule as dirty, so the list stays valid
     for (auto processor : processorsSorted_) {
         if (!processor->isValid()) {
             if (processor->isReady()) {
+                if (hasUnchangedInput(processor)) {
+                    processor->setValidUnchanged();
+                    continue;
+                }
+                invalidatedDirectly_.erase(processor);
+
                 try {
                     // re-initialize resources (e.g., shaders) if necessary
                     if (processor->getInvalidationLevel() >= InvalidationLevel::InvalidResources) {
+                        IVW_TRACE_SCOPE("initializeResources", processor->getIdentifier());
                         processor->initializeResources();
                     }
                     // call onChange for all invalid inports
@@ -122,7 +167,7 @@ void ProcessorNetworkEvaluator::evaluate() {
                 processor->notifyObserversAboutToProcess(processor);
 
                 try {
-                    IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
+                    IVW_TRACE_SCOPE("process", processor->getIdentifier());
                     // do the actual processing
                     processor->process();
                 } catch (...) {
@@ -149,26 +194,200 @@ void ProcessorNetworkEvaluator::evaluate() {
     notifyObserversProcessorNetworkEvaluationEnd();
 }
 
-void ProcessorNetworkEvaluator::onProcessorSinkChanged(Processor*) {
-    processorsSorted_ = util::topologicalSort(processorNetwork_);
+void ProcessorNetworkEvaluator::onProcessorSinkChanged(Processor*) { scheduleDirty_ = true; }
+
+void ProcessorNetworkEvaluator::onProcessorInvalidationBegin(Processor* p) {
+    if (!p->isInvalidatedByInport()) invalidatedDirectly_.insert(p);
+}
+
+bool ProcessorNetworkEvaluator::hasUnchangedInput(Processor* processor) const {
+    if (processor->getInvalidationLevel() != InvalidationLevel::InvalidOutput) return false;
+    if (invalidatedDirectly_.count(processor) != 0) return false;
+    const auto& inports = processor->getInports();
+    return !inports.empty() &&
+           std::none_of(inports.begin(), inports.end(), [](Inport* p) { return p->isChanged(); });
 }
 
 void ProcessorNetworkEvaluator::onProcessorNetworkDidAddProcessor(Processor* p) {
     p->ProcessorObservable::addObserver(this);
-    processorsSorted_ = util::topologicalSort(processorNetwork_);
+    invalidatedDirectly_.insert(p);
+    addToOrder(p);
 }
 
 void ProcessorNetworkEvaluator::onProcessorNetworkDidRemoveProcessor(Processor* p) {
     p->ProcessorObservable::removeObserver(this);
-    processorsSorted_ = util::topologicalSort(processorNetwork_);
+    invalidatedDirectly_.erase(p);
+    removeFromOrder(p);
 }
 
-void ProcessorNetworkEvaluator::onProcessorNetworkDidAddConnection(const PortConnection&) {
-    processorsSorted_ = util::topologicalSort(processorNetwork_);
+void ProcessorNetworkEvaluator::onProcessorNetworkDidAddConnection(const PortConnection& con) {
+    addEdgeToOrder(con.getOutport()->getProcessor(), con.getInport()->getProcessor());
 }
 
 void ProcessorNetworkEvaluator::onProcessorNetworkDidRemoveConnection(const PortConnection&) {
-    processorsSorted_ = util::topologicalSort(processorNetwork_);
+    // Removing an edge never invalidates a topological order, only the set of processors
+    // with a sink downstream might change.
+    scheduleDirty_ = true;
+}
+
+void ProcessorNetworkEvaluator::addToOrder(Processor* processor) {
+    scheduleDirty_ = true;
+    if (orderDirty_ || processorNetwork_->islocked()) {
+        orderDirty_ = true;
+        return;
+    }
+    // A new processor has no connections yet, it can go anywhere
+    position_[processor] = order_.size();
+    order_.push_back(processor);
+}
+
+void ProcessorNetworkEvaluator::removeFromOrder(Processor* processor) {
+    scheduleDirty_ = true;
+    if (orderDirty_ || processorNetwork_->islocked()) {
+        orderDirty_ = true;
+        return;
+    }
+    auto it = position_.find(processor);
+    if (it == position_.end()) return;
+    const auto pos = it->second;
+    position_.erase(it);
+    order_.erase(order_.begin() + pos);
+    for (auto i = pos; i < order_.size(); ++i) position_[order_[i]] = i;
+}
+
+void ProcessorNetworkEvaluator::addEdgeToOrder(Processor* from, Processor* to) {
+    scheduleDirty_ = true;
+    if (orderDirty_ || processorNetwork_->islocked()) {
+        orderDirty_ = true;
+        return;
+    }
+
+    const auto lower = position_[to];
+    const auto upper = position_[from];
+    if (lower > upper) return;  // already in order
+
+    // Find the affected region: everything reachable from "to" that is placed before "from",
+    // and everything that reaches "from" and is placed after "to".
+    std::unordered_set<Processor*> visited;
+    std::vector<Processor*> forward;
+    std::vector<Processor*> stack{to};
+    visited.insert(to);
+    while (!stack.empty()) {
+        auto p = stack.back();
+        stack.pop_back();
+        forward.push_back(p);
+        bool cycle = false;
+        forEachSuccessor(p, [&](Processor* s) {
+            const auto pos = position_[s];
+            if (pos == upper) cycle = true;
+            if (pos < upper && visited.insert(s).second) stack.push_back(s);
+        });
+        if (cycle) {
+            // Should not happen since the network does not allow cycles, fall back to a rebuild
+            orderDirty_ = true;
+            return;
+        }
+    }
+
+    std::vector<Processor*> backward;
+    stack.push_back(from);
+    visited.insert(from);
+    while (!stack.empty()) {
+        auto p = stack.back();
+        stack.pop_back();
+        backward.push_back(p);
+        forEachPredecessor(p, [&](Processor* s) {
+            if (position_[s] > lower && visited.insert(s).second) stack.push_back(s);
+        });
+    }
+
+    // Reuse the positions of the affected processors, placing all of backward before forward
+    const auto byPosition = [&](Processor* a, Processor* b) { return position_[a] < position_[b]; };
+    std::sort(forward.begin(), forward.end(), byPosition);
+    std::sort(backward.begin(), backward.end(), byPosition);
+
+    std::vector<size_t> positions;
+    positions.reserve(forward.size() + backward.size());
+    for (auto p : backward) positions.push_back(position_[p]);
+    for (auto p : forward) positions.push_back(position_[p]);
+    std::sort(positions.begin(), positions.end());
+
+    auto pos = positions.begin();
+    for (auto p : backward) {
+        position_[p] = *pos;
+        order_[*pos++] = p;
+    }
+    for (auto p : forward) {
+        position_[p] = *pos;
+        order_[*pos++] = p;
+    }
+}
+
+void ProcessorNetworkEvaluator::rebuildOrder() {
+    // Kahn's algorithm over the whole network
+    const auto processors = processorNetwork_->getProcessors();
+    std::unordered_map<Processor*, size_t> inDegree;
+    std::vector<Processor*> ready;
+    for (auto p : processors) {
+        size_t degree = 0;
+        forEachPredecessor(p, [&](Processor*) { ++degree; });
+        inDegree[p] = degree;
+        if (degree == 0) ready.push_back(p);
+    }
+
+    order_.clear();
+    order_.reserve(processors.size());
+    while (!ready.empty()) {
+        auto p = ready.back();
+        ready.pop_back();
+        order_.push_back(p);
+        forEachSuccessor(p, [&](Processor* s) {
+            if (--inDegree[s] == 0) ready.push_back(s);
+        });
+    }
+    // Processors in a cycle can not be ordered, add them at the end to not lose them
+    if (order_.size() != processors.size()) {
+        for (auto p : processors) {
+            if (inDegree[p] != 0) order_.push_back(p);
+        }
+    }
+
+    position_.clear();
+    for (size_t i = 0; i < order_.size(); ++i) position_[order_[i]] = i;
+    orderDirty_ = false;
+    scheduleDirty_ = true;
+}
+
+void ProcessorNetworkEvaluator::updateSchedule() {
+    if (orderDirty_) rebuildOrder();
+    if (!scheduleDirty_) return;
+
+    // Walk the order backwards, so all successors are visited before a processor
+    std::unordered_set<Processor*> hasSink;
+    for (auto it = order_.rbegin(); it != order_.rend(); ++it) {
+        auto p = *it;
+        bool sink = p->isSink();
+        if (!sink) forEachSuccessor(p, [&](Processor* s) { sink = sink || hasSink.count(s); });
+        if (sink) hasSink.insert(p);
+    }
+
+    processorsSorted_.clear();
+    levels_.clear();
+    std::unordered_map<Processor*, size_t> level;
+    for (auto p : order_) {
+        if (hasSink.count(p) == 0) continue;
+        processorsSorted_.push_back(p);
+
+        size_t l = 0;
+        forEachPredecessor(p, [&](Processor* s) {
+            auto it = level.find(s);
+            if (it != level.end()) l = std::max(l, it->second + 1);
+        });
+        level[p] = l;
+        if (levels_.size() <= l) levels_.resize(l + 1);
+        levels_[l].push_back(p);
+    }
+    scheduleDirty_ = false;
 }
 
 }  // namespace inviwo
@@ -30,6 +30,7 @@
 #include <inviwo/core/network/workspacemanager.h>
 
 #include <inviwo/core/io/serialization/versionconverter.h>
+#include <inviwo/core/io/serialization/binaryxml.h>
 #include <inviwo/core/common/inviwomodule.h>
 #include <inviwo/core/util/inviwosetupinfo.h>
 #include <inviwo/core/util/filesystem.h>
@@ -132,7 +133,8 @@ WorkspaceManager::~WorkspaceManager() = default;
 void WorkspaceManager::clear() { clears_.invoke(); }
 
 void WorkspaceManager::save(std::ostream& stream, const std::string& refPath,
-                            const ExceptionHandler& exceptionHandler, WorkspaceSaveMode mode) {
+                            const ExceptionHandler& exceptionHandler, WorkspaceSaveMode mode,
+                            SerializationFormat format) {
     Serializer serializer(refPath);
 
     if (mode != WorkspaceSaveMode::Undo) {
@@ -141,7 +143,7 @@ void WorkspaceManager::save(std::ostream& stream, const std::string& refPath,
     }
 
     serializers_.invoke(serializer, exceptionHandler, mode);
-    serializer.writeFile(stream, true);
+    serializer.writeFile(stream, format);
 }
 
 void WorkspaceManager::load(std::istream& stream, const std::string& refPath,
@@ -158,18 +160,22 @@ void WorkspaceManager::load(std::istream& stream, const std::string& refPath,
 }
 
 void WorkspaceManager::save(const std::string& path, const ExceptionHandler& exceptionHandler,
-                            WorkspaceSaveMode mode) {
-    auto ostream = filesystem::ofstream(path);
+                            WorkspaceSaveMode mode, SerializationFormat format) {
+    auto ostream = filesystem::ofstream(path, format == SerializationFormat::Binary
+                                                  ? std::ios_base::out | std::ios_base::binary
+                                                  : std::ios_base::out);
     if (ostream.is_open()) {
-        save(ostream, path, exceptionHandler, mode);
+        save(ostream, path, exceptionHandler, mode, format);
     } else {
         throw AbortException("Could not open workspace file: " + path, IvwContext);
     }
 }
 
 void WorkspaceManager::load(const std::string& path, const ExceptionHandler& exceptionHandler) {
-    auto istream = filesystem::ifstream(path);
+    auto istream = filesystem::ifstream(path, std::ios_base::in | std::ios_base::binary);
     if (istream.is_open()) {
+        // Xml is read in text mode as before
+        if (!util::isBinaryXml(istream)) istream = filesystem::ifstream(path);
         load(istream, path, exceptionHandler);
     } else {
         throw AbortException("Could not open workspace file: " + path, IvwContext);
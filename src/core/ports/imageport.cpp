@@ -82,6 +82,8 @@ void ImageOutport::setData(Image* data) {
     cache_.setMaster(data_);
 }
 
+bool ImageOutport::tracksDataVersion() const { return false; }
+
 bool ImageOutport::hasEditableData() const { return static_cast<bool>(image_); }
 
 void ImageOutport::disconnectFrom(Inport* port) {
@@ -31,6 +31,7 @@
 #include <inviwo/core/ports/outport.h>
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/core/util/stdextensions.h>
+#include <inviwo/core/util/raiiutils.h>
 
 namespace inviwo {
 
@@ -65,11 +66,20 @@ void Inport::invalidate(InvalidationLevel invalidationLevel) {
         onInvalidCallback_.invokeAll();
     lastInvalidationLevel_ = std::max(lastInvalidationLevel_, invalidationLevel);
 
-    if (processor_) processor_->invalidate(invalidationLevel);
+    if (processor_) {
+        ++processor_->inportInvalidations_;
+        util::OnScopeExit reset{[p = processor_]() { --p->inportInvalidations_; }};
+        processor_->invalidate(invalidationLevel);
+    }
 }
 
 void Inport::setValid(const Outport* source) {
     lastInvalidationLevel_ = InvalidationLevel::Valid;
+
+    auto it = std::find_if(dataVersions_.begin(), dataVersions_.end(),
+                           [&](const auto& item) { return item.first == source; });
+    if (it != dataVersions_.end() && it->second == source->getDataVersion()) return;
+
     setChanged(true, source);
 }
 
@@ -93,8 +103,15 @@ void Inport::setChanged(bool changed, const Outport* source) {
     if (changed_ == false) {
         if (source == nullptr) {
             changedSources_.clear();
+            dataVersions_.clear();
+            for (auto outport : connectedOutports_) {
+                dataVersions_.emplace_back(outport, outport->getDataVersion());
+            }
         } else {
             util::erase_remove(changedSources_, source);
+            util::erase_remove_if(dataVersions_,
+                                  [&](const auto& item) { return item.first == source; });
+            dataVersions_.emplace_back(source, source->getDataVersion());
         }
     } else if (source) {
         util::push_back_unique(changedSources_, source);
@@ -118,6 +135,8 @@ void Inport::disconnectFrom(Outport* outport) {
     auto it = std::find(connectedOutports_.begin(), connectedOutports_.end(), outport);
     if (it != connectedOutports_.end()) {
         connectedOutports_.erase(it);
+        util::erase_remove_if(dataVersions_,
+                              [&](const auto& item) { return item.first == outport; });
         outport->disconnectFrom(this);  // remove this from outport.
         setChanged(true, outport);      // mark that we should call onChange.
         onDisconnectCallback_.invokeAll();
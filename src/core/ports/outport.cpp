@@ -41,7 +41,8 @@ Outport::Outport(std::string identifier)
                    }
                },
                []() { return false; }}
-    , invalidationLevel_(InvalidationLevel::Valid) {}
+    , invalidationLevel_(InvalidationLevel::Valid)
+    , dataVersion_(0) {}
 
 Outport::~Outport() = default;
 
@@ -63,12 +64,21 @@ void Outport::invalidate(InvalidationLevel invalidationLevel) {
 
 InvalidationLevel Outport::getInvalidationLevel() const { return invalidationLevel_; }
 
-void Outport::setValid() {
+void Outport::setValid() { setValidInternal(true); }
+
+void Outport::setValidInternal(bool newData) {
     invalidationLevel_ = InvalidationLevel::Valid;
+    if (newData && !tracksDataVersion()) newDataVersion();
     for (auto inport : connectedInports_) inport->setValid(this);
     isReady_.update();
 }
 
+size_t Outport::getDataVersion() const { return dataVersion_; }
+
+bool Outport::tracksDataVersion() const { return false; }
+
+void Outport::newDataVersion() { ++dataVersion_; }
+
 void Outport::propagateEvent(Event* event) { processor_->propagateEvent(event, this); }
 
 const BaseCallBack* Outport::onConnect(std::function<void()> lambda) {
@@ -54,7 +54,8 @@ Processor::Processor(const std::string& identifier, const std::string& displayNa
                 [this]() { return inports_.empty(); }}
     , identifier_(identifier)
     , displayName_{displayName}
-    , network_(nullptr) {
+    , network_(nullptr)
+    , inportInvalidations_(0) {
     createMetaData<ProcessorMetaData>(ProcessorMetaData::CLASS_IDENTIFIER);
 }
 
@@ -293,6 +294,8 @@ bool Processor::isSink() const { return isSink_; }
 
 bool Processor::isReady() const { return isReady_; }
 
+bool Processor::isInvalidatedByInport() const { return inportInvalidations_ > 0; }
+
 bool Processor::allInportsAreReady() const {
     return util::all_of(inports_, [](Inport* p) { return p->isReady() || p->isOptional(); });
 }
@@ -409,6 +412,12 @@ void Processor::setValid() {
     for (auto outport : outports_) outport->setValid();
 }
 
+void Processor::setValidUnchanged() {
+    PropertyOwner::setValid();
+    for (auto inport : inports_) inport->setChanged(false);
+    for (auto outport : outports_) outport->setValidInternal(false);
+}
+
 void Processor::invokeEvent(Event* event) {
     if (event->hash() == PickingEvent::chash()) {
         static_cast<PickingEvent*>(event)->invoke(this);
@@ -28,6 +28,7 @@
  *********************************************************************************/
 
 #include <inviwo/core/properties/property.h>
+#include <inviwo/core/properties/propertyowner.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/settings/systemsettings.h>
 #include <inviwo/core/util/stdextensions.h>
@@ -95,10 +96,13 @@ Property& Property::operator=(const Property& that) {
 std::string Property::getIdentifier() const { return identifier_; }
 void Property::setIdentifier(const std::string& identifier) {
     if (identifier_ != identifier) {
+        const auto oldIdentifier = identifier_;
         identifier_ = identifier;
 
         util::validateIdentifier(identifier, "Property", IvwContext);
 
+        if (owner_) owner_->onPropertyIdentifierChange(this, oldIdentifier);
+
         notifyObserversOnSetIdentifier(this, identifier_);
         notifyAboutChange();
     }
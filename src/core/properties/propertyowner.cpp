@@ -55,6 +55,7 @@ PropertyOwner& PropertyOwner::operator=(const PropertyOwner& that) {
         invalidationLevel_ = that.invalidationLevel_;
         properties_.clear();
         ownedProperties_.clear();
+        propertyIndex_.clear();
         for (const auto& p : that.ownedProperties_) addProperty(p->clone());
     }
     return *this;
@@ -92,9 +93,11 @@ void PropertyOwner::insertProperty(size_t index, Property* property, bool owner)
     if (dynamic_cast<EventProperty*>(property)) {
         eventProperties_.push_back(static_cast<EventProperty*>(property));
     }
-    if (dynamic_cast<CompositeProperty*>(property)) {
-        compositeProperties_.push_back(static_cast<CompositeProperty*>(property));
+    auto composite = dynamic_cast<CompositeProperty*>(property);
+    if (composite) {
+        compositeProperties_.push_back(composite);
     }
+    propertyIndex_[property->getIdentifier()] = IndexEntry{property, composite};
 
     if (owner) {  // Assume ownership of property;
         ownedProperties_.emplace_back(property);
@@ -107,9 +110,9 @@ void PropertyOwner::insertProperty(size_t index, Property& property) {
 }
 
 Property* PropertyOwner::removeProperty(const std::string& identifier) {
-    return removeProperty(
-        std::find_if(properties_.begin(), properties_.end(),
-                     [&identifier](Property* p) { return p->getIdentifier() == identifier; }));
+    auto it = propertyIndex_.find(identifier);
+    if (it == propertyIndex_.end()) return nullptr;
+    return removeProperty(std::find(properties_.begin(), properties_.end(), it->second.property));
 }
 
 Property* PropertyOwner::removeProperty(Property* property) {
@@ -139,6 +142,7 @@ Property* PropertyOwner::removeProperty(std::vector<Property*>::iterator it) {
 
         prop->setOwner(nullptr);
         properties_.erase(it);
+        updatePropertyIndex(prop->getIdentifier());
         notifyObserversDidRemoveProperty(prop, index);
 
         // This will delete the property if owned; in that case set prop to nullptr.
@@ -172,11 +176,32 @@ std::vector<Property*> PropertyOwner::getPropertiesRecursive() const {
     return result;
 }
 
+void PropertyOwner::onPropertyIdentifierChange(Property* property,
+                                               const std::string& oldIdentifier) {
+    auto it = propertyIndex_.find(oldIdentifier);
+    if (it != propertyIndex_.end() && it->second.property == property) {
+        updatePropertyIndex(oldIdentifier);
+    }
+    updatePropertyIndex(property->getIdentifier());
+}
+
+void PropertyOwner::updatePropertyIndex(const std::string& identifier) {
+    // Identifiers are unique within an owner unless a property was renamed to an existing
+    // identifier, then the first one is found, as for a linear search.
+    auto it = util::find_if(properties_,
+                            [&](Property* p) { return p->getIdentifier() == identifier; });
+    if (it != properties_.end()) {
+        propertyIndex_[identifier] = IndexEntry{*it, dynamic_cast<CompositeProperty*>(*it)};
+    } else {
+        propertyIndex_.erase(identifier);
+    }
+}
+
 Property* PropertyOwner::getPropertyByIdentifier(const std::string& identifier,
                                                  bool recursiveSearch) const {
-    for (Property* property : properties_) {
-        if (property->getIdentifier() == identifier) return property;
-    }
+    auto it = propertyIndex_.find(identifier);
+    if (it != propertyIndex_.end()) return it->second.property;
+
     if (recursiveSearch) {
         for (CompositeProperty* compositeProperty : compositeProperties_) {
             Property* p = compositeProperty->getPropertyByIdentifier(identifier, true);
@@ -187,22 +212,16 @@ Property* PropertyOwner::getPropertyByIdentifier(const std::string& identifier,
 }
 
 Property* PropertyOwner::getPropertyByPath(const std::vector<std::string>& path) const {
-    Property* property = getPropertyByIdentifier(path[0]);
-    if (property) {
-        size_t i = 1;
-        while (path.size() > i) {
-            CompositeProperty* comp = dynamic_cast<CompositeProperty*>(property);
-            if (comp) {
-                property = comp->getPropertyByIdentifier(path[i]);
-                if (!property) return nullptr;
-            } else {
-                return nullptr;
-            }
-            ++i;
-        }
-        return property;
+    const PropertyOwner* owner = this;
+    const IndexEntry* entry = nullptr;
+    for (const auto& identifier : path) {
+        if (!owner) return nullptr;
+        auto it = owner->propertyIndex_.find(identifier);
+        if (it == owner->propertyIndex_.end()) return nullptr;
+        entry = &it->second;
+        owner = entry->composite;
     }
-    return nullptr;
+    return entry ? entry->property : nullptr;
 }
 
 size_t PropertyOwner::size() const { return properties_.size(); }
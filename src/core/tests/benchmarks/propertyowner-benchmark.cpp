@@ -0,0 +1,163 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/properties/compositeproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace inviwo;
+
+namespace {
+
+constexpr size_t propertiesPerComposite = 50;
+
+// A property tree like the one of a large workspace, with a total of n properties in composites
+// of propertiesPerComposite each.
+struct Tree {
+    Tree(size_t n) : root("root", "Root") {
+        for (size_t i = 0; i < n; ++i) {
+            if (i % propertiesPerComposite == 0) {
+                const auto id = "comp" + std::to_string(i / propertiesPerComposite);
+                comp = new CompositeProperty(id, id);
+                root.addProperty(comp);
+            }
+            const auto id = "prop" + std::to_string(i);
+            comp->addProperty(new IntProperty(id, id));
+            paths.push_back({comp->getIdentifier(), id});
+        }
+    }
+
+    CompositeProperty root;
+    CompositeProperty* comp = nullptr;
+    std::vector<std::vector<std::string>> paths;
+};
+
+// The linear search used before the identifier index, for comparison
+Property* linearByIdentifier(const PropertyOwner& owner, const std::string& identifier,
+                             bool recursiveSearch) {
+    for (auto property : owner.getProperties()) {
+        if (property->getIdentifier() == identifier) return property;
+    }
+    if (recursiveSearch) {
+        for (auto comp : owner.getCompositeProperties()) {
+            if (auto p = linearByIdentifier(*comp, identifier, true)) return p;
+        }
+    }
+    return nullptr;
+}
+
+Property* linearByPath(const PropertyOwner& owner, const std::vector<std::string>& path) {
+    Property* property = linearByIdentifier(owner, path[0], false);
+    for (size_t i = 1; property && i < path.size(); ++i) {
+        auto comp = dynamic_cast<CompositeProperty*>(property);
+        property = comp ? linearByIdentifier(*comp, path[i], false) : nullptr;
+    }
+    return property;
+}
+
+}  // namespace
+
+static void PathLinear(benchmark::State& state) {
+    Tree tree(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        for (const auto& path : tree.paths) {
+            benchmark::DoNotOptimize(linearByPath(tree.root, path));
+        }
+    }
+    state.counters["Properties"] = static_cast<double>(state.range(0));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void PathIndexed(benchmark::State& state) {
+    Tree tree(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        for (const auto& path : tree.paths) {
+            benchmark::DoNotOptimize(tree.root.getPropertyByPath(path));
+        }
+    }
+    state.counters["Properties"] = static_cast<double>(state.range(0));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void RecursiveLinear(benchmark::State& state) {
+    Tree tree(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        for (const auto& path : tree.paths) {
+            benchmark::DoNotOptimize(linearByIdentifier(tree.root, path.back(), true));
+        }
+    }
+    state.counters["Properties"] = static_cast<double>(state.range(0));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void RecursiveIndexed(benchmark::State& state) {
+    Tree tree(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        for (const auto& path : tree.paths) {
+            benchmark::DoNotOptimize(tree.root.getPropertyByIdentifier(path.back(), true));
+        }
+    }
+    state.counters["Properties"] = static_cast<double>(state.range(0));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void AddProperties(benchmark::State& state) {
+    for (auto _ : state) {
+        Tree tree(static_cast<size_t>(state.range(0)));
+        benchmark::DoNotOptimize(tree.root.size());
+    }
+    state.counters["Properties"] = static_cast<double>(state.range(0));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(PathLinear)->RangeMultiplier(4)->Range(1 << 10, 1 << 16);
+BENCHMARK(PathIndexed)->RangeMultiplier(4)->Range(1 << 10, 1 << 16);
+
+BENCHMARK(RecursiveLinear)->RangeMultiplier(4)->Range(1 << 10, 1 << 14);
+BENCHMARK(RecursiveIndexed)->RangeMultiplier(4)->Range(1 << 10, 1 << 16);
+
+BENCHMARK(AddProperties)->RangeMultiplier(4)->Range(1 << 10, 1 << 16);
+
+int main(int argc, char** argv) {
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+
+    return 0;
+}
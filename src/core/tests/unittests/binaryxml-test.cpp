@@ -0,0 +1,215 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/io/serialization/serialization.h>
+#include <inviwo/core/io/serialization/binaryxml.h>
+#include <inviwo/core/io/serialization/ticpp.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/compositeproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/core/properties/stringproperty.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <map>
+#include <sstream>
+
+namespace inviwo {
+
+namespace {
+
+struct Item : public Serializable {
+    Item(float v = 0) : value(v) {}
+    virtual void serialize(Serializer& s) const override { s.serialize("value", value); }
+    virtual void deserialize(Deserializer& d) override { d.deserialize("value", value); }
+    float value;
+};
+
+struct Content : public Serializable {
+    virtual void serialize(Serializer& s) const override {
+        s.serialize("int", intValue);
+        s.serialize("double", doubleValue, SerializationTarget::Attribute);
+        s.serialize("string", stringValue);
+        s.serialize("vec", vecValue);
+        s.serialize("items", items, "item");
+        s.serialize("map", mapValue, "entry");
+    }
+    virtual void deserialize(Deserializer& d) override {
+        d.deserialize("int", intValue);
+        d.deserialize("double", doubleValue, SerializationTarget::Attribute);
+        d.deserialize("string", stringValue);
+        d.deserialize("vec", vecValue);
+        d.deserialize("items", items, "item");
+        d.deserialize("map", mapValue, "entry");
+    }
+
+    int intValue = 0;
+    double doubleValue = 0.0;
+    std::string stringValue;
+    vec3 vecValue{0.0f};
+    std::vector<Item> items;
+    std::map<std::string, int> mapValue;
+};
+
+Content makeContent() {
+    Content c;
+    c.intValue = -42;
+    c.doubleValue = 1.0 / 3.0;
+    c.stringValue = "a \"quoted\" <string> & 'more'\nwith a new line";
+    c.vecValue = vec3{1.5f, -2.0f, 3.25f};
+    c.items = {Item{0.1f}, Item{0.2f}, Item{0.3f}};
+    c.mapValue = {{"first", 1}, {"second", 2}};
+    return c;
+}
+
+std::string toXml(const TxDocument& doc) {
+    TiXmlPrinter printer;
+    printer.SetIndent("    ");
+    doc.Accept(&printer);
+    return printer.Str();
+}
+
+}  // namespace
+
+TEST(BinaryXml, DocumentRoundTrip) {
+    const auto refpath = filesystem::findBasePath();
+    const auto content = makeContent();
+
+    std::stringstream xml;
+    std::stringstream binary;
+    {
+        Serializer serializer(refpath);
+        serializer.serialize("content", content);
+        serializer.writeFile(xml, SerializationFormat::Xml);
+        serializer.writeFile(binary, SerializationFormat::Binary);
+    }
+    EXPECT_TRUE(util::isBinaryXml(binary));
+    EXPECT_FALSE(util::isBinaryXml(xml));
+    EXPECT_LT(binary.str().size(), xml.str().size());
+
+    TxDocument doc;
+    util::readBinaryXml(binary, doc);
+    EXPECT_EQ(toXml(doc), xml.str());
+}
+
+TEST(BinaryXml, DeserializeBothFormats) {
+    const auto refpath = filesystem::findBasePath();
+    const auto content = makeContent();
+
+    for (auto format : {SerializationFormat::Xml, SerializationFormat::Binary}) {
+        std::stringstream ss;
+        Serializer serializer(refpath);
+        serializer.serialize("content", content);
+        serializer.writeFile(ss, format);
+
+        Content result;
+        Deserializer deserializer(ss, refpath);
+        deserializer.deserialize("content", result);
+
+        EXPECT_EQ(result.intValue, content.intValue);
+        EXPECT_EQ(result.doubleValue, content.doubleValue);
+        EXPECT_EQ(result.stringValue, content.stringValue);
+        EXPECT_EQ(result.vecValue, content.vecValue);
+        ASSERT_EQ(result.items.size(), content.items.size());
+        for (size_t i = 0; i < content.items.size(); ++i) {
+            EXPECT_EQ(result.items[i].value, content.items[i].value);
+        }
+        EXPECT_EQ(result.mapValue, content.mapValue);
+    }
+}
+
+TEST(BinaryXml, PropertiesRoundTrip) {
+    const auto refpath = filesystem::findBasePath();
+
+    const auto makeOwner = []() {
+        auto owner = std::make_unique<CompositeProperty>("owner", "Owner");
+        auto sub = new CompositeProperty("sub", "Sub");
+        owner->addProperty(new IntProperty("int", "Int", 5, 0, 100));
+        owner->addProperty(new FloatVec3Property("vec", "Vec", vec3{0.5f}));
+        owner->addProperty(sub);
+        sub->addProperty(new StringProperty("string", "String", "text"));
+        sub->addProperty(new BoolProperty("bool", "Bool", false));
+        return owner;
+    };
+
+    auto src = makeOwner();
+    static_cast<IntProperty*>(src->getPropertyByPath({"int"}))->set(17);
+    static_cast<FloatVec3Property*>(src->getPropertyByPath({"vec"}))->set(vec3{1, 2, 3});
+    static_cast<StringProperty*>(src->getPropertyByPath({"sub", "string"}))->set("changed <&>");
+    static_cast<BoolProperty*>(src->getPropertyByPath({"sub", "bool"}))->set(true);
+
+    std::stringstream xml;
+    std::stringstream binary;
+    {
+        Serializer serializer(refpath);
+        serializer.serialize("owner", *src);
+        serializer.writeFile(xml, SerializationFormat::Xml);
+        serializer.writeFile(binary, SerializationFormat::Binary);
+    }
+
+    for (auto stream : {&xml, &binary}) {
+        auto dst = makeOwner();
+        Deserializer deserializer(*stream, refpath);
+        deserializer.deserialize("owner", *dst);
+
+        EXPECT_EQ(static_cast<IntProperty*>(dst->getPropertyByPath({"int"}))->get(), 17);
+        EXPECT_EQ(static_cast<FloatVec3Property*>(dst->getPropertyByPath({"vec"}))->get(),
+                  vec3(1, 2, 3));
+        EXPECT_EQ(static_cast<StringProperty*>(dst->getPropertyByPath({"sub", "string"}))->get(),
+                  "changed <&>");
+        EXPECT_TRUE(static_cast<BoolProperty*>(dst->getPropertyByPath({"sub", "bool"}))->get());
+    }
+}
+
+TEST(BinaryXml, InvalidData) {
+    std::stringstream binary;
+    {
+        Serializer serializer(filesystem::findBasePath());
+        serializer.serialize("content", makeContent());
+        serializer.writeFile(binary, SerializationFormat::Binary);
+    }
+    const auto data = binary.str();
+
+    for (auto size : {size_t{2}, size_t{8}, data.size() / 2, data.size() - 1}) {
+        std::stringstream truncated{data.substr(0, size)};
+        TxDocument doc;
+        EXPECT_THROW(util::readBinaryXml(truncated, doc), SerializationException);
+    }
+
+    std::stringstream notBinary{"<?xml version=\"1.0\" ?>"};
+    TxDocument doc;
+    EXPECT_THROW(util::readBinaryXml(notBinary, doc), SerializationException);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,213 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/linktransaction.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+
+#include <memory>
+
+namespace inviwo {
+
+namespace {
+
+struct LinkProcessor : Processor {
+    LinkProcessor(const std::string& id) : Processor(id, id), value("value", "Value", 0, 0, 100) {
+        addProperty(value);
+        value.onChange([this]() { ++changes; });
+    }
+    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+    static const ProcessorInfo processorInfo_;
+
+    IntProperty value;
+    int changes = 0;
+};
+
+const ProcessorInfo LinkProcessor::processorInfo_{
+    "org.inviwo.LinkProcessor",  // Class identifier
+    "LinkProcessor",             // Display name
+    "Testing",                   // Category
+    CodeState::Stable,           // Code state
+    Tags::CPU,                   // Tags
+};
+
+struct LinkNetwork {
+    LinkNetwork() {
+        for (auto id : {"a", "b", "c", "d", "e"}) {
+            p.push_back(static_cast<LinkProcessor*>(
+                network.addProcessor(std::make_unique<LinkProcessor>(id))));
+        }
+        // a -> b -> c and d -> b
+        network.addLink(&p[0]->value, &p[1]->value);
+        network.addLink(&p[1]->value, &p[2]->value);
+        network.addLink(&p[3]->value, &p[1]->value);
+        network.resetLinkStats();
+    }
+    LinkProcessor* operator[](size_t i) { return p[i]; }
+
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    std::vector<LinkProcessor*> p;
+};
+
+}  // namespace
+
+TEST(LinkEvaluator, Immediate) {
+    LinkNetwork n;
+
+    n[0]->value.set(1);
+    EXPECT_EQ(n[1]->value.get(), 1);
+    EXPECT_EQ(n[2]->value.get(), 1);
+    EXPECT_EQ(n[3]->value.get(), 0);
+
+    n[0]->value.set(2);
+    EXPECT_EQ(n[2]->value.get(), 2);
+    EXPECT_EQ(n[2]->changes, 2);
+
+    EXPECT_EQ(n.network.getLinkStats().evaluations, 2u);
+    EXPECT_EQ(n.network.getLinkStats().propagations, 4u);
+    EXPECT_EQ(n.network.getLinkStats().coalesced, 0u);
+}
+
+TEST(LinkEvaluator, Transaction) {
+    LinkNetwork n;
+    {
+        LinkTransaction transaction(&n.network);
+        for (int i = 1; i <= 5; ++i) n[0]->value.set(i);
+        EXPECT_EQ(n[1]->value.get(), 0);
+        EXPECT_EQ(n[2]->value.get(), 0);
+    }
+    EXPECT_EQ(n[1]->value.get(), 5);
+    EXPECT_EQ(n[2]->value.get(), 5);
+    EXPECT_EQ(n[1]->changes, 1);
+    EXPECT_EQ(n[2]->changes, 1);
+
+    EXPECT_EQ(n.network.getLinkStats().evaluations, 1u);
+    EXPECT_EQ(n.network.getLinkStats().propagations, 2u);
+    EXPECT_EQ(n.network.getLinkStats().coalesced, 8u);
+}
+
+TEST(LinkEvaluator, TransactionLastSourceWins) {
+    LinkNetwork n;
+    {
+        LinkTransaction transaction(&n.network);
+        {
+            LinkTransaction nested(&n.network);
+            n[0]->value.set(7);
+            n[3]->value.set(9);
+        }
+        EXPECT_EQ(n[1]->value.get(), 0);
+    }
+    EXPECT_EQ(n[1]->value.get(), 9);
+    EXPECT_EQ(n[2]->value.get(), 9);
+    EXPECT_EQ(n[0]->value.get(), 7);
+    EXPECT_EQ(n[1]->changes, 1);
+    EXPECT_EQ(n[2]->changes, 1);
+
+    {
+        LinkTransaction transaction(&n.network);
+        n[3]->value.set(4);
+        n[0]->value.set(3);
+    }
+    EXPECT_EQ(n[1]->value.get(), 3);
+    EXPECT_EQ(n[2]->value.get(), 3);
+}
+
+TEST(LinkEvaluator, TransactionBidirectional) {
+    LinkNetwork n;
+    n.network.addLink(&n[1]->value, &n[0]->value);
+    {
+        LinkTransaction transaction(&n.network);
+        n[0]->value.set(1);
+        n[1]->value.set(2);
+    }
+    EXPECT_EQ(n[0]->value.get(), 2);
+    EXPECT_EQ(n[1]->value.get(), 2);
+    EXPECT_EQ(n[2]->value.get(), 2);
+
+    {
+        LinkTransaction transaction(&n.network);
+        n[1]->value.set(5);
+        n[0]->value.set(6);
+    }
+    EXPECT_EQ(n[0]->value.get(), 6);
+    EXPECT_EQ(n[1]->value.get(), 6);
+    EXPECT_EQ(n[2]->value.get(), 6);
+}
+
+TEST(LinkEvaluator, TransactionChain) {
+    LinkNetwork n;
+    {
+        LinkTransaction transaction(&n.network);
+        n[0]->value.set(7);
+        n[1]->value.set(9);
+    }
+    EXPECT_EQ(n[0]->value.get(), 7);
+    EXPECT_EQ(n[1]->value.get(), 9);
+    EXPECT_EQ(n[2]->value.get(), 9);
+    EXPECT_EQ(n[2]->changes, 1);
+
+    {
+        LinkTransaction transaction(&n.network);
+        n[1]->value.set(4);
+        n[0]->value.set(3);
+    }
+    EXPECT_EQ(n[1]->value.get(), 3);
+    EXPECT_EQ(n[2]->value.get(), 3);
+}
+
+TEST(LinkEvaluator, LinkChanges) {
+    LinkNetwork n;
+
+    n[0]->value.set(1);
+    EXPECT_EQ(n[4]->value.get(), 0);
+
+    n.network.addLink(&n[2]->value, &n[4]->value);
+    n[0]->value.set(2);
+    EXPECT_EQ(n[4]->value.get(), 2);
+
+    n.network.removeLink(&n[1]->value, &n[2]->value);
+    n[0]->value.set(3);
+    EXPECT_EQ(n[1]->value.get(), 3);
+    EXPECT_EQ(n[2]->value.get(), 2);
+    EXPECT_EQ(n[4]->value.get(), 2);
+
+    // Removing the processor of a pending source drops it from the transaction
+    LinkTransaction transaction(&n.network);
+    n[3]->value.set(5);
+    n.network.removeAndDeleteProcessor(n[3]);
+}
+
+}  // namespace inviwo
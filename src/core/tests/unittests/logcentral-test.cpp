@@ -0,0 +1,160 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/logcentral.h>
+#include <inviwo/core/util/logerrorcounter.h>
+#include <inviwo/core/util/raiiutils.h>
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+class TestLogger : public Logger {
+public:
+    virtual void log(std::string source, LogLevel, LogAudience, const char*, const char*, int,
+                     std::string msg) override {
+        if (active_.exchange(true)) concurrent_ = true;
+        if (source == "LogCentralTests") messages_.push_back(std::move(msg));
+        active_ = false;
+    }
+
+    std::vector<std::string> messages_;
+    std::atomic<bool> active_{false};
+    std::atomic<bool> concurrent_{false};
+};
+
+// Blocks the first call to log until released
+class BlockingLogger : public Logger {
+public:
+    virtual void log(std::string, LogLevel, LogAudience, const char*, const char*, int,
+                     std::string msg) override {
+        if (first_) {
+            first_ = false;
+            entered_.set_value();
+            release_.get_future().wait();
+        }
+        messages_.push_back(std::move(msg));
+    }
+
+    bool first_ = true;
+    std::promise<void> entered_;
+    std::promise<void> release_;
+    std::vector<std::string> messages_;
+};
+
+}  // namespace
+
+TEST(LogCentralTests, MessagesFromManyThreads) {
+    auto lc = LogCentral::getPtr();
+    const auto verbosity = lc->getVerbosity();
+    lc->setVerbosity(LogVerbosity::Info);
+    util::OnScopeExit restore{[&]() { lc->setVerbosity(verbosity); }};
+
+    auto logger = std::make_shared<TestLogger>();
+    lc->registerLogger(logger);
+
+    const int threads = 4;
+    const int messagesPerThread = 250;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            for (int i = 0; i < messagesPerThread; ++i) {
+                LogInfoCustom("LogCentralTests", t << ":" << i);
+                if (i % 64 == 0) lc->flush();
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    lc->flush();
+
+    const auto dropped = lc->getNumberOfDroppedMessages();
+    EXPECT_EQ(static_cast<size_t>(threads * messagesPerThread), logger->messages_.size() + dropped);
+    EXPECT_FALSE(logger->concurrent_);
+
+    // Messages from one thread arrive in order
+    std::vector<int> next(threads, 0);
+    for (const auto& msg : logger->messages_) {
+        const auto sep = msg.find(':');
+        ASSERT_NE(std::string::npos, sep);
+        const auto t = std::stoi(msg.substr(0, sep));
+        const auto i = std::stoi(msg.substr(sep + 1));
+        EXPECT_LE(next[t], i);
+        next[t] = i + 1;
+    }
+}
+
+TEST(LogCentralTests, ErrorsAreDispatchedDirectly) {
+    auto logger = std::make_shared<LogErrorCounter>();
+    LogCentral::getPtr()->registerLogger(logger);
+
+    LogErrorCustom("LogCentralTests", "Expected error, testing the log");
+    EXPECT_EQ(size_t{1}, logger->getErrorCount());
+}
+
+TEST(LogCentralTests, DroppedMessages) {
+    auto lc = LogCentral::getPtr();
+    const auto verbosity = lc->getVerbosity();
+    lc->setVerbosity(LogVerbosity::Info);
+    util::OnScopeExit restore{[&]() { lc->setVerbosity(verbosity); }};
+
+    auto logger = std::make_shared<BlockingLogger>();
+    lc->registerLogger(logger);
+    const auto dropped = lc->getNumberOfDroppedMessages();
+
+    // Wait for the dispatch thread to be stuck in the logger, then overfill the queue
+    LogInfoCustom("LogCentralTests", "first");
+    logger->entered_.get_future().wait();
+    const size_t extra = 10;
+    for (size_t i = 0; i < LogCentral::queueCapacity + extra; ++i) {
+        LogInfoCustom("LogCentralTests", "message");
+    }
+    EXPECT_EQ(dropped + extra, lc->getNumberOfDroppedMessages());
+
+    logger->release_.set_value();
+    lc->flush();
+
+    ASSERT_EQ(LogCentral::queueCapacity + 2, logger->messages_.size());
+    EXPECT_EQ("10 log messages were dropped since the message queue was full",
+              logger->messages_.back());
+}
+
+}  // namespace inviwo
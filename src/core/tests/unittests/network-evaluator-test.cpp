@@ -43,7 +43,9 @@
 #include <inviwo/core/ports/datainport.h>
 #include <inviwo/core/ports/dataoutport.h>
 
+#include <algorithm>
 #include <functional>
+#include <memory>
 
 namespace inviwo {
 
@@ -124,6 +126,13 @@ const auto createB = []() {
     return bt;
 };
 
+const auto createC = [](const std::string& id) {
+    auto ct = std::make_unique<TestProcessor>(id);
+    ct->addPort(std::make_unique<DataInport<int>>("in"));
+    ct->addPort(std::make_unique<DataOutport<int>>("out"));
+    return ct;
+};
+
 TEST(NetworkEvaluator, Eval) {
     ProcessorNetwork network{InviwoApplication::getPtr()};
     ProcessorNetworkEvaluator evaluator{&network};
@@ -257,4 +266,233 @@ TEST(NetworkEvaluator, Error) {
     }
 }
 
+TEST(NetworkEvaluator, SkipUnchanged) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+
+    auto at = createA();
+    auto a = at.get();
+    Instrument ai(*a);
+    std::shared_ptr<const int> aData = std::make_shared<int>(0);
+    a->onProcess = [func = a->onProcess, &aData](TestProcessor& p) {
+        func(p);
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(aData);
+    };
+
+    auto ct = createC("c");
+    auto c = ct.get();
+    Instrument ci(*c);
+    std::shared_ptr<const int> cData = std::make_shared<int>(0);
+    c->onProcess = [func = c->onProcess, &cData](TestProcessor& p) {
+        func(p);
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(cData);
+    };
+
+    auto bt = createB();
+    auto b = bt.get();
+    Instrument bi(*b);
+
+    {
+        NetworkLock lock(&network);
+        network.addProcessor(std::move(at));
+        network.addProcessor(std::move(ct));
+        network.addProcessor(std::move(bt));
+        network.addConnection(a->getOutports()[0], c->getInports()[0]);
+        network.addConnection(c->getOutports()[0], b->getInports()[0]);
+    }
+    ai.checkAndReset(1, 1, 0);
+    ci.checkAndReset(1, 1, 0);
+    bi.checkAndReset(1, 1, 0);
+
+    {
+        SCOPED_TRACE("Same data from a");
+        a->invalidate(InvalidationLevel::InvalidOutput);
+        ai.checkAndReset(0, 1, 0);
+        ci.checkAndReset(0, 0, 0);
+        bi.checkAndReset(0, 0, 0);
+        EXPECT_TRUE(c->isValid());
+        EXPECT_TRUE(b->isValid());
+    }
+    {
+        SCOPED_TRACE("Same data from c");
+        c->invalidate(InvalidationLevel::InvalidOutput);
+        ai.checkAndReset(0, 0, 0);
+        ci.checkAndReset(0, 1, 0);
+        bi.checkAndReset(0, 0, 0);
+    }
+    {
+        SCOPED_TRACE("New data from a");
+        aData = std::make_shared<int>(1);
+        a->invalidate(InvalidationLevel::InvalidOutput);
+        ai.checkAndReset(0, 1, 0);
+        ci.checkAndReset(0, 1, 0);
+        bi.checkAndReset(0, 0, 0);
+    }
+    {
+        SCOPED_TRACE("New data from a and c");
+        aData = std::make_shared<int>(2);
+        cData = std::make_shared<int>(2);
+        a->invalidate(InvalidationLevel::InvalidOutput);
+        ai.checkAndReset(0, 1, 0);
+        ci.checkAndReset(0, 1, 0);
+        bi.checkAndReset(0, 1, 0);
+    }
+}
+
+TEST(NetworkEvaluator, ModifiedInPlace) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+
+    // a sets its data once and then only modifies it in place, like a processor rendering into
+    // the same volume every time
+    auto at = createA();
+    auto a = at.get();
+    Instrument ai(*a);
+    auto aData = std::make_shared<int>(0);
+    a->onProcess = [func = a->onProcess, aData](TestProcessor& p) {
+        func(p);
+        auto port = static_cast<DataOutport<int>*>(p.getOutports()[0]);
+        if (!port->hasData()) port->setData(aData);
+        ++*aData;
+    };
+
+    auto ct = createC("c");
+    auto c = ct.get();
+    Instrument ci(*c);
+    std::shared_ptr<const int> cData = std::make_shared<int>(0);
+    c->onProcess = [func = c->onProcess, &cData](TestProcessor& p) {
+        func(p);
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(cData);
+    };
+
+    auto bt = createB();
+    auto b = bt.get();
+    Instrument bi(*b);
+
+    {
+        NetworkLock lock(&network);
+        network.addProcessor(std::move(at));
+        network.addProcessor(std::move(ct));
+        network.addProcessor(std::move(bt));
+        network.addConnection(a->getOutports()[0], c->getInports()[0]);
+        network.addConnection(c->getOutports()[0], b->getInports()[0]);
+    }
+    ai.checkAndReset(1, 1, 0);
+    ci.checkAndReset(1, 1, 0);
+    bi.checkAndReset(1, 1, 0);
+
+    for (int i = 0; i < 2; ++i) {
+        SCOPED_TRACE("Modified data from a");
+        a->invalidate(InvalidationLevel::InvalidOutput);
+        ai.checkAndReset(0, 1, 0);
+        ci.checkAndReset(0, 1, 0);
+        bi.checkAndReset(0, 0, 0);
+        EXPECT_EQ(*aData, i + 2);
+    }
+    {
+        SCOPED_TRACE("New const data from c");
+        cData = std::make_shared<int>(1);
+        a->invalidate(InvalidationLevel::InvalidOutput);
+        ai.checkAndReset(0, 1, 0);
+        ci.checkAndReset(0, 1, 0);
+        bi.checkAndReset(0, 1, 0);
+    }
+}
+
+namespace {
+
+// Build a -> c -> b and a -> d -> e, where b and e are sinks and the processors and connections
+// are added in reverse order. f hangs off c without a sink downstream.
+struct OrderNetwork {
+    OrderNetwork(ProcessorNetwork& network) {
+        auto bt = createB();
+        b = bt.get();
+        network.addProcessor(std::move(bt));
+        auto et = createB();
+        e = et.get();
+        e->setIdentifier("e");
+        network.addProcessor(std::move(et));
+        auto ct = createC("c");
+        c = ct.get();
+        network.addProcessor(std::move(ct));
+        auto dt = createC("d");
+        d = dt.get();
+        network.addProcessor(std::move(dt));
+        auto ft = createC("f");
+        f = ft.get();
+        network.addProcessor(std::move(ft));
+        auto at = createA();
+        a = at.get();
+        network.addProcessor(std::move(at));
+
+        network.addConnection(c->getOutports()[0], b->getInports()[0]);
+        network.addConnection(d->getOutports()[0], e->getInports()[0]);
+        network.addConnection(c->getOutports()[0], f->getInports()[0]);
+        network.addConnection(a->getOutports()[0], c->getInports()[0]);
+        network.addConnection(a->getOutports()[0], d->getInports()[0]);
+    }
+
+    void check(ProcessorNetworkEvaluator& evaluator) {
+        const auto& sorted = evaluator.getSortedProcessors();
+        ASSERT_EQ(sorted.size(), size_t{5});
+        const auto pos = [&](Processor* p) {
+            return std::find(sorted.begin(), sorted.end(), p) - sorted.begin();
+        };
+        EXPECT_LT(pos(a), pos(c));
+        EXPECT_LT(pos(c), pos(b));
+        EXPECT_LT(pos(a), pos(d));
+        EXPECT_LT(pos(d), pos(e));
+        EXPECT_EQ(std::find(sorted.begin(), sorted.end(), f), sorted.end());
+
+        const auto& levels = evaluator.getEvaluationLevels();
+        ASSERT_EQ(levels.size(), size_t{3});
+        EXPECT_EQ(levels[0], std::vector<Processor*>{a});
+        EXPECT_EQ(levels[1].size(), size_t{2});
+        EXPECT_EQ(levels[2].size(), size_t{2});
+    }
+
+    TestProcessor* a;
+    TestProcessor* b;
+    TestProcessor* c;
+    TestProcessor* d;
+    TestProcessor* e;
+    TestProcessor* f;
+};
+
+}  // namespace
+
+TEST(NetworkEvaluator, Order) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+
+    OrderNetwork on{network};
+    on.check(evaluator);
+
+    {
+        SCOPED_TRACE("Remove connection to sink");
+        network.removeConnection(on.c->getOutports()[0], on.b->getInports()[0]);
+        const auto& sorted = evaluator.getSortedProcessors();
+        EXPECT_EQ(sorted.size(), size_t{3});
+        EXPECT_EQ(std::find(sorted.begin(), sorted.end(), on.c), sorted.end());
+    }
+    {
+        SCOPED_TRACE("Remove processor");
+        network.removeAndDeleteProcessor(on.f);
+        network.addConnection(on.c->getOutports()[0], on.b->getInports()[0]);
+        EXPECT_EQ(evaluator.getSortedProcessors().size(), size_t{5});
+    }
+}
+
+TEST(NetworkEvaluator, OrderLocked) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+
+    std::unique_ptr<OrderNetwork> on;
+    {
+        NetworkLock lock(&network);
+        on = std::make_unique<OrderNetwork>(network);
+    }
+    on->check(evaluator);
+}
+
 }  // namespace inviwo
@@ -0,0 +1,97 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/properties/compositeproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+
+namespace inviwo {
+
+TEST(PropertyOwner, GetByIdentifier) {
+    CompositeProperty owner("owner", "Owner");
+    auto a = new IntProperty("a", "A");
+    auto b = new IntProperty("b", "B");
+    owner.addProperty(a);
+    owner.addProperty(b);
+
+    EXPECT_EQ(owner.getPropertyByIdentifier("a"), a);
+    EXPECT_EQ(owner.getPropertyByIdentifier("b"), b);
+    EXPECT_EQ(owner.getPropertyByIdentifier("c"), nullptr);
+    EXPECT_THROW(owner.addProperty(new IntProperty("a", "A")), Exception);
+
+    owner.removeProperty("a");
+    EXPECT_EQ(owner.getPropertyByIdentifier("a"), nullptr);
+    EXPECT_EQ(owner.size(), 1u);
+}
+
+TEST(PropertyOwner, Rename) {
+    CompositeProperty owner("owner", "Owner");
+    auto a = new IntProperty("a", "A");
+    auto b = new IntProperty("b", "B");
+    owner.addProperty(a);
+    owner.addProperty(b);
+
+    a->setIdentifier("c");
+    EXPECT_EQ(owner.getPropertyByIdentifier("a"), nullptr);
+    EXPECT_EQ(owner.getPropertyByIdentifier("c"), a);
+
+    // Renaming to an existing identifier finds the first one, as before
+    b->setIdentifier("c");
+    EXPECT_EQ(owner.getPropertyByIdentifier("c"), a);
+    EXPECT_EQ(owner.getPropertyByIdentifier("b"), nullptr);
+    owner.removeProperty(a);
+    EXPECT_EQ(owner.getPropertyByIdentifier("c"), b);
+}
+
+TEST(PropertyOwner, GetByPath) {
+    CompositeProperty owner("owner", "Owner");
+    auto comp = new CompositeProperty("comp", "Comp");
+    auto sub = new CompositeProperty("sub", "Sub");
+    auto a = new IntProperty("a", "A");
+    owner.addProperty(comp);
+    comp->addProperty(sub);
+    sub->addProperty(a);
+
+    EXPECT_EQ(owner.getPropertyByPath({"comp"}), comp);
+    EXPECT_EQ(owner.getPropertyByPath({"comp", "sub", "a"}), a);
+    EXPECT_EQ(owner.getPropertyByPath({"comp", "a"}), nullptr);
+    EXPECT_EQ(owner.getPropertyByPath({"comp", "sub", "a", "x"}), nullptr);
+    EXPECT_EQ(owner.getPropertyByPath({}), nullptr);
+    EXPECT_EQ(owner.getPropertyByIdentifier("a", true), a);
+
+    sub->setIdentifier("renamed");
+    EXPECT_EQ(owner.getPropertyByPath({"comp", "sub", "a"}), nullptr);
+    EXPECT_EQ(owner.getPropertyByPath({"comp", "renamed", "a"}), a);
+}
+
+}  // namespace inviwo
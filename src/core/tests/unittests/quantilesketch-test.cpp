@@ -0,0 +1,124 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/quantilesketch.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+namespace inviwo {
+
+TEST(QuantileSketch, NearestRankPercentiles) {
+    // https://en.wikipedia.org/wiki/Percentile
+    std::vector<int> data{20, 15, 50, 40, 35};
+    const auto res = util::nearestRankPercentiles(data.begin(), data.end(),
+                                                  {1.0, 0.05, 0.3, 0.4, 0.5});
+    EXPECT_EQ(res, (std::vector<int>{50, 15, 20, 20, 35}));
+
+    std::vector<int> empty;
+    EXPECT_EQ(util::nearestRankPercentiles(empty.begin(), empty.end(), {0.5}),
+              (std::vector<int>{0}));
+    EXPECT_THROW(util::nearestRankPercentiles(data.begin(), data.end(), {1.5}), RangeException);
+}
+
+TEST(QuantileSketch, Accuracy) {
+    std::mt19937 rand(0);
+    std::normal_distribution<double> dist(2.0, 3.0);
+    std::vector<double> data(200000);
+    std::generate(data.begin(), data.end(), [&]() { return dist(rand); });
+
+    util::QuantileSketch sketch;
+    sketch.add(data.begin(), data.end());
+    EXPECT_EQ(sketch.count(), static_cast<double>(data.size()));
+    EXPECT_LE(sketch.getNumberOfCentroids(), size_t{200});
+
+    std::sort(data.begin(), data.end());
+    EXPECT_EQ(sketch.min(), data.front());
+    EXPECT_EQ(sketch.max(), data.back());
+    EXPECT_EQ(sketch.quantile(0.0), data.front());
+    EXPECT_EQ(sketch.quantile(1.0), data.back());
+
+    for (auto q : {0.001, 0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99, 0.999}) {
+        const auto value = sketch.quantile(q);
+        const auto rank = std::lower_bound(data.begin(), data.end(), value) - data.begin();
+        const auto error = std::abs(static_cast<double>(rank) / data.size() - q);
+        // The rank error is proportional to q(1-q)
+        EXPECT_LT(error, 0.001 + 0.02 * q * (1.0 - q)) << "quantile " << q;
+    }
+}
+
+TEST(QuantileSketch, Merge) {
+    std::mt19937 rand(0);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    util::QuantileSketch all;
+    util::QuantileSketch merged;
+    for (int chunk = 0; chunk < 8; ++chunk) {
+        util::QuantileSketch part;
+        for (int i = 0; i < 10000; ++i) {
+            const auto value = dist(rand);
+            part.add(value);
+            all.add(value);
+        }
+        merged.merge(part);
+    }
+    EXPECT_EQ(merged.count(), all.count());
+    EXPECT_EQ(merged.min(), all.min());
+    EXPECT_EQ(merged.max(), all.max());
+    for (auto q : {0.01, 0.1, 0.5, 0.9, 0.99}) {
+        EXPECT_NEAR(merged.quantile(q), q, 0.005) << "quantile " << q;
+        EXPECT_NEAR(merged.quantile(q), all.quantile(q), 0.005) << "quantile " << q;
+    }
+}
+
+TEST(QuantileSketch, SpecialValues) {
+    util::QuantileSketch sketch;
+    EXPECT_TRUE(sketch.empty());
+    EXPECT_TRUE(std::isnan(sketch.quantile(0.5)));
+
+    sketch.add(std::numeric_limits<double>::quiet_NaN());
+    EXPECT_TRUE(sketch.empty());
+
+    for (int i = 1; i <= 5; ++i) sketch.add(static_cast<double>(i));
+    EXPECT_EQ(sketch.quantile(0.5), 3.0);
+    EXPECT_EQ(sketch.quantile(0.0), 1.0);
+    EXPECT_EQ(sketch.quantile(1.0), 5.0);
+    EXPECT_THROW(sketch.quantile(-0.1), RangeException);
+
+    sketch.clear();
+    EXPECT_TRUE(sketch.empty());
+}
+
+}  // namespace inviwo
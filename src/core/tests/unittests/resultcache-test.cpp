@@ -0,0 +1,172 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/resultcache.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/properties/compositeproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+
+namespace inviwo {
+
+TEST(ResultCache, HitAndMiss) {
+    ResultCache<int> cache;
+    auto input = std::make_shared<const int>(1);
+
+    const auto key = [&](float value) { return ResultCacheKey{}.addData(input).addValue(value); };
+
+    EXPECT_EQ(cache.get(key(1.0f)), nullptr);
+    cache.put(key(1.0f), std::make_shared<const int>(10));
+    cache.put(key(2.0f), std::make_shared<const int>(20));
+
+    auto result = cache.get(key(1.0f));
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(*result, 10);
+    result = cache.get(key(2.0f));
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(*result, 20);
+    EXPECT_EQ(cache.get(key(3.0f)), nullptr);
+
+    const auto& stats = cache.getStatistics();
+    EXPECT_EQ(stats.hits, size_t{2});
+    EXPECT_EQ(stats.misses, size_t{2});
+    EXPECT_EQ(stats.entries, size_t{2});
+    EXPECT_EQ(stats.bytes, 2 * sizeof(int));
+}
+
+TEST(ResultCache, DataIdentity) {
+    ResultCache<int> cache;
+    auto input = std::make_shared<const int>(1);
+    cache.put(ResultCacheKey{}.addData(input), std::make_shared<const int>(10));
+
+    // Equal content but another object
+    auto other = std::make_shared<const int>(1);
+    EXPECT_EQ(cache.get(ResultCacheKey{}.addData(other)), nullptr);
+    EXPECT_NE(cache.get(ResultCacheKey{}.addData(input)), nullptr);
+
+    // Entries of destroyed data are removed
+    input.reset();
+    cache.put(ResultCacheKey{}.addData(other), std::make_shared<const int>(20));
+    EXPECT_EQ(cache.getStatistics().entries, size_t{1});
+}
+
+TEST(ResultCache, DataModifiedInPlace) {
+    ResultCache<int> cache;
+    auto volume = std::make_shared<Volume>(size3_t{4}, DataUInt8::get());
+    std::shared_ptr<const Volume> input = volume;
+    const auto key = [&]() { return ResultCacheKey{}.addData(input); };
+
+    const auto put = [&]() {
+        EXPECT_EQ(cache.get(key()), nullptr);
+        cache.put(key(), std::make_shared<const int>(0));
+        EXPECT_NE(cache.get(key()), nullptr);
+    };
+
+    put();
+    {
+        SCOPED_TRACE("Basis");
+        volume->setBasis(2.0f * volume->getBasis());
+        put();
+    }
+    {
+        SCOPED_TRACE("Offset");
+        volume->setOffset(vec3(1.0f));
+        put();
+    }
+    {
+        SCOPED_TRACE("World matrix");
+        volume->setWorldMatrix(mat4(2.0f));
+        put();
+    }
+    {
+        SCOPED_TRACE("Data map");
+        volume->dataMap_.dataRange = dvec2(10.0, 20.0);
+        put();
+        volume->dataMap_.valueUnit = "m";
+        put();
+    }
+    {
+        SCOPED_TRACE("Data");
+        volume->getEditableRepresentation<VolumeRAM>();
+        put();
+    }
+}
+
+TEST(ResultCache, Eviction) {
+    ResultCache<int> cache{3 * sizeof(int)};
+    const auto key = [](int i) { return ResultCacheKey{}.addValue(i); };
+
+    for (int i = 0; i < 3; ++i) cache.put(key(i), std::make_shared<const int>(i));
+    // Use 0 to make 1 the least recently used
+    EXPECT_NE(cache.get(key(0)), nullptr);
+    cache.put(key(3), std::make_shared<const int>(3));
+
+    EXPECT_EQ(cache.getStatistics().evictions, size_t{1});
+    EXPECT_EQ(cache.getStatistics().entries, size_t{3});
+    EXPECT_NE(cache.get(key(0)), nullptr);
+    EXPECT_EQ(cache.get(key(1)), nullptr);
+    EXPECT_NE(cache.get(key(2)), nullptr);
+    EXPECT_NE(cache.get(key(3)), nullptr);
+
+    cache.setMemoryBudget(sizeof(int));
+    EXPECT_EQ(cache.getStatistics().entries, size_t{1});
+    EXPECT_NE(cache.get(key(3)), nullptr);
+
+    // Larger than the budget
+    ResultCache<int> small{sizeof(int), [](const int&) { return 2 * sizeof(int); }};
+    small.put(key(0), std::make_shared<const int>(0));
+    EXPECT_EQ(small.getStatistics().entries, size_t{0});
+}
+
+TEST(ResultCache, Properties) {
+    CompositeProperty owner("owner", "Owner");
+    IntProperty value("value", "Value", 1, 0, 10);
+    IntProperty output("output", "Output", 1, 0, 10);
+    owner.addProperty(value);
+    owner.addProperty(output);
+
+    const auto key = [&]() { return ResultCacheKey{}.addProperties(owner, {&output}); };
+
+    const auto key1 = key();
+    value.set(2);
+    const auto key2 = key();
+    EXPECT_NE(key1, key2);
+    output.set(5);
+    EXPECT_EQ(key2, key());
+    value.set(1);
+    EXPECT_EQ(key1, key());
+    EXPECT_EQ(key1.hash(), key().hash());
+}
+
+}  // namespace inviwo
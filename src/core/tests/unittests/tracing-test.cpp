@@ -0,0 +1,121 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/tracing.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace inviwo {
+
+namespace {
+
+std::string trace() {
+    std::stringstream ss;
+    Tracer::writeChromeTrace(ss);
+    return ss.str();
+}
+
+size_t count(const std::string& str, const std::string& pattern) {
+    size_t n = 0;
+    for (auto pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + 1)) {
+        ++n;
+    }
+    return n;
+}
+
+}  // namespace
+
+TEST(TracingTests, DisabledScopesAreNotRecorded) {
+    Tracer::setEnabled(false);
+    Tracer::clear();
+    { IVW_TRACE_SCOPE("test", "disabled scope"); }
+    EXPECT_EQ(size_t{0}, count(trace(), "disabled scope"));
+}
+
+TEST(TracingTests, NestedScopes) {
+    Tracer::clear();
+    Tracer::setEnabled(true);
+    {
+        IVW_TRACE_SCOPE("test", "outer scope");
+        for (int i = 0; i < 3; ++i) {
+            IVW_TRACE_SCOPE("test", "inner scope");
+        }
+        const std::string name = "named \"scope\"";
+        IVW_TRACE_SCOPE("test", name);
+        IVW_TRACE_SCOPE("test", nullptr);
+    }
+    Tracer::setEnabled(false);
+
+    const auto json = trace();
+    EXPECT_EQ(size_t{1}, count(json, R"("name":"outer scope","cat":"test","ph":"X")"));
+    EXPECT_EQ(size_t{3}, count(json, R"("name":"inner scope","cat":"test","ph":"X")"));
+    EXPECT_EQ(size_t{1}, count(json, R"("name":"named \"scope\"")"));
+    EXPECT_EQ(size_t{5}, count(json, R"("ph":"X")"));
+
+    Tracer::clear();
+    EXPECT_EQ(size_t{0}, count(trace(), R"("ph":"X")"));
+}
+
+TEST(TracingTests, ThreadsAndDroppedEvents) {
+    Tracer::clear();
+    const auto capacity = Tracer::getBufferCapacity();
+    Tracer::setBufferCapacity(100);
+    EXPECT_EQ(size_t{128}, Tracer::getBufferCapacity());
+
+    Tracer::setEnabled(true);
+    std::thread thread{[]() {
+        Tracer::setThreadName("Test thread");
+        for (int i = 0; i < 200; ++i) {
+            IVW_TRACE_SCOPE("test", "thread scope");
+        }
+    }};
+    thread.join();
+    Tracer::setEnabled(false);
+    Tracer::setBufferCapacity(capacity);
+
+    const auto json = trace();
+    EXPECT_EQ(size_t{1}, count(json, R"("args":{"name":"Test thread"})"));
+    EXPECT_EQ(size_t{128}, count(json, R"("name":"thread scope")"));
+    EXPECT_EQ(size_t{72}, Tracer::getNumberOfDroppedEvents());
+
+    // The buffers of finished threads are removed when clearing
+    Tracer::clear();
+    EXPECT_EQ(size_t{0}, count(trace(), "Test thread"));
+    EXPECT_EQ(size_t{0}, Tracer::getNumberOfDroppedEvents());
+}
+
+}  // namespace inviwo
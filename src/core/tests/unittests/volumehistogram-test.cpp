@@ -0,0 +1,147 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/volume/volumeramhistogram.h>
+
+#include <inviwo/core/util/quantilesketch.h>
+
+#include <algorithm>
+#include <random>
+
+namespace inviwo {
+
+TEST(VolumeHistogram, progressiveEqualsFull) {
+    const size3_t dims{13, 11, 9};
+    std::vector<float> data(glm::compMul(dims));
+    std::mt19937 gen(42);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    for (auto& v : data) v = dist(gen);
+    const dvec2 range{-5.0, 5.0};
+
+    const auto full = util::calculateVolumeHistogram(data.data(), dims, range, false, 256);
+
+    std::vector<HistogramContainer> estimates;
+    const auto progressive = util::calculateVolumeHistogramProgressive(
+        data.data(), dims, range, false, 256,
+        [&](const HistogramContainer& h) { estimates.push_back(h); });
+
+    ASSERT_EQ(size_t{3}, estimates.size());
+    for (const auto& estimate : estimates) {
+        ASSERT_EQ(size_t{1}, estimate.size());
+        EXPECT_TRUE(estimate.isValid());
+        EXPECT_EQ(size_t{256}, estimate[0].getData()->size());
+    }
+
+    ASSERT_EQ(size_t{1}, progressive.size());
+    ASSERT_TRUE(progressive.isValid());
+    EXPECT_EQ(*full[0].getData(), *progressive[0].getData());
+    EXPECT_EQ(full[0].getMaximumBinValue(), progressive[0].getMaximumBinValue());
+    EXPECT_EQ(full[0].stats_.min, progressive[0].stats_.min);
+    EXPECT_EQ(full[0].stats_.max, progressive[0].stats_.max);
+    EXPECT_NEAR(full[0].stats_.mean, progressive[0].stats_.mean, 1e-12);
+    EXPECT_NEAR(full[0].stats_.standardDeviation, progressive[0].stats_.standardDeviation,
+                1e-12);
+}
+
+TEST(VolumeHistogram, progressiveEstimatesRefine) {
+    const size3_t dims{4, 16, 16};
+    std::vector<glm::u8vec2> data(glm::compMul(dims));
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = glm::u8vec2(static_cast<glm::u8>(i % 256), static_cast<glm::u8>(7));
+    }
+    const dvec2 range{0.0, 255.0};
+
+    std::vector<double> maxBinValues;
+    const auto progressive = util::calculateVolumeHistogramProgressive(
+        data.data(), dims, range, false, 256, [&](const HistogramContainer& h) {
+            maxBinValues.push_back(h[1].getMaximumBinValue());
+        });
+
+    // The constant second channel ends up in a single bin, which counts all the rows visited
+    ASSERT_EQ(size_t{2}, progressive.size());
+    EXPECT_EQ(std::vector<double>({4.0 * 2 * 2, 4.0 * 4 * 4, 4.0 * 8 * 8}), maxBinValues);
+    EXPECT_EQ(static_cast<double>(data.size()), progressive[1].getMaximumBinValue());
+    EXPECT_EQ(1.0, (*progressive[1].getData())[7]);
+}
+
+TEST(VolumeHistogram, progressiveStop) {
+    const size3_t dims{8, 8, 8};
+    std::vector<float> data(glm::compMul(dims), 1.0f);
+    bool stop = false;
+    size_t calls = 0;
+    const auto res = util::calculateVolumeHistogramProgressive(
+        data.data(), dims, dvec2{0.0, 2.0}, stop, 16, [&](const HistogramContainer&) {
+            ++calls;
+            stop = true;
+        });
+    EXPECT_EQ(size_t{1}, calls);
+    EXPECT_TRUE(res.empty());
+}
+
+TEST(VolumeHistogram, percentiles) {
+    // Large enough for the percentiles to be estimated from a subsample
+    const size3_t dims{96, 96, 96};
+    std::vector<float> data(glm::compMul(dims));
+    std::mt19937 gen(7);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    for (auto& v : data) v = dist(gen);
+
+    const auto hist = util::calculateVolumeHistogram(data.data(), dims, dvec2{-5.0, 5.0});
+    ASSERT_EQ(size_t{1}, hist.size());
+    const auto& estimated = hist[0].stats_.percentiles;
+    ASSERT_EQ(size_t{101}, estimated.size());
+
+    std::vector<double> percentiles(101);
+    for (size_t i = 0; i < percentiles.size(); ++i) {
+        percentiles[i] = static_cast<double>(i) / 100.0;
+    }
+    auto values = data;
+    const auto exact = util::nearestRankPercentiles(values.begin(), values.end(), percentiles);
+
+    EXPECT_EQ(exact.front(), estimated.front());
+    EXPECT_EQ(exact.back(), estimated.back());
+
+    // Compare the ranks of the estimates to the requested percentiles
+    std::sort(values.begin(), values.end());
+    for (size_t i = 1; i + 1 < percentiles.size(); ++i) {
+        const auto rank = std::lower_bound(values.begin(), values.end(),
+                                           static_cast<float>(estimated[i])) -
+                          values.begin();
+        EXPECT_NEAR(percentiles[i], static_cast<double>(rank) / values.size(), 0.005)
+            << "percentile " << i;
+        EXPECT_NEAR(exact[i], estimated[i], 0.1) << "percentile " << i;
+    }
+}
+
+}  // namespace inviwo
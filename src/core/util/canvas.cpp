@@ -38,6 +38,7 @@
 #include <inviwo/core/interaction/events/wheelevent.h>
 #include <inviwo/core/interaction/events/touchevent.h>
 #include <inviwo/core/network/networklock.h>
+#include <inviwo/core/network/linktransaction.h>
 #include <inviwo/core/properties/boolproperty.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/settings/systemsettings.h>
@@ -56,6 +57,7 @@ void Canvas::resize(size2_t canvasSize) {
 
     if (propagator_) {
         NetworkLock lock;
+        LinkTransaction transaction;
         RenderContext::getPtr()->activateDefaultRenderContext();
         ResizeEvent resizeEvent(screenDimensions_);
         resizeEvent.setPreviousSize(previousScreenDimensions);
@@ -67,6 +69,9 @@ size2_t Canvas::getCanvasDimensions() const { return screenDimensions_; }
 
 void Canvas::propagateEvent(Event* event) {
     NetworkLock lock;
+    // Interactions often set the same properties several times, e.g. the camera, only
+    // propagate the final values over the links.
+    LinkTransaction transaction;
     if (!propagator_) return;
 
     pickingController_.propagateEvent(event, propagator_);
@@ -67,7 +67,10 @@ CommandLineParser::CommandLineParser(int argc, char** argv)
     , helpQuiet_("h", "help", "")
     , versionQuiet_("v", "version", "")
     , disableResourceManager_("", "no-resource-manager",
-                              "Pass this flag to disable the resource manager") {
+                              "Pass this flag to disable the resource manager")
+    , tracefile_("", "trace",
+                 "Enable tracing and write a Chrome trace event file when closing inviwo.", false,
+                 "", "tracefile") {
     cmdQuiet_.add(workspace_);
     cmdQuiet_.add(outputPath_);
     cmdQuiet_.add(quitAfterStartup_);
@@ -77,6 +80,7 @@ CommandLineParser::CommandLineParser(int argc, char** argv)
     cmdQuiet_.add(helpQuiet_);
     cmdQuiet_.add(versionQuiet_);
     cmdQuiet_.add(disableResourceManager_);
+    cmdQuiet_.add(tracefile_);
     cmdQuiet_.add(wildcard_);
 
     cmd_.add(workspace_);
@@ -86,6 +90,7 @@ CommandLineParser::CommandLineParser(int argc, char** argv)
     cmd_.add(logfile_);
     cmd_.add(logConsole_);
     cmd_.add(disableResourceManager_);
+    cmd_.add(tracefile_);
 
     parse(Mode::Quiet);
 }
@@ -184,6 +189,15 @@ bool CommandLineParser::getDisableResourceManager() const {
     return disableResourceManager_.isSet();
 }
 
+bool CommandLineParser::getTraceToFile() const { return tracefile_.isSet(); }
+
+const std::string CommandLineParser::getTraceFileName() const {
+    if (tracefile_.isSet())
+        return tracefile_.getValue();
+    else
+        return "";
+}
+
 int CommandLineParser::getARGC() const { return argc_; }
 
 char** CommandLineParser::getARGV() const { return argv_; }
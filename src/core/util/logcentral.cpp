@@ -33,6 +33,8 @@
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/util/raiiutils.h>
+#include <inviwo/core/util/tracing.h>
 
 namespace inviwo {
 
@@ -82,44 +84,194 @@ void Logger::logAssertion(const char* file, const char* function, int line, std:
     log("Assertion failed", LogLevel::Error, LogAudience::Developer, file, function, line, msg);
 }
 
-LogCentral::LogCentral() : logVerbosity_(LogVerbosity::Info), logStacktrace_(false) {}
+constexpr size_t LogCentral::queueCapacity;
+
+struct LogCentral::Message {
+    enum class Kind { Log, Network };
+
+    Kind kind = Kind::Log;
+    std::string source;
+    LogLevel level = LogLevel::Info;
+    LogAudience audience = LogAudience::Developer;
+    std::string file;
+    std::string function;
+    int line = 0;
+    std::string msg;
+};
+
+/**
+ * Bounded multiple producer queue, following Dmitry Vyukov's bounded MPMC queue.
+ * Pushing never blocks, it fails if the queue is full. Popping is only done while holding the
+ * dispatch mutex, hence there is only a single consumer at any time.
+ */
+class LogCentral::MessageQueue {
+public:
+    explicit MessageQueue(size_t capacity) : cells_(capacity), mask_{capacity - 1} {
+        for (size_t i = 0; i < capacity; ++i) cells_[i].sequence.store(i);
+    }
+
+    bool push(Message&& message) {
+        auto pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            auto& cell = cells_[pos & mask_];
+            const auto seq = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.message = std::move(message);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool pop(Message& message) {
+        const auto pos = dequeuePos_.load(std::memory_order_relaxed);
+        auto& cell = cells_[pos & mask_];
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1) return false;
+        message = std::move(cell.message);
+        cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+        dequeuePos_.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool empty() const {
+        const auto pos = dequeuePos_.load(std::memory_order_relaxed);
+        return cells_[pos & mask_].sequence.load(std::memory_order_acquire) != pos + 1;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        Message message;
+    };
+    std::vector<Cell> cells_;
+    const size_t mask_;
+    std::atomic<size_t> enqueuePos_{0};
+    std::atomic<size_t> dequeuePos_{0};
+};
+
+LogCentral::LogCentral()
+    : logVerbosity_{LogVerbosity::Info}
+    , logStacktrace_{false}
+    , breakLevel_{MessageBreakLevel::Off}
+    , queue_{std::make_unique<MessageQueue>(queueCapacity)}
+    , dropped_{0}
+    , reportedDropped_{0}
+    , dispatching_{false}
+    , stop_{false}
+    , dispatchThread_{[this]() {
+        Tracer::setThreadName("Log dispatch");
+        std::unique_lock<std::mutex> lock{wakeMutex_};
+        while (!stop_) {
+            wake_.wait(lock, [this]() { return stop_ || !queue_->empty(); });
+            lock.unlock();
+            dispatchQueued();
+            lock.lock();
+        }
+    }} {}
+
+LogCentral::~LogCentral() {
+    {
+        std::lock_guard<std::mutex> lock{wakeMutex_};
+        stop_ = true;
+    }
+    wake_.notify_one();
+    dispatchThread_.join();
+    flush();
+}
 
 void LogCentral::setVerbosity(LogVerbosity verbosity) { logVerbosity_ = verbosity; }
 
 LogVerbosity LogCentral::getVerbosity() { return logVerbosity_; }
 
-void LogCentral::registerLogger(std::weak_ptr<Logger> logger) { loggers_.push_back(logger); }
+void LogCentral::registerLogger(std::weak_ptr<Logger> logger) {
+    // Messages logged before the logger was registered should not reach it
+    dispatchQueued();
+    std::lock_guard<std::mutex> lock{registerMutex_};
+    newLoggers_.push_back(logger);
+}
 
-void LogCentral::log(std::string source, LogLevel level, LogAudience audience, const char* file,
-                     const char* function, int line, std::string msg) {
-    if (logStacktrace_ && level == LogLevel::Error && audience == LogAudience::Developer) {
-        std::stringstream ss;
-        ss << msg;
+void LogCentral::flush() { dispatchQueued(); }
 
-        std::vector<std::string> stacktrace = getStackTrace();
-        // start at i == 3 to remove log and getStacktrace from stackgrace
-        for (size_t i = 3; i < stacktrace.size(); ++i) {
-            ss << std::endl << stacktrace[i];
-        }
-        // append an extra line break to easier separate several stacktraces in a row
-        ss << std::endl;
+size_t LogCentral::getNumberOfDroppedMessages() const { return dropped_; }
 
-        msg = ss.str();
+void LogCentral::submit(Message&& message) {
+    if (queue_->push(std::move(message))) {
+        // Pass through the wake mutex so the notification can not fall between the dispatch
+        // thread checking the queue and starting to wait.
+        { std::lock_guard<std::mutex> lock{wakeMutex_}; }
+        wake_.notify_one();
+    } else {
+        ++dropped_;
     }
+}
 
-    if (level >= logVerbosity_) {
-        // use remove if here to remove expired weak pointers while calling the loggers.
-        util::erase_remove_if(loggers_, [&](const std::weak_ptr<Logger>& logger) {
-            if (auto l = logger.lock()) {
-                l->log(source, level, audience, file, function, line, msg);
-                return false;
-            } else {
-                return true;
-            }
-        });
+template <typename Callback>
+void LogCentral::forEachLogger(Callback callback) {
+    {
+        std::lock_guard<std::mutex> lock{registerMutex_};
+        loggers_.insert(loggers_.end(), newLoggers_.begin(), newLoggers_.end());
+        newLoggers_.clear();
     }
+    dispatching_ = true;
+    util::OnScopeExit reset{[this]() { dispatching_ = false; }};
+    // use remove if here to remove expired weak pointers while calling the loggers.
+    util::erase_remove_if(loggers_, [&](const std::weak_ptr<Logger>& logger) {
+        if (auto l = logger.lock()) {
+            callback(*l);
+            return false;
+        } else {
+            return true;
+        }
+    });
+}
 
-    switch (breakLevel_) {
+void LogCentral::dispatch(const Message& message) {
+    forEachLogger([&](Logger& logger) {
+        switch (message.kind) {
+            case Message::Kind::Log:
+                logger.log(message.source, message.level, message.audience, message.file.c_str(),
+                           message.function.c_str(), message.line, message.msg);
+                break;
+            case Message::Kind::Network:
+                logger.logNetwork(message.level, message.audience, message.msg,
+                                  message.file.c_str(), message.function.c_str(), message.line);
+                break;
+        }
+    });
+}
+
+void LogCentral::dispatchQueued() {
+    std::lock_guard<std::recursive_mutex> lock{dispatchMutex_};
+    // A logger is logging or flushing, the message will be handled by the outer call.
+    if (dispatching_) return;
+
+    Message message;
+    while (queue_->pop(message)) dispatch(message);
+
+    const size_t dropped = dropped_;
+    if (dropped != reportedDropped_) {
+        Message warning;
+        warning.source = "LogCentral";
+        warning.level = LogLevel::Warn;
+        warning.file = __FILE__;
+        warning.function = __FUNCTION__;
+        warning.line = __LINE__;
+        warning.msg = toString(dropped - reportedDropped_) +
+                      " log messages were dropped since the message queue was full";
+        reportedDropped_ = dropped;
+        dispatch(warning);
+    }
+}
+
+void LogCentral::breakIfNeeded(LogLevel level) const {
+    switch (breakLevel_.load()) {
         case MessageBreakLevel::Off:
             break;
         case MessageBreakLevel::Error:
@@ -136,45 +288,83 @@ void LogCentral::log(std::string source, LogLevel level, LogAudience audience, c
     }
 }
 
+void LogCentral::log(std::string source, LogLevel level, LogAudience audience, const char* file,
+                     const char* function, int line, std::string msg) {
+    // The stack trace has to be captured on the calling thread
+    if (logStacktrace_ && level == LogLevel::Error && audience == LogAudience::Developer) {
+        std::stringstream ss;
+        ss << msg;
+
+        std::vector<std::string> stacktrace = getStackTrace();
+        // start at i == 3 to remove log and getStacktrace from stackgrace
+        for (size_t i = 3; i < stacktrace.size(); ++i) {
+            ss << std::endl << stacktrace[i];
+        }
+        // append an extra line break to easier separate several stacktraces in a row
+        ss << std::endl;
+
+        msg = ss.str();
+    }
+
+    if (level >= logVerbosity_.load()) {
+        Message message;
+        message.kind = Message::Kind::Log;
+        message.source = std::move(source);
+        message.level = level;
+        message.audience = audience;
+        message.file = file ? file : "";
+        message.function = function ? function : "";
+        message.line = line;
+        message.msg = std::move(msg);
+        submit(std::move(message));
+
+        if (level == LogLevel::Error) flush();
+    }
+
+    breakIfNeeded(level);
+}
+
 void LogCentral::logProcessor(Processor* processor, LogLevel level, LogAudience audience,
                               std::string msg, const char* file, const char* function, int line) {
-    if (level >= logVerbosity_) {
-        // use remove if here to remove expired weak pointers while calling the loggers.
-        util::erase_remove_if(loggers_, [&](const std::weak_ptr<Logger>& logger) {
-            if (auto l = logger.lock()) {
-                l->logProcessor(processor, level, audience, msg, file, function, line);
-                return false;
-            } else {
-                return true;
-            }
+    if (level >= logVerbosity_.load()) {
+        std::lock_guard<std::recursive_mutex> lock{dispatchMutex_};
+        if (dispatching_) {
+            // Logged from within a logger, queue it as a regular message instead.
+            Logger::logProcessor(processor, level, audience, std::move(msg), file, function, line);
+            return;
+        }
+        dispatchQueued();
+        forEachLogger([&](Logger& logger) {
+            logger.logProcessor(processor, level, audience, msg, file, function, line);
         });
     }
 }
 
 void LogCentral::logNetwork(LogLevel level, LogAudience audience, std::string msg, const char* file,
                             const char* function, int line) {
-    if (level >= logVerbosity_) {
-        // use remove if here to remove expired weak pointers while calling the loggers.
-        util::erase_remove_if(loggers_, [&](const std::weak_ptr<Logger>& logger) {
-            if (auto l = logger.lock()) {
-                l->logNetwork(level, audience, msg, file, function, line);
-                return false;
-            } else {
-                return true;
-            }
-        });
+    if (level >= logVerbosity_.load()) {
+        Message message;
+        message.kind = Message::Kind::Network;
+        message.level = level;
+        message.audience = audience;
+        message.file = file ? file : "";
+        message.function = function ? function : "";
+        message.line = line;
+        message.msg = std::move(msg);
+        submit(std::move(message));
+
+        if (level == LogLevel::Error) flush();
     }
 }
 
 void LogCentral::logAssertion(const char* file, const char* function, int line, std::string msg) {
-    util::erase_remove_if(loggers_, [&](const std::weak_ptr<Logger>& logger) {
-        if (auto l = logger.lock()) {
-            l->logAssertion(file, function, line, msg);
-            return false;
-        } else {
-            return true;
-        }
-    });
+    std::lock_guard<std::recursive_mutex> lock{dispatchMutex_};
+    if (dispatching_) {
+        Logger::logAssertion(file, function, line, std::move(msg));
+        return;
+    }
+    dispatchQueued();
+    forEachLogger([&](Logger& logger) { logger.logAssertion(file, function, line, msg); });
 }
 
 void LogCentral::setLogStacktrace(const bool& logStacktrace) { logStacktrace_ = logStacktrace; }
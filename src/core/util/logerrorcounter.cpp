@@ -37,10 +37,13 @@ LogErrorCounter::~LogErrorCounter() = default;
 void LogErrorCounter::log(std::string /*logSource*/, LogLevel logLevel, LogAudience /*audience*/,
                           const char* /*fileName*/, const char* /*functionName*/,
                           int /*lineNumber*/, std::string /*logMsg*/) {
+    std::lock_guard<std::mutex> lock{mutex_};
     messageCount_[static_cast<LogLevel>(logLevel)]++;
 }
 
 size_t LogErrorCounter::getCount(const LogLevel& level) const {
+    if (LogCentral::isInitialized()) LogCentral::getPtr()->flush();
+    std::lock_guard<std::mutex> lock{mutex_};
     std::map<LogLevel, size_t>::const_iterator it = messageCount_.find(level);
     if (it == messageCount_.end()) return 0;
     return it->second;
@@ -53,6 +56,8 @@ size_t LogErrorCounter::getWarnCount() const { return getCount(LogLevel::Warn);
 size_t LogErrorCounter::getErrorCount() const { return getCount(LogLevel::Error); }
 
 void LogErrorCounter::reset() {
+    if (LogCentral::isInitialized()) LogCentral::getPtr()->flush();
+    std::lock_guard<std::mutex> lock{mutex_};
     for (auto& item : messageCount_) {
         item.second = 0;
     }
@@ -0,0 +1,195 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/quantilesketch.h>
+
+#include <limits>
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+constexpr double pi = 3.14159265358979323846;
+
+// The k1 scale function of the t-digest and its inverse, k(q) = compression / (2 pi) asin(2q - 1).
+// Adjacent centroids may only be merged if they together span at most one unit of k.
+double scale(double q, double normalizer) { return normalizer * std::asin(2.0 * q - 1.0); }
+double scaleInverse(double k, double normalizer) {
+    return k >= normalizer * pi / 2.0 ? 1.0 : (std::sin(k / normalizer) + 1.0) / 2.0;
+}
+
+}  // namespace
+
+QuantileSketch::QuantileSketch(double compression)
+    : compression_{std::max(compression, 10.0)}
+    , bufferSize_{static_cast<size_t>(5.0 * compression_)}
+    , min_{std::numeric_limits<double>::infinity()}
+    , max_{-std::numeric_limits<double>::infinity()} {
+    centroids_.reserve(static_cast<size_t>(compression_));
+    buffer_.reserve(bufferSize_ + static_cast<size_t>(compression_));
+}
+
+void QuantileSketch::add(double value, double weight) {
+    if (std::isnan(value) || !(weight > 0.0)) return;
+    buffer_.push_back(Centroid{value, weight});
+    totalWeight_ += weight;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+    if (buffer_.size() >= bufferSize_) flush();
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (other.empty()) return;
+    other.flush();
+    buffer_.insert(buffer_.end(), other.centroids_.begin(), other.centroids_.end());
+    totalWeight_ += other.totalWeight_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    if (buffer_.size() >= bufferSize_) flush();
+}
+
+void QuantileSketch::flush() const {
+    if (buffer_.empty()) return;
+
+    buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+    std::sort(buffer_.begin(), buffer_.end(),
+              [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; });
+    centroids_.clear();
+
+    const double normalizer = compression_ / (2.0 * pi);
+    const auto limit = [&](double weightSoFar) {
+        return totalWeight_ *
+               scaleInverse(scale(weightSoFar / totalWeight_, normalizer) + 1.0, normalizer);
+    };
+
+    auto current = buffer_.front();
+    double weightSoFar = 0.0;
+    double weightLimit = limit(weightSoFar);
+    for (auto it = std::next(buffer_.begin()); it != buffer_.end(); ++it) {
+        if (weightSoFar + current.weight + it->weight <= weightLimit) {
+            current.weight += it->weight;
+            current.mean += (it->mean - current.mean) * it->weight / current.weight;
+        } else {
+            weightSoFar += current.weight;
+            centroids_.push_back(current);
+            current = *it;
+            weightLimit = limit(weightSoFar);
+        }
+    }
+    centroids_.push_back(current);
+    buffer_.clear();
+}
+
+double QuantileSketch::quantile(double q) const {
+    if (q < 0.0 || q > 1.0) {
+        throw RangeException("Quantile must be between 0 and 1", IVW_CONTEXT);
+    }
+    if (empty()) return std::numeric_limits<double>::quiet_NaN();
+    flush();
+
+    const auto& c = centroids_;
+    if (c.size() == 1) return c.front().mean;
+
+    const double index = q * totalWeight_;
+    // The outermost half centroids are interpolated towards the exact extremes
+    if (index < 1.0) return min_;
+    if (index < c.front().weight / 2.0) {
+        return min_ + (index - 1.0) / (c.front().weight / 2.0 - 1.0) * (c.front().mean - min_);
+    }
+    if (index > totalWeight_ - 1.0) return max_;
+    if (totalWeight_ - index <= c.back().weight / 2.0) {
+        return max_ - (totalWeight_ - index - 1.0) / (c.back().weight / 2.0 - 1.0) *
+                          (max_ - c.back().mean);
+    }
+
+    // Interpolate between the centers of the two surrounding centroids, centroids of a single
+    // value are exact and cover half a unit of weight on each side.
+    double weightSoFar = c.front().weight / 2.0;
+    for (size_t i = 0; i + 1 < c.size(); ++i) {
+        const double dw = (c[i].weight + c[i + 1].weight) / 2.0;
+        if (weightSoFar + dw > index) {
+            double leftUnit = 0.0;
+            if (c[i].weight == 1.0) {
+                if (index - weightSoFar < 0.5) return c[i].mean;
+                leftUnit = 0.5;
+            }
+            double rightUnit = 0.0;
+            if (c[i + 1].weight == 1.0) {
+                if (weightSoFar + dw - index <= 0.5) return c[i + 1].mean;
+                rightUnit = 0.5;
+            }
+            const double z1 = index - weightSoFar - leftUnit;
+            const double z2 = weightSoFar + dw - index - rightUnit;
+            if (z1 + z2 <= 0.0) return c[i].mean;
+            return (c[i].mean * z2 + c[i + 1].mean * z1) / (z1 + z2);
+        }
+        weightSoFar += dw;
+    }
+    return c.back().mean;
+}
+
+std::vector<double> QuantileSketch::quantiles(const std::vector<double>& qs) const {
+    std::vector<double> result;
+    result.reserve(qs.size());
+    for (auto q : qs) result.push_back(quantile(q));
+    return result;
+}
+
+double QuantileSketch::count() const { return totalWeight_; }
+
+bool QuantileSketch::empty() const { return totalWeight_ == 0.0; }
+
+double QuantileSketch::min() const {
+    return empty() ? std::numeric_limits<double>::quiet_NaN() : min_;
+}
+
+double QuantileSketch::max() const {
+    return empty() ? std::numeric_limits<double>::quiet_NaN() : max_;
+}
+
+double QuantileSketch::getCompression() const { return compression_; }
+
+size_t QuantileSketch::getNumberOfCentroids() const {
+    flush();
+    return centroids_.size();
+}
+
+void QuantileSketch::clear() {
+    centroids_.clear();
+    buffer_.clear();
+    totalWeight_ = 0.0;
+    min_ = std::numeric_limits<double>::infinity();
+    max_ = -std::numeric_limits<double>::infinity();
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -0,0 +1,95 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/resultcache.h>
+#include <inviwo/core/util/stdextensions.h>
+#include <inviwo/core/io/serialization/serializer.h>
+#include <inviwo/core/properties/property.h>
+#include <inviwo/core/properties/propertyowner.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+
+#include <algorithm>
+#include <sstream>
+
+namespace inviwo {
+
+ResultCacheKey& ResultCacheKey::addValue(const std::string& value) {
+    addValue(value.size());
+    state_.append(value);
+    return *this;
+}
+
+ResultCacheKey& ResultCacheKey::addProperties(const PropertyOwner& owner,
+                                              const std::vector<const Property*>& ignored) {
+    Serializer serializer("");
+    for (auto property : owner.getProperties()) {
+        if (util::contains(ignored, property)) continue;
+        serializer.serialize(property->getIdentifier(), *property);
+    }
+    std::stringstream ss;
+    serializer.writeFile(ss);
+    return addValue(ss.str());
+}
+
+size_t ResultCacheKey::hash() const {
+    size_t seed = std::hash<std::string>{}(state_);
+    for (auto pointer : dataPointers_) util::hash_combine(seed, pointer);
+    return seed;
+}
+
+bool ResultCacheKey::isExpired() const {
+    return std::any_of(data_.begin(), data_.end(),
+                       [](const std::weak_ptr<const void>& data) { return data.expired(); });
+}
+
+bool ResultCacheKey::operator==(const ResultCacheKey& rhs) const {
+    // Equal pointers only refer to the same objects as long as both are alive
+    return dataPointers_ == rhs.dataPointers_ && state_ == rhs.state_ && !isExpired() &&
+           !rhs.isExpired();
+}
+
+bool ResultCacheKey::operator!=(const ResultCacheKey& rhs) const { return !operator==(rhs); }
+
+namespace util {
+
+size_t memorySize(const Volume& volume) {
+    return glm::compMul(volume.getDimensions()) * volume.getDataFormat()->getSize();
+}
+
+size_t memorySize(const Mesh& mesh) {
+    size_t bytes = 0;
+    for (const auto& buffer : mesh.getBuffers()) bytes += buffer.second->getSizeInBytes();
+    for (const auto& buffer : mesh.getIndexBuffers()) bytes += buffer.second->getSizeInBytes();
+    return bytes;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
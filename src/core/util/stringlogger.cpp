@@ -34,6 +34,7 @@ namespace inviwo {
 void StringLogger::log(std::string logSource, LogLevel logLevel, LogAudience /*audience*/,
                        const char* fileName, const char* /*functionName*/, int lineNumber,
                        std::string logMsg) {
+    std::lock_guard<std::mutex> lock{mutex_};
 
     switch (logLevel) {
         case LogLevel::Info:
@@ -52,6 +53,10 @@ void StringLogger::log(std::string logSource, LogLevel logLevel, LogAudience /*a
     logstream_ << logSource << " (" << fileName << ":" << lineNumber << ") " << logMsg << std::endl;
 }
 
-std::string StringLogger::getLog() const { return logstream_.str(); }
+std::string StringLogger::getLog() const {
+    if (LogCentral::isInitialized()) LogCentral::getPtr()->flush();
+    std::lock_guard<std::mutex> lock{mutex_};
+    return logstream_.str();
+}
 
 }  // namespace inviwo
@@ -30,6 +30,7 @@
 #include <inviwo/core/util/threadpool.h>
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/util/stdextensions.h>
+#include <inviwo/core/util/tracing.h>
 
 namespace inviwo {
 
@@ -79,6 +80,7 @@ ThreadPool::Worker::~Worker() { thread.join(); }
 
 ThreadPool::Worker::Worker(ThreadPool& pool)
     : state{State::Free}, thread{[this, &pool]() {
+        Tracer::setThreadName("Pool worker");
         pool.onThreadStart_();
         util::OnScopeExit cleanup{[&pool]() { pool.onThreadStop_(); }};
 
@@ -95,6 +97,7 @@ ThreadPool::Worker::Worker(ThreadPool& pool)
                 pool.tasks.pop();
             }
             state = State::Working;
+            IVW_TRACE_SCOPE("pool", "Task");
             task();
         }
         state = State::Done;
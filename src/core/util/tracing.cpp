@@ -0,0 +1,276 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#include <inviwo/core/util/tracing.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace inviwo {
+
+constexpr size_t TraceEvent::maxNameLength;
+
+std::atomic<bool> Tracer::enabled_{false};
+
+namespace {
+
+// All timestamps are relative to the time the core library was loaded
+const Tracer::Clock::time_point traceEpoch = Tracer::Clock::now();
+
+struct ThreadBuffer {
+    ThreadBuffer(size_t capacity, size_t aId, std::string aName)
+        : events(capacity), mask{capacity - 1}, id{aId}, name{std::move(aName)} {}
+
+    std::vector<TraceEvent> events;
+    const std::uint64_t mask;
+    const size_t id;
+    // Only written by the owning thread
+    std::atomic<std::uint64_t> head{0};
+    // Events before tail have been cleared, only written under the registry mutex
+    std::atomic<std::uint64_t> tail{0};
+    std::atomic<bool> alive{true};
+    // Guarded by the registry mutex
+    std::string name;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    size_t capacity = 16384;
+    size_t nextId = 0;
+};
+
+Registry& registry() {
+    static Registry registry;
+    return registry;
+}
+
+struct ThreadState {
+    ThreadState() = default;
+    ThreadState(const ThreadState&) = delete;
+    ThreadState& operator=(const ThreadState&) = delete;
+    ~ThreadState() {
+        if (buffer) buffer->alive = false;
+    }
+    std::shared_ptr<ThreadBuffer> buffer;
+    std::string name;
+};
+
+thread_local ThreadState threadState;
+
+ThreadBuffer& threadBuffer() {
+    if (!threadState.buffer) {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock{reg.mutex};
+        const auto id = reg.nextId++;
+        threadState.buffer = std::make_shared<ThreadBuffer>(
+            reg.capacity, id,
+            threadState.name.empty() ? "Thread " + std::to_string(id) : threadState.name);
+        reg.buffers.push_back(threadState.buffer);
+    }
+    return *threadState.buffer;
+}
+
+std::int64_t toNanoseconds(Tracer::Clock::duration d) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+}
+
+// Copy the events that are currently in the buffer. The owning thread might keep writing while
+// we read, hence we check the head again afterwards and discard any event that might have been
+// overwritten in the meantime, including the one that might currently be written.
+std::vector<TraceEvent> snapshot(const ThreadBuffer& buffer) {
+    const auto capacity = static_cast<std::uint64_t>(buffer.events.size());
+    const auto end = buffer.head.load(std::memory_order_acquire);
+    const auto begin =
+        std::max(buffer.tail.load(std::memory_order_relaxed), end > capacity ? end - capacity : 0);
+
+    std::vector<TraceEvent> events;
+    events.reserve(static_cast<size_t>(end - begin));
+    for (auto i = begin; i < end; ++i) events.push_back(buffer.events[i & buffer.mask]);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const auto after = buffer.head.load(std::memory_order_relaxed);
+    const std::uint64_t writing =
+        buffer.alive.load() && &buffer != threadState.buffer.get() ? 1 : 0;
+    const auto valid = after + writing > capacity ? after + writing - capacity : 0;
+    if (valid > begin) {
+        events.erase(events.begin(),
+                     events.begin() + static_cast<std::ptrdiff_t>(std::min(valid, end) - begin));
+    }
+    return events;
+}
+
+void writeJsonString(std::ostream& os, const char* str) {
+    static constexpr char hex[] = "0123456789abcdef";
+    os << '"';
+    for (; *str; ++str) {
+        const auto c = static_cast<unsigned char>(*str);
+        switch (c) {
+            case '"':
+                os << "\\\"";
+                break;
+            case '\\':
+                os << "\\\\";
+                break;
+            default:
+                if (c < 0x20) {
+                    os << "\\u00" << hex[c >> 4] << hex[c & 0xf];
+                } else {
+                    os << *str;
+                }
+        }
+    }
+    os << '"';
+}
+
+// Chrome expects microseconds, we keep the full nanosecond precision as decimals
+void writeMicroseconds(std::ostream& os, std::int64_t ns) {
+    const auto frac = ns % 1000;
+    os << ns / 1000 << '.' << static_cast<char>('0' + frac / 100)
+       << static_cast<char>('0' + (frac / 10) % 10) << static_cast<char>('0' + frac % 10);
+}
+
+}  // namespace
+
+void Tracer::setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+void Tracer::record(const char* category, const char* name, Clock::time_point start,
+                    Clock::time_point end) {
+    auto& buffer = threadBuffer();
+    const auto head = buffer.head.load(std::memory_order_relaxed);
+    auto& event = buffer.events[head & buffer.mask];
+
+    event.category = category;
+    event.start = std::max(std::int64_t{0}, toNanoseconds(start - traceEpoch));
+    event.duration = toNanoseconds(end - start);
+    size_t i = 0;
+    for (; i < TraceEvent::maxNameLength && name[i] != '\0'; ++i) event.name[i] = name[i];
+    event.name[i] = '\0';
+
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void Tracer::setThreadName(const std::string& name) {
+    threadState.name = name;
+    if (threadState.buffer) {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock{reg.mutex};
+        threadState.buffer->name = name;
+    }
+}
+
+void Tracer::setBufferCapacity(size_t events) {
+    size_t capacity = 1;
+    while (capacity < events) capacity <<= 1;
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock{reg.mutex};
+    reg.capacity = capacity;
+}
+
+size_t Tracer::getBufferCapacity() {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock{reg.mutex};
+    return reg.capacity;
+}
+
+void Tracer::clear() {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock{reg.mutex};
+    reg.buffers.erase(std::remove_if(reg.buffers.begin(), reg.buffers.end(),
+                                     [](const std::shared_ptr<ThreadBuffer>& buffer) {
+                                         return !buffer->alive;
+                                     }),
+                      reg.buffers.end());
+    for (auto& buffer : reg.buffers) {
+        buffer->tail.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+size_t Tracer::getNumberOfDroppedEvents() {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock{reg.mutex};
+    size_t dropped = 0;
+    for (auto& buffer : reg.buffers) {
+        const auto recorded = buffer->head.load(std::memory_order_acquire) -
+                              buffer->tail.load(std::memory_order_relaxed);
+        if (recorded > buffer->events.size()) {
+            dropped += static_cast<size_t>(recorded - buffer->events.size());
+        }
+    }
+    return dropped;
+}
+
+void Tracer::writeChromeTrace(std::ostream& os) {
+    std::vector<std::pair<std::shared_ptr<ThreadBuffer>, std::string>> buffers;
+    {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock{reg.mutex};
+        for (auto& buffer : reg.buffers) buffers.emplace_back(buffer, buffer->name);
+    }
+
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    os << R"({"name":"process_name","ph":"M","pid":1,"tid":0,"args":{"name":"Inviwo"}})";
+    for (auto& item : buffers) {
+        const auto tid = item.first->id;
+        os << ",\n" << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << tid
+           << R"(,"args":{"name":)";
+        writeJsonString(os, item.second.c_str());
+        os << "}}";
+
+        for (const auto& event : snapshot(*item.first)) {
+            os << ",\n{\"name\":";
+            writeJsonString(os, event.name);
+            os << ",\"cat\":";
+            writeJsonString(os, event.category);
+            os << R"(,"ph":"X","pid":1,"tid":)" << tid << ",\"ts\":";
+            writeMicroseconds(os, event.start);
+            os << ",\"dur\":";
+            writeMicroseconds(os, event.duration);
+            os << '}';
+        }
+    }
+    os << "\n]}\n";
+}
+
+void Tracer::writeChromeTrace(const std::string& filename) {
+    auto os = filesystem::ofstream(filename);
+    if (!os) {
+        throw FileException("Could not open file \"" + filename + "\" for writing",
+                            IVW_CONTEXT_CUSTOM("Tracer"));
+    }
+    writeChromeTrace(os);
+}
+
+}  // namespace inviwo
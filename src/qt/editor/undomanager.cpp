@@ -86,7 +86,7 @@ void UndoManager::pushState() {
     std::stringstream stream;
     try {
         manager_->save(stream, refPath_, [](ExceptionContext context) -> void { throw; },
-                       WorkspaceSaveMode::Undo);
+                       WorkspaceSaveMode::Undo, SerializationFormat::Binary);
     } catch (...) {
         return;
     }